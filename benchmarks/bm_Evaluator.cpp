@@ -0,0 +1,395 @@
+#include <benchmark/benchmark.h>
+
+#include "calculator/Expr.hpp"
+#include "compiler/Compiler.hpp"
+#include "evaluator/BatchVirtualMachine.hpp"
+#include "evaluator/Evaluator.hpp"
+#include "evaluator/VirtualMachine.hpp"
+#include "jit/TieredVirtualMachine.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "parser/Parser.hpp"
+#include "utils/AllocationCounter.hpp"
+#include "utils/ExpressionGenerator.hpp"
+
+namespace {
+/// Number of operands of the benchmarked expressions
+constexpr std::size_t cOperandCount{64};
+
+/**
+ * @brief Builds the operand values holding a value for every interned variable
+ *
+ * @param[in] symbolTable Symbol table holding the operands of the benchmarked expression
+ *
+ * @return Operand values, indexed by symbol id
+ */
+std::vector<std::optional<Evaluator::Value>>
+      createOperandValues(const Symbols::SymbolTable& symbolTable)
+{
+    std::vector<std::optional<Evaluator::Value>> operandValues(symbolTable.size());
+    for (Symbols::SymbolId symbolId = 0; symbolId < operandValues.size(); ++symbolId) {
+        operandValues[symbolId] = symbolTable.getName(symbolId).front() - 'a' + 1;
+    }
+
+    return operandValues;
+}
+
+/**
+ * @brief Parses the benchmarked expression for a given variable density
+ *
+ * @param[in,out] state State of the running benchmark (its first argument is the density)
+ * @param[in,out] symbolTable Symbol table used to intern the operands of the expression
+ *
+ * @return Shared pointer to the AST of the expression (nullptr if it could not be parsed)
+ */
+std::shared_ptr<const AST::Tree> parseExpression(benchmark::State& state,
+                                                 Symbols::SymbolTable& symbolTable)
+{
+    const auto arithmeticExpression = Benchmarks::Utils::createFlatExpression(
+          cOperandCount, static_cast<std::size_t>(state.range(0)));
+
+    Parser parser(arithmeticExpression, symbolTable);
+    if (!parser.execute()) {
+        state.SkipWithError("Invalid arithmetic expression");
+        return nullptr;
+    }
+
+    return parser.getASTOfRHS();
+}
+
+/**
+ * @brief Compiles the expression used by the what-if sweep benchmarks
+ * (a flat expression where half of the operands are variables)
+ *
+ * @param[in,out] state State of the running benchmark
+ * @param[in,out] symbolTable Symbol table used to intern the operands of the expression
+ *
+ * @return Shared pointer to the compiled expression (nullptr if it could not be compiled)
+ */
+std::shared_ptr<const Bytecode::Program> compileSweepExpression(benchmark::State& state,
+                                                                Symbols::SymbolTable& symbolTable)
+{
+    const auto arithmeticExpression = Benchmarks::Utils::createFlatExpression(cOperandCount, 50);
+
+    Parser parser(arithmeticExpression, symbolTable);
+    if (!parser.execute()) {
+        state.SkipWithError("Invalid arithmetic expression");
+        return nullptr;
+    }
+
+    Compiler compiler(*parser.getASTOfRHS());
+    if (!compiler.execute()) {
+        state.SkipWithError("Arithmetic expression could not be compiled");
+        return nullptr;
+    }
+
+    return compiler.getProgram();
+}
+
+/**
+ * @brief Builds a column of values for every interned variable
+ *
+ * @param[in] symbolTable Symbol table holding the operands of the benchmarked expression
+ * @param[in] bindingCount Amount of values of each column
+ *
+ * @return Values of the columns, indexed by symbol id
+ */
+std::vector<std::vector<Evaluator::Value>>
+      createColumnValues(const Symbols::SymbolTable& symbolTable, const std::size_t bindingCount)
+{
+    std::vector<std::vector<Evaluator::Value>> columnValues(
+          symbolTable.size(), std::vector<Evaluator::Value>(bindingCount));
+    for (auto& values : columnValues) {
+        for (std::size_t binding = 0; binding < bindingCount; ++binding) {
+            values[binding] = static_cast<Evaluator::Value>(binding % 9) + 1;
+        }
+    }
+
+    return columnValues;
+}
+} // namespace
+
+/**
+ * @brief Measures the time and heap allocations needed to evaluate an already parsed AST
+ * whose variables all have a value, for an increasing percentage of variable operands
+ */
+static void BM_EvaluatorExecute(benchmark::State& state)
+{
+    Symbols::SymbolTable symbolTable;
+    const auto ast = parseExpression(state, symbolTable);
+    if (!ast) {
+        return;
+    }
+
+    const auto operandValues = createOperandValues(symbolTable);
+
+    const auto allocationCountBefore = Benchmarks::Utils::getAllocationCount();
+
+    for (auto _ : state) {
+        Evaluator evaluator(*ast, operandValues);
+        benchmark::DoNotOptimize(evaluator.execute());
+    }
+
+    Benchmarks::Utils::reportAllocationsPerIteration(state, allocationCountBefore);
+}
+BENCHMARK(BM_EvaluatorExecute)->DenseRange(0, 100, 25);
+
+/**
+ * @brief Measures the time and heap allocations needed to run an already compiled expression
+ * whose variables all have a value, for an increasing percentage of variable operands
+ */
+static void BM_VirtualMachineExecute(benchmark::State& state)
+{
+    Symbols::SymbolTable symbolTable;
+    const auto ast = parseExpression(state, symbolTable);
+    if (!ast) {
+        return;
+    }
+
+    Compiler compiler(*ast);
+    if (!compiler.execute()) {
+        state.SkipWithError("Arithmetic expression could not be compiled");
+        return;
+    }
+    const auto program = compiler.getProgram();
+
+    const auto operandValues = createOperandValues(symbolTable);
+    VirtualMachine virtualMachine;
+
+    const auto allocationCountBefore = Benchmarks::Utils::getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(virtualMachine.execute(*program, operandValues));
+    }
+
+    Benchmarks::Utils::reportAllocationsPerIteration(state, allocationCountBefore);
+}
+BENCHMARK(BM_VirtualMachineExecute)->DenseRange(0, 100, 25);
+
+/**
+ * @brief Measures the time and heap allocations needed to run an already compiled expression
+ * whose AST was simplified first (the baseline being BM_VirtualMachineExecute),
+ * reporting the amount of AST nodes before and after the simplification
+ */
+static void BM_VirtualMachineOptimizedExecute(benchmark::State& state)
+{
+    Symbols::SymbolTable symbolTable;
+    const auto ast = parseExpression(state, symbolTable);
+    if (!ast) {
+        return;
+    }
+
+    Optimizer optimizer(*ast);
+    if (!optimizer.execute()) {
+        state.SkipWithError("Arithmetic expression could not be simplified");
+        return;
+    }
+
+    Compiler compiler(*optimizer.getOptimizedAST(), optimizer.getVariables());
+    if (!compiler.execute()) {
+        state.SkipWithError("Arithmetic expression could not be compiled");
+        return;
+    }
+    const auto program = compiler.getProgram();
+
+    const auto operandValues = createOperandValues(symbolTable);
+    VirtualMachine virtualMachine;
+
+    const auto allocationCountBefore = Benchmarks::Utils::getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(virtualMachine.execute(*program, operandValues));
+    }
+
+    Benchmarks::Utils::reportAllocationsPerIteration(state, allocationCountBefore);
+    state.counters["nodesBefore"] = static_cast<double>(ast->size());
+    state.counters["nodesAfter"] = static_cast<double>(optimizer.getOptimizedAST()->size());
+}
+BENCHMARK(BM_VirtualMachineOptimizedExecute)->DenseRange(0, 100, 25);
+
+/**
+ * @brief Measures the time and heap allocations needed to run an already compiled expression
+ * whose variables all have a value, once translated into native code
+ * (the baseline being BM_VirtualMachineExecute)
+ */
+static void BM_TieredVirtualMachineExecute(benchmark::State& state)
+{
+    Symbols::SymbolTable symbolTable;
+    const auto ast = parseExpression(state, symbolTable);
+    if (!ast) {
+        return;
+    }
+
+    Compiler compiler(*ast);
+    if (!compiler.execute()) {
+        state.SkipWithError("Arithmetic expression could not be compiled");
+        return;
+    }
+    const auto program = compiler.getProgram();
+
+    const auto operandValues = createOperandValues(symbolTable);
+    Jit::TieredVirtualMachine tieredVirtualMachine(0);
+    Jit::TieredVirtualMachine::ExpressionProfile profile;
+
+    // The first evaluation translates the expression
+    benchmark::DoNotOptimize(tieredVirtualMachine.execute(*program, operandValues, profile));
+    if (!profile.nativeFunction) {
+        state.SkipWithError("Arithmetic expression could not be translated into native code");
+        return;
+    }
+
+    const auto allocationCountBefore = Benchmarks::Utils::getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(tieredVirtualMachine.execute(*program, operandValues, profile));
+    }
+
+    Benchmarks::Utils::reportAllocationsPerIteration(state, allocationCountBefore);
+}
+BENCHMARK(BM_TieredVirtualMachineExecute)->DenseRange(0, 100, 25);
+
+/**
+ * @brief Measures the time needed to run a fixed formula compiled at run time
+ * (the reference for BM_ExprEvaluate)
+ */
+static void BM_FixedFormulaVirtualMachine(benchmark::State& state)
+{
+    Symbols::SymbolTable symbolTable;
+    Parser parser("x = (a*3-b)/(b+7)+a/2+(a-b)*(a+b)-c*(c-1)", symbolTable);
+    if (!parser.execute()) {
+        state.SkipWithError("Invalid arithmetic expression");
+        return;
+    }
+
+    Compiler compiler(*parser.getASTOfRHS());
+    if (!compiler.execute()) {
+        state.SkipWithError("Arithmetic expression could not be compiled");
+        return;
+    }
+
+    const auto program = compiler.getProgram();
+    auto operandValues = createOperandValues(symbolTable);
+    VirtualMachine virtualMachine;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(operandValues.data());
+        benchmark::DoNotOptimize(virtualMachine.execute(*program, operandValues));
+    }
+}
+BENCHMARK(BM_FixedFormulaVirtualMachine);
+
+/**
+ * @brief Measures the time needed to run the same fixed formula compiled at compile time
+ */
+static void BM_ExprEvaluate(benchmark::State& state)
+{
+    using Formula = Calculator::Expr<"(a*3-b)/(b+7)+a/2+(a-b)*(a+b)-c*(c-1)">;
+
+    Arithmetic::Value a{1};
+    Arithmetic::Value b{2};
+    Arithmetic::Value c{3};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(a);
+        benchmark::DoNotOptimize(b);
+        benchmark::DoNotOptimize(c);
+
+        Arithmetic::Value result{};
+        benchmark::DoNotOptimize(Formula::evaluate(result, a, b, c));
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_ExprEvaluate);
+
+/**
+ * @brief Measures the time needed to find the unmet dependencies of a compiled expression
+ * (none of its variables have a value), for an increasing percentage of variable operands
+ */
+static void BM_VirtualMachineUnmetDependencies(benchmark::State& state)
+{
+    Symbols::SymbolTable symbolTable;
+    const auto ast = parseExpression(state, symbolTable);
+    if (!ast) {
+        return;
+    }
+
+    Compiler compiler(*ast);
+    if (!compiler.execute()) {
+        state.SkipWithError("Arithmetic expression could not be compiled");
+        return;
+    }
+    const auto program = compiler.getProgram();
+
+    VirtualMachine virtualMachine;
+
+    const auto allocationCountBefore = Benchmarks::Utils::getAllocationCount();
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(virtualMachine.execute(*program, {}));
+    }
+
+    Benchmarks::Utils::reportAllocationsPerIteration(state, allocationCountBefore);
+}
+BENCHMARK(BM_VirtualMachineUnmetDependencies)->DenseRange(25, 100, 25);
+
+/**
+ * @brief Measures the time needed to run an already compiled expression over many bindings
+ * of its variables, one binding at a time (the baseline of BM_BatchVirtualMachineExecute)
+ */
+static void BM_VirtualMachinePerBinding(benchmark::State& state)
+{
+    Symbols::SymbolTable symbolTable;
+    const auto program = compileSweepExpression(state, symbolTable);
+    if (!program) {
+        return;
+    }
+
+    const auto bindingCount = static_cast<std::size_t>(state.range(0));
+    const auto columnValues = createColumnValues(symbolTable, bindingCount);
+    std::vector<std::optional<Evaluator::Value>> operandValues(symbolTable.size());
+    std::vector<Evaluator::Value> results(bindingCount);
+    VirtualMachine virtualMachine;
+
+    for (auto _ : state) {
+        for (std::size_t binding = 0; binding < bindingCount; ++binding) {
+            for (std::size_t symbolId = 0; symbolId < operandValues.size(); ++symbolId) {
+                operandValues[symbolId] = columnValues[symbolId][binding];
+            }
+            results[binding]
+                  = std::get<Evaluator::Value>(virtualMachine.execute(*program, operandValues));
+        }
+        benchmark::DoNotOptimize(results.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_VirtualMachinePerBinding)->RangeMultiplier(16)->Range(256, 1 << 16);
+
+/**
+ * @brief Measures the time needed to run an already compiled expression over many bindings
+ * of its variables, provided as columns
+ */
+static void BM_BatchVirtualMachineExecute(benchmark::State& state)
+{
+    Symbols::SymbolTable symbolTable;
+    const auto program = compileSweepExpression(state, symbolTable);
+    if (!program) {
+        return;
+    }
+
+    const auto bindingCount = static_cast<std::size_t>(state.range(0));
+    const auto columnValues = createColumnValues(symbolTable, bindingCount);
+    const std::vector<BatchVirtualMachine::Column> operandColumns(columnValues.begin(),
+                                                                  columnValues.end());
+    std::vector<Evaluator::Value> results(bindingCount);
+    std::vector<std::optional<Evaluator::Error>> errors(bindingCount);
+    BatchVirtualMachine batchVirtualMachine;
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+              batchVirtualMachine.execute(*program, operandColumns, results, errors));
+        benchmark::DoNotOptimize(results.data());
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BatchVirtualMachineExecute)->RangeMultiplier(16)->Range(256, 1 << 16);
@@ -0,0 +1,82 @@
+#include <benchmark/benchmark.h>
+
+#include "parser/Parser.hpp"
+#include "utils/AllocationCounter.hpp"
+#include "utils/ExpressionGenerator.hpp"
+
+namespace {
+/**
+ * @brief Measures the time and heap allocations needed to parse an expression into an AST
+ *
+ * @param[in,out] state State of the running benchmark
+ * @param[in] arithmeticExpression Expression to parse
+ */
+void measureParsing(benchmark::State& state, const std::string& arithmeticExpression)
+{
+    Symbols::SymbolTable symbolTable;
+
+    const auto allocationCountBefore = Benchmarks::Utils::getAllocationCount();
+
+    for (auto _ : state) {
+        Parser parser(arithmeticExpression, symbolTable);
+        benchmark::DoNotOptimize(parser.execute());
+        benchmark::DoNotOptimize(parser.getASTOfRHS());
+    }
+
+    state.SetBytesProcessed(state.iterations()
+                            * static_cast<int64_t>(arithmeticExpression.size()));
+    Benchmarks::Utils::reportAllocationsPerIteration(state, allocationCountBefore);
+}
+} // namespace
+
+/**
+ * @brief Parsing of flat expressions with an increasing amount of operands (half are variables)
+ */
+static void BM_ParserFlatExpression(benchmark::State& state)
+{
+    measureParsing(state,
+                   Benchmarks::Utils::createFlatExpression(static_cast<std::size_t>(state.range(0)),
+                                                           /*variablePercentage*/ 50));
+}
+BENCHMARK(BM_ParserFlatExpression)->RangeMultiplier(4)->Range(4, 1024);
+
+/**
+ * @brief Parsing of expressions with an increasing nesting depth
+ */
+static void BM_ParserNestedExpression(benchmark::State& state)
+{
+    measureParsing(state,
+                   Benchmarks::Utils::createNestedExpression(
+                         static_cast<std::size_t>(state.range(0))));
+}
+BENCHMARK(BM_ParserNestedExpression)->RangeMultiplier(4)->Range(1, 256);
+
+/**
+ * @brief Lookup of interned names in symbol tables holding an increasing amount of names
+ * (the cost should stay flat)
+ */
+static void BM_SymbolTableLookup(benchmark::State& state)
+{
+    const auto nameCount = static_cast<std::size_t>(state.range(0));
+
+    Symbols::SymbolTable symbolTable;
+    std::vector<std::string> names;
+    names.reserve(nameCount);
+    for (std::size_t index = 0; index < nameCount; ++index) {
+        names.push_back("operand_" + std::to_string(index));
+        benchmark::DoNotOptimize(symbolTable.intern(names.back()));
+    }
+
+    // Names are visited with a large odd stride, so lookups do not follow the insertion order
+    const auto allocationCountBefore = Benchmarks::Utils::getAllocationCount();
+    std::size_t index{0};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(symbolTable.find(names[index]));
+        index = (index + 7919) % nameCount;
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    Benchmarks::Utils::reportAllocationsPerIteration(state, allocationCountBefore);
+}
+BENCHMARK(BM_SymbolTableLookup)->RangeMultiplier(16)->Range(1 << 8, 1 << 20);
@@ -0,0 +1,258 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "calculator/Runner.hpp"
+#include "utils/AllocationCounter.hpp"
+
+namespace {
+/// Number of (single character) operands used by the workload
+constexpr int cOperandCount{26};
+
+/**
+ * @brief Generates a workload of instructions that repeatedly builds and tears down
+ * a dependency graph over all the operands
+ *
+ * Each round defines every operand, from 'z' down to 'a': each operand depends on
+ * (up to) two operands with a lower letter, which are only defined later in the round,
+ * so most expressions stay pending until 'a' resolves them in a cascade.
+ * The round then requests the last result and undoes all of its operations.
+ *
+ * @return Instructions of a single round
+ */
+std::vector<std::string> createWorkloadRound()
+{
+    std::vector<std::string> instructions;
+
+    for (int operand = cOperandCount - 1; operand >= 0; --operand) {
+        std::string instruction{static_cast<char>('a' + operand)};
+        instruction += " = ";
+
+        if (operand == 0) {
+            instruction += "7";
+        } else {
+            instruction += static_cast<char>('a' + (operand - 1));
+            instruction += " * 2 + ";
+            instruction += static_cast<char>('a' + operand / 2);
+            instruction += " / 3";
+        }
+
+        instructions.push_back(std::move(instruction));
+    }
+
+    instructions.emplace_back("result");
+    instructions.push_back("undo " + std::to_string(cOperandCount));
+
+    return instructions;
+}
+
+/**
+ * @brief Reports a percentile of the measured latencies (in microseconds)
+ *
+ * @param[in,out] state State of the running benchmark
+ * @param[in,out] latencies Every measured latency (partially sorted by the call)
+ * @param[in] name Name of the counter
+ * @param[in] percentile Percentile to report (0 to 1)
+ */
+void reportLatencyPercentile(benchmark::State& state,
+                             std::vector<std::chrono::nanoseconds>& latencies,
+                             const std::string& name,
+                             const double percentile)
+{
+    if (latencies.empty()) {
+        return;
+    }
+
+    const auto rank = std::min(latencies.size() - 1,
+                               static_cast<std::size_t>(percentile
+                                                        * static_cast<double>(latencies.size())));
+    std::nth_element(latencies.begin(), latencies.begin() + static_cast<std::ptrdiff_t>(rank),
+                     latencies.end());
+
+    state.counters[name]
+          = std::chrono::duration<double, std::micro>(latencies[rank]).count();
+}
+} // namespace
+
+/**
+ * @brief Measures the throughput of the whole instruction processing pipeline
+ * (parsing, compilation, evaluation and propagation), with and without the expression cache
+ * (argument: expression cache capacity)
+ */
+static void BM_RunnerProcessInstruction(benchmark::State& state)
+{
+    const auto instructions = createWorkloadRound();
+    Calculator::Runner calculator(static_cast<std::size_t>(state.range(0)));
+
+    const auto allocationCountBefore = Benchmarks::Utils::getAllocationCount();
+
+    std::size_t instructionIndex{0};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calculator.processInstruction(instructions[instructionIndex]));
+        instructionIndex = (instructionIndex + 1) % instructions.size();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+    Benchmarks::Utils::reportAllocationsPerIteration(state, allocationCountBefore);
+}
+BENCHMARK(BM_RunnerProcessInstruction)
+      ->ArgName("cacheCapacity")
+      ->Arg(0)
+      ->Arg(Calculator::Runner::cDefaultExpressionCacheCapacity);
+
+/**
+ * @brief Measures the throughput of eager and lazy evaluation over a mix of writes and reads
+ * (arguments: evaluation mode, percentage of reads)
+ *
+ * A tree of expressions is first built over a single source operand (every expression reads
+ * the source and its parent, so every write to the source affects all of them).
+ * The measured instructions then either write the source ("s = N") or read an expression
+ * ("get xK"): writes propagate through the whole tree in eager mode, while reads only evaluate
+ * the path to the root (when dirty) in lazy mode.
+ */
+static void BM_RunnerEvaluationMode(benchmark::State& state)
+{
+    constexpr int expressionCount{512};
+    constexpr std::size_t instructionCount{4096};
+
+    Calculator::Runner calculator;
+    calculator.setEvaluationMode(static_cast<Calculator::State::EvaluationMode>(state.range(0)));
+    const auto readPercentage = static_cast<uint32_t>(state.range(1));
+
+    calculator.processInstruction("x1 = s * 2 + 1");
+    for (int expression = 2; expression <= expressionCount; ++expression) {
+        calculator.processInstruction("x" + std::to_string(expression) + " = x"
+                                      + std::to_string(expression / 2) + " + s");
+    }
+    calculator.processInstruction("s = 1");
+
+    // The mix is generated once (with a fixed linear congruential generator)
+    // so that both modes process the same instructions
+    std::vector<std::string> instructions;
+    uint32_t seed{42};
+    const auto random = [&seed](const uint32_t upperBound) {
+        seed = seed * 1664525U + 1013904223U;
+        return (seed >> 8U) % upperBound;
+    };
+    for (std::size_t index = 0; index < instructionCount; ++index) {
+        instructions.push_back(random(100) < readPercentage
+                                     ? "get x" + std::to_string(1 + random(expressionCount))
+                                     : "s = " + std::to_string(1 + random(9)));
+    }
+
+    std::size_t instructionIndex{0};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(calculator.processInstruction(instructions[instructionIndex]));
+        instructionIndex = (instructionIndex + 1) % instructions.size();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RunnerEvaluationMode)
+      ->ArgNames({"lazy", "readPercentage"})
+      ->ArgsProduct({{0, 1}, {5, 50, 95}});
+
+/**
+ * @brief Measures the time needed to restore a session, either by replaying its instructions
+ * or by loading a snapshot of it (arguments: restore from snapshot, amount of expressions)
+ *
+ * The session defines a tree of pending expressions (each one reading its parent twice)
+ * which is resolved by a final assignment, cascading through all of them.
+ */
+static void BM_RunnerRestore(benchmark::State& state)
+{
+    const bool isFromSnapshot{state.range(0) != 0};
+    const auto expressionCount = static_cast<int>(state.range(1));
+    const auto snapshotPath = std::filesystem::temp_directory_path() / "bm_RunnerRestore.bin";
+
+    std::vector<std::string> instructions;
+    for (int expression = 1; expression <= expressionCount; ++expression) {
+        const auto parent = expression == 1 ? std::string{"s"}
+                                            : "x" + std::to_string(expression / 2);
+        instructions.push_back("x" + std::to_string(expression) + " = " + parent + " * 3 - "
+                               + parent + " / 2 + " + std::to_string(expression));
+    }
+    instructions.emplace_back("s = 7");
+
+    {
+        Calculator::Runner calculator;
+        for (const auto& instruction : instructions) {
+            static_cast<void>(calculator.processInstruction(instruction));
+        }
+        if (!calculator.saveSnapshot(snapshotPath.string())) {
+            state.SkipWithError("Unable to save the snapshot");
+            return;
+        }
+    }
+
+    for (auto _ : state) {
+        auto calculator = std::make_unique<Calculator::Runner>();
+
+        if (isFromSnapshot) {
+            benchmark::DoNotOptimize(calculator->loadSnapshot(snapshotPath.string()));
+        } else {
+            for (const auto& instruction : instructions) {
+                benchmark::DoNotOptimize(calculator->processInstruction(instruction));
+            }
+        }
+
+        // Tearing the session down is not part of restoring it
+        state.PauseTiming();
+        calculator.reset();
+        state.ResumeTiming();
+    }
+
+    std::filesystem::remove(snapshotPath);
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(instructions.size()));
+}
+BENCHMARK(BM_RunnerRestore)
+      ->ArgNames({"snapshot", "expressions"})
+      ->ArgsProduct({{0, 1}, {1024, 16384}})
+      ->Unit(benchmark::kMillisecond);
+
+/**
+ * @brief Measures the throughput and the latency distribution of the instruction processing
+ * pipeline with and without journaling the accepted instructions (argument: journaling)
+ *
+ * Journaled instructions are only appended to the pending records of the journal,
+ * which are written and synced to disk by its background thread (group commit).
+ */
+static void BM_RunnerJournal(benchmark::State& state)
+{
+    const bool isJournaling{state.range(0) != 0};
+    const auto journalPath = std::filesystem::temp_directory_path() / "bm_RunnerJournal.bin";
+    std::filesystem::remove(journalPath);
+
+    const auto round = createWorkloadRound();
+    std::vector<std::chrono::nanoseconds> latencies;
+    latencies.reserve(static_cast<std::size_t>(state.max_iterations));
+
+    {
+        Calculator::Runner calculator;
+        if (isJournaling && !calculator.openJournal(journalPath.string())) {
+            state.SkipWithError("Unable to open the journal");
+            return;
+        }
+
+        std::size_t instructionIndex{0};
+        for (auto _ : state) {
+            const auto startTime = std::chrono::steady_clock::now();
+            benchmark::DoNotOptimize(calculator.processInstruction(round[instructionIndex]));
+            latencies.push_back(std::chrono::steady_clock::now() - startTime);
+
+            instructionIndex = (instructionIndex + 1) % round.size();
+        }
+    }
+
+    std::filesystem::remove(journalPath);
+    state.SetItemsProcessed(state.iterations());
+    reportLatencyPercentile(state, latencies, "p50_us", 0.5);
+    reportLatencyPercentile(state, latencies, "p99_us", 0.99);
+    reportLatencyPercentile(state, latencies, "p999_us", 0.999);
+}
+BENCHMARK(BM_RunnerJournal)->ArgName("journal")->Arg(0)->Arg(1);
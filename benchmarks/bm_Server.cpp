@@ -0,0 +1,183 @@
+#include <benchmark/benchmark.h>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <latch>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "server/SessionServer.hpp"
+
+namespace {
+/// Amount of instructions sent by each client per benchmark iteration
+constexpr std::size_t cInstructionsPerClient{200};
+
+/// Instructions sent by the clients, in a loop (every round tears down what it defined)
+constexpr std::array<std::string_view, 6> cClientRound{
+      "c = (a + b) / 2\n", "b = a * 3\n", "a = 1 + 2\n", "result\n", "d = c - 1\n", "undo 4\n"};
+
+/**
+ * @brief Connects a client to the server
+ *
+ * @param[in] socketPath Path of the server socket
+ *
+ * @return Connected socket (-1 on failure)
+ */
+int connectClient(const std::string& socketPath)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::copy(socketPath.begin(), socketPath.end(), std::begin(address.sun_path));
+
+    const int socket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (::connect(socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(socket);
+        return -1;
+    }
+
+    return socket;
+}
+
+/**
+ * @brief Sends instructions one at a time, waiting for each response before sending the next
+ *
+ * @param[in] socket Connected socket
+ * @param[out] latencies Round trip time of every instruction
+ *
+ * @return False if the server stopped answering
+ */
+bool runClient(const int socket, std::vector<std::chrono::nanoseconds>& latencies)
+{
+    std::array<char, 512> response;
+
+    for (std::size_t index = 0; index < cInstructionsPerClient; ++index) {
+        const auto instruction = cClientRound[index % cClientRound.size()];
+        const auto startTime = std::chrono::steady_clock::now();
+
+        if (::send(socket, instruction.data(), instruction.size(), 0)
+            != static_cast<ssize_t>(instruction.size())) {
+            return false;
+        }
+
+        // Every response fits in a single (small) line
+        for (std::size_t receivedCount = 0;
+             receivedCount == 0 || response[receivedCount - 1] != '\n';) {
+            const auto count = ::recv(
+                  socket, response.data() + receivedCount, response.size() - receivedCount, 0);
+            if (count <= 0) {
+                return false;
+            }
+            receivedCount += static_cast<std::size_t>(count);
+        }
+
+        latencies.push_back(std::chrono::steady_clock::now() - startTime);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Reports a percentile of the measured latencies (in microseconds)
+ *
+ * @param[in,out] state State of the running benchmark
+ * @param[in,out] latencies Every measured latency (partially sorted by the call)
+ * @param[in] name Name of the counter
+ * @param[in] percentile Percentile to report (0 to 1)
+ */
+void reportLatencyPercentile(benchmark::State& state,
+                             std::vector<std::chrono::nanoseconds>& latencies,
+                             const std::string& name,
+                             const double percentile)
+{
+    if (latencies.empty()) {
+        return;
+    }
+
+    const auto rank = std::min(latencies.size() - 1,
+                               static_cast<std::size_t>(percentile
+                                                        * static_cast<double>(latencies.size())));
+    std::nth_element(latencies.begin(), latencies.begin() + static_cast<std::ptrdiff_t>(rank),
+                     latencies.end());
+
+    state.counters[name]
+          = std::chrono::duration<double, std::micro>(latencies[rank]).count();
+}
+} // namespace
+
+/**
+ * @brief Measures the aggregate throughput and the latency distribution of a server
+ * answering many concurrent clients, each sending one instruction at a time
+ * (arguments: client count and event loop count)
+ */
+static void BM_ServerConcurrentClients(benchmark::State& state)
+{
+    const auto clientCount = static_cast<std::size_t>(state.range(0));
+
+    Server::SessionServer server({.socketPath = "/tmp/bm_Server_" + std::to_string(::getpid()),
+                                  .threadCount = static_cast<std::size_t>(state.range(1))});
+    if (!server.start()) {
+        state.SkipWithError("Unable to start the server");
+        return;
+    }
+
+    std::vector<std::chrono::nanoseconds> latencies;
+
+    for (auto _ : state) {
+        std::vector<std::vector<std::chrono::nanoseconds>> clientLatencies(clientCount);
+        std::vector<int> sockets;
+        for (std::size_t client = 0; client < clientCount; ++client) {
+            sockets.push_back(connectClient(server.getSocketPath()));
+        }
+
+        // Clients only start sending once all of them are connected
+        std::latch startLine{static_cast<std::ptrdiff_t>(clientCount + 1)};
+        std::vector<std::thread> clients;
+        std::atomic<bool> isSuccessful{true};
+
+        for (std::size_t client = 0; client < clientCount; ++client) {
+            clients.emplace_back([&, client] {
+                clientLatencies[client].reserve(cInstructionsPerClient);
+                startLine.arrive_and_wait();
+                if (sockets[client] < 0 || !runClient(sockets[client], clientLatencies[client])) {
+                    isSuccessful = false;
+                }
+            });
+        }
+
+        startLine.arrive_and_wait();
+        const auto startTime = std::chrono::steady_clock::now();
+        for (auto& client : clients) {
+            client.join();
+        }
+        state.SetIterationTime(
+              std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+
+        for (std::size_t client = 0; client < clientCount; ++client) {
+            ::close(sockets[client]);
+            latencies.insert(
+                  latencies.end(), clientLatencies[client].begin(), clientLatencies[client].end());
+        }
+
+        if (!isSuccessful) {
+            state.SkipWithError("The server stopped answering");
+            return;
+        }
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                            * static_cast<int64_t>(clientCount * cInstructionsPerClient));
+    reportLatencyPercentile(state, latencies, "p50_us", 0.5);
+    reportLatencyPercentile(state, latencies, "p99_us", 0.99);
+    reportLatencyPercentile(state, latencies, "p999_us", 0.999);
+}
+BENCHMARK(BM_ServerConcurrentClients)
+      ->ArgNames({"clients", "threads"})
+      ->ArgsProduct({{1, 16, 128}, {1, 2, 4}})
+      ->UseManualTime()
+      ->Unit(benchmark::kMillisecond);
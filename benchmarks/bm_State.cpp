@@ -0,0 +1,315 @@
+#include <benchmark/benchmark.h>
+
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "calculator/State.hpp"
+#include "utils/AllocationCounter.hpp"
+
+namespace {
+/**
+ * @brief Generates (and interns) an operand of a synthetic dependency graph
+ *
+ * @param[in,out] symbolTable Symbol table holding the operands of the dependency graph
+ * @param[in] prefix Prefix of the operand name
+ * @param[in] index Index of the operand
+ *
+ * @return Symbol id of the operand
+ */
+Symbols::SymbolId operandId(Symbols::SymbolTable& symbolTable,
+                            const char prefix,
+                            const int64_t index)
+{
+    return symbolTable.intern(prefix + std::to_string(index));
+}
+
+/**
+ * @brief Creates a program that adds all the provided variables (and a literal one)
+ *
+ * @param[in] variables Operands to add
+ *
+ * @return Shared pointer to the compiled program
+ */
+std::shared_ptr<const Bytecode::Program> createSumProgram(std::vector<Symbols::SymbolId> variables)
+{
+    using Bytecode::OpCode;
+
+    auto program = std::make_shared<Bytecode::Program>();
+    program->instructions.push_back({OpCode::PUSH_LITERAL, 1});
+
+    for (uint32_t slot = 0; slot < variables.size(); ++slot) {
+        program->instructions.push_back({OpCode::PUSH_VARIABLE, slot});
+        program->instructions.push_back({OpCode::ADD, 0});
+    }
+
+    program->variables = std::move(variables);
+    program->maxStackDepth = 2;
+
+    return program;
+}
+
+/**
+ * @brief Registers a pending expression (sum of its dependencies) in the calculator state
+ *
+ * @param[in,out] state Calculator state
+ * @param[in] operand Operand of the expression
+ * @param[in] dependencies Operands the expression depends on
+ */
+void addSumExpression(Calculator::State& state,
+                      const Symbols::SymbolId operand,
+                      const std::vector<Symbols::SymbolId>& dependencies)
+{
+    if (!state.storeExpressionDependencies(
+              operand,
+              createSumProgram(dependencies),
+              dependencies)) {
+        std::abort();
+    }
+}
+
+/**
+ * @brief Measures how long it takes to update the source of a dependency graph
+ *
+ * @param[in,out] state State of the running benchmark
+ * @param[in] calculatorState Calculator state holding the dependency graph
+ * @param[in] sourceOperand Operand at the source of the dependency graph
+ */
+void measureSourceUpdates(benchmark::State& state,
+                          Calculator::State& calculatorState,
+                          const Symbols::SymbolId sourceOperand)
+{
+    const auto allocationCountBefore = Benchmarks::Utils::getAllocationCount();
+
+    int sourceValue{0};
+    std::size_t affectedValues{0};
+    for (auto _ : state) {
+        affectedValues
+              = calculatorState.storeExpressionValue(sourceOperand, ++sourceValue % 7).size();
+        benchmark::DoNotOptimize(affectedValues);
+    }
+
+    state.counters["affected"] = static_cast<double>(affectedValues);
+    Benchmarks::Utils::reportAllocationsPerIteration(state, allocationCountBefore);
+}
+} // namespace
+
+/**
+ * @brief Dependency chain: c1 = c0 + 1, c2 = c1 + 1, ..., cN = cN-1 + 1
+ */
+static void BM_StateChainPropagation(benchmark::State& state)
+{
+    Symbols::SymbolTable symbolTable;
+    Calculator::State calculatorState;
+    for (int64_t index = 1; index <= state.range(0); ++index) {
+        const auto previousOperand = operandId(symbolTable, 'c', index - 1);
+        addSumExpression(calculatorState, operandId(symbolTable, 'c', index), {previousOperand});
+    }
+
+    measureSourceUpdates(state, calculatorState, operandId(symbolTable, 'c', 0));
+}
+BENCHMARK(BM_StateChainPropagation)->RangeMultiplier(4)->Range(16, 4096);
+
+/**
+ * @brief Dependency chain of long expressions: cI = cI-1 + cI-1 + ... + 1, either interpreted
+ * or translated into native code (arguments: reads of cI-1 per expression and whether the
+ * expressions are translated)
+ */
+static void BM_StateLongExpressionChainPropagation(benchmark::State& state)
+{
+    constexpr int64_t cChainLength{1024};
+    const auto readCount = static_cast<std::size_t>(state.range(0));
+    const bool isNative{state.range(1) != 0};
+
+    Symbols::SymbolTable symbolTable;
+    Calculator::State calculatorState(
+          1, isNative ? 0 : std::numeric_limits<uint32_t>::max());
+    for (int64_t index = 1; index <= cChainLength; ++index) {
+        const auto previousOperand = operandId(symbolTable, 'c', index - 1);
+        if (!calculatorState.storeExpressionDependencies(
+                  operandId(symbolTable, 'c', index),
+                  createSumProgram(std::vector(readCount, previousOperand)),
+                  {previousOperand})) {
+            std::abort();
+        }
+    }
+
+    measureSourceUpdates(state, calculatorState, operandId(symbolTable, 'c', 0));
+}
+BENCHMARK(BM_StateLongExpressionChainPropagation)
+      ->ArgNames({"reads", "native"})
+      ->ArgsProduct({{8, 32, 128}, {0, 1}});
+
+/**
+ * @brief Wide diamond: w1..wN all depend on s, and t depends on every wI
+ */
+static void BM_StateWideDiamondPropagation(benchmark::State& state)
+{
+    Symbols::SymbolTable symbolTable;
+    Calculator::State calculatorState;
+    std::vector<Symbols::SymbolId> middleOperands;
+    const auto sourceOperand = symbolTable.intern("s");
+    for (int64_t index = 1; index <= state.range(0); ++index) {
+        middleOperands.push_back(operandId(symbolTable, 'w', index));
+        addSumExpression(calculatorState, middleOperands.back(), {sourceOperand});
+    }
+    addSumExpression(calculatorState, symbolTable.intern("t"), middleOperands);
+
+    measureSourceUpdates(state, calculatorState, sourceOperand);
+}
+BENCHMARK(BM_StateWideDiamondPropagation)->RangeMultiplier(4)->Range(16, 1024);
+
+/**
+ * @brief Chain of small diamonds: dI+1 depends on lI and rI, which both depend on dI
+ */
+static void BM_StateDiamondChainPropagation(benchmark::State& state)
+{
+    Symbols::SymbolTable symbolTable;
+    Calculator::State calculatorState;
+    for (int64_t index = 0; index < state.range(0); ++index) {
+        const auto topOperand = operandId(symbolTable, 'd', index);
+        const auto leftOperand = operandId(symbolTable, 'l', index);
+        const auto rightOperand = operandId(symbolTable, 'r', index);
+
+        addSumExpression(calculatorState, leftOperand, {topOperand});
+        addSumExpression(calculatorState, rightOperand, {topOperand});
+        addSumExpression(
+              calculatorState, operandId(symbolTable, 'd', index + 1), {leftOperand, rightOperand});
+    }
+
+    measureSourceUpdates(state, calculatorState, operandId(symbolTable, 'd', 0));
+}
+BENCHMARK(BM_StateDiamondChainPropagation)->DenseRange(4, 16, 4);
+
+/**
+ * @brief Tree cascade: every operand has fanOut dependants, down to the given depth
+ * (arguments: fan-out and depth)
+ */
+static void BM_StateTreePropagation(benchmark::State& state)
+{
+    const auto fanOut = state.range(0);
+    const auto depth = state.range(1);
+
+    Symbols::SymbolTable symbolTable;
+    Calculator::State calculatorState;
+
+    // Operands are numbered in breadth-first order: the dependants of tI are t(I*fanOut+1)...
+    int64_t levelEnd{1};
+    int64_t levelSize{1};
+    for (int64_t level = 1; level <= depth; ++level) {
+        levelSize *= fanOut;
+        levelEnd += levelSize;
+    }
+
+    for (int64_t index = 1; index < levelEnd; ++index) {
+        addSumExpression(calculatorState,
+                         operandId(symbolTable, 't', index),
+                         {operandId(symbolTable, 't', (index - 1) / fanOut)});
+    }
+
+    measureSourceUpdates(state, calculatorState, operandId(symbolTable, 't', 0));
+}
+BENCHMARK(BM_StateTreePropagation)
+      ->ArgNames({"fanOut", "depth"})
+      ->Args({2, 4})
+      ->Args({2, 8})
+      ->Args({2, 12})
+      ->Args({4, 3})
+      ->Args({4, 6})
+      ->Args({16, 2})
+      ->Args({16, 3})
+      ->Args({64, 2});
+
+/**
+ * @brief Wide fan-out evaluated by several propagation threads: w1..wN all depend on s,
+ * and vI depends on wI (arguments: width and propagation thread count)
+ */
+static void BM_StateParallelFanOutPropagation(benchmark::State& state)
+{
+    Symbols::SymbolTable symbolTable;
+    Calculator::State calculatorState(static_cast<std::size_t>(state.range(1)));
+    const auto sourceOperand = symbolTable.intern("s");
+    for (int64_t index = 1; index <= state.range(0); ++index) {
+        const auto middleOperand = operandId(symbolTable, 'w', index);
+        addSumExpression(calculatorState, middleOperand, {sourceOperand});
+        addSumExpression(calculatorState, operandId(symbolTable, 'v', index), {middleOperand});
+    }
+
+    measureSourceUpdates(state, calculatorState, sourceOperand);
+}
+BENCHMARK(BM_StateParallelFanOutPropagation)
+      ->ArgNames({"width", "threads"})
+      ->ArgsProduct({{4096, 65536}, {1, 2, 4, 8}})
+      ->UseRealTime();
+
+/**
+ * @brief Single wave of expressions w1..wN, all depending on s, always evaluated concurrently
+ * by several threads (arguments: width and propagation thread count, 1 being the serial baseline)
+ *
+ * Comparing the serial and concurrent timings of each width shows from which wave size
+ * the concurrent evaluation pays off (State::cDefaultMinParallelWaveSize)
+ */
+static void BM_StateParallelWaveEvaluation(benchmark::State& state)
+{
+    Symbols::SymbolTable symbolTable;
+    Calculator::State calculatorState(static_cast<std::size_t>(state.range(1)),
+                                      Jit::TieredVirtualMachine::cDefaultCompilationThreshold,
+                                      1);
+    const auto sourceOperand = symbolTable.intern("s");
+    for (int64_t index = 1; index <= state.range(0); ++index) {
+        addSumExpression(calculatorState, operandId(symbolTable, 'w', index), {sourceOperand});
+    }
+
+    measureSourceUpdates(state, calculatorState, sourceOperand);
+    state.counters["perExpression"] = benchmark::Counter(
+          static_cast<double>(state.iterations() * state.range(0)),
+          benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_StateParallelWaveEvaluation)
+      ->ArgNames({"width", "threads"})
+      ->Apply([](benchmark::internal::Benchmark* benchmark) {
+          // 1, 2 and 4 threads, plus one per core (on larger machines)
+          std::vector<int64_t> threadCounts{1, 2, 4};
+          if (const auto coreCount = static_cast<int64_t>(std::thread::hardware_concurrency());
+              coreCount > threadCounts.back()) {
+              threadCounts.push_back(coreCount);
+          }
+
+          for (const int64_t width : {64, 256, 512, 1024, 2048, 4096, 16384}) {
+              for (const auto threads : threadCounts) {
+                  benchmark->Args({width, threads});
+              }
+          }
+      })
+      ->UseRealTime();
+
+/**
+ * @brief Cycle rejection on a long dependency chain (c1 = c0 + 1, ..., cN = cN-1 + 1):
+ * cI = cN + 1 is rejected, where the affected region spans the operands from cI to cN
+ * (arguments: chain length and region length)
+ */
+static void BM_StateCycleRejection(benchmark::State& state)
+{
+    const auto chainLength = state.range(0);
+
+    Symbols::SymbolTable symbolTable;
+    Calculator::State calculatorState;
+    for (int64_t index = 1; index <= chainLength; ++index) {
+        const auto previousOperand = operandId(symbolTable, 'c', index - 1);
+        addSumExpression(calculatorState, operandId(symbolTable, 'c', index), {previousOperand});
+    }
+
+    const auto cyclicOperand = operandId(symbolTable, 'c', chainLength - state.range(1));
+    const std::vector dependencies{operandId(symbolTable, 'c', chainLength)};
+    const auto program = createSumProgram(dependencies);
+
+    for (auto _ : state) {
+        if (calculatorState.storeExpressionDependencies(cyclicOperand, program, dependencies)) {
+            std::abort();
+        }
+    }
+}
+BENCHMARK(BM_StateCycleRejection)
+      ->ArgNames({"chain", "region"})
+      ->ArgsProduct({{4096, 65536}, {16, 256, 4096}});
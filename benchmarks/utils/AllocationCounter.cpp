@@ -0,0 +1,40 @@
+#include "AllocationCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+/// Amount of calls made to the global operator new
+std::atomic<uint64_t> gAllocationCount{0};
+} // namespace
+
+void* operator new(const std::size_t size)
+{
+    gAllocationCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+namespace Benchmarks::Utils {
+
+uint64_t getAllocationCount()
+{
+    return gAllocationCount.load(std::memory_order_relaxed);
+}
+
+} // namespace Benchmarks::Utils
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+namespace Benchmarks::Utils {
+
+/**
+ * @brief Retrieves the amount of heap allocations performed so far by the process
+ *
+ * Every benchmark executable linking against this helper has its global allocation
+ * functions replaced by counting ones
+ *
+ * @return Number of calls made to the global operator new
+ */
+[[nodiscard]] uint64_t getAllocationCount();
+
+/**
+ * @brief Reports the average amount of heap allocations per iteration of a benchmark
+ *
+ * @param[in,out] state State of the running benchmark
+ * @param[in] allocationCountBefore Allocation count sampled before the benchmark loop started
+ */
+inline void reportAllocationsPerIteration(benchmark::State& state,
+                                          const uint64_t allocationCountBefore)
+{
+    state.counters["allocs/iter"] = benchmark::Counter(
+          static_cast<double>(getAllocationCount() - allocationCountBefore),
+          benchmark::Counter::kAvgIterations);
+}
+
+} // namespace Benchmarks::Utils
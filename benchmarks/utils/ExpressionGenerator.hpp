@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace Benchmarks::Utils {
+
+/**
+ * @brief Generates the (single character) operand at a given position of a synthetic expression
+ *
+ * Variables are spread evenly across the expression according to the requested density,
+ * and both variables and literals are never zero (so divisions are always defined).
+ *
+ * @param[in] position Position of the operand in the expression
+ * @param[in] variablePercentage Percentage of operands that are variables (0 to 100)
+ *
+ * @return Operand character
+ */
+[[nodiscard]] inline char createOperand(const std::size_t position,
+                                        const std::size_t variablePercentage)
+{
+    constexpr std::size_t cVariableCount{26};
+    constexpr std::size_t cLiteralCount{9};
+
+    const bool isVariable
+          = ((position + 1) * variablePercentage) / 100 > (position * variablePercentage) / 100;
+
+    return isVariable ? static_cast<char>('a' + position % cVariableCount)
+                      : static_cast<char>('1' + position % cLiteralCount);
+}
+
+/**
+ * @brief Generates a flat arithmetic expression ("x = o0 + o1 * o2 - o3 / o4 + ...")
+ *
+ * Operators cycle through '+', '*', '-' and '/', so that products and quotients only
+ * ever involve two operands (keeping intermediate values small).
+ *
+ * @param[in] operandCount Number of operands of the RHS
+ * @param[in] variablePercentage Percentage of operands that are variables (0 to 100)
+ *
+ * @return Arithmetic expression
+ */
+[[nodiscard]] inline std::string createFlatExpression(const std::size_t operandCount,
+                                                      const std::size_t variablePercentage)
+{
+    constexpr std::array cOperators{'+', '*', '-', '/'};
+
+    std::string expression{"x="};
+    for (std::size_t position = 0; position < operandCount; ++position) {
+        if (position > 0) {
+            expression.push_back(cOperators[(position - 1) % cOperators.size()]);
+        }
+        expression.push_back(createOperand(position, variablePercentage));
+    }
+
+    return expression;
+}
+
+/**
+ * @brief Generates a nested arithmetic expression ("x = (((a+1)*b)-2)...")
+ *
+ * @param[in] nestingDepth Number of nested parentheses pairs
+ *
+ * @return Arithmetic expression
+ */
+[[nodiscard]] inline std::string createNestedExpression(const std::size_t nestingDepth)
+{
+    constexpr std::array cOperators{'+', '*', '-', '/'};
+
+    std::string expression{"x="};
+    expression.append(nestingDepth, '(');
+    expression.push_back(createOperand(0, 50));
+
+    for (std::size_t depth = 1; depth <= nestingDepth; ++depth) {
+        expression.push_back(cOperators[(depth - 1) % cOperators.size()]);
+        expression.push_back(createOperand(depth, 50));
+        expression.push_back(')');
+    }
+
+    return expression;
+}
+
+} // namespace Benchmarks::Utils
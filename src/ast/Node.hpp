@@ -1,11 +1,32 @@
 #pragma once
 
-#include <iostream>
+#include <cstdint>
+#include <limits>
 
 namespace AST {
 
+/// Alias representing the position of a node inside the node arena of an AST
+using NodeIndex = uint32_t;
+
+/// Sentinel index used to represent the absence of a child node
+inline constexpr NodeIndex cInvalidNodeIndex{std::numeric_limits<NodeIndex>::max()};
+
+/**
+ * @brief Enum representing the kinds of nodes an AST can hold
+ */
+enum class NodeType : uint8_t {
+
+    LITERAL = 0,  // Integer literal (the node value is the literal itself)
+    VARIABLE = 1, // Operand (the node value is the symbol id of the operand)
+    OPERATOR = 2, // Binary operator (the node value is the operator character)
+    CONSTANT = 3  // Folded constant (the node value is its index in the constants of the tree)
+};
+
 /**
  * @brief Implementation of an AST Node
+ *
+ * Nodes do not own their children: they are linked through 32-bit indices
+ * into the contiguous node storage of the AST::Tree they belong to
  */
 class Node
 {
@@ -13,25 +34,39 @@ public:
     /**
      * @brief Class constructor
      *
-     * @param[in] nodeValue char representing the value that the node will hold
-     * @param[in] leftNode Left child node
-     * @param[in] rightNode Right child node
+     * @param[in] nodeType Kind of the node
+     * @param[in] nodeValue Value that the node will hold (interpreted according to its type)
+     * @param[in] leftNodeIndex Index of the left child node
+     * @param[in] rightNodeIndex Index of the right child node
+     */
+    explicit constexpr Node(NodeType nodeType,
+                            uint32_t nodeValue,
+                            NodeIndex leftNodeIndex = cInvalidNodeIndex,
+                            NodeIndex rightNodeIndex = cInvalidNodeIndex)
+        : mNodeType{nodeType}
+        , mNodeValue{nodeValue}
+        , mLeftNodeIndex{leftNodeIndex}
+        , mRightNodeIndex{rightNodeIndex}
+    {
+    }
+
+    /**
+     * @brief Getter for the kind of the node
+     *
+     * @return Node type
      */
-    explicit Node(char nodeValue,
-                  std::unique_ptr<Node> leftNode = nullptr,
-                  std::unique_ptr<Node> rightNode = nullptr)
-        : mNodeValue{nodeValue}
-        , mLeftNode{std::move(leftNode)}
-        , mRightNode{std::move(rightNode)}
+    [[nodiscard]] constexpr NodeType getNodeType() const
     {
+        return mNodeType;
     }
 
     /**
      * @brief Getter for the value currently being held by the node
      *
-     * @return Node value
+     * @return Node value (literal, symbol id, operator character or constant index,
+     * depending on the node type)
      */
-    [[nodiscard]] char getNodeValue() const
+    [[nodiscard]] constexpr uint32_t getNodeValue() const
     {
         return mNodeValue;
     }
@@ -39,52 +74,32 @@ public:
     /**
      * @brief Getter for the left child node
      *
-     * @return Reference to the left child node pointer
+     * @return Index of the left child node (cInvalidNodeIndex if there is none)
      */
-    [[nodiscard]] const std::unique_ptr<Node>& getReferenceToLeftNodePointer() const
+    [[nodiscard]] constexpr NodeIndex getLeftNodeIndex() const
     {
-        return mLeftNode;
+        return mLeftNodeIndex;
     }
 
     /**
      * @brief Getter for the right child node
      *
-     * @return Reference to the right child node pointer
+     * @return Index of the right child node (cInvalidNodeIndex if there is none)
      */
-    [[nodiscard]] const std::unique_ptr<Node>& getReferenceToRightNodePointer() const
+    [[nodiscard]] constexpr NodeIndex getRightNodeIndex() const
     {
-        return mRightNode;
+        return mRightNodeIndex;
     }
 
 private:
+    /// Kind of the node
+    NodeType mNodeType{};
     /// Value being held by the node
-    char mNodeValue{};
-    /// Left child node
-    std::unique_ptr<Node> mLeftNode{nullptr};
-    /// Right child node
-    std::unique_ptr<Node> mRightNode{nullptr};
+    uint32_t mNodeValue{};
+    /// Index of the left child node
+    NodeIndex mLeftNodeIndex{cInvalidNodeIndex};
+    /// Index of the right child node
+    NodeIndex mRightNodeIndex{cInvalidNodeIndex};
 };
 
-/**
- * @brief Helper method used to print (horizontally) the contents of an AST
- *
- * Recursive calls are made in order to print the content of every node's value.
- *
- * Preorder traversal is being used:
- * 1. Visit root node;
- * 2. Traverse left node (maintaining preorder traversal);
- * 2. Traverse right node (maintaining preorder traversal);
- *
- * @param[in] rootNode Reference to the root node of the AST
- * @param[in] prefix Helper string used to beautify the outputted data
- */
-inline void printAST(const std::unique_ptr<Node>& rootNode, std::string&& prefix = "")
-{
-    if (rootNode) {
-        std::cout << prefix << rootNode->getNodeValue() << "\n";
-        printAST(rootNode->getReferenceToLeftNodePointer(), prefix + "    ");
-        printAST(rootNode->getReferenceToRightNodePointer(), prefix + "    ");
-    }
-}
-
 } // namespace AST
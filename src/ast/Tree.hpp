@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ast/Node.hpp"
+#include "symbols/SymbolTable.hpp"
+
+namespace AST {
+
+/**
+ * @brief Implementation of an AST whose nodes live in a single contiguous arena
+ *
+ * Nodes are appended bottom-up (children are always added before their parent),
+ * so the most recently added node is the root of the tree built so far
+ * and every child index is lower than the index of its parent.
+ *
+ * Releasing a tree is a single deallocation of its node storage.
+ */
+class Tree
+{
+public:
+    /**
+     * @brief Class' default constructor
+     */
+    Tree() = default;
+
+    /**
+     * @brief Class constructor
+     *
+     * @param[in] expectedNodeCount Number of nodes to reserve storage for
+     */
+    explicit Tree(const std::size_t expectedNodeCount)
+    {
+        mNodes.reserve(expectedNodeCount);
+    }
+
+    /**
+     * @brief Appends a new literal (leaf) node to the tree, which becomes the new root node
+     *
+     * @param[in] literal Integer literal that the node will hold
+     *
+     * @return Index of the new node
+     */
+    NodeIndex addLiteralNode(const uint32_t literal)
+    {
+        mNodes.emplace_back(NodeType::LITERAL, literal);
+        return static_cast<NodeIndex>(mNodes.size() - 1);
+    }
+
+    /**
+     * @brief Appends a new constant (leaf) node to the tree, which becomes the new root node
+     *
+     * Constants do not fit in a node, so they are kept aside and referenced by their index
+     *
+     * @param[in] constant Integer constant (e.g. the result of folding a subtree)
+     * that the node will hold
+     *
+     * @return Index of the new node
+     */
+    NodeIndex addConstantNode(const int64_t constant)
+    {
+        mNodes.emplace_back(NodeType::CONSTANT, static_cast<uint32_t>(mConstants.size()));
+        mConstants.push_back(constant);
+        return static_cast<NodeIndex>(mNodes.size() - 1);
+    }
+
+    /**
+     * @brief Appends a new variable (leaf) node to the tree, which becomes the new root node
+     *
+     * @param[in] symbolId Symbol id of the operand that the node will hold
+     *
+     * @return Index of the new node
+     */
+    NodeIndex addVariableNode(const Symbols::SymbolId symbolId)
+    {
+        mNodes.emplace_back(NodeType::VARIABLE, symbolId);
+        return static_cast<NodeIndex>(mNodes.size() - 1);
+    }
+
+    /**
+     * @brief Appends a new operator node to the tree, which becomes the new root node
+     *
+     * @param[in] operation Binary operator character that the node will hold
+     * @param[in] leftNodeIndex Index of the (previously added) left child node
+     * @param[in] rightNodeIndex Index of the (previously added) right child node
+     *
+     * @return Index of the new node
+     */
+    NodeIndex addOperatorNode(const char operation,
+                              const NodeIndex leftNodeIndex,
+                              const NodeIndex rightNodeIndex)
+    {
+        assert(leftNodeIndex < mNodes.size() && rightNodeIndex < mNodes.size());
+
+        mNodes.emplace_back(NodeType::OPERATOR,
+                            static_cast<unsigned char>(operation),
+                            leftNodeIndex,
+                            rightNodeIndex);
+        return static_cast<NodeIndex>(mNodes.size() - 1);
+    }
+
+    /**
+     * @brief Getter for a node of the tree
+     *
+     * @param[in] nodeIndex Index of the node to retrieve
+     *
+     * @return Reference to the requested node
+     */
+    [[nodiscard]] const Node& getNode(const NodeIndex nodeIndex) const
+    {
+        return mNodes[nodeIndex];
+    }
+
+    /**
+     * @brief Getter for the value held by a constant node of the tree
+     *
+     * @param[in] node Constant node of the tree
+     *
+     * @return Integer constant held by the node
+     */
+    [[nodiscard]] int64_t getConstantValue(const Node& node) const
+    {
+        assert(node.getNodeType() == NodeType::CONSTANT);
+        return mConstants[node.getNodeValue()];
+    }
+
+    /**
+     * @brief Getter for the root node of the tree
+     *
+     * @return Index of the root node (cInvalidNodeIndex if the tree is empty)
+     */
+    [[nodiscard]] NodeIndex getRootNodeIndex() const
+    {
+        return mNodes.empty() ? cInvalidNodeIndex : static_cast<NodeIndex>(mNodes.size() - 1);
+    }
+
+    /**
+     * @brief Checks if the tree holds any node
+     *
+     * @return True if the tree has no nodes (false otherwise)
+     */
+    [[nodiscard]] bool empty() const
+    {
+        return mNodes.empty();
+    }
+
+    /**
+     * @brief Getter for the amount of nodes in the tree
+     *
+     * @return Number of nodes
+     */
+    [[nodiscard]] std::size_t size() const
+    {
+        return mNodes.size();
+    }
+
+private:
+    /// Contiguous storage holding every node of the tree
+    std::vector<Node> mNodes;
+
+    /// Values of the constant nodes of the tree, indexed by their node value
+    std::vector<int64_t> mConstants;
+};
+
+/**
+ * @brief Helper method used to print (horizontally) the contents of an AST
+ *
+ * Recursive calls are made in order to print the content of every node's value
+ * (variables are printed as '$' followed by their symbol id).
+ *
+ * Preorder traversal is being used:
+ * 1. Visit root node;
+ * 2. Traverse left node (maintaining preorder traversal);
+ * 2. Traverse right node (maintaining preorder traversal);
+ *
+ * @param[in] tree Reference to the AST
+ * @param[in] nodeIndex Index of the node to start printing from
+ * @param[in] prefix Helper string used to beautify the outputted data
+ */
+inline void printAST(const Tree& tree, const NodeIndex nodeIndex, std::string&& prefix = "")
+{
+    if (nodeIndex != cInvalidNodeIndex) {
+        const auto& node = tree.getNode(nodeIndex);
+
+        switch (node.getNodeType()) {
+        case NodeType::LITERAL:
+            std::cout << prefix << node.getNodeValue() << "\n";
+            break;
+        case NodeType::VARIABLE:
+            std::cout << prefix << "$" << node.getNodeValue() << "\n";
+            break;
+        case NodeType::OPERATOR:
+            std::cout << prefix << static_cast<char>(node.getNodeValue()) << "\n";
+            break;
+        case NodeType::CONSTANT:
+            std::cout << prefix << tree.getConstantValue(node) << "\n";
+            break;
+        }
+
+        printAST(tree, node.getLeftNodeIndex(), prefix + "    ");
+        printAST(tree, node.getRightNodeIndex(), prefix + "    ");
+    }
+}
+
+} // namespace AST
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "symbols/SymbolTable.hpp"
+
+namespace Bytecode {
+
+/**
+ * @brief Enum representing the instructions supported by the virtual machine
+ */
+enum class OpCode : uint8_t {
+
+    PUSH_LITERAL = 0,  // Push the literal held by the operand onto the stack
+    PUSH_VARIABLE = 1, // Push the value of the variable slot held by the operand onto the stack
+    ADD = 2,           // Pop two values and push their sum
+    SUB = 3,           // Pop two values and push their difference
+    MULT = 4,          // Pop two values and push their product
+    DIV = 5,           // Pop two values and push their quotient
+    PUSH_CONSTANT = 6  // Push the constant whose index (in the program constants) is the operand
+};
+
+/**
+ * @brief Single instruction of a compiled arithmetic expression
+ */
+struct Instruction
+{
+    /// Operation to perform
+    OpCode opCode{};
+    /// Literal value, constant index or variable slot (only meaningful for push operations)
+    uint32_t operand{};
+};
+
+/**
+ * @brief Arithmetic expression lowered into a postfix (stack machine) instruction stream
+ */
+struct Program
+{
+    /// Instructions to execute, in postfix order
+    std::vector<Instruction> instructions;
+    /// Symbol ids of the operands referenced by the expression, indexed by their variable slot
+    std::vector<Symbols::SymbolId> variables;
+    /// Values of the constants referenced by the expression, indexed by their constant index
+    std::vector<int64_t> constants;
+    /// Maximum amount of values simultaneously held on the stack during execution
+    uint32_t maxStackDepth{};
+};
+
+} // namespace Bytecode
@@ -0,0 +1,47 @@
+#include "BatchRunner.hpp"
+
+#include "utils/Methods.hpp"
+
+namespace Calculator {
+
+BatchRunner::BatchRunner(std::istream& input, std::ostream& output)
+    : mInput{input}
+    , mOutput{output}
+{
+}
+
+BatchRunner::Statistics BatchRunner::execute()
+{
+    Statistics statistics;
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    // The same string is reused for every line, so that its storage is only grown when needed
+    std::string instruction;
+    while (std::getline(mInput, instruction)) {
+        writeResults(
+              mRunner.processInstruction(Utils::Methods::removeLineEnding(instruction)), mOutput);
+        ++statistics.instructionCount;
+    }
+
+    // Results may still be sitting in the output buffer
+    mOutput.flush();
+
+    statistics.wallTime = std::chrono::steady_clock::now() - startTime;
+
+    return statistics;
+}
+
+Runner& BatchRunner::getRunner()
+{
+    return mRunner;
+}
+
+void writeResults(const std::vector<std::string>& results, std::ostream& output)
+{
+    for (auto itr = results.cbegin(); itr != results.cend(); ++itr) {
+        output << *itr << (std::next(itr) != results.cend() ? ", " : "\n");
+    }
+}
+
+} // namespace Calculator
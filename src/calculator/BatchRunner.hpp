@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "Runner.hpp"
+
+namespace Calculator {
+
+/**
+ * @brief Class responsible for replaying a stream of instructions through the calculator
+ *
+ * Instructions are read (one per line) until the end of the input stream is reached,
+ * without prompting for them, and their results are written to the output stream
+ * using the same format as the interactive mode.
+ */
+class BatchRunner
+{
+public:
+    /**
+     * @brief Summary of a batch execution
+     */
+    struct Statistics
+    {
+        /// Amount of processed instructions
+        std::size_t instructionCount{};
+        /// Time spent processing the instructions
+        std::chrono::duration<double> wallTime{};
+
+        /**
+         * @brief Computes the throughput of the batch execution
+         *
+         * @return Processed instructions per second (0 if no time was measured)
+         */
+        [[nodiscard]] double getInstructionsPerSecond() const
+        {
+            return wallTime.count() > 0.0 ? static_cast<double>(instructionCount) / wallTime.count()
+                                          : 0.0;
+        }
+    };
+
+    /**
+     * @brief Class constructor
+     *
+     * @param[in] input Stream to read the instructions from
+     * @param[in] output Stream to write the results of the instructions to
+     */
+    BatchRunner(std::istream& input, std::ostream& output);
+
+    /**
+     * @brief Processes every instruction of the input stream
+     *
+     * @return Statistics of the batch execution
+     */
+    Statistics execute();
+
+    /**
+     * @brief Getter for the calculator processing the instructions
+     * (e.g. to enable tracing before executing them)
+     *
+     * @return Reference to the calculator
+     */
+    [[nodiscard]] Runner& getRunner();
+
+private:
+    /// Stream to read the instructions from
+    std::istream& mInput;
+
+    /// Stream to write the results of the instructions to
+    std::ostream& mOutput;
+
+    /// Calculator processing the instructions
+    Runner mRunner;
+};
+
+/**
+ * @brief Writes the results of an instruction as a single line (results are comma separated)
+ *
+ * Nothing is written if there are no results.
+ *
+ * @param[in] results Results of the instruction
+ * @param[in,out] output Stream to write the results to
+ */
+void writeResults(const std::vector<std::string>& results, std::ostream& output);
+
+} // namespace Calculator
@@ -0,0 +1,321 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "evaluator/Arithmetic.hpp"
+#include "utils/ExpressionScanner.hpp"
+
+namespace Calculator {
+
+/**
+ * @brief String literal usable as a template argument (e.g. Expr<"2*(3+4)">)
+ *
+ * @tparam cSize Size of the string literal (including its null terminator)
+ */
+template <std::size_t cSize>
+struct FixedString
+{
+    /**
+     * @brief Class constructor
+     *
+     * @param[in] literal String literal to hold
+     */
+    consteval FixedString(const char (&literal)[cSize]) // NOLINT: implicit by design
+    {
+        std::copy_n(literal, cSize, characters);
+    }
+
+    /**
+     * @brief Retrieves a view of the held string
+     *
+     * @return View of the characters (without the null terminator)
+     */
+    [[nodiscard]] constexpr std::string_view view() const
+    {
+        return {characters, cSize - 1};
+    }
+
+    /// Characters of the string literal (including its null terminator)
+    char characters[cSize]{};
+};
+
+/**
+ * @brief Enum representing the types of the tokens of a compiled expression
+ */
+enum class ExprTokenType : uint8_t {
+
+    LITERAL = 0,  // Pushes the literal
+    VARIABLE = 1, // Pushes the value of the variable
+    OPERATOR = 2  // Pops two values and pushes the result of the operation
+};
+
+/**
+ * @brief Token of a compiled expression (in postfix order)
+ */
+struct ExprToken
+{
+    /// Type of the token
+    ExprTokenType type{};
+    /// Literal value, variable index or operator character (according to the type)
+    Arithmetic::Value value{};
+};
+
+/**
+ * @brief Arithmetic expression compiled at compile time, sized for the worst case
+ *
+ * @tparam cMaxTokenCount Maximum amount of tokens of the expression
+ * (never more than its characters)
+ */
+template <std::size_t cMaxTokenCount>
+struct ExprProgram
+{
+    /// Tokens of the expression, in postfix order
+    std::array<ExprToken, cMaxTokenCount> tokens{};
+    /// Amount of valid tokens
+    std::size_t tokenCount{};
+    /// Names of the variables, in order of appearance
+    std::array<std::string_view, cMaxTokenCount> variables{};
+    /// Amount of variables
+    std::size_t variableCount{};
+    /// Maximum amount of values on the stack while evaluating the expression
+    std::size_t maxStackDepth{};
+    /// Reason why the expression was rejected (empty if valid)
+    std::string_view error{};
+};
+
+/**
+ * @brief Emits the tokens of a scanned expression into a compiled expression
+ * (see Utils::Grammar::scanExpression)
+ *
+ * @tparam cMaxTokenCount Maximum amount of tokens of the expression
+ */
+template <std::size_t cMaxTokenCount>
+struct ExprEmitter
+{
+    /**
+     * @brief Emits a variable (numbered in order of appearance)
+     *
+     * @param[in] name Name of the variable
+     */
+    constexpr void addVariable(const std::string_view name)
+    {
+        const auto variablesEnd
+              = program.variables.begin() + static_cast<std::ptrdiff_t>(program.variableCount);
+        const auto variableItr = std::find(program.variables.begin(), variablesEnd, name);
+        if (variableItr == variablesEnd) {
+            program.variables[program.variableCount++] = name;
+        }
+
+        emit({ExprTokenType::VARIABLE, variableItr - program.variables.begin()});
+    }
+
+    /**
+     * @brief Emits an integer literal
+     *
+     * @param[in] literal Value of the literal
+     */
+    constexpr void addLiteral(const Arithmetic::Value literal)
+    {
+        emit({ExprTokenType::LITERAL, literal});
+    }
+
+    /**
+     * @brief Emits a binary operator
+     *
+     * @param[in] operation Operator character
+     */
+    constexpr void addOperator(const char operation)
+    {
+        emit({ExprTokenType::OPERATOR, operation});
+    }
+
+    /**
+     * @brief Appends a token, tracking the depth of the evaluation stack
+     *
+     * @param[in] token Token to append
+     */
+    constexpr void emit(const ExprToken& token)
+    {
+        program.tokens[program.tokenCount++] = token;
+        stackDepth = token.type == ExprTokenType::OPERATOR ? stackDepth - 1 : stackDepth + 1;
+        program.maxStackDepth = std::max(program.maxStackDepth, stackDepth);
+    }
+
+    /// Compiled expression
+    ExprProgram<cMaxTokenCount> program{};
+    /// Amount of values on the stack after the last emitted token
+    std::size_t stackDepth{0};
+};
+
+/**
+ * @brief Parses an arithmetic expression with the same scanner as the Parser,
+ * directly emitting its tokens in postfix order
+ *
+ * @tparam cMaxTokenCount Maximum amount of tokens of the expression
+ *
+ * @param[in] expression Arithmetic expression to compile (it must outlive the compiled one)
+ *
+ * @return Compiled expression (rejected if its error is not empty)
+ */
+template <std::size_t cMaxTokenCount>
+consteval ExprProgram<cMaxTokenCount> compileExpr(const std::string_view expression)
+{
+    ExprEmitter<cMaxTokenCount> emitter;
+    emitter.program.error = Utils::Grammar::scanExpression(expression, emitter);
+
+    return emitter.program;
+}
+
+/**
+ * @brief Arithmetic expression (the RHS of an assignment) parsed and compiled at compile time
+ *
+ * The expression follows the same grammar, precedences and (checked) arithmetic as the ones
+ * handled by the Parser and the Evaluator, and is rejected at compile time if invalid.
+ * Fully literal expressions evaluate to compile-time constants (through value()),
+ * while expressions with variables are unrolled into straight-line code specialized for them
+ * (through evaluate(), whose arguments are the values of the variables in order of appearance).
+ *
+ * Example:
+ * @code
+ * static_assert(Calculator::Expr<"2*(3+4)">::value() == 14);
+ *
+ * using Margin = Calculator::Expr<"(price - cost) * 100 / price">;
+ * Arithmetic::Value margin{};
+ * if (!Margin::evaluate(margin, 250, 200)) { ... } // price = 250, cost = 200
+ * @endcode
+ *
+ * @tparam cExpression Arithmetic expression
+ */
+template <FixedString cExpression>
+class Expr
+{
+private:
+    /// Compiled expression (sized for the worst case)
+    static constexpr auto cProgram = compileExpr<cExpression.view().size()>(cExpression.view());
+    static_assert(cProgram.error.empty(), "Invalid arithmetic expression");
+
+    /// Tokens of the compiled expression
+    static constexpr auto cTokens = [] {
+        std::array<ExprToken, cProgram.tokenCount> tokens{};
+        std::copy_n(cProgram.tokens.begin(), tokens.size(), tokens.begin());
+        return tokens;
+    }();
+
+    /// Amount of values on the stack before each token is executed
+    static constexpr auto cStackDepths = [] {
+        std::array<std::size_t, cProgram.tokenCount> stackDepths{};
+        std::size_t stackDepth{0};
+        for (std::size_t index = 0; index < stackDepths.size(); ++index) {
+            stackDepths[index] = stackDepth;
+            stackDepth = cTokens[index].type == ExprTokenType::OPERATOR ? stackDepth - 1
+                                                                        : stackDepth + 1;
+        }
+        return stackDepths;
+    }();
+
+public:
+    /// Amount of variables of the expression (the arguments of evaluate())
+    static constexpr std::size_t cVariableCount{cProgram.variableCount};
+
+    /// Names of the variables of the expression, in order of appearance
+    static constexpr auto cVariables = [] {
+        std::array<std::string_view, cVariableCount> variables{};
+        std::copy_n(cProgram.variables.begin(), variables.size(), variables.begin());
+        return variables;
+    }();
+
+    /**
+     * @brief Evaluates the expression
+     *
+     * @param[out] result Value of the expression (only meaningful if successful)
+     * @param[in] values Values of the variables, in order of appearance
+     *
+     * @return Error of the evaluation (empty if successful)
+     */
+    template <std::convertible_to<Arithmetic::Value>... Values>
+        requires(sizeof...(Values) == cVariableCount)
+    [[nodiscard]] static constexpr std::optional<Arithmetic::Error>
+          evaluate(Arithmetic::Value& result, const Values... values)
+    {
+        const std::array<Arithmetic::Value, cVariableCount> variableValues{
+              static_cast<Arithmetic::Value>(values)...};
+        std::array<Arithmetic::Value, cProgram.maxStackDepth> stack{};
+        std::optional<Arithmetic::Error> error;
+
+        // Every token is executed with its type, operands and stack slots known at compile time
+        // (stopping at the first failed operation)
+        [&]<std::size_t... cIndices>(std::index_sequence<cIndices...>) {
+            static_cast<void>((execute<cIndices>(stack, variableValues, error) && ...));
+        }(std::make_index_sequence<cTokens.size()>{});
+
+        if (!error) {
+            result = stack[0];
+        }
+        return error;
+    }
+
+    /**
+     * @brief Evaluates a fully literal expression at compile time
+     * (failed evaluations, such as divisions by zero, do not compile)
+     *
+     * @return Value of the expression
+     */
+    [[nodiscard]] static consteval Arithmetic::Value value()
+        requires(cVariableCount == 0)
+    {
+        Arithmetic::Value result{};
+        if (evaluate(result)) {
+            failedEvaluation();
+        }
+        return result;
+    }
+
+private:
+    /**
+     * @brief Executes a single token of the expression
+     *
+     * @tparam cIndex Index of the token
+     *
+     * @param[in,out] stack Evaluation stack
+     * @param[in] variableValues Values of the variables
+     * @param[out] error Error of the operation (if it failed)
+     *
+     * @return True if the token was executed successfully (false otherwise)
+     */
+    template <std::size_t cIndex>
+    static constexpr bool
+          execute(std::array<Arithmetic::Value, cProgram.maxStackDepth>& stack,
+                  const std::array<Arithmetic::Value, cVariableCount>& variableValues,
+                  std::optional<Arithmetic::Error>& error)
+    {
+        constexpr auto cToken = cTokens[cIndex];
+        constexpr auto cStackDepth = cStackDepths[cIndex];
+
+        if constexpr (cToken.type == ExprTokenType::LITERAL) {
+            stack[cStackDepth] = cToken.value;
+        } else if constexpr (cToken.type == ExprTokenType::VARIABLE) {
+            stack[cStackDepth] = variableValues[static_cast<std::size_t>(cToken.value)];
+        } else {
+            auto& left = stack[cStackDepth - 2];
+            const auto right = stack[cStackDepth - 1];
+            error = Arithmetic::apply(static_cast<char>(cToken.value), left, right, left);
+        }
+
+        return !error;
+    }
+
+    /**
+     * @brief Reports a failed compile-time evaluation
+     * (as it is not constexpr, reaching it while evaluating at compile time is an error)
+     */
+    static void failedEvaluation() {}
+};
+
+} // namespace Calculator
@@ -0,0 +1,86 @@
+#include "ExpressionCache.hpp"
+
+#include <algorithm>
+
+namespace Calculator {
+
+ExpressionCache::ExpressionCache(const std::size_t capacity)
+    : mCapacity{capacity}
+{
+    mEntriesLookupMap.reserve(capacity);
+}
+
+std::shared_ptr<const Bytecode::Program> ExpressionCache::find(const std::string_view normalizedRHS)
+{
+    const auto lookupItr = mEntriesLookupMap.find(normalizedRHS);
+
+    if (lookupItr == mEntriesLookupMap.end()) {
+        ++mStatistics.misses;
+        return nullptr;
+    }
+
+    ++mStatistics.hits;
+
+    // Move the entry to the front of the list (most recently used)
+    mEntries.splice(mEntries.begin(), mEntries, lookupItr->second);
+
+    return lookupItr->second->second;
+}
+
+void ExpressionCache::insert(std::string normalizedRHS,
+                             std::shared_ptr<const Bytecode::Program> program)
+{
+    if (mCapacity == 0) {
+        return;
+    }
+
+    // Refresh the entry if the expression is already cached
+    if (const auto lookupItr = mEntriesLookupMap.find(normalizedRHS);
+        lookupItr != mEntriesLookupMap.end()) {
+        lookupItr->second->second = std::move(program);
+        mEntries.splice(mEntries.begin(), mEntries, lookupItr->second);
+        return;
+    }
+
+    // Make room for the new entry by dropping the least recently used one
+    if (mEntries.size() == mCapacity) {
+        mEntriesLookupMap.erase(mEntries.back().first);
+        mEntries.pop_back();
+        ++mStatistics.evictions;
+    }
+
+    mEntries.emplace_front(std::move(normalizedRHS), std::move(program));
+    mEntriesLookupMap.emplace(mEntries.front().first, mEntries.begin());
+}
+
+const ExpressionCache::Statistics& ExpressionCache::getStatistics() const
+{
+    return mStatistics;
+}
+
+void ExpressionCache::clear()
+{
+    mEntriesLookupMap.clear();
+    mEntries.clear();
+}
+
+void ExpressionCache::eraseProgramsReading(const Symbols::SymbolId firstSymbolId)
+{
+    for (auto entryItr = mEntries.begin(); entryItr != mEntries.end();) {
+        if (std::ranges::any_of(entryItr->second->variables, [firstSymbolId](const auto variable) {
+                return variable >= firstSymbolId;
+            })) {
+            mEntriesLookupMap.erase(entryItr->first);
+            entryItr = mEntries.erase(entryItr);
+        } else {
+            ++entryItr;
+        }
+    }
+}
+
+std::size_t ExpressionCache::size() const
+{
+    return mEntries.size();
+}
+
+} // namespace Calculator
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include "bytecode/Program.hpp"
+#include "symbols/SymbolTable.hpp"
+
+namespace Calculator {
+
+/**
+ * @brief Bounded LRU cache mapping normalized RHS expressions to their compiled programs
+ *
+ * Cached programs are immutable, so they can be shared between the cache
+ * and the pending expressions stored in the calculator state
+ */
+class ExpressionCache
+{
+public:
+    /**
+     * @brief Usage counters of the cache
+     */
+    struct Statistics
+    {
+        /// Lookups that found a cached program
+        uint64_t hits{};
+        /// Lookups that did not find a cached program
+        uint64_t misses{};
+        /// Programs dropped to make room for newer ones
+        uint64_t evictions{};
+    };
+
+    /**
+     * @brief Class constructor
+     *
+     * @param[in] capacity Maximum amount of programs to keep cached (0 disables caching)
+     */
+    explicit ExpressionCache(std::size_t capacity);
+
+    /**
+     * @brief Retrieves the compiled program of an expression, marking it as the most recently used
+     *
+     * @param[in] normalizedRHS RHS expression (without white spaces) to look for
+     *
+     * @return Shared pointer to the compiled program (nullptr if the expression is not cached)
+     */
+    [[nodiscard]] std::shared_ptr<const Bytecode::Program> find(std::string_view normalizedRHS);
+
+    /**
+     * @brief Caches the compiled program of an expression, evicting the least recently used one
+     * if the cache is full
+     *
+     * @param[in] normalizedRHS RHS expression (without white spaces) used as key
+     * @param[in] program Compiled program of the expression
+     */
+    void insert(std::string normalizedRHS, std::shared_ptr<const Bytecode::Program> program);
+
+    /**
+     * @brief Drops every cached program (keeping the usage counters)
+     */
+    void clear();
+
+    /**
+     * @brief Drops the cached programs reading operands whose identifier is not lower
+     * than the given one (used when the names of those operands are forgotten)
+     *
+     * @param[in] firstSymbolId Lowest identifier of the operands that cached programs cannot read
+     */
+    void eraseProgramsReading(Symbols::SymbolId firstSymbolId);
+
+    /**
+     * @brief Getter for the usage counters of the cache
+     *
+     * @return Reference to the cache statistics
+     */
+    [[nodiscard]] const Statistics& getStatistics() const;
+
+    /**
+     * @brief Getter for the amount of currently cached programs
+     *
+     * @return Number of cached programs
+     */
+    [[nodiscard]] std::size_t size() const;
+
+private:
+    /// Alias representing a cache entry (normalized RHS and its compiled program)
+    using Entry = std::pair<std::string, std::shared_ptr<const Bytecode::Program>>;
+
+    /// Maximum amount of programs to keep cached
+    std::size_t mCapacity{};
+
+    /// Cached entries, from the most to the least recently used
+    std::list<Entry> mEntries;
+
+    /// Map used to look up entries by their key (views into the keys owned by mEntries)
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> mEntriesLookupMap;
+
+    /// Usage counters
+    Statistics mStatistics;
+};
+
+} // namespace Calculator
@@ -0,0 +1,49 @@
+#include "ReplayRunner.hpp"
+
+#include <chrono>
+
+#include "utils/Methods.hpp"
+
+namespace Calculator {
+
+ReplayRunner::ReplayRunner(const std::string_view instructionsLog, std::ostream& output)
+    : mInstructionsLog{instructionsLog}
+    , mOutput{output}
+{
+}
+
+BatchRunner::Statistics ReplayRunner::execute()
+{
+    BatchRunner::Statistics statistics;
+
+    const auto startTime = std::chrono::steady_clock::now();
+
+    auto remainingLog = mInstructionsLog;
+    while (!remainingLog.empty()) {
+
+        // Split the next line off the log (the last one might not be terminated)
+        const auto lineEndPosition = remainingLog.find('\n');
+        const auto instruction
+              = Utils::Methods::removeLineEnding(remainingLog.substr(0, lineEndPosition));
+        remainingLog.remove_prefix(lineEndPosition == std::string_view::npos
+                                         ? remainingLog.size()
+                                         : lineEndPosition + 1);
+
+        writeResults(mRunner.processInstruction(instruction), mOutput);
+        ++statistics.instructionCount;
+    }
+
+    // Results may still be sitting in the output buffer
+    mOutput.flush();
+
+    statistics.wallTime = std::chrono::steady_clock::now() - startTime;
+
+    return statistics;
+}
+
+Runner& ReplayRunner::getRunner()
+{
+    return mRunner;
+}
+
+} // namespace Calculator
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <ostream>
+#include <string_view>
+
+#include "BatchRunner.hpp"
+#include "Runner.hpp"
+
+namespace Calculator {
+
+/**
+ * @brief Class responsible for replaying an in-memory log of instructions through the calculator
+ *
+ * The log (typically a memory mapped file) is walked line by line as views,
+ * so the text of the instructions is never copied.
+ * Results are written to the output stream using the same format as the interactive mode.
+ */
+class ReplayRunner
+{
+public:
+    /**
+     * @brief Class constructor
+     *
+     * @param[in] instructionsLog View of the instructions to replay (one per line),
+     * which must outlive the replay
+     * @param[in] output Stream to write the results of the instructions to
+     */
+    ReplayRunner(std::string_view instructionsLog, std::ostream& output);
+
+    /**
+     * @brief Processes every instruction of the log
+     *
+     * @return Statistics of the replay
+     */
+    BatchRunner::Statistics execute();
+
+    /**
+     * @brief Getter for the calculator processing the instructions
+     * (e.g. to enable tracing before executing them)
+     *
+     * @return Reference to the calculator
+     */
+    [[nodiscard]] Runner& getRunner();
+
+private:
+    /// View of the instructions to replay
+    std::string_view mInstructionsLog;
+
+    /// Stream to write the results of the instructions to
+    std::ostream& mOutput;
+
+    /// Calculator processing the instructions
+    Runner mRunner;
+};
+
+} // namespace Calculator
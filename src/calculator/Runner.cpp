@@ -1,8 +1,18 @@
 #include "Runner.hpp"
 
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <fstream>
+
+#include "compiler/Compiler.hpp"
 #include "evaluator/Evaluator.hpp"
+#include "io/BinaryStream.hpp"
+#include "io/MappedFile.hpp"
+#include "optimizer/Optimizer.hpp"
 #include "parser/Parser.hpp"
 #include "utils/Constants.hpp"
+#include "utils/Grammar.hpp"
 #include "utils/Methods.hpp"
 
 namespace {
@@ -10,6 +20,19 @@ namespace {
 constexpr auto cUndoCommand{"undo"};
 /// Supported string for the result command
 constexpr auto cResultCommand{"result"};
+/// Supported string for the stats command
+constexpr auto cStatsCommand{"stats"};
+/// Supported string for the get command
+constexpr auto cGetCommand{"get"};
+/// Supported string for the save command
+constexpr auto cSaveCommand{"save"};
+/// Supported string for the load command
+constexpr auto cLoadCommand{"load"};
+
+/// Magic string starting every snapshot file
+constexpr std::string_view cSnapshotMagic{"CALCSNAP"};
+/// Version of the snapshot format (increased on every incompatible change)
+constexpr uint32_t cSnapshotFormatVersion{1};
 
 /**
  * @brief Enum representing operations supported by the calculator
@@ -18,46 +41,140 @@ enum class SupportedOperation : uint8_t {
 
     RESULT = 0, // Present result of last fulfilled operation
     UNDO = 1,   // Undo a certain amount of operation
-    OTHER = 2   // Most probably an arithmetic expression (needs further evaluation)
+    STATS = 2,  // Present the latency and propagation statistics
+    GET = 3,    // Present the value of an operand
+    SAVE = 4,   // Save a snapshot of the session
+    LOAD = 5,   // Replace the session with a snapshot
+    OTHER = 6   // Most probably an arithmetic expression (needs further evaluation)
 };
 
 /**
  * @brief Parses an input string to determine the type of operation that is being requested
  *
+ * The input is tokenized (on white spaces) in place, without copying it
+ *
  * @param[in] input The input string to parse
  *
- * @return A pair consisting of the type of operation and an optional integer argument
+ * @return A pair consisting of the type of operation and its argument (empty if none)
  */
-std::pair<SupportedOperation, std::optional<int>> getOperationRequest(const std::string& input)
+std::pair<SupportedOperation, std::string_view> getOperationRequest(const std::string_view input)
 {
-    const auto inputStringTokens
-          = Utils::Methods::splitString(input, Utils::Constants::cWhiteSpace);
+    using Utils::Constants::cWhiteSpace;
 
-    if (inputStringTokens.size() == 1 && inputStringTokens.back() == cResultCommand) {
-        return {SupportedOperation::RESULT, {}};
-    } else if (inputStringTokens.size() == 2 && inputStringTokens.front() == cUndoCommand) {
+    const auto delimiterPosition = input.find(cWhiteSpace);
 
-        int result{};
-        try {
-            result = std::stoi(inputStringTokens.back());
+    if (delimiterPosition == std::string_view::npos) {
+        if (input == cResultCommand) {
+            return {SupportedOperation::RESULT, {}};
         }
-        catch (const std::exception& e) {
-            result = -1;
+        if (input == cStatsCommand) {
+            return {SupportedOperation::STATS, {}};
         }
+    } else if (const auto command = input.substr(0, delimiterPosition),
+               argument = input.substr(delimiterPosition + 1);
+               argument.find(cWhiteSpace) == std::string_view::npos
+               // Operands can be named after the commands as well (e.g. "undo =2")
+               && argument.find(Utils::Constants::cAssignOp) == std::string_view::npos) {
 
-        return {SupportedOperation::UNDO, result};
+        if (command == cUndoCommand) {
+            return {SupportedOperation::UNDO, argument};
+        }
+        if (command == cGetCommand) {
+            return {SupportedOperation::GET, argument};
+        }
+        if (command == cSaveCommand) {
+            return {SupportedOperation::SAVE, argument};
+        }
+        if (command == cLoadCommand) {
+            return {SupportedOperation::LOAD, argument};
+        }
     }
 
     return {SupportedOperation::OTHER, {}};
 }
 
+/**
+ * @brief Parses the argument of the undo command
+ *
+ * @param[in] argument Argument of the undo command
+ *
+ * @return Amount of operations to undo (-1 if the argument is not a number)
+ */
+int parseUndoCount(const std::string_view argument)
+{
+    int undoCount{};
+    if (const auto [_, errorCode]
+        = std::from_chars(argument.data(), argument.data() + argument.size(), undoCount);
+        errorCode != std::errc{}) {
+        undoCount = -1;
+    }
+
+    return undoCount;
+}
+
+/**
+ * @brief Traces an instruction, from its construction until its destruction
+ * (nothing is traced without a trace writer)
+ */
+class InstructionSpan
+{
+public:
+    /**
+     * @brief Class constructor (starts the span)
+     *
+     * @param[in,out] traceWriter Writer recording the span (nullptr if not tracing)
+     * @param[in] input Instruction (it must outlive the span)
+     */
+    InstructionSpan(Metrics::TraceWriter* const traceWriter, const std::string_view input)
+        : mTraceWriter{traceWriter}
+        , mInput{input}
+        , mStartTime{traceWriter ? traceWriter->now() : 0}
+    {
+    }
+
+    /**
+     * @brief Class destructor (records the span)
+     */
+    ~InstructionSpan()
+    {
+        if (mTraceWriter) {
+            mTraceWriter->record(0,
+                                 {.name = std::string{mInput},
+                                  .category = "instruction",
+                                  .startTime = mStartTime,
+                                  .duration = mTraceWriter->now() - mStartTime});
+        }
+    }
+
+    InstructionSpan(const InstructionSpan&) = delete;
+    InstructionSpan& operator=(const InstructionSpan&) = delete;
+
+private:
+    /// Writer recording the span
+    Metrics::TraceWriter* mTraceWriter;
+
+    /// Traced instruction
+    std::string_view mInput;
+
+    /// Start of the span
+    uint64_t mStartTime;
+};
+
 } // namespace
 
 namespace Calculator {
 
-std::vector<std::string> Runner::processInstruction(const std::string& input)
+Runner::Runner(const std::size_t expressionCacheCapacity, const std::size_t propagationThreadCount)
+    : mState{propagationThreadCount}
+    , mExpressionCache{expressionCacheCapacity}
+{
+}
+
+std::vector<std::string> Runner::processInstruction(const std::string_view input)
 {
     std::vector<std::string> results;
+    const Statistics::StageTimer instructionTimer(mStatistics, Statistics::Stage::INSTRUCTION);
+    const InstructionSpan instructionSpan(mTraceWriter.get(), input);
 
     // Handle situations where the user provided a supported instructions
     // instead of an arithmetic expression.
@@ -67,73 +184,164 @@ std::vector<std::string> Runner::processInstruction(const std::string& input)
         switch (operationRequest.first) {
         case SupportedOperation::RESULT: {
             const auto lastOperation = mState.getLastFulfilledOperation();
+            reportPropagationErrors();
 
-            if (lastOperation == decltype(lastOperation)()) {
-                std::cerr << "There is no result available yet\n";
+            if (!lastOperation) {
+                *mDiagnostics << "There is no result available yet\n";
             } else {
-                results.emplace_back("return " + lastOperation.first + " = "
-                                     + std::to_string(lastOperation.second));
+                results.emplace_back("return "
+                                     + std::string{mSymbolTable.getName(lastOperation->first)}
+                                     + " = " + std::to_string(lastOperation->second));
             }
 
             return results;
         }
         case SupportedOperation::UNDO: {
-            const auto undoneOperations = mState.undoLastRegisteredOperations(
-                  operationRequest.second.value_or(/*default*/ 0));
+            const auto undoneOperations = [&] {
+                const Statistics::StageTimer undoTimer(mStatistics, Statistics::Stage::UNDO);
+                return mState.undoLastRegisteredOperations(
+                      parseUndoCount(operationRequest.second));
+            }();
+            reportPropagationErrors();
 
             if (undoneOperations.empty()) {
-                std::cout << "No operations were undone\n";
+                *mDiagnostics << "No operations were undone\n";
             } else {
+                journalInstruction(input);
+
                 for (const auto& undoneOperation : undoneOperations) {
-                    results.emplace_back("delete " + undoneOperation);
+                    results.emplace_back("delete "
+                                         + std::string{mSymbolTable.getName(undoneOperation)});
                 }
             }
 
             return results;
         }
+        case SupportedOperation::GET: {
+            const auto operand = mSymbolTable.find(operationRequest.second);
+            if (!operand) {
+                *mDiagnostics << "Unknown operand \'" << operationRequest.second << "\'\n";
+                return results;
+            }
+
+            refreshOperands({&*operand, 1});
+
+            if (const auto& operandValues = mState.getOperandValues();
+                *operand < operandValues.size() && operandValues[*operand]) {
+                results.emplace_back(std::string{operationRequest.second} + " = "
+                                     + std::to_string(*operandValues[*operand]));
+            } else {
+                *mDiagnostics << "\'" << operationRequest.second << "\' has no value\n";
+            }
+
+            return results;
+        }
+        case SupportedOperation::SAVE: {
+            if (!mAreFileCommandsEnabled) {
+                *mDiagnostics << "File commands are disabled in this session\n";
+            } else if (!saveSnapshot(std::string{operationRequest.second})) {
+                *mDiagnostics << "Unable to save the snapshot\n";
+            } else {
+                journalInstruction(input);
+            }
+
+            return results;
+        }
+        case SupportedOperation::LOAD: {
+            if (!mAreFileCommandsEnabled) {
+                *mDiagnostics << "File commands are disabled in this session\n";
+            } else if (!loadSnapshot(std::string{operationRequest.second})) {
+                *mDiagnostics << "Unable to load the snapshot\n";
+            } else {
+                journalInstruction(input);
+            }
+
+            return results;
+        }
+        case SupportedOperation::STATS: {
+            if constexpr (!Statistics::cIsEnabled) {
+                *mDiagnostics << "Statistics are disabled in this build\n";
+            } else {
+                // The report is a single result holding one entry per line
+                // (separate results would be written comma separated, on a single line)
+                std::string report;
+                for (const auto& line : mStatistics.report(mState.getPendingExpressionCount(),
+                                                           mExpressionCache.getStatistics())) {
+                    if (!report.empty()) {
+                        report += '\n';
+                    }
+                    report += line;
+                }
+                results.push_back(std::move(report));
+            }
+
+            return results;
+        }
         case SupportedOperation::OTHER:
         default:
             break;
         }
     }
 
-    // Try to parse the provided arithmetic expression
-    Parser expressionParser(input);
-    if (!expressionParser.execute()) {
-        std::cout << "\nInvalid arithmetic expression provided.";
+    // Names are interned while the expression is parsed,
+    // so the ones it introduced are forgotten again if it is rejected
+    const auto symbolCount = mSymbolTable.size();
+
+    // Try to parse and compile the provided arithmetic expression
+    // (retrieving the operand of its LHS and the compiled program of its RHS)
+    Symbols::SymbolId expressionOperand{};
+    const auto expressionProgram = getCompiledExpression(input, expressionOperand);
+    if (!expressionProgram) {
+        *mDiagnostics << "Invalid arithmetic expression provided\n";
+        forgetNewSymbols(symbolCount);
         return results;
     }
 
-    // Retrieve the LHS of the parsed arithmetic expression (an operand).
-    const auto expressionOperand = expressionParser.getOperandOfLHS();
-    // Retrieve the RHS of the parsed arithmetic expression (an AST).
-    const auto expressionAST = expressionParser.getASTOfRHS();
+    // In lazy mode, the operand and the operands read by the program may be out of date
+    // (the operand is refreshed as well, so that older updates do not overwrite it)
+    refreshOperands({&expressionOperand, 1});
+    refreshOperands(expressionProgram->variables);
 
-    // Try to evaluate the AST to check if we can obtain
+    // Try to evaluate the program to check if we can obtain
     // either a valid result or a list of unmet dependencies
-    Evaluator astEvaluator(expressionAST->top(),
-                           // the map with the current values of each operand is provided for
-                           // dependency lookup when evaluation the AST
-                           mState.getOperandValueMap());
+    const auto evaluationResult = [&] {
+        const Statistics::StageTimer evaluationTimer(mStatistics, Statistics::Stage::EVALUATION);
+        return mVirtualMachine.execute(
+              *expressionProgram,
+              // the map with the current values of each operand is provided for
+              // dependency lookup when evaluating the program
+              mState.getOperandValues());
+    }();
 
-    // Get the result of the evaluation and process it according to its type
-    const auto evaluationResult = astEvaluator.execute();
+    // Process the result of the evaluation according to its type
     std::visit(
           [&](auto&& variantValue) {
-              // Expected types: int or unordered_set<std::string>
+              // Expected types: Evaluator::Value, Evaluator::Dependencies or Evaluator::Error
               using VariantType = std::decay_t<decltype(variantValue)>;
 
               // Did we get a value after the expression was evaluated?
-              if constexpr (std::is_same_v<VariantType, int>) {
+              if constexpr (std::is_same_v<VariantType, Evaluator::Value>) {
 
                   // Then, store it
-                  for (const auto& [operand, value] :
-                       mState.storeExpressionValue(expressionOperand, variantValue)) {
+                  const auto affectedValues = [&] {
+                      const Statistics::StageTimer propagationTimer(
+                            mStatistics, Statistics::Stage::PROPAGATION);
+                      return mState.storeExpressionValue(expressionOperand, variantValue);
+                  }();
+                  mStatistics.recordEvaluations(1 + mState.getLastPropagationEvaluationCount());
+                  mStatistics.recordCascade(affectedValues.size());
+
+                  for (const auto& [operand, value] : affectedValues) {
 
-                      results.emplace_back(operand + " = " + std::to_string(value));
+                      results.emplace_back(std::string{mSymbolTable.getName(operand)} + " = "
+                                           + std::to_string(value));
                   }
 
+                  // Dependant expressions that failed to be evaluated lost their values
+                  reportPropagationErrors();
+
                   mState.updateOperationOrder(expressionOperand);
+                  journalInstruction(input);
               }
               // Or did we get a list of unmet dependencies instead?
               else if constexpr (std::is_same_v<VariantType, Evaluator::Dependencies>) {
@@ -141,17 +349,35 @@ std::vector<std::string> Runner::processInstruction(const std::string& input)
                   if (!variantValue.empty()) {
 
                       // Then, update the state of the dependencies
-                      if (!mState.storeExpressionDependencies(
-                                expressionOperand, expressionAST, variantValue)) {
+                      const auto areDependenciesStored = [&] {
+                          const Statistics::StageTimer dependenciesTimer(
+                                mStatistics, Statistics::Stage::DEPENDENCIES);
+                          return mState.storeExpressionDependencies(
+                                expressionOperand, expressionProgram, variantValue);
+                      }();
+                      mStatistics.recordEvaluations(1);
 
-                          std::cerr << "Cyclic dependency found: \'" << expressionOperand
-                                    << "\' is already a dependency in another expression\n";
+                      if (!areDependenciesStored) {
+
+                          *mDiagnostics << "Cyclic dependency found: \'"
+                                        << mSymbolTable.getName(expressionOperand)
+                                        << "\' is already a dependency in another expression\n";
+                          forgetNewSymbols(symbolCount);
                       } else {
                           mState.updateOperationOrder(expressionOperand);
+                          journalInstruction(input);
                       }
                   }
+              }
+              // Or did the evaluation fail?
+              else if constexpr (std::is_same_v<VariantType, Evaluator::Error>) {
+
+                  *mDiagnostics << "Unable to evaluate \'"
+                                << mSymbolTable.getName(expressionOperand)
+                                << "\': " << Arithmetic::describe(variantValue) << "\n";
+                  forgetNewSymbols(symbolCount);
               } else {
-                  std::cerr << "Unknown result type returned\n";
+                  *mDiagnostics << "Unknown result type returned\n";
               }
           },
           evaluationResult);
@@ -159,4 +385,293 @@ std::vector<std::string> Runner::processInstruction(const std::string& input)
     return results;
 }
 
+const ExpressionCache::Statistics& Runner::getExpressionCacheStatistics() const
+{
+    return mExpressionCache.getStatistics();
+}
+
+void Runner::setEvaluationMode(const State::EvaluationMode evaluationMode)
+{
+    mState.setEvaluationMode(evaluationMode);
+}
+
+void Runner::setFileCommandsEnabled(const bool areEnabled)
+{
+    mAreFileCommandsEnabled = areEnabled;
+}
+
+void Runner::setDiagnosticsStream(std::ostream& diagnostics)
+{
+    mDiagnostics = &diagnostics;
+}
+
+std::optional<Evaluator::Value> Runner::getOperandValue(const std::string_view operand)
+{
+    const auto symbolId = mSymbolTable.find(operand);
+    if (!symbolId.has_value()) {
+        return {};
+    }
+
+    mState.refreshOperands({&*symbolId, 1});
+
+    const auto& operandValues = mState.getOperandValues();
+    return *symbolId < operandValues.size() ? operandValues[*symbolId] : std::nullopt;
+}
+
+void Runner::refreshOperands(const std::span<const Symbols::SymbolId> operands)
+{
+    mState.refreshOperands(operands);
+    reportPropagationErrors();
+}
+
+void Runner::reportPropagationErrors() const
+{
+    for (const auto& [operand, error] : mState.getLastPropagationErrors()) {
+        *mDiagnostics << "Unable to evaluate \'" << mSymbolTable.getName(operand)
+                      << "\': " << Arithmetic::describe(error) << "\n";
+    }
+}
+
+bool Runner::saveSnapshot(const std::string& fileName) const
+{
+    IO::BinaryWriter writer;
+    writer.writeBytes(cSnapshotMagic);
+    writer.write<uint32_t>(cSnapshotFormatVersion);
+
+    writer.write<uint32_t>(static_cast<uint32_t>(mSymbolTable.size()));
+    for (Symbols::SymbolId symbolId = 0; symbolId < mSymbolTable.size(); ++symbolId) {
+        const auto name = mSymbolTable.getName(symbolId);
+        writer.write<uint32_t>(static_cast<uint32_t>(name.size()));
+        writer.writeBytes(name);
+    }
+
+    mState.save(writer);
+
+    const auto& snapshot = writer.getBuffer();
+    std::ofstream snapshotFile(fileName, std::ios::binary | std::ios::trunc);
+    if (!snapshotFile.write(snapshot.data(), static_cast<std::streamsize>(snapshot.size()))) {
+        *mDiagnostics << "Unable to write " << fileName << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+bool Runner::loadSnapshot(const std::string& fileName)
+{
+    IO::MappedFile snapshotFile;
+    if (!snapshotFile.open(fileName)) {
+        return false;
+    }
+
+    IO::BinaryReader reader(snapshotFile.getContents());
+    if (reader.readBytes(cSnapshotMagic.size()) != cSnapshotMagic
+        || reader.read<uint32_t>() != cSnapshotFormatVersion) {
+        *mDiagnostics << fileName << " is not a snapshot (of a supported version)\n";
+        return false;
+    }
+
+    // Names are interned in order, so that they get back their identifiers
+    Symbols::SymbolTable symbolTable;
+    for (auto symbolCount = reader.readCount(sizeof(uint32_t)); symbolCount > 0; --symbolCount) {
+        const auto name = reader.readBytes(reader.read<uint32_t>());
+        const auto expectedSymbolId = symbolTable.size();
+
+        if (!reader.isValid() || !Parser::isValidLHS(name)
+            || symbolTable.intern(name) != expectedSymbolId) {
+            *mDiagnostics << fileName << " holds invalid operand names\n";
+            return false;
+        }
+    }
+
+    if (!reader.isValid() || !mState.load(reader, symbolTable.size())) {
+        *mDiagnostics << fileName << " holds an invalid state\n";
+        return false;
+    }
+
+    mSymbolTable = std::move(symbolTable);
+
+    // Cached programs reference the identifiers of the previous session
+    mExpressionCache.clear();
+
+    // Dirty expressions of lazy snapshots may have been evaluated
+    reportPropagationErrors();
+
+    return true;
+}
+
+bool Runner::enableTracing(const std::string& fileName)
+{
+    // Every propagation thread records on its own track (the calling thread is the first one)
+    const auto threadCount = mState.getPropagationThreadCount();
+    std::vector<std::string> threadNames{"calculator"};
+    for (std::size_t thread = 1; thread < threadCount; ++thread) {
+        threadNames.push_back("propagation " + std::to_string(thread));
+    }
+
+    auto traceWriter = std::make_unique<Metrics::TraceWriter>(threadCount);
+    if (!traceWriter->open(fileName, threadNames)) {
+        return false;
+    }
+
+    mState.setTraceWriter(traceWriter.get(), &mSymbolTable);
+    mTraceWriter = std::move(traceWriter);
+    return true;
+}
+
+bool Runner::openJournal(const std::string& fileName,
+                         const IO::Journal::Configuration& configuration)
+{
+    if (mJournal) {
+        *mDiagnostics << "Journal already opened\n";
+        return false;
+    }
+
+    // Only the valid records are kept (a crash may have torn the last ones)
+    std::size_t validSize{0};
+    if (std::filesystem::exists(fileName)) {
+        IO::MappedFile journalFile;
+        if (!journalFile.open(fileName)) {
+            return false;
+        }
+
+        const auto records = IO::Journal::readRecords(journalFile.getContents(), validSize);
+        if (!records) {
+            *mDiagnostics << fileName << " is not a journal (of a supported version)\n";
+            return false;
+        }
+
+        replayJournal(*records);
+    }
+
+    auto journal = std::make_unique<IO::Journal>(configuration);
+    if (!journal->open(fileName, validSize)) {
+        return false;
+    }
+
+    mJournal = std::move(journal);
+    return true;
+}
+
+void Runner::replayJournal(const std::span<const std::string_view> records)
+{
+    const auto isCheckpoint = [](const std::string_view record) {
+        const auto operation = getOperationRequest(record).first;
+        return operation == SupportedOperation::SAVE || operation == SupportedOperation::LOAD;
+    };
+
+    // The last snapshot holds the whole session up to its checkpoint
+    auto replayStart = records.begin();
+    if (const auto checkpoint = std::ranges::find_if(records.rbegin(), records.rend(),
+                                                     isCheckpoint);
+        checkpoint != records.rend()
+        && loadSnapshot(std::string{getOperationRequest(*checkpoint).second})) {
+        replayStart = checkpoint.base();
+    }
+
+    // Snapshots are not saved again (they would overwrite newer ones)
+    for (const auto record : std::span{replayStart, records.end()}) {
+        if (getOperationRequest(record).first != SupportedOperation::SAVE) {
+            static_cast<void>(processInstruction(record));
+        }
+    }
+}
+
+void Runner::journalInstruction(const std::string_view input)
+{
+    if (mJournal) {
+        mJournal->append(input);
+    }
+}
+
+void Runner::forgetNewSymbols(const std::size_t symbolCount)
+{
+    if (mSymbolTable.size() == symbolCount) {
+        return;
+    }
+
+    mSymbolTable.truncate(symbolCount);
+    mExpressionCache.eraseProgramsReading(static_cast<Symbols::SymbolId>(symbolCount));
+}
+
+std::shared_ptr<const Bytecode::Program>
+      Runner::getCompiledExpression(const std::string_view input,
+                                    Symbols::SymbolId& expressionOperand)
+{
+    using Utils::Constants::cAssignOp;
+
+    // White spaces are not meaningful, so they are not part of the cache keys,
+    // unless they separate two operands (e.g. "b c"), which must still be rejected
+    // (the normalization buffer is reused, so it only allocates when it needs to grow)
+    auto& normalizedInput = mNormalizedInputBuffer;
+    normalizedInput.clear();
+    bool isAfterWhiteSpace{false};
+    for (const auto character : input) {
+        if (Utils::Grammar::isWhiteSpace(character)) {
+            isAfterWhiteSpace = true;
+            continue;
+        }
+
+        if (isAfterWhiteSpace && !normalizedInput.empty()
+            && Utils::Grammar::isOperandCharacter(normalizedInput.back())
+            && Utils::Grammar::isOperandCharacter(character)) {
+            normalizedInput += Utils::Constants::cWhiteSpace;
+        }
+        normalizedInput += character;
+        isAfterWhiteSpace = false;
+    }
+
+    // A valid arithmetic expression holds a single assignment operator
+    const auto assignOpPosition = normalizedInput.find(cAssignOp);
+    if (assignOpPosition == std::string::npos
+        || normalizedInput.find(cAssignOp, assignOpPosition + 1) != std::string::npos) {
+        return nullptr;
+    }
+
+    const auto normalizedLHS = std::string_view{normalizedInput}.substr(0, assignOpPosition);
+    const auto normalizedRHS = std::string_view{normalizedInput}.substr(assignOpPosition + 1);
+
+    if (!Parser::isValidLHS(normalizedLHS)) {
+        return nullptr;
+    }
+
+    // Recently compiled expressions skip both parsing and compilation
+    if (auto cachedProgram = mExpressionCache.find(normalizedRHS)) {
+        expressionOperand = mSymbolTable.intern(normalizedLHS);
+        return cachedProgram;
+    }
+
+    Parser expressionParser(normalizedInput, mSymbolTable);
+    {
+        const Statistics::StageTimer parsingTimer(mStatistics, Statistics::Stage::PARSING);
+        if (!expressionParser.execute()) {
+            if (const auto error = expressionParser.getError(); !error.empty()) {
+                *mDiagnostics << error << "\n";
+            }
+            return nullptr;
+        }
+    }
+    const Statistics::StageTimer compilationTimer(mStatistics, Statistics::Stage::COMPILATION);
+
+    // Simplify the RHS of the parsed arithmetic expression (an AST) and lower it into bytecode,
+    // so that it can be cheaply re-evaluated when its dependencies change
+    // (operands optimized away still are dependencies of the expression)
+    Optimizer expressionOptimizer(*expressionParser.getASTOfRHS());
+    if (!expressionOptimizer.execute()) {
+        return nullptr;
+    }
+
+    Compiler expressionCompiler(*expressionOptimizer.getOptimizedAST(),
+                                expressionOptimizer.getVariables());
+    if (!expressionCompiler.execute()) {
+        return nullptr;
+    }
+
+    expressionOperand = mSymbolTable.intern(expressionParser.getOperandOfLHS());
+    auto expressionProgram = expressionCompiler.getProgram();
+    mExpressionCache.insert(std::string{normalizedRHS}, expressionProgram);
+
+    return expressionProgram;
+}
+
 } // namespace Calculator
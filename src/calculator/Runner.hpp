@@ -1,9 +1,22 @@
 #pragma once
 
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "ExpressionCache.hpp"
 #include "State.hpp"
+#include "Statistics.hpp"
+#include "bytecode/Program.hpp"
+#include "evaluator/Evaluator.hpp"
+#include "evaluator/VirtualMachine.hpp"
+#include "io/Journal.hpp"
+#include "metrics/TraceWriter.hpp"
+#include "symbols/SymbolTable.hpp"
 
 namespace Calculator {
 
@@ -13,30 +26,224 @@ namespace Calculator {
  * This class handles various calculator operations including:
  * - evaluating arithmetic expressions;
  * - undoing previous operations;
- * - fetching the result of the last completed operation;
+ * - fetching the result of the last completed operation, or the value of an operand;
+ * - saving and loading snapshots of the whole session;
+ * - journaling the accepted instructions, so that a session can be recovered after a crash;
+ * - reporting latency and propagation statistics (when compiled in);
  */
 class Runner
 {
 public:
+    /// Default maximum amount of compiled expressions kept in the expression cache
+    static constexpr std::size_t cDefaultExpressionCacheCapacity{1024};
+
     /**
-     * @brief Class' default constructor
+     * @brief Class constructor
+     *
+     * @param[in] expressionCacheCapacity Maximum amount of compiled expressions to keep cached
+     * @param[in] propagationThreadCount Amount of threads re-evaluating the expressions
+     * affected by a value update
      */
-    Runner() = default;
+    explicit Runner(std::size_t expressionCacheCapacity = cDefaultExpressionCacheCapacity,
+                    std::size_t propagationThreadCount = 1);
 
     /**
      * @brief Processes a given instruction and returns the corresponding results
      *
-     * Supported instructions are an arithmetic expression or commands like "undo 2" or "result"
+     * Supported instructions are an arithmetic expression or commands like "undo 2", "result",
+     * "get x", "save file", "load file" or "stats"
      *
-     * @param[in] input Instruction to process
+     * @param[in] input Instruction to process (only viewed while it is being processed)
      *
      * @return A vector of strings containing the results of the instruction after being processed
      */
-    std::vector<std::string> processInstruction(const std::string& input);
+    std::vector<std::string> processInstruction(std::string_view input);
+
+    /**
+     * @brief Getter for the usage counters of the expression cache
+     *
+     * @return Reference to the expression cache statistics
+     */
+    [[nodiscard]] const ExpressionCache::Statistics& getExpressionCacheStatistics() const;
+
+    /**
+     * @brief Switches between eager and lazy evaluation of the expressions depending on
+     * updated values (see State::EvaluationMode)
+     *
+     * In lazy mode, assignments only output the value of their own operand,
+     * and the values of the others are computed when read (by "result", "get x",
+     * other expressions or getOperandValue)
+     *
+     * @param[in] evaluationMode New evaluation mode
+     */
+    void setEvaluationMode(State::EvaluationMode evaluationMode);
+
+    /**
+     * @brief Allows or forbids the instructions accessing files ("save file" and "load file"),
+     * e.g. for sessions whose instructions come from remote clients
+     *
+     * @param[in] areEnabled Whether the file commands are accepted (they are by default)
+     */
+    void setFileCommandsEnabled(bool areEnabled);
+
+    /**
+     * @brief Redirects the diagnostics of the calculator (rejected instructions and errors),
+     * e.g. to keep those of several sessions apart (std::cerr by default)
+     *
+     * @param[in,out] diagnostics Stream to write the diagnostics to, which must outlive the
+     * calculator (a stream without buffer discards them)
+     */
+    void setDiagnosticsStream(std::ostream& diagnostics);
+
+    /**
+     * @brief Retrieves the current value of an operand (refreshing it, in lazy mode)
+     *
+     * @param[in] operand Name of the operand
+     *
+     * @return Value of the operand (empty if the operand is unknown or has no value)
+     */
+    [[nodiscard]] std::optional<Evaluator::Value> getOperandValue(std::string_view operand);
+
+    /**
+     * @brief Saves a snapshot of the whole session (operand names and state) into a binary file
+     *
+     * The snapshot starts with a magic string and a format version, followed by the operand
+     * names (in order of their identifiers) and the encoded state (see State::save).
+     * It is written with a single sequential write.
+     *
+     * @param[in] fileName Name of the snapshot file (it is truncated)
+     *
+     * @return True if the snapshot was saved (false otherwise)
+     */
+    [[nodiscard]] bool saveSnapshot(const std::string& fileName) const;
+
+    /**
+     * @brief Replaces the whole session with a snapshot saved by saveSnapshot
+     *
+     * The snapshot is memory mapped and decoded sequentially: expressions are restored
+     * in their compiled form, so nothing is parsed or evaluated again (except for the dirty
+     * expressions of lazy snapshots, when evaluating eagerly).
+     * The session is left untouched if the snapshot is rejected.
+     *
+     * @param[in] fileName Name of the snapshot file
+     *
+     * @return True if the snapshot was loaded (false otherwise)
+     */
+    [[nodiscard]] bool loadSnapshot(const std::string& fileName);
+
+    /**
+     * @brief Traces the following instructions into a Chrome trace-event JSON file
+     *
+     * Every instruction is a span of the calling thread, enclosing the propagation of its value
+     * update, whose re-evaluations are spans of the propagation threads evaluating them
+     * (named after their operands, with the operand that triggered them and their wave).
+     * Events are written by a background thread, and the file is completed on destruction.
+     *
+     * @param[in] fileName Name of the trace file (it is truncated)
+     *
+     * @return True if the trace file was opened (false otherwise)
+     */
+    [[nodiscard]] bool enableTracing(const std::string& fileName);
+
+    /**
+     * @brief Recovers the session recorded by a journal and journals the following instructions
+     *
+     * Every instruction that changes the session (stored expressions, undone operations,
+     * saved and loaded snapshots) is appended to the journal once accepted, and is durable
+     * once synced by the group commit of the journal (see IO::Journal).
+     * Existing journals are replayed on top of the current session: when the journal holds
+     * a saved or loaded snapshot (a checkpoint), the last one is loaded and only the
+     * instructions following it are replayed (every instruction is, if it cannot be loaded).
+     * The snapshots named by a journal must thus be kept as long as the journal.
+     *
+     * @param[in] fileName Name of the journal file (created if needed)
+     * @param[in] configuration Group commit policy of the journal
+     *
+     * @return True if the journal was recovered and opened (false otherwise)
+     */
+    [[nodiscard]] bool openJournal(const std::string& fileName,
+                                   const IO::Journal::Configuration& configuration = {});
 
 private:
+    /**
+     * @brief Replays the instructions recorded by a journal (see openJournal)
+     *
+     * @param[in] records Instructions recorded by the journal, in order
+     */
+    void replayJournal(std::span<const std::string_view> records);
+
+    /**
+     * @brief Appends an accepted instruction to the journal (if any)
+     *
+     * @param[in] input Instruction to journal
+     */
+    void journalInstruction(std::string_view input);
+
+    /**
+     * @brief Brings the values of the given operands up to date (in lazy mode),
+     * reporting the errors found
+     *
+     * @param[in] operands Operands to refresh
+     */
+    void refreshOperands(std::span<const Symbols::SymbolId> operands);
+
+    /**
+     * @brief Reports the errors found by the last value update or refresh
+     */
+    void reportPropagationErrors() const;
+
+    /**
+     * @brief Forgets the operand names interned while processing a rejected instruction,
+     * so that they do not outlive it (nor do the cached programs reading them)
+     *
+     * @param[in] symbolCount Amount of interned names before the instruction was processed
+     */
+    void forgetNewSymbols(std::size_t symbolCount);
+
+    /**
+     * @brief Retrieves the compiled RHS of an arithmetic expression
+     *
+     * Expressions whose (normalized) RHS was recently compiled are served from the
+     * expression cache, skipping both parsing and compilation
+     *
+     * @param[in] input Arithmetic expression
+     * @param[out] expressionOperand Symbol id of the LHS operand of the arithmetic expression
+     *
+     * @return Shared pointer to the compiled RHS (nullptr if the expression is invalid)
+     */
+    [[nodiscard]] std::shared_ptr<const Bytecode::Program>
+          getCompiledExpression(std::string_view input, Symbols::SymbolId& expressionOperand);
+
+private:
+    /// Interned operand names (every other component refers to operands by their symbol id)
+    Symbols::SymbolTable mSymbolTable;
+
     /// State of the calculator (operand values and existing dependencies)
     State mState;
+
+    /// Virtual machine used to evaluate newly provided arithmetic expressions
+    VirtualMachine mVirtualMachine;
+
+    /// Cache of the most recently compiled RHS expressions
+    ExpressionCache mExpressionCache;
+
+    /// Writer of the trace file (nullptr when not tracing)
+    std::unique_ptr<Metrics::TraceWriter> mTraceWriter;
+
+    /// Journal of the accepted instructions (nullptr when not journaling)
+    std::unique_ptr<IO::Journal> mJournal;
+
+    /// Latency histograms and counters of the processed instructions
+    Statistics mStatistics;
+
+    /// Whether the instructions accessing files are accepted
+    bool mAreFileCommandsEnabled{true};
+
+    /// Stream the diagnostics are written to
+    std::ostream* mDiagnostics{&std::cerr};
+
+    /// Reusable buffer holding the instruction being processed without white spaces
+    std::string mNormalizedInputBuffer;
 };
 
 } // namespace Calculator
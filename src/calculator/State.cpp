@@ -1,145 +1,1078 @@
 #include "State.hpp"
 
-#include <functional>
+#include <algorithm>
+#include <unordered_map>
 
-#include "utils/Methods.hpp"
+namespace {
+/// Amount of expressions evaluated by each task of a concurrently evaluated wave
+constexpr std::size_t cWaveChunkSize{128};
+
+/// Minimum size of an encoded program (its four counts)
+constexpr std::size_t cMinEncodedProgramSize{4 * sizeof(uint32_t)};
+/// Minimum size of an encoded operand (entry, topological position and both edge counts)
+constexpr std::size_t cMinEncodedOperandSize{2 * sizeof(uint8_t) + 4 * sizeof(uint32_t)};
+/// Minimum size of an encoded version update (operand, entry and both edge counts)
+constexpr std::size_t cMinEncodedVersionUpdateSize{2 * sizeof(uint8_t) + 4 * sizeof(uint32_t)};
+
+/**
+ * @brief Encodes a compiled program
+ *
+ * @param[out] writer Writer to encode the program with
+ * @param[in] program Program to encode
+ */
+void writeProgram(IO::BinaryWriter& writer, const Bytecode::Program& program)
+{
+    writer.write<uint32_t>(static_cast<uint32_t>(program.instructions.size()));
+    for (const auto& instruction : program.instructions) {
+        writer.write<uint8_t>(static_cast<uint8_t>(instruction.opCode));
+        writer.write<uint32_t>(instruction.operand);
+    }
+
+    writer.write<uint32_t>(static_cast<uint32_t>(program.variables.size()));
+    for (const auto variable : program.variables) {
+        writer.write<uint32_t>(variable);
+    }
+
+    writer.write<uint32_t>(static_cast<uint32_t>(program.constants.size()));
+    for (const auto constant : program.constants) {
+        writer.write<int64_t>(constant);
+    }
+
+    writer.write<uint32_t>(program.maxStackDepth);
+}
+
+/**
+ * @brief Decodes a compiled program encoded by writeProgram
+ *
+ * @param[in,out] reader Reader to decode the program from
+ *
+ * @return Decoded program (only meaningful if the reader is still valid)
+ */
+Bytecode::Program readProgram(IO::BinaryReader& reader)
+{
+    Bytecode::Program program;
+
+    program.instructions.resize(reader.readCount(sizeof(uint8_t) + sizeof(uint32_t)));
+    for (auto& instruction : program.instructions) {
+        instruction.opCode = static_cast<Bytecode::OpCode>(reader.read<uint8_t>());
+        instruction.operand = reader.read<uint32_t>();
+    }
+
+    program.variables.resize(reader.readCount(sizeof(uint32_t)));
+    for (auto& variable : program.variables) {
+        variable = reader.read<uint32_t>();
+    }
+
+    program.constants.resize(reader.readCount(sizeof(int64_t)));
+    for (auto& constant : program.constants) {
+        constant = reader.read<int64_t>();
+    }
+
+    program.maxStackDepth = reader.read<uint32_t>();
+
+    return program;
+}
+
+/**
+ * @brief Checks that a decoded program can be executed safely: its operations are known,
+ * its operands reference existing variables, constants and operands, and it leaves a single
+ * value on a stack that never grows beyond its maximum depth
+ *
+ * @param[in] program Program to check
+ * @param[in] symbolCount Amount of interned operands
+ *
+ * @return True if the program is valid (false otherwise)
+ */
+bool isValidProgram(const Bytecode::Program& program, const std::size_t symbolCount)
+{
+    using Bytecode::OpCode;
+
+    if (!std::ranges::all_of(program.variables, [symbolCount](const auto variable) {
+            return variable < symbolCount;
+        })) {
+        return false;
+    }
+
+    std::size_t stackDepth{0};
+    for (const auto& instruction : program.instructions) {
+        switch (instruction.opCode) {
+        case OpCode::PUSH_LITERAL:
+            break;
+        case OpCode::PUSH_VARIABLE:
+            if (instruction.operand >= program.variables.size()) {
+                return false;
+            }
+            break;
+        case OpCode::PUSH_CONSTANT:
+            if (instruction.operand >= program.constants.size()) {
+                return false;
+            }
+            break;
+        case OpCode::ADD:
+        case OpCode::SUB:
+        case OpCode::MULT:
+        case OpCode::DIV:
+            if (stackDepth < 2) {
+                return false;
+            }
+            stackDepth -= 2;
+            break;
+        default:
+            return false;
+        }
+
+        if (++stackDepth > program.maxStackDepth) {
+            return false;
+        }
+    }
+
+    return stackDepth == 1;
+}
+} // namespace
 
 namespace Calculator {
 
-void State::updateOperationOrder(const std::string& operand)
+State::State(const std::size_t propagationThreadCount,
+             const uint32_t compilationThreshold,
+             const std::size_t minParallelWaveSize)
+    : mMinParallelWaveSize{minParallelWaveSize}
 {
-    mOperandOrderStack.push(operand);
+    const auto threadCount = std::max<std::size_t>(propagationThreadCount, 1);
+    mVirtualMachines.reserve(threadCount);
+    for (std::size_t thread = 0; thread < threadCount; ++thread) {
+        mVirtualMachines.emplace_back(compilationThreshold);
+    }
+
+    if (mVirtualMachines.size() > 1) {
+        mThreadPool = std::make_unique<Concurrency::ThreadPool>(mVirtualMachines.size());
+    }
 }
 
-std::vector<std::pair<std::string, int>>
-      State::storeExpressionValue(const std::string& operand, const int value)
+void State::updateOperationOrder(const Symbols::SymbolId operand)
 {
-    std::vector<std::pair<std::string, int>> affectedValues;
+    reserveOperand(operand);
+
+    // The new version shares every entry of the previous one that was not modified since
+    std::sort(mModifiedOperands.begin(), mModifiedOperands.end());
+
+    mVersionUpdates.clear();
+    for (const auto modifiedOperand : mModifiedOperands) {
+        mVersionUpdates.emplace_back(
+              modifiedOperand,
+              VersionEntry{mOperandValues[modifiedOperand],
+                           mExpressionsWithDependencies[modifiedOperand],
+                           static_cast<uint32_t>(mOperandDependants[modifiedOperand].size()),
+                           static_cast<uint32_t>(mOperandDependencies[modifiedOperand].size()),
+                           mDirtyStates[modifiedOperand]});
+        mIsOperandModified[modifiedOperand] = false;
+    }
+    mModifiedOperands.clear();
+
+    const auto version = mOperationHistory.empty() ? Version{} : mOperationHistory.back().version;
+    mOperationHistory.push_back({operand, version.with(mVersionUpdates)});
+}
+
+std::vector<State::OperandValue> State::storeExpressionValue(const Symbols::SymbolId operand,
+                                                             const Evaluator::Value value)
+{
+    reserveOperand(operand);
+
+    mPropagationErrors.clear();
+    mPropagationEvaluationCount = 0;
 
-    // Function used to handle the recursive logic of storing values and resolving dependencies
-    std::function<void(const std::string&, int)> storeValueAndCheckDependencies =
+    if (mEvaluationMode == EvaluationMode::LAZY) {
+        // Older updates of the operand are applied first, so that they do not overwrite it
+        refreshOperand(operand);
 
-          [&](const std::string& newOperand, int newValue) {
-              // Update the values map with the new value of the operand
-              mOperandValuesMap.insert_or_assign(newOperand, newValue);
-              affectedValues.emplace_back(newOperand, newValue);
+        mOperandValues[operand] = value;
+        markModified(operand);
+        markDependantsDirty(operand);
 
-              // Check if there are any expressions that depend on the provided operand
-              // (whose value is now known) and if so, try to resolve them
-              const auto operandDependencyRange = mOperandDependenciesMap.equal_range(newOperand);
+        return {{operand, value}};
+    }
+
+    const auto propagationStartTime = mTraceWriter ? mTraceWriter->now() : 0;
+    std::vector<OperandValue> affectedValues;
+
+    // Update the operand values with the new value of the operand
+    mOperandValues[operand] = value;
+    markModified(operand);
+    affectedValues.emplace_back(operand, value);
 
-              for (auto itr = operandDependencyRange.first; itr != operandDependencyRange.second;
-                   ++itr) {
+    // Helper lambda used to check if a dependant operand is affected by the value update:
+    // every dependant with a pending expression is, except for the updated operand itself
+    const auto isAffected = [&](const Symbols::SymbolId dependantOperand) {
+        return dependantOperand != operand && mExpressionsWithDependencies[dependantOperand];
+    };
 
-                  const auto dependantOperand = itr->second;
+    // Collect every pending expression that (transitively) depends on the provided operand,
+    // counting how many of its inputs are affected as well
+    // (an expression is only evaluated once all of those inputs were processed)
+    mAffectedOperands.clear();
+    {
+        const auto visitDependants = [&](const Symbols::SymbolId visitedOperand) {
+            for (const auto dependantOperand : mOperandDependants[visitedOperand]) {
+                if (isAffected(dependantOperand)
+                    && mAffectedExpressions[dependantOperand].pendingInputsCount++ == 0) {
+                    mAffectedOperands.push_back(dependantOperand);
+                }
+            }
+        };
 
-                  // If the dependent operand has an associated expression, evaluate it
-                  if (mExpressionsWithDependenciesMap.contains(dependantOperand)) {
+        visitDependants(operand);
+        for (std::size_t index = 0; index < mAffectedOperands.size(); ++index) {
+            visitDependants(mAffectedOperands[index]);
+        }
+    }
+
+    // Helper lambda used to mark a processed operand as an available input of its dependants,
+    // queuing the ones left without pending inputs
+    const auto releaseDependants = [&](const Symbols::SymbolId processedOperand,
+                                       const bool wasUpdated) {
+        for (const auto dependantOperand : mOperandDependants[processedOperand]) {
+            if (!isAffected(dependantOperand)) {
+                continue;
+            }
+
+            auto& affectedExpression = mAffectedExpressions[dependantOperand];
+            affectedExpression.hasUpdatedInputs |= wasUpdated;
+
+            if (--affectedExpression.pendingInputsCount == 0) {
+                mReadyOperands.push_back(dependantOperand);
+            }
+        }
+    };
 
-                      Evaluator evaluator(
-                            mExpressionsWithDependenciesMap.at(dependantOperand)->top(),
-                            mOperandValuesMap);
-                      const auto evaluatorResult = evaluator.execute();
+    // Evaluate the affected expressions in topological order (Kahn's algorithm),
+    // so that each of them is evaluated exactly once.
+    // The ready queue is FIFO, so expressions are processed one wave at a time:
+    // a wave holds the expressions whose affected inputs were all processed by previous waves
+    mReadyOperands.clear();
+    releaseDependants(operand, true);
 
-                      // If the evaluation results in an integer value,
-                      // store it and check its dependencies
-                      if (const int* dependantOperandResult = std::get_if<int>(&evaluatorResult)) {
-                          storeValueAndCheckDependencies(dependantOperand, *dependantOperandResult);
-                      }
-                  }
-              }
-          };
+    for (std::size_t waveBegin = 0, wave = 0; waveBegin < mReadyOperands.size(); ++wave) {
+        const auto waveEnd = mReadyOperands.size();
+        evaluateWave(waveBegin, waveEnd, wave, operand);
 
-    // Bootstrap the the recursive dependencies checking
-    storeValueAndCheckDependencies(operand, value);
+        // Store the results in queue order, queuing the expressions of the next wave
+        for (std::size_t index = waveBegin; index < waveEnd; ++index) {
+            const auto dependantOperand = mReadyOperands[index];
+            const auto& waveResult = mWaveResults[index - waveBegin];
+            bool wasUpdated{false};
+            mPropagationEvaluationCount += waveResult.has_value() ? 1U : 0U;
+
+            // Expressions that were not evaluated (their inputs kept their values) are unchanged
+            if (waveResult) {
+                wasUpdated = storeEvaluationResult(dependantOperand, *waveResult);
+
+                if (const auto* newValue = std::get_if<Evaluator::Value>(&*waveResult)) {
+                    affectedValues.emplace_back(dependantOperand, *newValue);
+                }
+            }
+
+            releaseDependants(dependantOperand, wasUpdated);
+        }
+
+        waveBegin = waveEnd;
+    }
+
+    // Reset the bookkeeping of every affected expression
+    // (including those never processed due to cyclic dependencies)
+    for (const auto affectedOperand : mAffectedOperands) {
+        mAffectedExpressions[affectedOperand] = {};
+    }
+
+    // The propagation encloses the re-evaluations traced on the calling thread
+    if (mTraceWriter) {
+        mTraceWriter->record(
+              0,
+              {.name = std::string{mTracedSymbolTable->getName(operand)},
+               .category = "propagation",
+               .startTime = propagationStartTime,
+               .duration = mTraceWriter->now() - propagationStartTime,
+               .arguments = {{{"evaluations", std::to_string(mPropagationEvaluationCount)},
+                              {"updated values", std::to_string(affectedValues.size())}}}});
+    }
 
     return affectedValues;
 }
 
-bool State::storeExpressionDependencies(const std::string& operand,
-                                        std::shared_ptr<Parser::ASTofRSH> expressionAST,
+bool State::storeExpressionDependencies(const Symbols::SymbolId operand,
+                                        std::shared_ptr<const Bytecode::Program> expressionProgram,
                                         const Evaluator::Dependencies& dependencies)
 {
+    // An expression depending on its own operand is always cyclic
+    if (std::ranges::find(dependencies, operand) != dependencies.cend()) {
+        return false;
+    }
 
-    // Check for cyclic dependencies (e.g.: a = c, b = a, c = b).
-    const auto operandDependencyRange = mOperandDependenciesMap.equal_range(operand);
+    // Older updates of the operand and of its dependencies are applied first
+    // (clean operands only depend on clean ones, so their new dependencies must be clean)
+    if (mEvaluationMode == EvaluationMode::LAZY) {
+        mPropagationErrors.clear();
+        refreshOperand(operand);
+        for (const auto dependency : dependencies) {
+            refreshOperand(dependency);
+        }
+    }
 
-    for (auto itr = operandDependencyRange.first; itr != operandDependencyRange.second; ++itr) {
+    // Operands without slots have no dependency edges yet, so they cannot close a cycle:
+    // the edges from the other ones are added first, so that a cyclic expression
+    // does not leave slots behind for the operands it introduced
+    // (e.g. the names of a rejected instruction, which are then forgotten)
+    reserveOperand(operand);
+    const auto knownOperandCount = mOperandValues.size();
+    const auto addDependencyEdges = [&](const bool areDependenciesKnown) {
+        for (const auto dependency : dependencies) {
+            if ((dependency < knownOperandCount) != areDependenciesKnown) {
+                continue;
+            }
+            reserveOperand(dependency);
 
-        const auto dependantOperand = itr->second;
+            // Redefining an expression must not register the same dependant twice
+            const auto& dependants = mOperandDependants[dependency];
+            if (std::ranges::find(dependants, operand) == dependants.cend()
+                && !insertDependencyEdge(dependency, operand)) {
+                return false;
+            }
+        }
+        return true;
+    };
 
-        if (dependencies.contains(dependantOperand)) {
-            // Cyclic dependency found.
-            return false;
+    // Add the new dependencies to the dependency graph
+    const auto previousDependencyCount = mOperandDependencies[operand].size();
+    if (!addDependencyEdges(true) || !addDependencyEdges(false)) {
+        // Cyclic dependency found (e.g.: a = c, b = a, c = b),
+        // so remove the edges added so far (which are the last ones of their lists)
+        auto& operandDependencies = mOperandDependencies[operand];
+        while (operandDependencies.size() > previousDependencyCount) {
+            mOperandDependants[operandDependencies.back()].pop_back();
+            operandDependencies.pop_back();
         }
+
+        return false;
     }
 
-    // Store the expression's AST of the provided operand
+    // Store the compiled expression of the provided operand
     // since it might be resolved later if the dependencies are met.
-    mExpressionsWithDependenciesMap.insert_or_assign(operand, std::move(expressionAST));
+    mExpressionsWithDependencies[operand] = std::move(expressionProgram);
+    Jit::TieredVirtualMachine::resetProfile(mExpressionProfiles[operand]);
+    markModified(operand);
 
-    // Add the new dependencies to the operand dependencies map
-    for (const auto& dependency : dependencies) {
-        mOperandDependenciesMap.emplace(dependency, operand);
+    const auto& operandDependencies = mOperandDependencies[operand];
+    for (auto index = previousDependencyCount; index < operandDependencies.size(); ++index) {
+        markModified(operandDependencies[index]);
     }
 
     return true;
 }
 
-const std::unordered_map<std::string, int>& State::getOperandValueMap() const
+void State::refreshOperands(const std::span<const Symbols::SymbolId> operands)
 {
-    return mOperandValuesMap;
+    mPropagationErrors.clear();
+    mPropagationEvaluationCount = 0;
+
+    if (mEvaluationMode == EvaluationMode::LAZY) {
+        for (const auto operand : operands) {
+            refreshOperand(operand);
+        }
+    }
 }
 
-std::pair<std::string, int> State::getLastFulfilledOperation() const
+void State::setEvaluationMode(const EvaluationMode evaluationMode)
 {
-    // Go through the stack of operations history and check
-    // which operand already has a value available
-    auto operandOrderStack = mOperandOrderStack;
-    while (!operandOrderStack.empty()) {
+    if (evaluationMode == EvaluationMode::EAGER) {
+        mPropagationErrors.clear();
+        for (Symbols::SymbolId operand = 0; operand < mDirtyStates.size(); ++operand) {
+            refreshOperand(operand);
+        }
+    }
+
+    mEvaluationMode = evaluationMode;
+}
+
+State::EvaluationMode State::getEvaluationMode() const
+{
+    return mEvaluationMode;
+}
 
-        if (mOperandValuesMap.contains(operandOrderStack.top())) {
+const std::vector<std::optional<Evaluator::Value>>& State::getOperandValues() const
+{
+    return mOperandValues;
+}
 
-            return {operandOrderStack.top(), mOperandValuesMap.at(operandOrderStack.top())};
+const std::vector<State::OperandError>& State::getLastPropagationErrors() const
+{
+    return mPropagationErrors;
+}
+
+std::size_t State::getLastPropagationEvaluationCount() const
+{
+    return mPropagationEvaluationCount;
+}
+
+std::size_t State::getPendingExpressionCount() const
+{
+    std::size_t pendingExpressionCount{0};
+    for (std::size_t operand = 0; operand < mExpressionsWithDependencies.size(); ++operand) {
+        if (mExpressionsWithDependencies[operand]
+            && (!mOperandValues[operand] || mDirtyStates[operand] != DirtyState::CLEAN)) {
+            ++pendingExpressionCount;
         }
+    }
+
+    return pendingExpressionCount;
+}
 
-        operandOrderStack.pop();
+std::size_t State::getPropagationThreadCount() const
+{
+    return mVirtualMachines.size();
+}
+
+void State::setTraceWriter(Metrics::TraceWriter* const traceWriter,
+                           const Symbols::SymbolTable* const symbolTable)
+{
+    mTraceWriter = traceWriter;
+    mTracedSymbolTable = symbolTable;
+}
+
+std::optional<State::OperandValue> State::getLastFulfilledOperation()
+{
+    mPropagationErrors.clear();
+
+    // Go through the stack of operations history and check
+    // which operand already has a value available
+    for (auto itr = mOperationHistory.crbegin(); itr != mOperationHistory.crend(); ++itr) {
+        refreshOperand(itr->operand);
+
+        if (const auto& value = mOperandValues[itr->operand]) {
+            return OperandValue{itr->operand, *value};
+        }
     }
 
     return {};
 }
 
-std::vector<std::string> State::undoLastRegisteredOperations(const int undoCount)
+std::vector<Symbols::SymbolId> State::undoLastRegisteredOperations(const int undoCount)
 {
-    std::vector<std::string> deletedOperations;
+    std::vector<Symbols::SymbolId> deletedOperations;
 
     // Check for either an invalid count value or if there are enough operations to undo
-    if (undoCount <= 0 || static_cast<int>(mOperandOrderStack.size()) < undoCount) {
+    if (undoCount <= 0 || static_cast<int>(mOperationHistory.size()) < undoCount) {
         return deletedOperations;
     }
 
-    for (int deleteCounter = 0; deleteCounter < undoCount; ++deleteCounter) {
+    // Version to go back to: the one left by the last remaining operation (if any)
+    const auto remainingCount = mOperationHistory.size() - static_cast<std::size_t>(undoCount);
+    const auto restoredVersion
+          = remainingCount == 0 ? Version{} : mOperationHistory[remainingCount - 1].version;
+    const auto& currentVersion = mOperationHistory.back().version;
 
-        // Get the operand from the top of the stack
-        const auto operand = mOperandOrderStack.top();
+    // Operands restored as dirty (by versions recorded in lazy mode) are refreshed in eager mode
+    std::vector<Symbols::SymbolId> dirtyOperands;
 
-        // Try to remove the operand from the operand values map
-        if (mOperandValuesMap.contains(operand)) {
-            mOperandValuesMap.erase(operand);
+    // Helper lambda used to restore the flat containers of an operand from the restored version
+    const auto restoreOperand = [&](const std::size_t operand) {
+        auto entry = restoredVersion.get(operand);
+        mOperandValues[operand] = entry.value;
+        if (mExpressionsWithDependencies[operand] != entry.expression) {
+            mExpressionsWithDependencies[operand] = std::move(entry.expression);
+            Jit::TieredVirtualMachine::resetProfile(mExpressionProfiles[operand]);
         }
+        mOperandDependants[operand].resize(entry.dependantCount);
+        mOperandDependencies[operand].resize(entry.dependencyCount);
+        mDirtyStates[operand] = entry.dirtyState;
 
-        // Tey to remove the operand from the expressions with dependencies map
-        if (mExpressionsWithDependenciesMap.contains(operand)) {
-            mExpressionsWithDependenciesMap.erase(operand);
+        if (entry.dirtyState != DirtyState::CLEAN && mEvaluationMode == EvaluationMode::EAGER) {
+            dirtyOperands.push_back(static_cast<Symbols::SymbolId>(operand));
         }
+    };
+
+    // Only the operands that differ between both versions (or were modified since the current
+    // version was recorded) need to be restored.
+    // (undoing only removes dependency edges, so the topological order remains valid)
+    currentVersion.forEachDifference(restoredVersion, restoreOperand);
+    for (const auto modifiedOperand : mModifiedOperands) {
+        restoreOperand(modifiedOperand);
+        mIsOperandModified[modifiedOperand] = false;
+    }
+    mModifiedOperands.clear();
 
-        // Remove the operand from the operation order stack
-        mOperandOrderStack.pop();
+    for (int deleteCounter = 0; deleteCounter < undoCount; ++deleteCounter) {
+        // Remove the operand from the top of the operation history
+        deletedOperations.push_back(mOperationHistory.back().operand);
+        mOperationHistory.pop_back();
+    }
 
-        deletedOperations.push_back(operand);
+    mPropagationErrors.clear();
+    for (const auto dirtyOperand : dirtyOperands) {
+        refreshOperand(dirtyOperand);
     }
 
     return deletedOperations;
 }
 
+void State::save(IO::BinaryWriter& writer) const
+{
+    // Programs are shared by the operands and by the versions of the state,
+    // so each of them is written once and referenced by its index (0 meaning no program)
+    std::unordered_map<const Bytecode::Program*, uint32_t> programIndices;
+    std::vector<const Bytecode::Program*> programs;
+    const auto indexProgram = [&](const std::shared_ptr<const Bytecode::Program>& program) {
+        if (program
+            && programIndices.try_emplace(program.get(), programs.size() + 1).second) {
+            programs.push_back(program.get());
+        }
+    };
+
+    for (const auto& expression : mExpressionsWithDependencies) {
+        indexProgram(expression);
+    }
+
+    // Every version only holds the entries that differ from the previous one
+    std::vector<std::vector<Version::Update>> versionUpdates(mOperationHistory.size());
+    for (std::size_t index = 0; index < mOperationHistory.size(); ++index) {
+        const auto& version = mOperationHistory[index].version;
+        const auto& previousVersion
+              = index == 0 ? Version{} : mOperationHistory[index - 1].version;
+
+        version.forEachDifference(previousVersion, [&](const std::size_t operand) {
+            auto entry = version.get(operand);
+            indexProgram(entry.expression);
+            versionUpdates[index].emplace_back(operand, std::move(entry));
+        });
+    }
+
+    const auto writeEntry = [&](const std::optional<Evaluator::Value>& value,
+                                const std::shared_ptr<const Bytecode::Program>& expression,
+                                const DirtyState dirtyState) {
+        writer.write<uint8_t>(value.has_value() ? 1 : 0);
+        if (value) {
+            writer.write<int64_t>(*value);
+        }
+        writer.write<uint32_t>(expression ? programIndices.at(expression.get()) : 0);
+        writer.write<uint8_t>(static_cast<uint8_t>(dirtyState));
+    };
+
+    const auto writeOperands = [&writer](const std::vector<Symbols::SymbolId>& operands) {
+        writer.write<uint32_t>(static_cast<uint32_t>(operands.size()));
+        for (const auto operand : operands) {
+            writer.write<uint32_t>(operand);
+        }
+    };
+
+    writer.write<uint32_t>(static_cast<uint32_t>(programs.size()));
+    for (const auto* program : programs) {
+        writeProgram(writer, *program);
+    }
+
+    writer.write<uint32_t>(static_cast<uint32_t>(mOperandValues.size()));
+    for (std::size_t operand = 0; operand < mOperandValues.size(); ++operand) {
+        writeEntry(mOperandValues[operand],
+                   mExpressionsWithDependencies[operand],
+                   mDirtyStates[operand]);
+        writer.write<uint32_t>(mTopologicalPositions[operand]);
+        writeOperands(mOperandDependants[operand]);
+        writeOperands(mOperandDependencies[operand]);
+    }
+
+    writeOperands(mModifiedOperands);
+
+    writer.write<uint32_t>(static_cast<uint32_t>(mOperationHistory.size()));
+    for (std::size_t index = 0; index < mOperationHistory.size(); ++index) {
+        writer.write<uint32_t>(mOperationHistory[index].operand);
+        writer.write<uint32_t>(static_cast<uint32_t>(versionUpdates[index].size()));
+
+        for (const auto& [operand, entry] : versionUpdates[index]) {
+            writer.write<uint32_t>(static_cast<uint32_t>(operand));
+            writeEntry(entry.value, entry.expression, entry.dirtyState);
+            writer.write<uint32_t>(entry.dependantCount);
+            writer.write<uint32_t>(entry.dependencyCount);
+        }
+    }
+}
+
+bool State::load(IO::BinaryReader& reader, const std::size_t symbolCount)
+{
+    std::vector<std::shared_ptr<const Bytecode::Program>> programs(1);
+    for (auto programCount = reader.readCount(cMinEncodedProgramSize); programCount > 0;
+         --programCount) {
+        auto program = readProgram(reader);
+        if (!reader.isValid() || !isValidProgram(program, symbolCount)) {
+            return false;
+        }
+        programs.push_back(std::make_shared<const Bytecode::Program>(std::move(program)));
+    }
+
+    const auto readEntry = [&](VersionEntry& entry) {
+        if (const auto hasValue = reader.read<uint8_t>(); hasValue == 1) {
+            entry.value = reader.read<int64_t>();
+        } else if (hasValue != 0) {
+            return false;
+        }
+
+        const auto programIndex = reader.read<uint32_t>();
+        const auto dirtyState = reader.read<uint8_t>();
+        if (!reader.isValid() || programIndex >= programs.size()
+            || dirtyState > static_cast<uint8_t>(DirtyState::DIRTY)) {
+            return false;
+        }
+
+        entry.expression = programs[programIndex];
+        entry.dirtyState = static_cast<DirtyState>(dirtyState);
+        return true;
+    };
+
+    const auto operandCount = reader.readCount(cMinEncodedOperandSize);
+    if (!reader.isValid() || operandCount > symbolCount) {
+        return false;
+    }
+
+    const auto readOperands = [&](std::vector<Symbols::SymbolId>& operands) {
+        operands.resize(reader.readCount(sizeof(Symbols::SymbolId)));
+        for (auto& operand : operands) {
+            operand = reader.read<uint32_t>();
+            if (operand >= operandCount) {
+                return false;
+            }
+        }
+        return reader.isValid();
+    };
+
+    std::vector<std::optional<Evaluator::Value>> operandValues(operandCount);
+    std::vector<std::shared_ptr<const Bytecode::Program>> expressions(operandCount);
+    std::vector<DirtyState> dirtyStates(operandCount);
+    std::vector<uint32_t> topologicalPositions(operandCount);
+    std::vector<std::vector<Symbols::SymbolId>> operandDependants(operandCount);
+    std::vector<std::vector<Symbols::SymbolId>> operandDependencies(operandCount);
+    std::vector<bool> isPositionUsed(operandCount);
+
+    for (std::size_t operand = 0; operand < operandCount; ++operand) {
+        VersionEntry entry;
+        if (!readEntry(entry)) {
+            return false;
+        }
+        operandValues[operand] = entry.value;
+        expressions[operand] = std::move(entry.expression);
+        dirtyStates[operand] = entry.dirtyState;
+
+        const auto position = reader.read<uint32_t>();
+        if (position >= operandCount || isPositionUsed[position]) {
+            return false;
+        }
+        topologicalPositions[operand] = position;
+        isPositionUsed[position] = true;
+
+        if (!readOperands(operandDependants[operand])
+            || !readOperands(operandDependencies[operand])) {
+            return false;
+        }
+    }
+
+    // Both directions of every edge must be present, following the topological order
+    {
+        std::vector<std::pair<Symbols::SymbolId, Symbols::SymbolId>> forwardEdges;
+        std::vector<std::pair<Symbols::SymbolId, Symbols::SymbolId>> backwardEdges;
+
+        for (Symbols::SymbolId operand = 0; operand < operandCount; ++operand) {
+            for (const auto dependant : operandDependants[operand]) {
+                if (topologicalPositions[operand] >= topologicalPositions[dependant]) {
+                    return false;
+                }
+                forwardEdges.emplace_back(operand, dependant);
+            }
+            for (const auto dependency : operandDependencies[operand]) {
+                backwardEdges.emplace_back(dependency, operand);
+            }
+        }
+
+        std::sort(forwardEdges.begin(), forwardEdges.end());
+        std::sort(backwardEdges.begin(), backwardEdges.end());
+        if (forwardEdges != backwardEdges) {
+            return false;
+        }
+    }
+
+    std::vector<Symbols::SymbolId> modifiedOperands;
+    std::vector<bool> isOperandModified(operandCount);
+    if (!readOperands(modifiedOperands)) {
+        return false;
+    }
+    for (const auto operand : modifiedOperands) {
+        if (isOperandModified[operand]) {
+            return false;
+        }
+        isOperandModified[operand] = true;
+    }
+
+    // Versions are rebuilt one on top of the other, sharing their unchanged entries again
+    // (edges are only ever appended, so every version sees a prefix of the current ones)
+    std::vector<Operation> operationHistory(reader.readCount(2 * sizeof(uint32_t)));
+    std::vector<Version::Update> versionUpdates;
+
+    for (std::size_t index = 0; index < operationHistory.size(); ++index) {
+        const auto operand = reader.read<uint32_t>();
+        versionUpdates.resize(reader.readCount(cMinEncodedVersionUpdateSize));
+        if (!reader.isValid() || operand >= operandCount) {
+            return false;
+        }
+
+        for (std::size_t update = 0; update < versionUpdates.size(); ++update) {
+            auto& [updatedOperand, entry] = versionUpdates[update];
+            updatedOperand = reader.read<uint32_t>();
+            entry = {};
+
+            if (!readEntry(entry) || updatedOperand >= operandCount
+                || (update > 0 && updatedOperand <= versionUpdates[update - 1].first)) {
+                return false;
+            }
+
+            entry.dependantCount = reader.read<uint32_t>();
+            entry.dependencyCount = reader.read<uint32_t>();
+            if (entry.dependantCount > operandDependants[updatedOperand].size()
+                || entry.dependencyCount > operandDependencies[updatedOperand].size()) {
+                return false;
+            }
+        }
+
+        const auto& previousVersion
+              = index == 0 ? Version{} : operationHistory[index - 1].version;
+        operationHistory[index] = {operand, previousVersion.with(versionUpdates)};
+    }
+
+    if (!reader.isAtEnd()) {
+        return false;
+    }
+
+    // The encoded state is consistent: replace the current one
+    mOperationHistory = std::move(operationHistory);
+    mModifiedOperands = std::move(modifiedOperands);
+    mIsOperandModified = std::move(isOperandModified);
+    mVersionUpdates.clear();
+    mOperandValues = std::move(operandValues);
+    mDirtyStates = std::move(dirtyStates);
+    mIsOperandRefreshing.assign(operandCount, false);
+    mOperandDependants = std::move(operandDependants);
+    mOperandDependencies = std::move(operandDependencies);
+    mTopologicalPositions = std::move(topologicalPositions);
+    mIsOperandVisited.assign(operandCount, false);
+    mExpressionsWithDependencies = std::move(expressions);
+    for (auto& profile : mExpressionProfiles) {
+        Jit::TieredVirtualMachine::resetProfile(profile);
+    }
+    mExpressionProfiles.assign(operandCount, {});
+    mAffectedExpressions.assign(operandCount, {});
+    mPropagationErrors.clear();
+    mPropagationEvaluationCount = 0;
+
+    if (mEvaluationMode == EvaluationMode::EAGER) {
+        setEvaluationMode(EvaluationMode::EAGER);
+    }
+
+    return true;
+}
+
+void State::evaluateWave(const std::size_t waveBegin,
+                         const std::size_t waveEnd,
+                         const std::size_t wave,
+                         const Symbols::SymbolId trigger)
+{
+    mWaveResults.assign(waveEnd - waveBegin, std::nullopt);
+
+    // Helper lambda used to evaluate a range of expressions of the wave
+    const auto evaluateExpressions
+          = [&](const std::size_t thread, const std::size_t begin, const std::size_t end) {
+                for (std::size_t index = begin; index < end; ++index) {
+                    const auto dependantOperand = mReadyOperands[waveBegin + index];
+
+                    // Expressions whose inputs kept their values do not need to be evaluated
+                    if (!mAffectedExpressions[dependantOperand].hasUpdatedInputs) {
+                        continue;
+                    }
+
+                    const auto startTime = mTraceWriter ? mTraceWriter->now() : 0;
+
+                    mWaveResults[index] = mVirtualMachines[thread].execute(
+                          *mExpressionsWithDependencies[dependantOperand],
+                          mOperandValues,
+                          mExpressionProfiles[dependantOperand]);
+
+                    // Symbols are not interned while propagating, so names can be read
+                    // concurrently
+                    if (mTraceWriter) {
+                        mTraceWriter->record(
+                              thread,
+                              {.name = std::string{mTracedSymbolTable->getName(dependantOperand)},
+                               .category = "evaluation",
+                               .startTime = startTime,
+                               .duration = mTraceWriter->now() - startTime,
+                               .arguments = {{{"trigger",
+                                               std::string{mTracedSymbolTable->getName(trigger)}},
+                                              {"wave", std::to_string(wave)}}}});
+                    }
+                }
+            };
+
+    if (mThreadPool && mWaveResults.size() >= mMinParallelWaveSize) {
+        mThreadPool->parallelFor(mWaveResults.size(), cWaveChunkSize, evaluateExpressions);
+    } else {
+        evaluateExpressions(0, 0, mWaveResults.size());
+    }
+}
+
+void State::reserveOperand(const Symbols::SymbolId operand)
+{
+    if (operand < mOperandValues.size()) {
+        return;
+    }
+
+    // New operands are positioned at the end of the topological order
+    // (they have no dependency edges yet)
+    for (auto newOperand = static_cast<Symbols::SymbolId>(mOperandValues.size());
+         newOperand <= operand;
+         ++newOperand) {
+        mTopologicalPositions.push_back(newOperand);
+    }
+
+    const std::size_t operandCount{operand + 1U};
+    mOperandValues.resize(operandCount);
+    mOperandDependants.resize(operandCount);
+    mOperandDependencies.resize(operandCount);
+    mExpressionsWithDependencies.resize(operandCount);
+    mExpressionProfiles.resize(operandCount);
+    mAffectedExpressions.resize(operandCount);
+    mIsOperandModified.resize(operandCount);
+    mIsOperandVisited.resize(operandCount);
+    mDirtyStates.resize(operandCount);
+    mIsOperandRefreshing.resize(operandCount);
+}
+
+void State::markModified(const Symbols::SymbolId operand)
+{
+    if (!mIsOperandModified[operand]) {
+        mIsOperandModified[operand] = true;
+        mModifiedOperands.push_back(operand);
+    }
+}
+
+void State::setDirtyState(const Symbols::SymbolId operand, const DirtyState dirtyState)
+{
+    if (mDirtyStates[operand] != dirtyState) {
+        mDirtyStates[operand] = dirtyState;
+        markModified(operand);
+    }
+}
+
+void State::markDependantsDirty(const Symbols::SymbolId operand)
+{
+    // Dependants that were already marked only have marked dependants,
+    // so only the newly marked ones are visited
+    mRegionStack.clear();
+    for (const auto dependantOperand : mOperandDependants[operand]) {
+        if (mExpressionsWithDependencies[dependantOperand]) {
+            if (mDirtyStates[dependantOperand] == DirtyState::CLEAN) {
+                mRegionStack.push_back(dependantOperand);
+            }
+            setDirtyState(dependantOperand, DirtyState::DIRTY);
+        }
+    }
+
+    while (!mRegionStack.empty()) {
+        const auto markedOperand = mRegionStack.back();
+        mRegionStack.pop_back();
+
+        for (const auto dependantOperand : mOperandDependants[markedOperand]) {
+            if (mExpressionsWithDependencies[dependantOperand]
+                && mDirtyStates[dependantOperand] == DirtyState::CLEAN) {
+                setDirtyState(dependantOperand, DirtyState::MAYBE_DIRTY);
+                mRegionStack.push_back(dependantOperand);
+            }
+        }
+    }
+}
+
+void State::refreshOperand(const Symbols::SymbolId operand)
+{
+    if (operand >= mDirtyStates.size() || mDirtyStates[operand] == DirtyState::CLEAN) {
+        return;
+    }
+
+    // Every variable read by an expression is refreshed before it (depth first),
+    // as the ones that are not dependencies of the expression may be dirty as well
+    mRefreshStack.assign(1, {operand, 0});
+    mIsOperandRefreshing[operand] = true;
+
+    while (!mRefreshStack.empty()) {
+        const auto [refreshedOperand, variableIndex] = mRefreshStack.back();
+        const auto& variables = mExpressionsWithDependencies[refreshedOperand]->variables;
+
+        if (variableIndex < variables.size()) {
+            ++mRefreshStack.back().second;
+
+            const auto variable = variables[variableIndex];
+            if (variable < mDirtyStates.size() && mDirtyStates[variable] != DirtyState::CLEAN
+                && !mIsOperandRefreshing[variable]) {
+                mIsOperandRefreshing[variable] = true;
+                mRefreshStack.emplace_back(variable, 0);
+            }
+            continue;
+        }
+
+        mRefreshStack.pop_back();
+        mIsOperandRefreshing[refreshedOperand] = false;
+
+        // Expressions whose inputs kept their values once refreshed are unchanged
+        if (mDirtyStates[refreshedOperand] == DirtyState::DIRTY) {
+            const auto startTime = mTraceWriter ? mTraceWriter->now() : 0;
+
+            const auto result = mVirtualMachines.front().execute(
+                  *mExpressionsWithDependencies[refreshedOperand],
+                  mOperandValues,
+                  mExpressionProfiles[refreshedOperand]);
+            ++mPropagationEvaluationCount;
+
+            if (mTraceWriter) {
+                mTraceWriter->record(
+                      0,
+                      {.name = std::string{mTracedSymbolTable->getName(refreshedOperand)},
+                       .category = "evaluation",
+                       .startTime = startTime,
+                       .duration = mTraceWriter->now() - startTime,
+                       .arguments
+                       = {{{"read", std::string{mTracedSymbolTable->getName(operand)}}}}});
+            }
+
+            if (storeEvaluationResult(refreshedOperand, result)) {
+                for (const auto dependantOperand : mOperandDependants[refreshedOperand]) {
+                    if (mExpressionsWithDependencies[dependantOperand]) {
+                        setDirtyState(dependantOperand, DirtyState::DIRTY);
+                    }
+                }
+            }
+        }
+
+        setDirtyState(refreshedOperand, DirtyState::CLEAN);
+    }
+}
+
+bool State::storeEvaluationResult(const Symbols::SymbolId operand,
+                                  const Evaluator::Result& result)
+{
+    if (const auto* value = std::get_if<Evaluator::Value>(&result)) {
+        mOperandValues[operand] = *value;
+        markModified(operand);
+        return true;
+    }
+
+    if (const auto* error = std::get_if<Evaluator::Error>(&result)) {
+        mPropagationErrors.emplace_back(operand, *error);
+    }
+
+    // A value computed from inputs that changed no longer holds
+    // (its dependants must then be evaluated again, losing their values as well)
+    if (mOperandValues[operand]) {
+        mOperandValues[operand].reset();
+        markModified(operand);
+        return true;
+    }
+
+    return false;
+}
+
+bool State::insertDependencyEdge(const Symbols::SymbolId dependency,
+                                 const Symbols::SymbolId dependant)
+{
+    if (dependency == dependant) {
+        return false;
+    }
+
+    const auto lowerBound = mTopologicalPositions[dependant];
+    const auto upperBound = mTopologicalPositions[dependency];
+
+    // Only an edge going backwards in the topological order can close a cycle,
+    // and only through the operands ordered between its endpoints (the affected region)
+    if (upperBound > lowerBound) {
+        mForwardRegion.clear();
+        collectRegion(dependant, mOperandDependants, lowerBound, upperBound, mForwardRegion);
+
+        const bool isCyclic{mIsOperandVisited[dependency]};
+        if (!isCyclic) {
+            mBackwardRegion.clear();
+            collectRegion(
+                  dependency, mOperandDependencies, lowerBound, upperBound, mBackwardRegion);
+        }
+
+        for (const auto operand : mForwardRegion) {
+            mIsOperandVisited[operand] = false;
+        }
+        if (isCyclic) {
+            return false;
+        }
+        for (const auto operand : mBackwardRegion) {
+            mIsOperandVisited[operand] = false;
+        }
+
+        // Reuse the positions of both regions, placing the operands reaching the dependency
+        // before the ones reachable from the dependant (each region keeps its relative order)
+        const auto byPosition = [this](const Symbols::SymbolId left,
+                                       const Symbols::SymbolId right) {
+            return mTopologicalPositions[left] < mTopologicalPositions[right];
+        };
+        std::ranges::sort(mBackwardRegion, byPosition);
+        std::ranges::sort(mForwardRegion, byPosition);
+
+        mReorderedPositions.clear();
+        for (const auto operand : mBackwardRegion) {
+            mReorderedPositions.push_back(mTopologicalPositions[operand]);
+        }
+        for (const auto operand : mForwardRegion) {
+            mReorderedPositions.push_back(mTopologicalPositions[operand]);
+        }
+        std::ranges::sort(mReorderedPositions);
+
+        auto position = mReorderedPositions.cbegin();
+        const auto assignPositions = [&](const std::vector<Symbols::SymbolId>& region) {
+            for (const auto operand : region) {
+                mTopologicalPositions[operand] = *position++;
+            }
+        };
+        assignPositions(mBackwardRegion);
+        assignPositions(mForwardRegion);
+    }
+
+    mOperandDependants[dependency].push_back(dependant);
+    mOperandDependencies[dependant].push_back(dependency);
+
+    return true;
+}
+
+void State::collectRegion(const Symbols::SymbolId origin,
+                          const std::vector<std::vector<Symbols::SymbolId>>& adjacency,
+                          const uint32_t lowerBound,
+                          const uint32_t upperBound,
+                          std::vector<Symbols::SymbolId>& region)
+{
+    mIsOperandVisited[origin] = true;
+    region.push_back(origin);
+    mRegionStack.assign(1, origin);
+
+    // Depth-first search, pruning the operands positioned outside of the bounds
+    while (!mRegionStack.empty()) {
+        const auto operand = mRegionStack.back();
+        mRegionStack.pop_back();
+
+        for (const auto adjacentOperand : adjacency[operand]) {
+            const auto position = mTopologicalPositions[adjacentOperand];
+            if (position < lowerBound || position > upperBound
+                || mIsOperandVisited[adjacentOperand]) {
+                continue;
+            }
+
+            mIsOperandVisited[adjacentOperand] = true;
+            region.push_back(adjacentOperand);
+            mRegionStack.push_back(adjacentOperand);
+        }
+    }
+}
+
 } // namespace Calculator
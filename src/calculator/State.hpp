@@ -1,13 +1,19 @@
 #pragma once
 
-#include <stack>
-#include <string>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
 #include <vector>
-#include <unordered_map>
-#include <unordered_set>
 
+#include "bytecode/Program.hpp"
+#include "concurrency/ThreadPool.hpp"
 #include "evaluator/Evaluator.hpp"
-#include "parser/Parser.hpp"
+#include "io/BinaryStream.hpp"
+#include "jit/TieredVirtualMachine.hpp"
+#include "metrics/TraceWriter.hpp"
+#include "symbols/SymbolTable.hpp"
+#include "utils/PersistentVector.hpp"
 
 namespace Calculator {
 
@@ -19,86 +25,489 @@ namespace Calculator {
  * - maintains the order of operations
  * - stores the results of evaluated expressions
  * - tracks dependencies between operands
+ *
+ * Operands are identified by their (dense) symbol ids,
+ * so every piece of per-operand data is kept in flat containers indexed by those ids
+ *
+ * A topological order of the dependency graph is maintained incrementally (Pearce-Kelly),
+ * so cyclic dependencies (of any length) are detected by only visiting the operands ordered
+ * between the endpoints of each new dependency
+ *
+ * Expressions re-evaluated often (as their inputs keep changing) are translated into native code
+ * by the tiered virtual machines, falling back to interpreting them whenever that is not possible
+ *
+ * Every registered operation also records a version of the whole state (persistent vectors
+ * sharing every entry that did not change), so undoing operations restores exactly the
+ * state that preceded them by switching back to an older version
+ *
+ * In lazy mode, value updates only mark the expressions depending on them as dirty,
+ * and those are re-evaluated when their values are read (see refreshOperands), at most once
+ * until one of their inputs is updated again
  */
 class State
 {
 public:
+    /// Alias representing an operand and its value
+    using OperandValue = std::pair<Symbols::SymbolId, Evaluator::Value>;
+    /// Alias representing an operand and the error that prevented its expression from having
+    /// a value
+    using OperandError = std::pair<Symbols::SymbolId, Evaluator::Error>;
+
     /**
-     * @brief Class' default constructor
+     * @brief Enum representing how value updates reach the expressions depending on them
      */
-    State() = default;
+    enum class EvaluationMode : uint8_t {
+
+        EAGER = 0, // Affected expressions are re-evaluated by every value update (push)
+        LAZY = 1   // Affected expressions are marked dirty, and re-evaluated when read (pull)
+    };
+
+    /// Default minimum amount of expressions of a wave for it to be evaluated concurrently
+    /// (see BM_StateParallelWaveEvaluation)
+    static constexpr std::size_t cDefaultMinParallelWaveSize{1024};
 
     /**
-     * @brief Updates the operation order with the given operand.
+     * @brief Class constructor
+     *
+     * @param[in] propagationThreadCount Amount of threads evaluating the waves of affected
+     * expressions (1 evaluates them on the calling thread only)
+     * @param[in] compilationThreshold Amount of evaluations of a pending expression
+     * before it is translated into native code
+     * @param[in] minParallelWaveSize Minimum amount of expressions of a wave for it to be
+     * evaluated concurrently (when using several propagation threads)
+     */
+    explicit State(std::size_t propagationThreadCount = 1,
+                   uint32_t compilationThreshold
+                   = Jit::TieredVirtualMachine::cDefaultCompilationThreshold,
+                   std::size_t minParallelWaveSize = cDefaultMinParallelWaveSize);
+
+    /**
+     * @brief Updates the operation order with the given operand,
+     * recording the current state as the outcome of the operation
      *
      * @param[in] operand The operand to update in the operation order.
      */
-    void updateOperationOrder(const std::string& operand);
+    void updateOperationOrder(Symbols::SymbolId operand);
 
     /**
-     * @brief Stores the value of a given operand and recursively resolves
+     * @brief Stores the value of a given operand and resolves
      * any dependencies that can be fulfilled with the new value
      *
+     * Affected pending expressions are evaluated iteratively, in topological order,
+     * so that each of them is evaluated (at most) once per update.
+     * They are processed in waves (expressions whose affected inputs were all processed by
+     * previous waves): every expression of a wave is evaluated against the values preceding the
+     * wave, so large waves are evaluated concurrently with the same (deterministic) results
+     *
+     * Affected expressions that can no longer be evaluated (their evaluation fails, or one of
+     * their inputs lost its value) lose their values as well, and the errors found are kept
+     * until the next update (see getLastPropagationErrors)
+     *
+     * In lazy mode, the affected expressions are only marked dirty (once the value of the
+     * operand itself is up to date, so that it is not overwritten by an older update)
+     *
      * @param[in] operand Operand whose value is to be stored
      * @param[in] value Value of the operand
      *
      * @return Operands and their respective values that were affected by setting the new value
+     * (only the provided operand in lazy mode)
      */
-    std::vector<std::pair<std::string, int>>
-          storeExpressionValue(const std::string& operand, const int value);
+    std::vector<OperandValue> storeExpressionValue(Symbols::SymbolId operand,
+                                                   const Evaluator::Value value);
 
     /**
      * @brief Stores the dependencies of an expression
      *
-     * As a safeguard, cyclic dependencies are checked before storing new dependencies
+     * Definitions that would close a cycle in the dependency graph (including an expression
+     * depending on its own operand) are rejected, leaving the state untouched
      *
      * @param[in] operand Operand whose dependencies are to be stored
-     * @param[in] expressionAST AST of the expression associated with the operand
+     * @param[in] expressionProgram Compiled expression associated with the operand
      * @param[in] dependencies Set of operands that the given operand depends on
      *
      * @return True if the dependencies were stored successfully
      * @return False if a cyclic dependency was found
      */
-    [[nodiscard]] bool storeExpressionDependencies(const std::string& operand,
-                                                   std::shared_ptr<Parser::ASTofRSH> expressionAST,
-                                                   const Evaluator::Dependencies& dependencies);
+    [[nodiscard]] bool
+          storeExpressionDependencies(Symbols::SymbolId operand,
+                                      std::shared_ptr<const Bytecode::Program> expressionProgram,
+                                      const Evaluator::Dependencies& dependencies);
+
+    /**
+     * @brief Brings the values of the given operands up to date (lazy mode only)
+     *
+     * Dirty expressions of the operands, and the ones they read, are re-evaluated
+     * (inputs first), and keep their values until one of their inputs is updated again.
+     * Expressions whose inputs kept their values once refreshed are not re-evaluated.
+     * The errors found are kept until the next update or refresh (see getLastPropagationErrors)
+     *
+     * @param[in] operands Operands to refresh (unknown ones are ignored)
+     */
+    void refreshOperands(std::span<const Symbols::SymbolId> operands);
+
+    /**
+     * @brief Switches the evaluation mode
+     * (switching to the eager mode refreshes every dirty expression)
+     *
+     * @param[in] evaluationMode New evaluation mode
+     */
+    void setEvaluationMode(EvaluationMode evaluationMode);
+
+    /**
+     * @brief Getter for the evaluation mode
+     *
+     * @return Current evaluation mode
+     */
+    [[nodiscard]] EvaluationMode getEvaluationMode() const;
+
+    /**
+     * @brief Retrieves the operand values for lookup
+     * (in lazy mode, the values of dirty expressions are out of date until refreshed)
+     *
+     * @return A const reference to the operand values, indexed by their symbol id
+     */
+    [[nodiscard]] const std::vector<std::optional<Evaluator::Value>>& getOperandValues() const;
+
+    /**
+     * @brief Retrieves the errors found while propagating the last value update
+     *
+     * @return Operands whose expressions failed to be evaluated and their respective errors,
+     * in evaluation order
+     */
+    [[nodiscard]] const std::vector<OperandError>& getLastPropagationErrors() const;
+
+    /**
+     * @brief Getter for the amount of pending expressions evaluated while propagating the last
+     * value update (expressions whose inputs kept their values are not evaluated)
+     *
+     * @return Amount of evaluated expressions
+     */
+    [[nodiscard]] std::size_t getLastPropagationEvaluationCount() const;
+
+    /**
+     * @brief Counts the expressions still waiting on the values of other operands
+     * (visits every operand, so it is meant for occasional reporting)
+     *
+     * @return Amount of expressions without a value (or dirty, in lazy mode)
+     */
+    [[nodiscard]] std::size_t getPendingExpressionCount() const;
+
+    /**
+     * @brief Getter for the amount of threads evaluating the waves of affected expressions
+     *
+     * @return Amount of propagation threads (the calling thread included)
+     */
+    [[nodiscard]] std::size_t getPropagationThreadCount() const;
 
     /**
-     * @brief Retrieves the map of operand values for lookup
+     * @brief Traces every re-evaluation of the following propagations
+     * (one event per evaluated expression, on the track of the propagation thread evaluating it)
      *
-     * @return A const reference to the map containing operand values
+     * @param[in] traceWriter Writer recording the events, with a recording thread per
+     * propagation thread (nullptr disables tracing)
+     * @param[in] symbolTable Symbol table naming the traced operands
+     * (both must outlive the state, or tracing must be disabled first)
      */
-    [[nodiscard]] const std::unordered_map<std::string, int>& getOperandValueMap() const;
+    void setTraceWriter(Metrics::TraceWriter* traceWriter, const Symbols::SymbolTable* symbolTable);
 
     /**
      * @brief Retrieves the result of the last fulfilled operation
+     * (refreshing the operands of the operations it goes through, in lazy mode)
      *
      * @return Operand and value pair relative to the last fulfilled operation
+     * (empty if no operation was fulfilled yet)
      */
-    [[nodiscard]] std::pair<std::string, int> getLastFulfilledOperation() const;
+    [[nodiscard]] std::optional<OperandValue> getLastFulfilledOperation();
 
     /**
      * @brief Undoes the specified number of operations
-     * (by removing their entries from the operation history and the operand values registry)
+     * (restoring the state recorded by the last remaining operation, or the initial state)
+     *
+     * Switching versions is constant time, while syncing the flat containers only visits
+     * the operands that changed since the restored version.
+     * In eager mode, operands restored as dirty (by versions recorded in lazy mode) are refreshed
+     * (the errors found are kept until the next update, see getLastPropagationErrors)
      *
      * @param[in] undoCount Number of operations to undo
      *
      * @return Operands of the undone operations
      */
-    [[nodiscard]] std::vector<std::string> undoLastRegisteredOperations(const int undoCount);
+    [[nodiscard]] std::vector<Symbols::SymbolId> undoLastRegisteredOperations(const int undoCount);
+
+    /**
+     * @brief Encodes the whole state: the values, pending expressions (as compiled programs,
+     * each shared one written once), dependency edges and topological order of the operands,
+     * and the operation history (each version as its differences with the previous one)
+     *
+     * @param[out] writer Writer to encode the state with
+     */
+    void save(IO::BinaryWriter& writer) const;
+
+    /**
+     * @brief Replaces the whole state with one encoded by save
+     *
+     * The encoded state is validated (references, edges, topological order and programs),
+     * and must end the decoded data, before replacing anything,
+     * so the state is left untouched if it is rejected.
+     * Dirty expressions of states saved in lazy mode are refreshed right away in eager mode
+     *
+     * @param[in,out] reader Reader to decode the state from
+     * @param[in] symbolCount Amount of interned operands (that programs can reference)
+     *
+     * @return True if the state was replaced (false otherwise)
+     */
+    [[nodiscard]] bool load(IO::BinaryReader& reader, std::size_t symbolCount);
+
+private:
+    /**
+     * @brief Enum representing whether the value of an operand is up to date (lazy mode only)
+     *
+     * Dirty operands only have dirty dependants (along the edges of the dependency graph),
+     * so clean operands only depend on clean ones
+     */
+    enum class DirtyState : uint8_t {
+
+        CLEAN = 0,       // The value is up to date
+        MAYBE_DIRTY = 1, // An input may be updated once refreshed (re-evaluated only if it is)
+        DIRTY = 2        // An input was updated (re-evaluated when refreshed)
+    };
+
+    /**
+     * @brief Grows the per-operand containers so that they can be indexed by the given operand
+     *
+     * @param[in] operand Operand about to be indexed
+     */
+    void reserveOperand(Symbols::SymbolId operand);
+
+    /**
+     * @brief Marks an operand whose data changed since the last recorded version
+     *
+     * @param[in] operand Modified operand
+     */
+    void markModified(Symbols::SymbolId operand);
+
+    /**
+     * @brief Updates the dirty state of an operand, marking it as modified if it changed
+     *
+     * @param[in] operand Operand to update
+     * @param[in] dirtyState New dirty state of the operand
+     */
+    void setDirtyState(Symbols::SymbolId operand, DirtyState dirtyState);
+
+    /**
+     * @brief Marks the dependants of an updated operand as dirty (lazy mode only)
+     * and their own dependants as maybe dirty
+     *
+     * @param[in] operand Updated operand
+     */
+    void markDependantsDirty(Symbols::SymbolId operand);
+
+    /**
+     * @brief Brings the value of an operand up to date (lazy mode only)
+     * (see refreshOperands)
+     *
+     * @param[in] operand Operand to refresh
+     */
+    void refreshOperand(Symbols::SymbolId operand);
+
+    /**
+     * @brief Stores the result of the re-evaluation of an affected expression
+     * (errors are kept in mPropagationErrors)
+     *
+     * @param[in] operand Operand of the expression
+     * @param[in] result Result of the expression
+     *
+     * @return True if the value of the operand was updated (set, or lost)
+     */
+    bool storeEvaluationResult(Symbols::SymbolId operand, const Evaluator::Result& result);
+
+    /**
+     * @brief Adds a dependency edge to the dependency graph, keeping its topological order
+     *
+     * When the dependency is ordered after its dependant, the operands reachable from the
+     * dependant and the ones reaching the dependency (within the range of positions delimited
+     * by both) are reordered, reusing the positions they held
+     *
+     * @param[in] dependency Operand the dependant depends on
+     * @param[in] dependant Operand whose expression depends on the dependency
+     *
+     * @return True if the edge was added
+     * @return False if the edge would close a cycle (the graph is left untouched)
+     */
+    [[nodiscard]] bool insertDependencyEdge(Symbols::SymbolId dependency,
+                                            Symbols::SymbolId dependant);
+
+    /**
+     * @brief Collects the operands reachable from an operand (following the edges in a direction)
+     * whose topological positions lie within the given bounds, marking them as visited
+     *
+     * @param[in] origin Operand to start from
+     * @param[in] adjacency Edges to follow (dependants or dependencies of each operand)
+     * @param[in] lowerBound Lowest position of the visited operands
+     * @param[in] upperBound Highest position of the visited operands
+     * @param[out] region Visited operands
+     */
+    void collectRegion(Symbols::SymbolId origin,
+                       const std::vector<std::vector<Symbols::SymbolId>>& adjacency,
+                       uint32_t lowerBound,
+                       uint32_t upperBound,
+                       std::vector<Symbols::SymbolId>& region);
+
+    /**
+     * @brief Evaluates a wave of ready expressions, storing their results in mWaveResults
+     * (operand values are only read, so large waves are split between the propagation threads)
+     *
+     * @param[in] waveBegin Index of the first expression of the wave in mReadyOperands
+     * @param[in] waveEnd Index one past the last expression of the wave in mReadyOperands
+     * @param[in] wave Index of the wave within its propagation (only used when tracing)
+     * @param[in] trigger Operand whose update is being propagated (only used when tracing)
+     */
+    void evaluateWave(std::size_t waveBegin,
+                      std::size_t waveEnd,
+                      std::size_t wave,
+                      Symbols::SymbolId trigger);
 
 private:
-    /// LIFO stack to keep track of the order of operations by tracking operands of each expression
-    std::stack<std::string> mOperandOrderStack;
+    /**
+     * @brief Data of an operand recorded by the versions of the state
+     */
+    struct VersionEntry
+    {
+        /// Value of the operand
+        std::optional<Evaluator::Value> value;
+        /// Pending expression of the operand
+        std::shared_ptr<const Bytecode::Program> expression;
+        /// Amount of dependants of the operand
+        /// (dependants are only ever appended, so older versions see a prefix of the current ones)
+        uint32_t dependantCount{};
+        /// Amount of dependencies of the operand (only ever appended as well)
+        uint32_t dependencyCount{};
+        /// Whether the value of the operand is up to date (lazy mode only)
+        DirtyState dirtyState{};
+
+        /// Equality comparison operator
+        bool operator==(const VersionEntry&) const = default;
+    };
+
+    /// Alias representing a persistent snapshot of the state (indexed by symbol id)
+    using Version = Utils::PersistentVector<VersionEntry>;
+
+    /**
+     * @brief Entry of the operation history
+     */
+    struct Operation
+    {
+        /// Operand set by the operation
+        Symbols::SymbolId operand{};
+        /// State right after the operation
+        Version version;
+    };
+
+    /**
+     * @brief Bookkeeping of a pending expression affected by a value update
+     */
+    struct AffectedExpression
+    {
+        /// Amount of affected inputs of the expression that were not processed yet
+        uint32_t pendingInputsCount{};
+        /// Whether the value of (at least) one of the inputs of the expression was updated
+        bool hasUpdatedInputs{};
+    };
+
+    /// LIFO stack to keep track of the order of operations (and the state each of them left)
+    std::vector<Operation> mOperationHistory;
+
+    /// Operands modified since the last recorded version
+    std::vector<Symbols::SymbolId> mModifiedOperands;
+
+    /// Whether each operand was modified since the last recorded version
+    std::vector<bool> mIsOperandModified;
+
+    /// Scratch list of the entries updated by the version being recorded
+    std::vector<Version::Update> mVersionUpdates;
+
+    /// Current value of each operand (empty if the operand has no value)
+    std::vector<std::optional<Evaluator::Value>> mOperandValues;
+
+    /// How value updates reach the expressions depending on them
+    EvaluationMode mEvaluationMode{EvaluationMode::EAGER};
+
+    /// Whether the value of each operand is up to date (always clean in eager mode)
+    std::vector<DirtyState> mDirtyStates;
+
+    /// Scratch stack of the operands being refreshed and the index of their next variable
+    std::vector<std::pair<Symbols::SymbolId, std::size_t>> mRefreshStack;
+
+    /// Scratch flags of the operands being refreshed (reads closing a cycle use the current value)
+    std::vector<bool> mIsOperandRefreshing;
+
+    /// Operands whose expressions depend on each operand (one to many relationship).
+    std::vector<std::vector<Symbols::SymbolId>> mOperandDependants;
+
+    /// Operands each operand's expression depends on (reverse edges of mOperandDependants)
+    std::vector<std::vector<Symbols::SymbolId>> mOperandDependencies;
+
+    /// Position of each operand in the topological order of the dependency graph
+    /// (every operand is positioned before its dependants)
+    std::vector<uint32_t> mTopologicalPositions;
+
+    /// Scratch flags of the operands visited while reordering the dependency graph
+    std::vector<bool> mIsOperandVisited;
+
+    /// Scratch list of the operands reachable from the dependant of a new dependency edge
+    std::vector<Symbols::SymbolId> mForwardRegion;
+
+    /// Scratch list of the operands reaching the dependency of a new dependency edge
+    std::vector<Symbols::SymbolId> mBackwardRegion;
+
+    /// Scratch stack of the operands to visit while collecting a region
+    std::vector<Symbols::SymbolId> mRegionStack;
+
+    /// Scratch list of the positions reused when reordering the dependency graph
+    std::vector<uint32_t> mReorderedPositions;
+
+    /// (Compiled) arithmetic expression of each operand depending on the values of other operands
+    std::vector<std::shared_ptr<const Bytecode::Program>> mExpressionsWithDependencies;
+
+    /// Execution profile of the expression of each operand
+    /// (reset whenever the expression changes, including when it is restored by an undo)
+    std::vector<Jit::TieredVirtualMachine::ExpressionProfile> mExpressionProfiles;
+
+    /// Scratch bookkeeping of the expressions affected by the value update being propagated
+    /// (indexed by symbol id, only meaningful for the operands listed in mAffectedOperands)
+    std::vector<AffectedExpression> mAffectedExpressions;
+
+    /// Scratch list of the operands affected by the value update being propagated
+    std::vector<Symbols::SymbolId> mAffectedOperands;
+
+    /// Scratch queue of the affected operands ready to be evaluated, in topological order
+    std::vector<Symbols::SymbolId> mReadyOperands;
+
+    /// Scratch results of the wave being evaluated
+    /// (empty for the expressions that were not evaluated)
+    std::vector<std::optional<Evaluator::Result>> mWaveResults;
+
+    /// Errors found while propagating the last value update
+    std::vector<OperandError> mPropagationErrors;
+
+    /// Amount of expressions evaluated while propagating the last value update
+    std::size_t mPropagationEvaluationCount{};
+
+    /// Virtual machines used to re-run the expressions whose dependencies were updated
+    /// (one per propagation thread, each owning the native code it generated)
+    std::vector<Jit::TieredVirtualMachine> mVirtualMachines;
+
+    /// Threads evaluating large waves concurrently (only when using several propagation threads)
+    std::unique_ptr<Concurrency::ThreadPool> mThreadPool;
 
-    /// Map holding the operands with their current values
-    std::unordered_map<std::string, int> mOperandValuesMap;
+    /// Minimum amount of expressions of a wave for it to be evaluated concurrently
+    std::size_t mMinParallelWaveSize;
 
-    /// Multimap to track dependencies between operands (one to many relationship).
-    std::unordered_multimap<std::string, std::string> mOperandDependenciesMap;
+    /// Writer recording the re-evaluations (nullptr when not tracing)
+    Metrics::TraceWriter* mTraceWriter{nullptr};
 
-    /// Map to track arithmetic expressions that depend on the values of other operands
-    std::unordered_map<std::string, std::shared_ptr<Parser::ASTofRSH>> mExpressionsWithDependenciesMap;
+    /// Symbol table naming the traced operands
+    const Symbols::SymbolTable* mTracedSymbolTable{nullptr};
 };
 
 } // namespace Calculator
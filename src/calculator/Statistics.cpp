@@ -0,0 +1,111 @@
+#include "Statistics.hpp"
+
+#ifdef STATISTICS_BUILD
+
+#include <string_view>
+#include <utility>
+
+namespace {
+/// Names of the measured stages, indexed by stage
+constexpr std::array<std::string_view, Calculator::Statistics::cStageCount> cStageNames{
+      "instruction", "parsing", "compilation", "evaluation", "propagation", "dependencies", "undo"};
+
+/// Reported percentiles (and their labels)
+constexpr std::array<std::pair<std::string_view, double>, 4> cPercentiles{{
+      {"p50", 50.0},
+      {"p90", 90.0},
+      {"p99", 99.0},
+      {"p99.9", 99.9},
+}};
+
+/**
+ * @brief Formats the summary of a histogram
+ *
+ * @param[in] name Name of the histogram
+ * @param[in] histogram Histogram to summarize
+ *
+ * @return Summary of the histogram (count, minimum, percentiles, maximum and mean)
+ */
+std::string formatHistogram(const std::string_view name, const Metrics::Histogram& histogram)
+{
+    std::string summary{name};
+    summary += ": count=" + std::to_string(histogram.getCount())
+               + " min=" + std::to_string(histogram.getMin());
+
+    for (const auto& [label, percentile] : cPercentiles) {
+        summary += " ";
+        summary += label;
+        summary += "=" + std::to_string(histogram.getValueAtPercentile(percentile));
+    }
+
+    summary += " max=" + std::to_string(histogram.getMax())
+               + " mean=" + std::to_string(static_cast<uint64_t>(histogram.getMean()));
+
+    return summary;
+}
+} // namespace
+
+namespace Calculator {
+
+Statistics::StageTimer::StageTimer(Statistics& statistics, const Stage stage)
+    : mStatistics{statistics}
+    , mStage{stage}
+    , mStart{std::chrono::steady_clock::now()}
+{
+}
+
+Statistics::StageTimer::~StageTimer()
+{
+    const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now() - mStart);
+    mStatistics.getHistograms().stageLatencies[static_cast<std::size_t>(mStage)].record(
+          static_cast<uint64_t>(latency.count()));
+}
+
+void Statistics::recordEvaluations(const std::size_t evaluationCount)
+{
+    getHistograms().evaluationsPerInstruction.record(evaluationCount);
+}
+
+void Statistics::recordCascade(const std::size_t cascadeSize)
+{
+    getHistograms().cascadeSizes.record(cascadeSize);
+}
+
+Statistics::Histograms& Statistics::getHistograms()
+{
+    if (!mHistograms) {
+        mHistograms = std::make_unique<Histograms>();
+    }
+
+    return *mHistograms;
+}
+
+std::vector<std::string>
+      Statistics::report(const std::size_t pendingExpressionCount,
+                         const ExpressionCache::Statistics& cacheStatistics) const
+{
+    // Nothing was recorded yet if the histograms were never allocated
+    static const Histograms cEmptyHistograms{};
+    const auto& histograms = mHistograms ? *mHistograms : cEmptyHistograms;
+
+    std::vector<std::string> lines;
+
+    for (std::size_t stage = 0; stage < cStageCount; ++stage) {
+        lines.push_back(formatHistogram(std::string{cStageNames[stage]} + " (ns)",
+                                        histograms.stageLatencies[stage]));
+    }
+    lines.push_back(
+          formatHistogram("evaluations per instruction", histograms.evaluationsPerInstruction));
+    lines.push_back(formatHistogram("cascade size", histograms.cascadeSizes));
+    lines.push_back("pending expressions: " + std::to_string(pendingExpressionCount));
+    lines.push_back("expression cache: hits=" + std::to_string(cacheStatistics.hits)
+                    + " misses=" + std::to_string(cacheStatistics.misses)
+                    + " evictions=" + std::to_string(cacheStatistics.evictions));
+
+    return lines;
+}
+
+} // namespace Calculator
+
+#endif
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "ExpressionCache.hpp"
+
+#ifdef STATISTICS_BUILD
+#include "metrics/Histogram.hpp"
+#endif
+
+namespace Calculator {
+
+/**
+ * @brief Latency histograms and counters of the instructions processed by a Runner
+ *
+ * Statistics are only compiled in when the ENABLE_STATISTICS CMake option is on (defining
+ * STATISTICS_BUILD). Otherwise every method is an empty inline function, no clock is ever read
+ * and no histogram is stored, so the instrumentation is removed entirely.
+ *
+ * The histograms (a few KiB each) are only allocated once the first value is recorded,
+ * so that idle calculators (e.g. the sessions of idle server clients) do not pay for them
+ */
+class Statistics
+{
+public:
+    /// Whether statistics are compiled in
+#ifdef STATISTICS_BUILD
+    static constexpr bool cIsEnabled{true};
+#else
+    static constexpr bool cIsEnabled{false};
+#endif
+
+    /**
+     * @brief Enum representing the measured stages of an instruction
+     */
+    enum class Stage : uint8_t {
+
+        INSTRUCTION = 0,  // Whole instruction
+        PARSING = 1,      // Parsing an expression (skipped by cached expressions)
+        COMPILATION = 2,  // Simplifying and compiling an expression (skipped as well)
+        EVALUATION = 3,   // Evaluating a new expression
+        PROPAGATION = 4,  // Storing a value and propagating it to the affected expressions
+        DEPENDENCIES = 5, // Storing the dependencies of a pending expression
+        UNDO = 6          // Undoing operations
+    };
+
+    /// Amount of measured stages
+    static constexpr std::size_t cStageCount{7};
+
+    /**
+     * @brief Measures the latency of a stage, from its construction until its destruction
+     */
+    class StageTimer
+    {
+    public:
+        /**
+         * @brief Class constructor (starts measuring)
+         *
+         * @param[in,out] statistics Statistics to record the latency in
+         * @param[in] stage Measured stage
+         */
+        StageTimer(Statistics& statistics, Stage stage);
+
+        /**
+         * @brief Class destructor (records the latency)
+         */
+        ~StageTimer();
+
+        StageTimer(const StageTimer&) = delete;
+        StageTimer& operator=(const StageTimer&) = delete;
+
+#ifdef STATISTICS_BUILD
+    private:
+        /// Statistics to record the latency in
+        Statistics& mStatistics;
+
+        /// Measured stage
+        Stage mStage;
+
+        /// Start of the stage
+        std::chrono::steady_clock::time_point mStart;
+#endif
+    };
+
+    /**
+     * @brief Records the amount of expressions evaluated by an instruction
+     * (the new expression itself, plus the ones re-evaluated by its propagation)
+     *
+     * @param[in] evaluationCount Amount of evaluated expressions
+     */
+    void recordEvaluations(std::size_t evaluationCount);
+
+    /**
+     * @brief Records the size of the cascade of a value update
+     *
+     * @param[in] cascadeSize Amount of operands whose values were updated
+     * (including the one set by the instruction)
+     */
+    void recordCascade(std::size_t cascadeSize);
+
+    /**
+     * @brief Reports the recorded statistics, one per line
+     * (latencies are reported in nanoseconds)
+     *
+     * @param[in] pendingExpressionCount Amount of expressions waiting on other operands
+     * @param[in] cacheStatistics Usage counters of the expression cache
+     *
+     * @return Lines of the report (empty if statistics are not compiled in)
+     */
+    [[nodiscard]] std::vector<std::string>
+          report(std::size_t pendingExpressionCount,
+                 const ExpressionCache::Statistics& cacheStatistics) const;
+
+#ifdef STATISTICS_BUILD
+private:
+    /**
+     * @brief Recorded histograms
+     */
+    struct Histograms
+    {
+        /// Latencies of each stage, indexed by stage
+        std::array<Metrics::Histogram, cStageCount> stageLatencies;
+        /// Amount of expressions evaluated by each instruction
+        Metrics::Histogram evaluationsPerInstruction;
+        /// Amount of operands updated by each value update
+        Metrics::Histogram cascadeSizes;
+    };
+
+    /**
+     * @brief Retrieves the recorded histograms, allocating them on first use
+     *
+     * @return Reference to the histograms
+     */
+    [[nodiscard]] Histograms& getHistograms();
+
+private:
+    /// Recorded histograms (nullptr until the first value is recorded)
+    std::unique_ptr<Histograms> mHistograms;
+#endif
+};
+
+#ifndef STATISTICS_BUILD
+inline Statistics::StageTimer::StageTimer(Statistics& /*statistics*/, Stage /*stage*/) {}
+
+inline Statistics::StageTimer::~StageTimer() = default;
+
+inline void Statistics::recordEvaluations(std::size_t /*evaluationCount*/) {}
+
+inline void Statistics::recordCascade(std::size_t /*cascadeSize*/) {}
+
+inline std::vector<std::string>
+      Statistics::report(std::size_t /*pendingExpressionCount*/,
+                         const ExpressionCache::Statistics& /*cacheStatistics*/) const
+{
+    return {};
+}
+#endif
+
+} // namespace Calculator
@@ -0,0 +1,138 @@
+#include "Compiler.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "utils/Constants.hpp"
+
+namespace {
+using namespace Utils::Constants;
+
+/**
+ * @brief Maps a binary operator character to the corresponding op code
+ *
+ * @param[in] character Character to evaluate
+ *
+ * @return Op code of the operator (empty if the character is not a supported operator)
+ */
+constexpr std::optional<Bytecode::OpCode> toOpCode(const char character)
+{
+    using Bytecode::OpCode;
+    switch (character) {
+    case cAddOp:
+        return OpCode::ADD;
+    case cSubOp:
+        return OpCode::SUB;
+    case cMultOp:
+        return OpCode::MULT;
+    case cDivOp:
+        return OpCode::DIV;
+    default:
+        return {};
+    }
+}
+} // namespace
+
+Compiler::Compiler(const AST::Tree& ast, std::vector<Symbols::SymbolId> variables)
+    : mAst{ast}
+    , mVariables{std::move(variables)}
+{
+}
+
+bool Compiler::execute()
+{
+    using Bytecode::OpCode;
+
+    if (mAst.empty()) {
+        std::cerr << "Empty AST\n";
+        return false;
+    }
+
+    auto program = std::make_shared<Bytecode::Program>();
+    program->instructions.reserve(mAst.size());
+    program->variables = mVariables;
+
+    uint32_t stackDepth{0};
+
+    // Iterative postorder traversal of the AST:
+    // each entry holds a node index and whether its children were already emitted
+    std::vector<std::pair<AST::NodeIndex, bool>> pendingNodes;
+    pendingNodes.reserve(mAst.size());
+    pendingNodes.emplace_back(mAst.getRootNodeIndex(), false);
+
+    while (!pendingNodes.empty()) {
+        const auto [nodeIndex, childrenEmitted] = pendingNodes.back();
+        pendingNodes.pop_back();
+
+        const auto& node = mAst.getNode(nodeIndex);
+
+        switch (node.getNodeType()) {
+        case AST::NodeType::LITERAL:
+            program->instructions.push_back({OpCode::PUSH_LITERAL, node.getNodeValue()});
+            ++stackDepth;
+            break;
+
+        case AST::NodeType::CONSTANT: {
+            auto& constants = program->constants;
+            program->instructions.push_back(
+                  {OpCode::PUSH_CONSTANT, static_cast<uint32_t>(constants.size())});
+            constants.push_back(mAst.getConstantValue(node));
+            ++stackDepth;
+            break;
+        }
+
+        case AST::NodeType::VARIABLE: {
+            // Every distinct operand gets its own variable slot
+            auto& variables = program->variables;
+            const auto slot = static_cast<uint32_t>(std::distance(
+                  variables.begin(), std::ranges::find(variables, node.getNodeValue())));
+            if (slot == variables.size()) {
+                variables.push_back(node.getNodeValue());
+            }
+
+            program->instructions.push_back({OpCode::PUSH_VARIABLE, slot});
+            ++stackDepth;
+            break;
+        }
+
+        case AST::NodeType::OPERATOR: {
+            const auto opCode = toOpCode(static_cast<char>(node.getNodeValue()));
+            if (!opCode) {
+                std::cerr << "Unsupported operator found in the AST\n";
+                return false;
+            }
+
+            // Emit both operands before the operator itself
+            if (!childrenEmitted) {
+                if (node.getLeftNodeIndex() == AST::cInvalidNodeIndex
+                    || node.getRightNodeIndex() == AST::cInvalidNodeIndex) {
+                    std::cerr << "Operator without operands found in the AST\n";
+                    return false;
+                }
+
+                pendingNodes.emplace_back(nodeIndex, true);
+                pendingNodes.emplace_back(node.getRightNodeIndex(), false);
+                pendingNodes.emplace_back(node.getLeftNodeIndex(), false);
+                continue;
+            }
+
+            program->instructions.push_back({*opCode, 0});
+            --stackDepth;
+            break;
+        }
+        }
+
+        program->maxStackDepth = std::max(program->maxStackDepth, stackDepth);
+    }
+
+    mProgram = std::move(program);
+    return true;
+}
+
+std::shared_ptr<const Bytecode::Program> Compiler::getProgram() const
+{
+    return mProgram;
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "ast/Tree.hpp"
+#include "bytecode/Program.hpp"
+
+/**
+ * @brief Class responsible for lowering the AST of an arithmetic expression into bytecode
+ *
+ * Operator mapping and variable slot assignment happen once, at compile time,
+ * so that the resulting program can be executed repeatedly without re-analysing the AST
+ */
+class Compiler
+{
+public:
+    /**
+     * @brief Class constructor
+     *
+     * @param[in] ast Reference to the AST to compile
+     * @param[in] variables Operands holding the first variable slots (in order), even if the AST
+     * does not reference them (e.g. operands optimized away, which remain dependencies)
+     */
+    explicit Compiler(const AST::Tree& ast, std::vector<Symbols::SymbolId> variables = {});
+
+    /**
+     * @brief Lowers the AST into a postfix instruction stream
+     *
+     * @return True if compilation was successful (false otherwise)
+     */
+    [[nodiscard]] bool execute();
+
+    /**
+     * @brief Getter for the compiled program
+     *
+     * @return Shared pointer to the (immutable) compiled program
+     */
+    [[nodiscard]] std::shared_ptr<const Bytecode::Program> getProgram() const;
+
+private:
+    /// Reference to the AST to compile
+    const AST::Tree& mAst;
+
+    /// Operands holding the first variable slots
+    std::vector<Symbols::SymbolId> mVariables;
+
+    /// Program being generated
+    std::shared_ptr<Bytecode::Program> mProgram;
+};
@@ -0,0 +1,174 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+namespace {
+/**
+ * @brief Packs a [begin, end) range of indices into a single word
+ *
+ * @param[in] begin First index of the range
+ * @param[in] end One past the last index of the range
+ *
+ * @return Packed range
+ */
+constexpr uint64_t packRange(const uint64_t begin, const uint64_t end)
+{
+    return (begin << 32U) | end;
+}
+
+/**
+ * @brief Retrieves the first index of a packed range
+ *
+ * @param[in] range Packed range
+ *
+ * @return First index of the range
+ */
+constexpr uint64_t rangeBegin(const uint64_t range)
+{
+    return range >> 32U;
+}
+
+/**
+ * @brief Retrieves the end (one past the last index) of a packed range
+ *
+ * @param[in] range Packed range
+ *
+ * @return End of the range
+ */
+constexpr uint64_t rangeEnd(const uint64_t range)
+{
+    return range & 0xFFFF'FFFFU;
+}
+} // namespace
+
+namespace Concurrency {
+
+ThreadPool::ThreadPool(const std::size_t threadCount)
+    : mShares{std::make_unique<Share[]>(std::max<std::size_t>(threadCount, 1))}
+    , mThreadCount{std::max<std::size_t>(threadCount, 1)}
+{
+    mWorkers.reserve(mThreadCount - 1);
+    for (std::size_t participant = 1; participant < mThreadCount; ++participant) {
+        mWorkers.emplace_back([this, participant] { workerLoop(participant); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        const std::lock_guard lock{mMutex};
+        mIsStopping = true;
+    }
+    mLoopStarted.notify_all();
+
+    for (auto& worker : mWorkers) {
+        worker.join();
+    }
+}
+
+std::size_t ThreadPool::getThreadCount() const
+{
+    return mThreadCount;
+}
+
+void ThreadPool::parallelFor(const std::size_t count, const std::size_t chunkSize, const Task& task)
+{
+    if (count == 0) {
+        return;
+    }
+
+    // Not worth waking up the workers for a single chunk
+    if (mWorkers.empty() || count <= chunkSize) {
+        task(0, 0, count);
+        return;
+    }
+
+    // Split the indices evenly between the participants
+    for (std::size_t participant = 0; participant < mThreadCount; ++participant) {
+        mShares[participant].range.store(packRange(count * participant / mThreadCount,
+                                                   count * (participant + 1) / mThreadCount),
+                                         std::memory_order_relaxed);
+    }
+
+    {
+        const std::lock_guard lock{mMutex};
+        mTask = &task;
+        mChunkSize = std::max<std::size_t>(chunkSize, 1);
+        mBusyWorkerCount = mWorkers.size();
+        ++mGeneration;
+    }
+    mLoopStarted.notify_all();
+
+    participate(0);
+
+    // The loop (and the task it references) must outlive every participant
+    std::unique_lock lock{mMutex};
+    mLoopFinished.wait(lock, [this] { return mBusyWorkerCount == 0; });
+    mTask = nullptr;
+}
+
+void ThreadPool::participate(const std::size_t participant)
+{
+    const auto chunkSize = static_cast<uint64_t>(mChunkSize);
+
+    // Process the own share, front to back
+    auto& ownShare = mShares[participant].range;
+    auto range = ownShare.load(std::memory_order_acquire);
+
+    while (rangeBegin(range) < rangeEnd(range)) {
+        const auto chunkEnd = std::min(rangeBegin(range) + chunkSize, rangeEnd(range));
+
+        if (ownShare.compare_exchange_weak(range,
+                                           packRange(chunkEnd, rangeEnd(range)),
+                                           std::memory_order_acq_rel)) {
+            (*mTask)(participant, rangeBegin(range), chunkEnd);
+            range = ownShare.load(std::memory_order_acquire);
+        }
+    }
+
+    // Steal chunks from the back of the other shares, until every share is empty
+    for (std::size_t offset = 1; offset < mThreadCount; ++offset) {
+        auto& victimShare = mShares[(participant + offset) % mThreadCount].range;
+        range = victimShare.load(std::memory_order_acquire);
+
+        while (rangeBegin(range) < rangeEnd(range)) {
+            const auto chunkBegin
+                  = rangeEnd(range) - std::min(rangeEnd(range) - rangeBegin(range), chunkSize);
+
+            if (victimShare.compare_exchange_weak(range,
+                                                  packRange(rangeBegin(range), chunkBegin),
+                                                  std::memory_order_acq_rel)) {
+                (*mTask)(participant, chunkBegin, rangeEnd(range));
+                range = victimShare.load(std::memory_order_acquire);
+            }
+        }
+    }
+}
+
+void ThreadPool::workerLoop(const std::size_t participant)
+{
+    uint64_t lastGeneration{0};
+
+    while (true) {
+        {
+            std::unique_lock lock{mMutex};
+            mLoopStarted.wait(lock, [&] { return mIsStopping || mGeneration != lastGeneration; });
+
+            if (mIsStopping) {
+                return;
+            }
+            lastGeneration = mGeneration;
+        }
+
+        participate(participant);
+
+        {
+            const std::lock_guard lock{mMutex};
+            if (--mBusyWorkerCount == 0) {
+                mLoopFinished.notify_one();
+            }
+        }
+    }
+}
+
+} // namespace Concurrency
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Concurrency {
+
+/**
+ * @brief Fixed-size pool of threads running parallel loops with work stealing
+ *
+ * The index range of a loop is split evenly between the participants (the calling thread
+ * included), which process their own share chunk by chunk, front to back.
+ * Participants that run out of work steal chunks from the back of the other shares,
+ * so uneven chunks are balanced without a central queue.
+ */
+class ThreadPool
+{
+public:
+    /// Alias representing the body of a parallel loop:
+    /// called with the index of the participant and a [begin, end) range of indices
+    using Task = std::function<void(std::size_t participant, std::size_t begin, std::size_t end)>;
+
+    /**
+     * @brief Class constructor
+     *
+     * @param[in] threadCount Amount of threads running each loop, including the calling thread
+     * (values below 1 are treated as 1, so no worker thread is spawned)
+     */
+    explicit ThreadPool(std::size_t threadCount);
+
+    /**
+     * @brief Class destructor (joins the worker threads)
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ThreadPool(ThreadPool&&) = delete;
+    ThreadPool& operator=(ThreadPool&&) = delete;
+
+    /**
+     * @brief Getter for the amount of threads running each loop
+     *
+     * @return Amount of participants (worker threads and the calling thread)
+     */
+    [[nodiscard]] std::size_t getThreadCount() const;
+
+    /**
+     * @brief Runs a loop over the [0, count) range, blocking until every index was processed
+     *
+     * Every index is processed exactly once. Participant indices are below getThreadCount(),
+     * and a participant never runs two chunks at the same time (so per-participant scratch
+     * data can be used by the task without synchronization).
+     *
+     * @param[in] count Amount of indices to process
+     * @param[in] chunkSize Maximum amount of indices processed by each task call
+     * @param[in] task Body of the loop
+     */
+    void parallelFor(std::size_t count, std::size_t chunkSize, const Task& task);
+
+private:
+    /**
+     * @brief Share of the indices of a loop owned by a participant
+     *
+     * Both bounds are packed in a single word, so that the owner (popping from the front)
+     * and thieves (popping from the back) claim indices with a single compare-and-swap
+     */
+    struct alignas(64) Share
+    {
+        /// Packed [begin, end) range of unclaimed indices (begin in the upper half)
+        std::atomic<uint64_t> range{0};
+    };
+
+    /**
+     * @brief Processes chunks of the current loop until no unclaimed indices are left
+     *
+     * @param[in] participant Index of the participant
+     */
+    void participate(std::size_t participant);
+
+    /**
+     * @brief Body of the worker threads: waits for loops and takes part in them
+     *
+     * @param[in] participant Index of the participant
+     */
+    void workerLoop(std::size_t participant);
+
+private:
+    /// Worker threads (the calling thread is participant 0)
+    std::vector<std::thread> mWorkers;
+
+    /// Share of the current loop owned by each participant
+    std::unique_ptr<Share[]> mShares;
+
+    /// Amount of participants (worker threads and the calling thread)
+    std::size_t mThreadCount{1};
+
+    /// Body and chunk size of the current loop
+    const Task* mTask{nullptr};
+    std::size_t mChunkSize{1};
+
+    /// Synchronization of the workers: a new generation is published for every loop
+    std::mutex mMutex;
+    std::condition_variable mLoopStarted;
+    std::condition_variable mLoopFinished;
+    uint64_t mGeneration{0};
+    std::size_t mBusyWorkerCount{0};
+    bool mIsStopping{false};
+};
+
+} // namespace Concurrency
@@ -0,0 +1,153 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string_view>
+
+#include "utils/Constants.hpp"
+
+/**
+ * @brief Exact (checked) integer arithmetic shared by every evaluation engine,
+ * so that all of them produce the same values and report the same errors
+ */
+namespace Arithmetic {
+
+/// Alias representing the values arithmetic expressions are evaluated with
+using Value = int64_t;
+
+/**
+ * @brief Enum representing the errors that can happen while evaluating an arithmetic expression
+ */
+enum class Error : uint8_t {
+
+    DIVISION_BY_ZERO = 0, // The divisor of a division is zero
+    INTEGER_OVERFLOW = 1  // The result of an operation does not fit in a Value
+};
+
+/**
+ * @brief Adds two values
+ *
+ * @param[in] left Left operand
+ * @param[in] right Right operand
+ * @param[out] result Sum of the operands (only meaningful if successful)
+ *
+ * @return Error of the operation (empty if successful)
+ */
+[[nodiscard]] constexpr std::optional<Error> add(const Value left, const Value right, Value& result)
+{
+    if (__builtin_add_overflow(left, right, &result)) {
+        return Error::INTEGER_OVERFLOW;
+    }
+    return {};
+}
+
+/**
+ * @brief Subtracts two values
+ *
+ * @param[in] left Left operand
+ * @param[in] right Right operand
+ * @param[out] result Difference of the operands (only meaningful if successful)
+ *
+ * @return Error of the operation (empty if successful)
+ */
+[[nodiscard]] constexpr std::optional<Error>
+      subtract(const Value left, const Value right, Value& result)
+{
+    if (__builtin_sub_overflow(left, right, &result)) {
+        return Error::INTEGER_OVERFLOW;
+    }
+    return {};
+}
+
+/**
+ * @brief Multiplies two values
+ *
+ * @param[in] left Left operand
+ * @param[in] right Right operand
+ * @param[out] result Product of the operands (only meaningful if successful)
+ *
+ * @return Error of the operation (empty if successful)
+ */
+[[nodiscard]] constexpr std::optional<Error>
+      multiply(const Value left, const Value right, Value& result)
+{
+    if (__builtin_mul_overflow(left, right, &result)) {
+        return Error::INTEGER_OVERFLOW;
+    }
+    return {};
+}
+
+/**
+ * @brief Divides two values, truncating the quotient toward zero
+ *
+ * @param[in] left Dividend
+ * @param[in] right Divisor
+ * @param[out] result Quotient of the operands (only meaningful if successful)
+ *
+ * @return Error of the operation (empty if successful)
+ */
+[[nodiscard]] constexpr std::optional<Error>
+      divide(const Value left, const Value right, Value& result)
+{
+    if (right == 0) {
+        return Error::DIVISION_BY_ZERO;
+    }
+
+    // The only quotient that does not fit: -2^63 / -1 = 2^63
+    if (right == -1 && left == std::numeric_limits<Value>::min()) {
+        return Error::INTEGER_OVERFLOW;
+    }
+
+    result = left / right;
+    return {};
+}
+
+/**
+ * @brief Performs a binary arithmetic operation
+ *
+ * @param[in] operation Binary operator character
+ * @param[in] left Left operand
+ * @param[in] right Right operand
+ * @param[out] result Result of the operation (only meaningful if successful)
+ *
+ * @return Error of the operation (empty if successful)
+ */
+[[nodiscard]] constexpr std::optional<Error>
+      apply(const char operation, const Value left, const Value right, Value& result)
+{
+    using namespace Utils::Constants;
+    switch (operation) {
+    case cAddOp:
+        return add(left, right, result);
+    case cSubOp:
+        return subtract(left, right, result);
+    case cMultOp:
+        return multiply(left, right, result);
+    case cDivOp:
+        return divide(left, right, result);
+    default:
+        result = 1;
+        return {};
+    }
+}
+
+/**
+ * @brief Describes an evaluation error
+ *
+ * @param[in] error Error to describe
+ *
+ * @return Human readable description of the error
+ */
+[[nodiscard]] constexpr std::string_view describe(const Error error)
+{
+    switch (error) {
+    case Error::DIVISION_BY_ZERO:
+        return "division by zero";
+    case Error::INTEGER_OVERFLOW:
+        return "integer overflow";
+    }
+    return "unknown error";
+}
+
+} // namespace Arithmetic
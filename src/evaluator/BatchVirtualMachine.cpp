@@ -0,0 +1,155 @@
+#include "BatchVirtualMachine.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+namespace {
+/**
+ * @brief Combines two tiles of values lane by lane, storing the result in the left one
+ *
+ * The lane count is a compile time constant and the operation reports its failure as a value,
+ * so the loop is branchless (and vectorizable whenever the operation is)
+ *
+ * Lanes that already failed keep their first error, and lanes failing now record the error
+ * of the operation (their values are then meaningless, but still well defined)
+ *
+ * @param[in,out] left Left operands (and results)
+ * @param[in] right Right operands
+ * @param[in,out] errorLanes First error of each lane (0 if the lane did not fail)
+ * @param[in] operation Binary operation to apply to every lane,
+ * returning the error code of the lane (0 if it did not fail)
+ */
+template <typename Lanes, typename ErrorLanes, typename Operation>
+void combineLanes(Lanes& left,
+                  const Lanes& right,
+                  ErrorLanes& errorLanes,
+                  const Operation operation)
+{
+    for (std::size_t lane = 0; lane < left.size(); ++lane) {
+        const auto errorCode = operation(left[lane], right[lane]);
+        errorLanes[lane] = errorLanes[lane] != 0 ? errorLanes[lane] : errorCode;
+    }
+}
+
+/**
+ * @brief Converts an arithmetic error into the error code stored in the lanes
+ *
+ * @param[in] error Error to convert
+ *
+ * @return Error code of the error
+ */
+constexpr uint8_t toErrorCode(const Arithmetic::Error error)
+{
+    return static_cast<uint8_t>(static_cast<uint8_t>(error) + 1U);
+}
+} // namespace
+
+bool BatchVirtualMachine::execute(const Bytecode::Program& program,
+                                  const OperandColumns operandColumns,
+                                  const std::span<Arithmetic::Value> results,
+                                  const std::span<std::optional<Arithmetic::Error>> errors)
+{
+    using Arithmetic::Error;
+    using Arithmetic::Value;
+    using Bytecode::OpCode;
+
+    if (program.instructions.empty()) {
+        std::cerr << "Empty program";
+        return false;
+    }
+
+    if (errors.size() != results.size()) {
+        std::cerr << "Mismatching result and error columns\n";
+        return false;
+    }
+
+    // Bind every variable slot to its column before running the program
+    mSlotColumns.resize(program.variables.size());
+
+    for (std::size_t slot = 0; slot < program.variables.size(); ++slot) {
+        const auto symbolId = program.variables[slot];
+
+        if (symbolId >= operandColumns.size() || operandColumns[symbolId].size() < results.size()) {
+            std::cerr << "Missing values for the operand with symbol id " << symbolId << "\n";
+            return false;
+        }
+
+        mSlotColumns[slot] = operandColumns[symbolId];
+    }
+
+    mValueStack.resize(program.maxStackDepth);
+    auto* const stackBottom = mValueStack.data();
+
+    for (std::size_t firstBinding = 0; firstBinding < results.size(); firstBinding += cLaneCount) {
+        // The last tile may be partial: its unused lanes are computed but never stored
+        const auto laneCount = std::min(cLaneCount, results.size() - firstBinding);
+        auto* stackTop = stackBottom; // One past the last pushed tile
+        mErrorLanes.fill(0);
+
+        for (const auto& [opCode, operand] : program.instructions) {
+            switch (opCode) {
+            case OpCode::PUSH_LITERAL:
+                stackTop->fill(operand);
+                ++stackTop;
+                break;
+            case OpCode::PUSH_CONSTANT:
+                stackTop->fill(program.constants[operand]);
+                ++stackTop;
+                break;
+            case OpCode::PUSH_VARIABLE: {
+                const auto values = mSlotColumns[operand].subspan(firstBinding, laneCount);
+                std::ranges::copy(values, stackTop->begin());
+                std::fill(stackTop->begin() + static_cast<std::ptrdiff_t>(laneCount),
+                          stackTop->end(),
+                          1);
+                ++stackTop;
+                break;
+            }
+            case OpCode::ADD:
+                --stackTop;
+                combineLanes(*(stackTop - 1), *stackTop, mErrorLanes, [](Value& l, Value r) {
+                    return static_cast<uint8_t>(
+                          __builtin_add_overflow(l, r, &l) ? toErrorCode(Error::INTEGER_OVERFLOW)
+                                                           : 0);
+                });
+                break;
+            case OpCode::SUB:
+                --stackTop;
+                combineLanes(*(stackTop - 1), *stackTop, mErrorLanes, [](Value& l, Value r) {
+                    return static_cast<uint8_t>(
+                          __builtin_sub_overflow(l, r, &l) ? toErrorCode(Error::INTEGER_OVERFLOW)
+                                                           : 0);
+                });
+                break;
+            case OpCode::MULT:
+                --stackTop;
+                combineLanes(*(stackTop - 1), *stackTop, mErrorLanes, [](Value& l, Value r) {
+                    return static_cast<uint8_t>(
+                          __builtin_mul_overflow(l, r, &l) ? toErrorCode(Error::INTEGER_OVERFLOW)
+                                                           : 0);
+                });
+                break;
+            case OpCode::DIV:
+                --stackTop;
+                combineLanes(*(stackTop - 1), *stackTop, mErrorLanes, [](Value& l, Value r) {
+                    // Failing lanes are not divided (and keep their dividend), so no lane traps
+                    Value quotient{};
+                    const auto error = Arithmetic::divide(l, r, quotient);
+                    l = error ? l : quotient;
+                    return error ? toErrorCode(*error) : uint8_t{0};
+                });
+                break;
+            }
+        }
+
+        for (std::size_t lane = 0; lane < laneCount; ++lane) {
+            const auto binding = firstBinding + lane;
+            results[binding] = (*stackBottom)[lane];
+            errors[binding] = mErrorLanes[lane] == 0
+                                    ? std::nullopt
+                                    : std::optional{static_cast<Error>(mErrorLanes[lane] - 1)};
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "bytecode/Program.hpp"
+#include "evaluator/Arithmetic.hpp"
+
+/**
+ * @brief Class responsible for executing a compiled arithmetic expression
+ * over many bindings of its variables at once
+ *
+ * Inputs and outputs are columnar: every operand is bound to a column of values
+ * (one value per binding) and the result of each binding is written to an output column.
+ * Instructions are executed over tiles of lanes (one lane per binding) rather than one value
+ * at a time, so every operator runs as a tight loop the compiler can vectorize.
+ *
+ * Results match the ones of the VirtualMachine (and the Evaluator) for every binding:
+ * values are computed with exact 64-bit integer arithmetic, and the bindings whose evaluation
+ * fails report the first error found (in evaluation order) instead of a value.
+ */
+class BatchVirtualMachine
+{
+public:
+    /// Alias representing the values of an operand (one per binding)
+    using Column = std::span<const Arithmetic::Value>;
+    /// Alias representing the columns of the operands, indexed by their symbol id
+    /// (operands without a column, or beyond the end of the span, are unknown)
+    using OperandColumns = std::span<const Column>;
+
+    /// Amount of bindings processed by each instruction
+    static constexpr std::size_t cLaneCount{256};
+
+    /**
+     * @brief Class' default constructor
+     */
+    BatchVirtualMachine() = default;
+
+    /**
+     * @brief Executes a compiled arithmetic expression over every binding of its variables
+     *
+     * @param[in] program Compiled arithmetic expression to execute
+     * @param[in] operandColumns Columns of the operands, indexed by their symbol id
+     * (the columns of the variables of the program must hold one value per result)
+     * @param[out] results Column the result of each binding is written to
+     * (the results of the bindings whose evaluation failed are unspecified)
+     * @param[out] errors Column the error of each binding is written to
+     * (empty for the bindings whose evaluation succeeded), holding one entry per result
+     *
+     * @return True if the expression was executed (false if a variable has no suitable column)
+     */
+    [[nodiscard]] bool execute(const Bytecode::Program& program,
+                               OperandColumns operandColumns,
+                               std::span<Arithmetic::Value> results,
+                               std::span<std::optional<Arithmetic::Error>> errors);
+
+private:
+    /// Alias representing the values of a tile of bindings
+    using Lanes = std::array<Arithmetic::Value, cLaneCount>;
+    /// Alias representing the errors of a tile of bindings
+    /// (0 if the lane did not fail, or 1 plus its first error otherwise)
+    using ErrorLanes = std::array<uint8_t, cLaneCount>;
+
+    /// Columns bound to the variable slots of the program being executed
+    std::vector<Column> mSlotColumns;
+
+    /// Value stack used while running the instructions (one tile per stack entry)
+    std::vector<Lanes> mValueStack;
+
+    /// First error of each binding of the tile being executed
+    ErrorLanes mErrorLanes{};
+};
@@ -1,85 +1,72 @@
 #include "Evaluator.hpp"
 
-#include "utils/Constants.hpp"
+#include <algorithm>
+#include <iostream>
 
-namespace {
-/**
- * @brief Performs an arithmetic operation
- *
- * @param[in] operation Binary operation type
- * @param[in] leftOperand Left Operand
- * @param[in] rightOperand Right Operand
- *
- * @return Operation result
- */
-constexpr auto performArithmeticOperation(const char operation,
-                                          const float leftOperand,
-                                          const float rightOperand)
-{
-    using namespace Utils::Constants;
-    switch (operation) {
-    case cAddOp:
-        return leftOperand + rightOperand;
-    case cSubOp:
-        return leftOperand - rightOperand;
-    case cMultOp:
-        return leftOperand * rightOperand;
-    case cDivOp:
-        return leftOperand / rightOperand;
-    default:
-        return 1.f;
-    }
-}
-} // namespace
-
-Evaluator::Evaluator(const std::unique_ptr<AST::Node>& astRootNode,
-                     const std::unordered_map<std::string, int>& operandLookupMap)
-    : mAstRootNode{astRootNode}
-    , mDependenciesLookupMap{operandLookupMap}
+Evaluator::Evaluator(const AST::Tree& ast, const OperandValues operandValues)
+    : mAst{ast}
+    , mOperandValues{operandValues}
 {
 }
 
 Evaluator::Result Evaluator::execute()
 {
-    if (!mAstRootNode) {
+    if (mAst.empty()) {
         std::cerr << "Empty AST";
         return {};
     }
 
-    const auto expressionValue = static_cast<int32_t>(analyseAndTraverseASTNode(mAstRootNode));
+    const auto expressionValue = analyseAndTraverseASTNode(mAst.getRootNodeIndex());
 
     if (!mDependencies.empty()) {
         return mDependencies;
     }
 
+    if (mError) {
+        return *mError;
+    }
+
     return expressionValue;
 }
 
-float Evaluator::analyseAndTraverseASTNode(const std::unique_ptr<AST::Node>& node)
+Evaluator::Value Evaluator::analyseAndTraverseASTNode(const AST::NodeIndex nodeIndex)
 {
-    const auto nodeValue = node->getNodeValue();
+    const auto& node = mAst.getNode(nodeIndex);
+    const auto nodeValue = node.getNodeValue();
 
-    if (std::isdigit(nodeValue)) {
-        return static_cast<float>(nodeValue - '0');
-    } else if (std::isalpha(nodeValue)) {
+    switch (node.getNodeType()) {
+    case AST::NodeType::LITERAL:
+        return nodeValue;
 
-        const auto nodeValueString = {nodeValue};
+    case AST::NodeType::CONSTANT:
+        return mAst.getConstantValue(node);
 
-        // If the variable exists in the lookup map, return the corresponding value
-        if (mDependenciesLookupMap.contains(nodeValueString)) {
-            return static_cast<float>(mDependenciesLookupMap.at(nodeValueString));
+    case AST::NodeType::VARIABLE:
+        // If the variable has a value, return it
+        if (nodeValue < mOperandValues.size() && mOperandValues[nodeValue]) {
+            return *mOperandValues[nodeValue];
         }
 
-        // Otherwise, add it as a dependencies
-        mDependencies.insert(nodeValueString);
+        // Otherwise, add it as a dependency
+        if (std::ranges::find(mDependencies, nodeValue) == mDependencies.cend()) {
+            mDependencies.push_back(nodeValue);
+        }
+        break;
 
-    } else {
-        const auto leftNodeValue = analyseAndTraverseASTNode(node->getReferenceToLeftNodePointer());
-        const auto rightNodeValue
-              = analyseAndTraverseASTNode(node->getReferenceToRightNodePointer());
+    case AST::NodeType::OPERATOR: {
+        const auto leftNodeValue = analyseAndTraverseASTNode(node.getLeftNodeIndex());
+        const auto rightNodeValue = analyseAndTraverseASTNode(node.getRightNodeIndex());
 
-        return performArithmeticOperation(nodeValue, leftNodeValue, rightNodeValue);
+        // Only the first error is kept, but the traversal goes on to collect every dependency
+        Value value{};
+        const auto error = Arithmetic::apply(
+              static_cast<char>(nodeValue), leftNodeValue, rightNodeValue, value);
+        if (error && !mError) {
+            mError = error;
+        }
+        return value;
+    }
     }
 
-    return 0.f;
+    return 0;
 }
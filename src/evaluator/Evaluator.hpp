@@ -1,45 +1,55 @@
 #pragma once
 
-#include <memory>
-#include <string>
+#include <optional>
+#include <span>
 #include <variant>
-#include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
-#include "ast/Node.hpp"
+#include "ast/Tree.hpp"
+#include "evaluator/Arithmetic.hpp"
+#include "symbols/SymbolTable.hpp"
 
 /**
  * @brief Class responsible for evaluating arithmetic expressions contained in an AST
  *
- * Evaluation is only performed on integers
+ * Evaluation is exactly performed on 64-bit integers (divisions truncate toward zero),
+ * and divisions by zero and overflows are reported instead of producing a value
  */
 class Evaluator
 {
 public:
     /// Alias representing a set of operands that are dependencies of an expression
-    using Dependencies = std::unordered_set<std::string>;
-    /// Alias representing the result of the evaluation: an value or a set of dependencies
-    using Result = std::variant<int, Dependencies>;
+    /// (unique symbol ids, in order of appearance)
+    using Dependencies = std::vector<Symbols::SymbolId>;
+    /// Alias representing the value of an expression
+    using Value = Arithmetic::Value;
+    /// Alias representing an error that prevented an expression from having a value
+    using Error = Arithmetic::Error;
+    /// Alias representing the result of the evaluation: a value, a set of dependencies or an error
+    using Result = std::variant<Value, Dependencies, Error>;
+    /// Alias representing the current values of the operands, indexed by their symbol id
+    /// (operands without a value, or beyond the end of the span, are unknown)
+    using OperandValues = std::span<const std::optional<Value>>;
 
     /**
      * @brief Class constructor
      *
-     * @param[in] astRootNode Reference to the root node of an (AST)
-     * @param[in] dependenciesLookupMap Map of operand names to their corresponding integer values
+     * @param[in] ast Reference to an AST
+     * @param[in] operandValues Values of the operands, indexed by their symbol id
      */
-    explicit Evaluator(const std::unique_ptr<AST::Node>& astRootNode,
-                       const std::unordered_map<std::string, int>& dependenciesLookupMap);
+    explicit Evaluator(const AST::Tree& ast, OperandValues operandValues);
 
     /**
      * @brief Evaluates an AST holding an arithmetic expression and outputs a result
      *
      * During the evaluation, if dependencies are detected within the AST,
-     * the provided dependencies map is used for value lookup
+     * the provided operand values are used for value lookup
      *
      * If the evaluation is successful, the result will be the value o the expression
      *
      * However, if there are unresolved dependencies (variables) in the expression,
-     * the result will be those dependencies
+     * the result will be those dependencies, and otherwise, if an operation failed,
+     * the result will be the first error found (in evaluation order)
      *
      * @return Result of the arithmetic expression
      */
@@ -49,21 +59,24 @@ private:
     /**
      * @brief Helper method used to recursively traverse the AST and evaluate each node's content
      *
-     * @param[in] node Reference to an AST node to analyse
+     * @param[in] nodeIndex Index of the AST node to analyse
      *
-     * @return Final value of the node
+     * @return Final value of the node (meaningless if an error or dependency was found)
      */
-    [[nodiscard]] float analyseAndTraverseASTNode(const std::unique_ptr<AST::Node>& node);
+    [[nodiscard]] Value analyseAndTraverseASTNode(AST::NodeIndex nodeIndex);
 
 private:
-    /// Reference to the AST root node
-    const std::unique_ptr<AST::Node>& mAstRootNode;
+    /// Reference to the AST to evaluate
+    const AST::Tree& mAst;
 
-    /// Map used to lookup the value of specific operands
-    ///( used to resolve dependencies when analysing an AST)
-    const std::unordered_map<std::string, int>& mDependenciesLookupMap;
+    /// Values used to lookup the value of specific operands
+    /// (used to resolve dependencies when analysing an AST)
+    OperandValues mOperandValues;
 
     /// Set of dependencies encountered during AST evaluation
-    /// (operands not found on the dependencies lookup map)
+    /// (operands without a value)
     Dependencies mDependencies;
+
+    /// First error encountered during AST evaluation
+    std::optional<Error> mError;
 };
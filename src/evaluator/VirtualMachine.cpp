@@ -0,0 +1,76 @@
+#include "VirtualMachine.hpp"
+
+#include <iostream>
+
+Evaluator::Result VirtualMachine::execute(const Bytecode::Program& program,
+                                          const Evaluator::OperandValues operandValues)
+{
+    using Bytecode::OpCode;
+
+    if (program.instructions.empty()) {
+        std::cerr << "Empty program";
+        return {};
+    }
+
+    // Resolve every variable slot before running the program
+    Evaluator::Dependencies dependencies;
+    mSlotValues.resize(program.variables.size());
+
+    for (std::size_t slot = 0; slot < program.variables.size(); ++slot) {
+        const auto symbolId = program.variables[slot];
+
+        if (symbolId < operandValues.size() && operandValues[symbolId]) {
+            mSlotValues[slot] = *operandValues[symbolId];
+        } else {
+            dependencies.push_back(symbolId);
+        }
+    }
+
+    if (!dependencies.empty()) {
+        return dependencies;
+    }
+
+    mValueStack.resize(program.maxStackDepth);
+    auto* const stackBottom = mValueStack.data();
+    auto* stackTop = stackBottom; // One past the last pushed value
+
+    std::optional<Evaluator::Error> error;
+
+    for (const auto& [opCode, operand] : program.instructions) {
+        switch (opCode) {
+        case OpCode::PUSH_LITERAL:
+            *stackTop++ = operand;
+            break;
+        case OpCode::PUSH_CONSTANT:
+            *stackTop++ = program.constants[operand];
+            break;
+        case OpCode::PUSH_VARIABLE:
+            *stackTop++ = mSlotValues[operand];
+            break;
+        case OpCode::ADD:
+            --stackTop;
+            error = Arithmetic::add(*(stackTop - 1), *stackTop, *(stackTop - 1));
+            break;
+        case OpCode::SUB:
+            --stackTop;
+            error = Arithmetic::subtract(*(stackTop - 1), *stackTop, *(stackTop - 1));
+            break;
+        case OpCode::MULT:
+            --stackTop;
+            error = Arithmetic::multiply(*(stackTop - 1), *stackTop, *(stackTop - 1));
+            break;
+        case OpCode::DIV:
+            --stackTop;
+            error = Arithmetic::divide(*(stackTop - 1), *stackTop, *(stackTop - 1));
+            break;
+        }
+
+        // Postfix order matches the evaluation order of the Evaluator,
+        // so the first failing operation is the one it reports as well
+        if (error) {
+            return *error;
+        }
+    }
+
+    return *stackBottom;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+
+#include "bytecode/Program.hpp"
+#include "evaluator/Evaluator.hpp"
+
+/**
+ * @brief Class responsible for executing compiled arithmetic expressions
+ *
+ * Produces the same results as the Evaluator, but runs over a postfix instruction stream
+ * instead of walking an AST. Internal buffers are kept between executions,
+ * so a long-lived instance does not allocate once it has warmed up.
+ */
+class VirtualMachine
+{
+public:
+    /**
+     * @brief Class' default constructor
+     */
+    VirtualMachine() = default;
+
+    /**
+     * @brief Executes a compiled arithmetic expression and outputs a result
+     *
+     * Every variable slot of the program is resolved (once) through the provided operand values
+     * before running the instructions
+     *
+     * If every variable is available, the result will be the value of the expression
+     *
+     * However, if there are unresolved dependencies (variables) in the expression,
+     * the result will be those dependencies, and otherwise, if an operation fails,
+     * the execution stops and the result will be its error
+     *
+     * @param[in] program Compiled arithmetic expression to execute
+     * @param[in] operandValues Values of the operands, indexed by their symbol id
+     *
+     * @return Result of the arithmetic expression
+     */
+    [[nodiscard]] Evaluator::Result execute(const Bytecode::Program& program,
+                                            Evaluator::OperandValues operandValues);
+
+private:
+    /// Values of the variable slots of the program being executed
+    std::vector<Evaluator::Value> mSlotValues;
+
+    /// Value stack used while running the instructions
+    std::vector<Evaluator::Value> mValueStack;
+};
@@ -0,0 +1,247 @@
+#include "ReferenceModel.hpp"
+
+#include <algorithm>
+#include <deque>
+
+namespace Generator {
+
+std::string Definition::toInstruction() const
+{
+    const auto literalString = std::to_string(literal);
+
+    switch (form) {
+    case ExpressionForm::LITERAL:
+        return operand + " = " + literalString;
+    case ExpressionForm::INCREMENT:
+        return operand + " = " + inputs[0] + " + " + literalString;
+    case ExpressionForm::SCALE:
+        return operand + " = " + inputs[0] + " * " + literalString;
+    case ExpressionForm::AVERAGE:
+        return operand + " = (" + inputs[0] + " + " + inputs[1] + ") / 2";
+    case ExpressionForm::AVERAGE_INCREMENT:
+        return operand + " = (" + inputs[0] + " + " + inputs[1] + ") / 2 + " + literalString;
+    }
+
+    return {};
+}
+
+std::size_t Definition::getInputCount() const
+{
+    switch (form) {
+    case ExpressionForm::LITERAL:
+        return 0;
+    case ExpressionForm::INCREMENT:
+    case ExpressionForm::SCALE:
+        return 1;
+    case ExpressionForm::AVERAGE:
+    case ExpressionForm::AVERAGE_INCREMENT:
+        return 2;
+    }
+
+    return 0;
+}
+
+std::vector<std::string> ReferenceModel::define(const Definition& definition)
+{
+    std::vector<std::string> results;
+
+    if (const auto value = evaluate(definition)) {
+        mValues.insert_or_assign(definition.operand, *value);
+        results.push_back(definition.operand + " = " + std::to_string(*value));
+        propagate(definition.operand, results);
+
+        registerOperation(definition.operand);
+        return results;
+    }
+
+    // Only the inputs without a value become dependencies
+    std::vector<std::string> dependencies;
+    for (std::size_t index = 0; index < definition.getInputCount(); ++index) {
+        const auto& input = definition.inputs[index];
+        if (!mValues.contains(input)
+            && std::ranges::find(dependencies, input) == dependencies.end()) {
+            dependencies.push_back(input);
+        }
+    }
+
+    // Definitions closing a cycle (their operand reaches one of their dependencies) are rejected
+    {
+        std::set<std::string> reachableOperands{definition.operand};
+        std::deque<std::string> operandsToVisit{definition.operand};
+        while (!operandsToVisit.empty()) {
+            const auto dependantsItr = mDependants.find(operandsToVisit.front());
+            operandsToVisit.pop_front();
+            if (dependantsItr == mDependants.end()) {
+                continue;
+            }
+
+            for (const auto& dependant : dependantsItr->second) {
+                if (reachableOperands.insert(dependant).second) {
+                    operandsToVisit.push_back(dependant);
+                }
+            }
+        }
+
+        for (const auto& dependency : dependencies) {
+            if (reachableOperands.contains(dependency)) {
+                return results;
+            }
+        }
+    }
+
+    mPendingDefinitions.insert_or_assign(definition.operand, definition);
+    for (const auto& dependency : dependencies) {
+        mDependants[dependency].insert(definition.operand);
+    }
+
+    registerOperation(definition.operand);
+    return results;
+}
+
+std::vector<std::string> ReferenceModel::undo(const int undoCount)
+{
+    std::vector<std::string> results;
+
+    if (undoCount <= 0 || static_cast<std::size_t>(undoCount) > mOperations.size()) {
+        return results;
+    }
+
+    for (int undoneCount = 0; undoneCount < undoCount; ++undoneCount) {
+        results.push_back("delete " + mOperations.back().operand);
+        mOperations.pop_back();
+    }
+
+    // Restore the state left by the last remaining operation (or the initial one)
+    if (mOperations.empty()) {
+        mValues.clear();
+        mPendingDefinitions.clear();
+        mDependants.clear();
+    } else {
+        mValues = mOperations.back().values;
+        mPendingDefinitions = mOperations.back().pendingDefinitions;
+        mDependants = mOperations.back().dependants;
+    }
+
+    return results;
+}
+
+std::vector<std::string> ReferenceModel::result() const
+{
+    for (auto itr = mOperations.crbegin(); itr != mOperations.crend(); ++itr) {
+        if (const auto valueItr = mValues.find(itr->operand); valueItr != mValues.end()) {
+            return {"return " + itr->operand + " = " + std::to_string(valueItr->second)};
+        }
+    }
+
+    return {};
+}
+
+std::size_t ReferenceModel::getOperationCount() const
+{
+    return mOperations.size();
+}
+
+const std::map<std::string, int64_t>& ReferenceModel::getValues() const
+{
+    return mValues;
+}
+
+std::optional<int64_t> ReferenceModel::evaluate(const Definition& definition) const
+{
+    std::array<int64_t, 2> inputValues{};
+    for (std::size_t index = 0; index < definition.getInputCount(); ++index) {
+        const auto valueItr = mValues.find(definition.inputs[index]);
+        if (valueItr == mValues.end()) {
+            return {};
+        }
+        inputValues[index] = valueItr->second;
+    }
+
+    const int64_t literal{definition.literal};
+    int64_t value{};
+
+    switch (definition.form) {
+    case ExpressionForm::LITERAL:
+        value = literal;
+        break;
+    case ExpressionForm::INCREMENT:
+        value = inputValues[0] + literal;
+        break;
+    case ExpressionForm::SCALE:
+        value = inputValues[0] * literal;
+        break;
+    case ExpressionForm::AVERAGE:
+        value = (inputValues[0] + inputValues[1]) / 2;
+        break;
+    case ExpressionForm::AVERAGE_INCREMENT:
+        value = (inputValues[0] + inputValues[1]) / 2 + literal;
+        break;
+    }
+
+    return value;
+}
+
+void ReferenceModel::propagate(const std::string& source, std::vector<std::string>& results)
+{
+    // Helper lambda used to check if an operand is affected by the update
+    const auto isAffected = [&](const std::string& operand) {
+        return operand != source && mPendingDefinitions.contains(operand);
+    };
+
+    // Count, for every affected operand, how many of its registered inputs are affected as well
+    std::map<std::string, std::size_t> pendingInputCounts;
+    {
+        std::deque<std::string> operandsToVisit{source};
+        while (!operandsToVisit.empty()) {
+            const auto operand = operandsToVisit.front();
+            operandsToVisit.pop_front();
+
+            for (const auto& dependant : mDependants[operand]) {
+                if (isAffected(dependant) && pendingInputCounts[dependant]++ == 0) {
+                    operandsToVisit.push_back(dependant);
+                }
+            }
+        }
+    }
+
+    // Evaluate the affected operands in topological order
+    // (operands involved in cycles are never evaluated)
+    std::set<std::string> operandsWithUpdatedInputs;
+    std::deque<std::pair<std::string, bool>> processedOperands{{source, true}};
+
+    while (!processedOperands.empty()) {
+        const auto [operand, wasUpdated] = processedOperands.front();
+        processedOperands.pop_front();
+
+        for (const auto& dependant : mDependants[operand]) {
+            if (!isAffected(dependant)) {
+                continue;
+            }
+
+            if (wasUpdated) {
+                operandsWithUpdatedInputs.insert(dependant);
+            }
+
+            if (--pendingInputCounts[dependant] == 0) {
+                bool isUpdated{false};
+
+                if (operandsWithUpdatedInputs.contains(dependant)) {
+                    if (const auto value = evaluate(mPendingDefinitions.at(dependant))) {
+                        mValues.insert_or_assign(dependant, *value);
+                        results.push_back(dependant + " = " + std::to_string(*value));
+                        isUpdated = true;
+                    }
+                }
+
+                processedOperands.emplace_back(dependant, isUpdated);
+            }
+        }
+    }
+}
+
+void ReferenceModel::registerOperation(const std::string& operand)
+{
+    mOperations.push_back({operand, mValues, mPendingDefinitions, mDependants});
+}
+
+} // namespace Generator
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace Generator {
+
+/**
+ * @brief Enum representing the shapes of the arithmetic expressions emitted by the generator
+ */
+enum class ExpressionForm : uint8_t {
+
+    LITERAL = 0,          // x = k
+    INCREMENT = 1,        // x = p + k
+    SCALE = 2,            // x = p * k
+    AVERAGE = 3,          // x = (p + q) / 2
+    AVERAGE_INCREMENT = 4 // x = (p + q) / 2 + k
+};
+
+/**
+ * @brief Definition of an operand through an arithmetic expression
+ */
+struct Definition
+{
+    /// Operand being defined (LHS)
+    std::string operand;
+    /// Shape of the RHS
+    ExpressionForm form{ExpressionForm::LITERAL};
+    /// Operands used by the RHS (only the ones required by the form are meaningful)
+    std::array<std::string, 2> inputs;
+    /// Single digit literal used by the RHS (if required by the form)
+    int literal{0};
+
+    /**
+     * @brief Renders the definition as a calculator instruction
+     *
+     * @return Arithmetic expression (e.g. "x = (p + q) / 2")
+     */
+    [[nodiscard]] std::string toInstruction() const;
+
+    /**
+     * @brief Getter for the amount of inputs used by the RHS
+     *
+     * @return Number of meaningful entries of inputs
+     */
+    [[nodiscard]] std::size_t getInputCount() const;
+};
+
+/**
+ * @brief Straightforward (ordered maps and strings) model of the calculator semantics,
+ * used to compute the expected results of generated workloads
+ *
+ * It is deliberately independent of the calculator implementation:
+ * - operands whose inputs all have values are resolved on definition;
+ * - otherwise their expression is kept pending, registering them as dependants of the
+ *   inputs that had no value (dependants are only unregistered by undoing operations);
+ * - every value update re-evaluates, in topological order, the pending expressions
+ *   (transitively) depending on the updated operand whose inputs were updated;
+ * - undoing operations restores the whole state that preceded them
+ *   (values, pending expressions and dependants).
+ */
+class ReferenceModel
+{
+public:
+    /**
+     * @brief Processes the definition of an operand
+     *
+     * @param[in] definition Definition to process
+     *
+     * @return Expected results of the instruction
+     */
+    std::vector<std::string> define(const Definition& definition);
+
+    /**
+     * @brief Processes an undo command
+     *
+     * @param[in] undoCount Number of operations to undo
+     *
+     * @return Expected results of the instruction
+     */
+    std::vector<std::string> undo(int undoCount);
+
+    /**
+     * @brief Processes a result command
+     *
+     * @return Expected results of the instruction
+     */
+    [[nodiscard]] std::vector<std::string> result() const;
+
+    /**
+     * @brief Getter for the amount of operations that can currently be undone
+     *
+     * @return Number of registered operations
+     */
+    [[nodiscard]] std::size_t getOperationCount() const;
+
+    /**
+     * @brief Getter for the current operand values
+     *
+     * @return Reference to the values, indexed by operand name
+     */
+    [[nodiscard]] const std::map<std::string, int64_t>& getValues() const;
+
+private:
+    /**
+     * @brief Evaluates the RHS of a definition (with the same 64-bit integer arithmetic as the
+     * calculator, which cannot fail for the generated forms and literals)
+     *
+     * @param[in] definition Definition to evaluate
+     *
+     * @return Value of the RHS (empty if some of its inputs have no value)
+     */
+    [[nodiscard]] std::optional<int64_t> evaluate(const Definition& definition) const;
+
+    /**
+     * @brief Re-evaluates the pending expressions affected by the update of an operand
+     *
+     * @param[in] source Updated operand
+     * @param[in,out] results Results to append the updated operands to
+     */
+    void propagate(const std::string& source, std::vector<std::string>& results);
+
+    /**
+     * @brief Registers an operation, recording the state it left
+     *
+     * @param[in] operand Operand set by the operation
+     */
+    void registerOperation(const std::string& operand);
+
+private:
+    /**
+     * @brief Entry of the operation history
+     */
+    struct Operation
+    {
+        /// Operand set by the operation
+        std::string operand;
+        /// Operand values right after the operation
+        std::map<std::string, int64_t> values;
+        /// Pending expressions right after the operation
+        std::map<std::string, Definition> pendingDefinitions;
+        /// Dependants right after the operation
+        std::map<std::string, std::set<std::string>> dependants;
+    };
+
+private:
+    /// Current value of each operand
+    std::map<std::string, int64_t> mValues;
+
+    /// Pending expression of each operand (kept until the operand is undone)
+    std::map<std::string, Definition> mPendingDefinitions;
+
+    /// Operands whose pending expressions were registered as dependants of each operand
+    std::map<std::string, std::set<std::string>> mDependants;
+
+    /// Registered operations, alongside a full copy of the state they left (most recent last)
+    std::vector<Operation> mOperations;
+};
+
+} // namespace Generator
@@ -0,0 +1,221 @@
+#include "WorkloadGenerator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <utility>
+
+namespace {
+/// Amount of letters the operand names start with
+constexpr std::size_t cLetterCount{26};
+
+/// Names of the supported workload shapes
+constexpr std::array<std::pair<std::string_view, Generator::WorkloadShape>, 5> cShapeNames{{
+      {"chain", Generator::WorkloadShape::CHAIN},
+      {"fan-out", Generator::WorkloadShape::FAN_OUT},
+      {"diamond", Generator::WorkloadShape::DIAMOND},
+      {"random-dag", Generator::WorkloadShape::RANDOM_DAG},
+      {"mixed", Generator::WorkloadShape::MIXED},
+}};
+
+/**
+ * @brief Generates the name of the operand with a given index
+ *
+ * The first operands are named after a single letter, while the following ones
+ * are suffixed with the amount of times the letters wrapped around (e.g. "a", ..., "z", "a1")
+ *
+ * @param[in] index Index of the operand
+ *
+ * @return Operand name
+ */
+std::string operandName(const std::size_t index)
+{
+    std::string name(1, static_cast<char>('a' + index % cLetterCount));
+    if (index >= cLetterCount) {
+        name += std::to_string(index / cLetterCount);
+    }
+
+    return name;
+}
+} // namespace
+
+namespace Generator {
+
+std::optional<WorkloadShape> parseWorkloadShape(const std::string_view shapeName)
+{
+    for (const auto& [name, shape] : cShapeNames) {
+        if (name == shapeName) {
+            return shape;
+        }
+    }
+
+    return {};
+}
+
+std::string formatCanonicalResults(std::vector<std::string> results)
+{
+    if (results.size() > 2) {
+        std::sort(std::next(results.begin()), results.end());
+    }
+
+    std::string formattedResults;
+    for (const auto& result : results) {
+        if (!formattedResults.empty()) {
+            formattedResults += ", ";
+        }
+        formattedResults += result;
+    }
+
+    return formattedResults;
+}
+
+WorkloadGenerator::WorkloadGenerator(const WorkloadParameters& parameters)
+    : mParameters{parameters}
+    , mRandomEngine{parameters.seed}
+{
+}
+
+bool WorkloadGenerator::execute(std::ostream& instructions, std::ostream& expectedResults)
+{
+    if (mParameters.operandCount < 2) {
+        std::cerr << "The operand count must be at least 2\n";
+        return false;
+    }
+
+    mInstructions = &instructions;
+    mExpectedResults = &expectedResults;
+
+    while (mEmittedInstructionCount < mParameters.instructionCount) {
+
+        for (const auto& definition : createRoundDefinitions()) {
+            emit(definition.toInstruction(), mReferenceModel.define(definition));
+
+            if (chance(mParameters.undoPercentage)) {
+                const auto undoCount
+                      = std::min(1 + random(3), mReferenceModel.getOperationCount());
+                emit("undo " + std::to_string(undoCount),
+                     mReferenceModel.undo(static_cast<int>(undoCount)));
+            }
+        }
+
+        // Tear the dependency graph down, so that the next round starts from scratch
+        if (const auto operationCount = mReferenceModel.getOperationCount(); operationCount > 0) {
+            emit("undo " + std::to_string(operationCount),
+                 mReferenceModel.undo(static_cast<int>(operationCount)));
+        }
+    }
+
+    return true;
+}
+
+void WorkloadGenerator::writeExpectedState(std::ostream& expectedState) const
+{
+    const auto& values = mReferenceModel.getValues();
+
+    for (std::size_t index = 0; index < mParameters.operandCount; ++index) {
+        const auto operand = operandName(index);
+
+        if (const auto valueItr = values.find(operand); valueItr != values.end()) {
+            expectedState << operand << " = " << valueItr->second << "\n";
+        } else {
+            expectedState << operand << " = undefined\n";
+        }
+    }
+}
+
+std::vector<Definition> WorkloadGenerator::createRoundDefinitions()
+{
+    const auto operandCount = mParameters.operandCount;
+    const auto literal = [this] { return static_cast<int>(1 + random(9)); };
+
+    auto shape = mParameters.shape;
+    if (shape == WorkloadShape::MIXED) {
+        shape = static_cast<WorkloadShape>(random(static_cast<std::size_t>(WorkloadShape::MIXED)));
+    }
+
+    // Every operand only depends on operands with a lower index
+    // (so no cycles are ever created, even across rounds)
+    std::vector<Definition> definitions;
+    definitions.push_back({operandName(0), ExpressionForm::LITERAL, {}, literal()});
+
+    for (std::size_t index = 1; index < operandCount; ++index) {
+        Definition definition{operandName(index), ExpressionForm::LITERAL, {}, literal()};
+
+        switch (shape) {
+        case WorkloadShape::CHAIN:
+            definition.form = ExpressionForm::INCREMENT;
+            definition.inputs[0] = operandName(index - 1);
+            break;
+        case WorkloadShape::FAN_OUT:
+            definition.form = ExpressionForm::SCALE;
+            definition.inputs[0] = operandName(0);
+            break;
+        case WorkloadShape::DIAMOND: {
+            // Operands 3i+1 and 3i+2 depend on the tip 3i, while 3i+3 depends on both of them
+            const auto tipIndex = (index - 1) / 3 * 3;
+            if (index % 3 == 0) {
+                definition.form = ExpressionForm::AVERAGE;
+                definition.inputs = {operandName(index - 2), operandName(index - 1)};
+            } else {
+                definition.form = ExpressionForm::INCREMENT;
+                definition.inputs[0] = operandName(tipIndex);
+            }
+            break;
+        }
+        case WorkloadShape::RANDOM_DAG:
+            if (random(2) == 0) {
+                definition.form = ExpressionForm::INCREMENT;
+                definition.inputs[0] = operandName(random(index));
+            } else {
+                definition.form = ExpressionForm::AVERAGE_INCREMENT;
+                definition.inputs = {operandName(random(index)), operandName(random(index))};
+            }
+            break;
+        case WorkloadShape::MIXED:
+            break;
+        }
+
+        definitions.push_back(std::move(definition));
+    }
+
+    // Dependants are defined before their inputs, leaving their expressions pending
+    // until the root of the graph (defined last) resolves all of them in a single cascade
+    std::reverse(definitions.begin(), definitions.end());
+
+    return definitions;
+}
+
+void WorkloadGenerator::emit(const std::string& instruction, std::vector<std::string> results)
+{
+    if (mEmittedInstructionCount >= mParameters.instructionCount) {
+        return;
+    }
+
+    *mInstructions << instruction << "\n";
+    *mExpectedResults << formatCanonicalResults(std::move(results)) << "\n";
+    ++mEmittedInstructionCount;
+
+    // Results are only polled when available (the calculator just reports their absence)
+    if (mEmittedInstructionCount < mParameters.instructionCount
+        && chance(mParameters.resultPercentage)) {
+        if (auto lastResult = mReferenceModel.result(); !lastResult.empty()) {
+            *mInstructions << "result\n";
+            *mExpectedResults << formatCanonicalResults(std::move(lastResult)) << "\n";
+            ++mEmittedInstructionCount;
+        }
+    }
+}
+
+std::size_t WorkloadGenerator::random(const std::size_t upperBound)
+{
+    // The modulo (rather than a standard distribution) keeps the workloads identical
+    // across standard library implementations
+    return static_cast<std::size_t>(mRandomEngine() % upperBound);
+}
+
+bool WorkloadGenerator::chance(const uint32_t percentage)
+{
+    return percentage > 0 && random(100) < percentage;
+}
+
+} // namespace Generator
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <ostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ReferenceModel.hpp"
+
+namespace Generator {
+
+/**
+ * @brief Enum representing the shapes of the dependency graphs built by a workload
+ */
+enum class WorkloadShape : uint8_t {
+
+    CHAIN = 0,      // o1 = o0 + k, o2 = o1 + k, ...
+    FAN_OUT = 1,    // every operand depends on o0
+    DIAMOND = 2,    // chain of diamonds (two operands depending on the previous diamond tip)
+    RANDOM_DAG = 3, // every operand depends on one or two random operands with a lower index
+    MIXED = 4       // a random shape (out of the above) for every round
+};
+
+/**
+ * @brief Parameters controlling the generation of a workload
+ */
+struct WorkloadParameters
+{
+    /// Shape of the dependency graphs
+    WorkloadShape shape{WorkloadShape::MIXED};
+    /// Seed of the pseudo-random number generator (same seed, same workload)
+    uint64_t seed{0};
+    /// Amount of instructions to generate
+    std::size_t instructionCount{1000};
+    /// Amount of operands of each dependency graph (at least 2)
+    std::size_t operandCount{26};
+    /// Chance (percentage) of undoing the last few operations after each definition
+    uint32_t undoPercentage{0};
+    /// Chance (percentage) of polling for the last result after each instruction
+    uint32_t resultPercentage{0};
+};
+
+/**
+ * @brief Parses the name of a workload shape
+ *
+ * @param[in] shapeName Name of the shape (e.g. "random-dag")
+ *
+ * @return Workload shape (empty if the name is unknown)
+ */
+[[nodiscard]] std::optional<WorkloadShape> parseWorkloadShape(std::string_view shapeName);
+
+/**
+ * @brief Formats the results of an instruction in a canonical way
+ *
+ * The first result (the operand set by the instruction itself) is kept in place,
+ * while the (propagated) remaining ones are sorted, since their order is not part of
+ * the calculator contract
+ *
+ * @param[in] results Results of an instruction
+ *
+ * @return Comma separated results
+ */
+[[nodiscard]] std::string formatCanonicalResults(std::vector<std::string> results);
+
+/**
+ * @brief Class responsible for generating synthetic instruction streams with controlled shapes,
+ * alongside their expected results and final state
+ *
+ * Workloads are made of rounds: every round defines the operands of a dependency graph
+ * (dependants before their inputs, so their expressions are left pending),
+ * then resolves the whole graph by defining its root and finally undoes all of its operations.
+ */
+class WorkloadGenerator
+{
+public:
+    /**
+     * @brief Class constructor
+     *
+     * @param[in] parameters Parameters controlling the generation of the workload
+     */
+    explicit WorkloadGenerator(const WorkloadParameters& parameters);
+
+    /**
+     * @brief Generates the workload
+     *
+     * @param[out] instructions Stream to write the instructions to (one per line)
+     * @param[out] expectedResults Stream to write the canonical results of each instruction to
+     * (one line per instruction, empty if the instruction has no results)
+     *
+     * @return True if the workload was generated (false if the parameters are invalid)
+     */
+    [[nodiscard]] bool execute(std::ostream& instructions, std::ostream& expectedResults);
+
+    /**
+     * @brief Writes the expected final state of the calculator
+     * (one line per operand: "x = <value>" or "x = undefined")
+     *
+     * @param[out] expectedState Stream to write the final state to
+     */
+    void writeExpectedState(std::ostream& expectedState) const;
+
+private:
+    /**
+     * @brief Generates the definitions of the next round
+     * (ordered so that dependants are defined before their inputs)
+     *
+     * @return Definitions of the round
+     */
+    [[nodiscard]] std::vector<Definition> createRoundDefinitions();
+
+    /**
+     * @brief Emits an instruction and its expected results
+     *
+     * @param[in] instruction Instruction to emit
+     * @param[in] results Expected results of the instruction
+     */
+    void emit(const std::string& instruction, std::vector<std::string> results);
+
+    /**
+     * @brief Generates a pseudo-random number
+     *
+     * @param[in] upperBound Exclusive upper bound of the number
+     *
+     * @return Number in the [0, upperBound) range
+     */
+    [[nodiscard]] std::size_t random(std::size_t upperBound);
+
+    /**
+     * @brief Draws whether an event with the given chance happens
+     *
+     * @param[in] percentage Chance of the event
+     *
+     * @return True if the event happens
+     */
+    [[nodiscard]] bool chance(uint32_t percentage);
+
+private:
+    /// Parameters controlling the generation of the workload
+    WorkloadParameters mParameters;
+
+    /// Pseudo-random number generator
+    std::mt19937_64 mRandomEngine;
+
+    /// Model computing the expected results of the instructions
+    ReferenceModel mReferenceModel;
+
+    /// Amount of instructions emitted so far
+    std::size_t mEmittedInstructionCount{0};
+
+    /// Streams the instructions and their expected results are written to
+    std::ostream* mInstructions{nullptr};
+    std::ostream* mExpectedResults{nullptr};
+};
+
+} // namespace Generator
@@ -0,0 +1,124 @@
+#include "WorkloadVerifier.hpp"
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "WorkloadGenerator.hpp"
+#include "calculator/Runner.hpp"
+#include "utils/Constants.hpp"
+
+namespace {
+/// Maximum amount of mismatches reported to the error stream
+constexpr std::size_t cMaxReportedMismatches{10};
+
+/// Placeholder used by the expected state for operands without a value
+constexpr std::string_view cUndefinedValue{"undefined"};
+
+/// Separator of the results of an instruction, once formatted
+constexpr std::string_view cResultSeparator{", "};
+
+/**
+ * @brief Extracts the next line of a text
+ *
+ * @param[in,out] text Text to extract the line from (the line and its terminator are consumed)
+ *
+ * @return View of the line (without its terminator)
+ */
+std::string_view nextLine(std::string_view& text)
+{
+    const auto lineEnd = text.find('\n');
+    auto line = text.substr(0, lineEnd);
+    text.remove_prefix(lineEnd == std::string_view::npos ? text.size() : lineEnd + 1);
+
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+
+    return line;
+}
+} // namespace
+
+namespace Generator {
+
+WorkloadVerifier::WorkloadVerifier(const std::string_view instructions,
+                                   const std::string_view expectedResults,
+                                   const std::string_view expectedState,
+                                   const Calculator::State::EvaluationMode evaluationMode)
+    : mInstructions{instructions}
+    , mExpectedResults{expectedResults}
+    , mExpectedState{expectedState}
+    , mEvaluationMode{evaluationMode}
+{
+}
+
+WorkloadVerifier::Report WorkloadVerifier::execute() const
+{
+    Report report;
+    Calculator::Runner runner;
+    runner.setEvaluationMode(mEvaluationMode);
+
+    const auto reportMismatch = [&report](const std::string_view what,
+                                          const std::string_view expected,
+                                          const std::string_view actual) {
+        if (report.mismatchedInstructionCount + report.mismatchedOperandCount
+            < cMaxReportedMismatches) {
+            std::cerr << "Mismatch on " << what << "\n  expected: " << expected
+                      << "\n  actual:   " << actual << "\n";
+        }
+    };
+
+    auto instructions = mInstructions;
+    auto expectedResults = mExpectedResults;
+
+    while (!instructions.empty()) {
+        const auto instruction = nextLine(instructions);
+        auto expected = nextLine(expectedResults);
+
+        // Lazy assignments do not output the values of their dependants
+        // (the assigned operand always comes first)
+        if (mEvaluationMode == Calculator::State::EvaluationMode::LAZY
+            && instruction.find(Utils::Constants::cAssignOp) != std::string_view::npos) {
+            expected = expected.substr(0, expected.find(cResultSeparator));
+        }
+
+        // Only the calculator itself is timed
+        const auto startTime = std::chrono::steady_clock::now();
+        auto results = runner.processInstruction(instruction);
+        report.wallTime += std::chrono::steady_clock::now() - startTime;
+        ++report.instructionCount;
+
+        if (const auto actual = formatCanonicalResults(std::move(results)); actual != expected) {
+            reportMismatch("instruction " + std::to_string(report.instructionCount) + " ("
+                                 + std::string(instruction) + ")",
+                           expected,
+                           actual);
+            ++report.mismatchedInstructionCount;
+        }
+    }
+
+    auto expectedState = mExpectedState;
+
+    while (!expectedState.empty()) {
+        const auto line = nextLine(expectedState);
+        const auto separatorPosition = line.find(" = ");
+        if (separatorPosition == std::string_view::npos) {
+            continue;
+        }
+
+        const auto operand = line.substr(0, separatorPosition);
+        const auto expectedValue = line.substr(separatorPosition + 3);
+        const auto value = runner.getOperandValue(operand);
+        const auto actualValue = value.has_value() ? std::to_string(*value)
+                                                   : std::string(cUndefinedValue);
+
+        if (actualValue != expectedValue) {
+            reportMismatch("final value of " + std::string(operand), expectedValue, actualValue);
+            ++report.mismatchedOperandCount;
+        }
+    }
+
+    return report;
+}
+
+} // namespace Generator
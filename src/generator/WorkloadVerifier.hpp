@@ -0,0 +1,95 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <string_view>
+
+#include "calculator/State.hpp"
+
+namespace Generator {
+
+/**
+ * @brief Class responsible for replaying a generated workload through the calculator
+ * and checking its results against the expected ones
+ */
+class WorkloadVerifier
+{
+public:
+    /**
+     * @brief Summary of a verification
+     */
+    struct Report
+    {
+        /// Amount of processed instructions
+        std::size_t instructionCount{};
+        /// Amount of instructions whose results differ from the expected ones
+        std::size_t mismatchedInstructionCount{};
+        /// Amount of operands whose final value differs from the expected one
+        std::size_t mismatchedOperandCount{};
+        /// Time spent processing the instructions (verification excluded)
+        std::chrono::duration<double> wallTime{};
+
+        /**
+         * @brief Checks whether the calculator behaved as expected
+         *
+         * @return True if no mismatches were found
+         */
+        [[nodiscard]] bool isSuccessful() const
+        {
+            return mismatchedInstructionCount == 0 && mismatchedOperandCount == 0;
+        }
+
+        /**
+         * @brief Computes the throughput of the calculator
+         *
+         * @return Processed instructions per second (0 if no time was measured)
+         */
+        [[nodiscard]] double getInstructionsPerSecond() const
+        {
+            return wallTime.count() > 0.0 ? static_cast<double>(instructionCount) / wallTime.count()
+                                          : 0.0;
+        }
+    };
+
+    /**
+     * @brief Class constructor
+     *
+     * The verifier does not copy the workload, so the viewed characters must outlive it.
+     * In lazy mode, assignments only output the value of their own operand,
+     * so only the first expected result of each assignment is checked
+     *
+     * @param[in] instructions Instructions of the workload (one per line)
+     * @param[in] expectedResults Expected results of the instructions (one line per instruction)
+     * @param[in] expectedState Expected final state (one "x = <value>" line per operand)
+     * @param[in] evaluationMode Evaluation mode of the calculator
+     */
+    WorkloadVerifier(std::string_view instructions,
+                     std::string_view expectedResults,
+                     std::string_view expectedState,
+                     Calculator::State::EvaluationMode evaluationMode
+                     = Calculator::State::EvaluationMode::EAGER);
+
+    /**
+     * @brief Replays the workload through a fresh calculator and checks its results
+     *
+     * The first few mismatches are reported to the error stream
+     *
+     * @return Report of the verification
+     */
+    [[nodiscard]] Report execute() const;
+
+private:
+    /// View of the instructions of the workload
+    std::string_view mInstructions;
+
+    /// View of the expected results of the instructions
+    std::string_view mExpectedResults;
+
+    /// View of the expected final state
+    std::string_view mExpectedState;
+
+    /// Evaluation mode of the calculator
+    Calculator::State::EvaluationMode mEvaluationMode;
+};
+
+} // namespace Generator
@@ -0,0 +1,171 @@
+#include <charconv>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "generator/WorkloadGenerator.hpp"
+#include "generator/WorkloadVerifier.hpp"
+#include "io/MappedFile.hpp"
+
+namespace {
+/// Command used to generate a workload
+constexpr std::string_view cGenerateCommand{"generate"};
+/// Command used to verify the calculator against a workload
+constexpr std::string_view cVerifyCommand{"verify"};
+
+/// Extensions of the files making up a workload
+constexpr std::string_view cInstructionsExtension{".instructions"};
+constexpr std::string_view cExpectedResultsExtension{".expected"};
+constexpr std::string_view cExpectedStateExtension{".state"};
+
+/**
+ * @brief Prints the supported command line options
+ *
+ * @param[in] programName Name of the executable
+ */
+void printUsage(const std::string_view programName)
+{
+    std::cerr << "Usage:\n"
+              << "  " << programName << " " << cGenerateCommand
+              << " [--shape chain|fan-out|diamond|random-dag|mixed] [--instructions N]"
+                 " [--seed N] [--operands N] [--undo-percentage P] [--result-percentage P]"
+                 " <prefix>\n"
+              << "      Writes <prefix>" << cInstructionsExtension << ", <prefix>"
+              << cExpectedResultsExtension << " and <prefix>" << cExpectedStateExtension << "\n"
+              << "  " << programName << " " << cVerifyCommand << " <prefix>\n"
+              << "      Replays <prefix>" << cInstructionsExtension
+              << " through the calculator and checks its results\n";
+}
+
+/**
+ * @brief Parses an unsigned integer command line argument
+ *
+ * @param[in] argument Argument to parse
+ * @param[out] value Parsed value
+ *
+ * @return True if the whole argument is a valid unsigned integer (false otherwise)
+ */
+template <typename T>
+bool parseNumber(const std::string_view argument, T& value)
+{
+    const auto [end, errorCode]
+          = std::from_chars(argument.data(), argument.data() + argument.size(), value);
+
+    return errorCode == std::errc{} && end == argument.data() + argument.size();
+}
+
+/**
+ * @brief Generates a workload and writes it to the files with the given prefix
+ *
+ * @param[in] argc Number of command line arguments
+ * @param[in] argv Command line arguments
+ *
+ * @return Exit code
+ */
+int runGenerateCommand(const int argc, char* argv[])
+{
+    Generator::WorkloadParameters parameters;
+
+    int argumentIndex{2};
+    for (; argumentIndex + 1 < argc; argumentIndex += 2) {
+        const std::string_view option{argv[argumentIndex]};
+        const std::string_view argument{argv[argumentIndex + 1]};
+
+        bool isValid{false};
+        if (option == "--shape") {
+            const auto shape = Generator::parseWorkloadShape(argument);
+            isValid = shape.has_value();
+            parameters.shape = shape.value_or(parameters.shape);
+        } else if (option == "--instructions") {
+            isValid = parseNumber(argument, parameters.instructionCount);
+        } else if (option == "--seed") {
+            isValid = parseNumber(argument, parameters.seed);
+        } else if (option == "--operands") {
+            isValid = parseNumber(argument, parameters.operandCount);
+        } else if (option == "--undo-percentage") {
+            isValid = parseNumber(argument, parameters.undoPercentage)
+                      && parameters.undoPercentage <= 100;
+        } else if (option == "--result-percentage") {
+            isValid = parseNumber(argument, parameters.resultPercentage)
+                      && parameters.resultPercentage <= 100;
+        }
+
+        if (!isValid) {
+            std::cerr << "Invalid option: " << option << " " << argument << "\n";
+            return 1;
+        }
+    }
+
+    if (argumentIndex + 1 != argc) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    const std::string prefix{argv[argumentIndex]};
+    std::ofstream instructions{prefix + std::string(cInstructionsExtension)};
+    std::ofstream expectedResults{prefix + std::string(cExpectedResultsExtension)};
+    std::ofstream expectedState{prefix + std::string(cExpectedStateExtension)};
+
+    if (!instructions || !expectedResults || !expectedState) {
+        std::cerr << "Unable to create the workload files: " << prefix << "\n";
+        return 1;
+    }
+
+    Generator::WorkloadGenerator generator(parameters);
+    if (!generator.execute(instructions, expectedResults)) {
+        return 1;
+    }
+    generator.writeExpectedState(expectedState);
+
+    return 0;
+}
+
+/**
+ * @brief Verifies the calculator against the workload stored in the files with the given prefix
+ *
+ * @param[in] prefix Prefix of the workload files
+ *
+ * @return Exit code (0 only if no mismatches were found)
+ */
+int runVerifyCommand(const std::string& prefix)
+{
+    IO::MappedFile instructions;
+    IO::MappedFile expectedResults;
+    IO::MappedFile expectedState;
+
+    if (!instructions.open(prefix + std::string(cInstructionsExtension))
+        || !expectedResults.open(prefix + std::string(cExpectedResultsExtension))
+        || !expectedState.open(prefix + std::string(cExpectedStateExtension))) {
+        return 1;
+    }
+
+    const Generator::WorkloadVerifier verifier(
+          instructions.getContents(), expectedResults.getContents(), expectedState.getContents());
+    const auto report = verifier.execute();
+
+    std::cerr << "Instructions: " << report.instructionCount << "\n"
+              << "Mismatched instructions: " << report.mismatchedInstructionCount << "\n"
+              << "Mismatched operands: " << report.mismatchedOperandCount << "\n"
+              << "Wall time: " << report.wallTime.count() << " s\n"
+              << "Throughput: " << report.getInstructionsPerSecond() << " instructions/s\n";
+
+    return report.isSuccessful() ? 0 : 1;
+}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const std::string_view programName{argc > 0 ? argv[0] : "Workload-Generator"};
+
+    if (argc >= 3 && argv[1] == cGenerateCommand) {
+        return runGenerateCommand(argc, argv);
+    }
+
+    if (argc == 3 && argv[1] == cVerifyCommand) {
+        return runVerifyCommand(argv[2]);
+    }
+
+    printUsage(programName);
+    return 1;
+}
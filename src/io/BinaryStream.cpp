@@ -0,0 +1,65 @@
+#include "BinaryStream.hpp"
+
+namespace IO {
+
+void BinaryWriter::writeBytes(const std::string_view bytes)
+{
+    mBuffer += bytes;
+}
+
+const std::string& BinaryWriter::getBuffer() const
+{
+    return mBuffer;
+}
+
+void BinaryWriter::clear()
+{
+    mBuffer.clear();
+}
+
+BinaryReader::BinaryReader(const std::string_view data)
+    : mData{data}
+{
+}
+
+uint32_t BinaryReader::readCount(const std::size_t minElementSize)
+{
+    const auto count = read<uint32_t>();
+    if (minElementSize > 0 && count > mData.size() / minElementSize) {
+        fail();
+        return 0;
+    }
+
+    return count;
+}
+
+std::string_view BinaryReader::readBytes(const std::size_t size)
+{
+    if (mHasFailed || mData.size() < size) {
+        fail();
+        return {};
+    }
+
+    const auto bytes = mData.substr(0, size);
+    mData.remove_prefix(size);
+
+    return bytes;
+}
+
+bool BinaryReader::isValid() const
+{
+    return !mHasFailed;
+}
+
+bool BinaryReader::isAtEnd() const
+{
+    return !mHasFailed && mData.empty();
+}
+
+void BinaryReader::fail()
+{
+    mHasFailed = true;
+    mData = {};
+}
+
+} // namespace IO
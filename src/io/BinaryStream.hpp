@@ -0,0 +1,155 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace IO {
+
+/**
+ * @brief Class responsible for encoding binary data into a buffer
+ *
+ * Integers are encoded in little-endian order (regardless of the host),
+ * so that the encoded data can be decoded on any host by a BinaryReader
+ */
+class BinaryWriter
+{
+public:
+    /**
+     * @brief Appends an integer to the buffer
+     *
+     * @tparam T Integral type of the value (its whole width is encoded)
+     *
+     * @param[in] value Value to append
+     */
+    template <std::integral T>
+    void write(const T value)
+    {
+        using Unsigned = std::make_unsigned_t<T>;
+        const auto bits = static_cast<Unsigned>(value);
+
+        for (std::size_t byte = 0; byte < sizeof(T); ++byte) {
+            mBuffer += static_cast<char>(static_cast<uint8_t>(bits >> (byte * 8U)));
+        }
+    }
+
+    /**
+     * @brief Appends raw bytes to the buffer (without their size)
+     *
+     * @param[in] bytes Bytes to append
+     */
+    void writeBytes(std::string_view bytes);
+
+    /**
+     * @brief Getter for the encoded data
+     *
+     * @return Reference to the buffer holding the encoded data
+     */
+    [[nodiscard]] const std::string& getBuffer() const;
+
+    /**
+     * @brief Discards the encoded data (keeping the capacity of the buffer)
+     */
+    void clear();
+
+private:
+    /// Encoded data
+    std::string mBuffer;
+};
+
+/**
+ * @brief Class responsible for decoding binary data encoded by a BinaryWriter
+ *
+ * Data is decoded sequentially from a view (e.g. of a memory mapped file), without copying it.
+ * Reading past the end of the data fails every later read as well,
+ * so a whole section can be read before checking whether it was complete.
+ */
+class BinaryReader
+{
+public:
+    /**
+     * @brief Class constructor
+     *
+     * The reader does not copy the data, so the viewed bytes must outlive it
+     *
+     * @param[in] data Data to decode
+     */
+    explicit BinaryReader(std::string_view data);
+
+    /**
+     * @brief Reads an integer
+     *
+     * @tparam T Integral type of the value
+     *
+     * @return Decoded value (0 if there are not enough bytes left)
+     */
+    template <std::integral T>
+    [[nodiscard]] T read()
+    {
+        using Unsigned = std::make_unsigned_t<T>;
+
+        if (mHasFailed || mData.size() < sizeof(T)) {
+            mHasFailed = true;
+            return T{};
+        }
+
+        Unsigned bits{0};
+        for (std::size_t byte = 0; byte < sizeof(T); ++byte) {
+            bits |= static_cast<Unsigned>(static_cast<Unsigned>(static_cast<uint8_t>(mData[byte]))
+                                          << (byte * 8U));
+        }
+        mData.remove_prefix(sizeof(T));
+
+        return static_cast<T>(bits);
+    }
+
+    /**
+     * @brief Reads an amount of elements, checking that enough bytes are left to hold them
+     * (so that corrupted counts are rejected before anything is allocated for them)
+     *
+     * @param[in] minElementSize Minimum amount of bytes used by each element
+     *
+     * @return Amount of elements (0 if there are not enough bytes left)
+     */
+    [[nodiscard]] uint32_t readCount(std::size_t minElementSize);
+
+    /**
+     * @brief Reads raw bytes
+     *
+     * @param[in] size Amount of bytes to read
+     *
+     * @return View of the bytes (empty if there are not enough bytes left)
+     */
+    [[nodiscard]] std::string_view readBytes(std::size_t size);
+
+    /**
+     * @brief Checks whether every read succeeded so far
+     *
+     * @return True if no read went past the end of the data
+     */
+    [[nodiscard]] bool isValid() const;
+
+    /**
+     * @brief Checks whether the whole data was read
+     *
+     * @return True if every byte was read (and every read succeeded)
+     */
+    [[nodiscard]] bool isAtEnd() const;
+
+    /**
+     * @brief Fails every later read (e.g. when the decoded data is inconsistent)
+     */
+    void fail();
+
+private:
+    /// Data left to decode
+    std::string_view mData;
+
+    /// Whether a read failed
+    bool mHasFailed{false};
+};
+
+} // namespace IO
@@ -0,0 +1,237 @@
+#include "Journal.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+namespace {
+/// Magic string starting every journal file
+constexpr std::string_view cJournalMagic{"CALCJRNL"};
+/// Version of the journal format (increased on every incompatible change)
+constexpr uint32_t cJournalFormatVersion{1};
+/// Amount of bytes preceding the contents of every record (its size and checksum)
+constexpr std::size_t cRecordHeaderSize{2 * sizeof(uint32_t)};
+
+/**
+ * @brief Encodes the header starting every journal file
+ *
+ * @return Magic string and format version of the journal
+ */
+std::string encodeHeader()
+{
+    IO::BinaryWriter writer;
+    writer.writeBytes(cJournalMagic);
+    writer.write<uint32_t>(cJournalFormatVersion);
+
+    return writer.getBuffer();
+}
+
+/**
+ * @brief Computes the checksum of a record (32-bit FNV-1a)
+ *
+ * @param[in] record Contents of the record
+ *
+ * @return Checksum of the record
+ */
+uint32_t computeChecksum(const std::string_view record)
+{
+    constexpr uint32_t cOffsetBasis{2166136261U};
+    constexpr uint32_t cPrime{16777619U};
+
+    uint32_t checksum{cOffsetBasis};
+    for (const auto character : record) {
+        checksum = (checksum ^ static_cast<uint8_t>(character)) * cPrime;
+    }
+
+    return checksum;
+}
+} // namespace
+
+namespace IO {
+
+Journal::Journal(const Configuration& configuration)
+    : mConfiguration{configuration}
+{
+}
+
+Journal::~Journal()
+{
+    if (mWriter.joinable()) {
+        {
+            const std::lock_guard lock{mMutex};
+            mIsStopping = true;
+        }
+        mRecordsAppended.notify_one();
+        mWriter.join();
+    }
+
+    if (mFileDescriptor >= 0) {
+        ::close(mFileDescriptor);
+    }
+}
+
+std::optional<std::vector<std::string_view>>
+      Journal::readRecords(const std::string_view contents, std::size_t& validSize)
+{
+    std::vector<std::string_view> records;
+    validSize = 0;
+
+    // A crash while creating the journal may have left part of its header only
+    const auto header = encodeHeader();
+    if (contents.size() < header.size()) {
+        return std::string_view{header}.starts_with(contents)
+                     ? std::optional{std::move(records)}
+                     : std::nullopt;
+    }
+
+    if (!contents.starts_with(header)) {
+        return std::nullopt;
+    }
+    validSize = header.size();
+
+    BinaryReader reader(contents.substr(header.size()));
+    while (!reader.isAtEnd()) {
+        const auto size = reader.read<uint32_t>();
+        const auto checksum = reader.read<uint32_t>();
+        const auto record = reader.readBytes(size);
+
+        if (!reader.isValid() || computeChecksum(record) != checksum) {
+            break;
+        }
+
+        records.push_back(record);
+        validSize += cRecordHeaderSize + record.size();
+    }
+
+    return records;
+}
+
+bool Journal::open(const std::string& fileName, const std::size_t validSize)
+{
+    if (mWriter.joinable()) {
+        std::cerr << "Journal already opened\n";
+        return false;
+    }
+
+    mFileDescriptor = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+    if (mFileDescriptor < 0) {
+        std::cerr << "Unable to open " << fileName << ": " << std::strerror(errno) << "\n";
+        return false;
+    }
+
+    // Torn records (and partial headers) left by a crash are dropped
+    const auto header = encodeHeader();
+    const auto keptSize = validSize < header.size() ? 0 : validSize;
+    if (::ftruncate(mFileDescriptor, static_cast<off_t>(keptSize)) != 0
+        || ::lseek(mFileDescriptor, 0, SEEK_END) < 0
+        || (keptSize == 0 && !writeBatch(header))) {
+        std::cerr << "Unable to prepare " << fileName << ": " << std::strerror(errno) << "\n";
+        ::close(mFileDescriptor);
+        mFileDescriptor = -1;
+        return false;
+    }
+
+    mWriter = std::thread{[this] { writeLoop(); }};
+    return true;
+}
+
+void Journal::append(const std::string_view record)
+{
+    std::unique_lock lock{mMutex};
+
+    // Appending is throttled while the background thread is too far behind
+    mRecordsSynced.wait(lock, [this] {
+        return mPendingRecords.getBuffer().size() < cMaxPendingSize;
+    });
+
+    const auto wasEmpty = mPendingRecords.getBuffer().empty();
+    mPendingRecords.write<uint32_t>(static_cast<uint32_t>(record.size()));
+    mPendingRecords.write<uint32_t>(computeChecksum(record));
+    mPendingRecords.writeBytes(record);
+    ++mAppendedCount;
+
+    // The background thread only needs to know when a batch starts or is large enough
+    if (wasEmpty || mPendingRecords.getBuffer().size() >= mConfiguration.syncSize) {
+        lock.unlock();
+        mRecordsAppended.notify_one();
+    }
+}
+
+bool Journal::flush()
+{
+    std::unique_lock lock{mMutex};
+    if (!mWriter.joinable()) {
+        return false;
+    }
+
+    const auto appendedCount = mAppendedCount;
+    ++mFlushWaiterCount;
+    mRecordsAppended.notify_one();
+    mRecordsSynced.wait(lock, [&] { return mSyncedCount >= appendedCount; });
+    --mFlushWaiterCount;
+
+    return !mHasFailed;
+}
+
+void Journal::writeLoop()
+{
+    BinaryWriter batch;
+
+    while (true) {
+        uint64_t batchEnd{};
+        {
+            std::unique_lock lock{mMutex};
+            mRecordsAppended.wait(
+                  lock, [this] { return mIsStopping || !mPendingRecords.getBuffer().empty(); });
+
+            if (mPendingRecords.getBuffer().empty()) {
+                return; // Stopping, and every record was synced
+            }
+
+            // Records appended while the first one waits share its sync
+            mRecordsAppended.wait_for(lock, mConfiguration.syncInterval, [this] {
+                return mIsStopping || mFlushWaiterCount > 0
+                       || mPendingRecords.getBuffer().size() >= mConfiguration.syncSize;
+            });
+
+            std::swap(batch, mPendingRecords);
+            batchEnd = mAppendedCount;
+        }
+
+        // Failures are only reported once (later records are most probably lost as well)
+        const auto isSynced = writeBatch(batch.getBuffer());
+        if (!isSynced && !mHasFailed) {
+            std::cerr << "Unable to write the journal: " << std::strerror(errno) << "\n";
+        }
+        batch.clear();
+
+        {
+            const std::lock_guard lock{mMutex};
+            mSyncedCount = batchEnd;
+            mHasFailed = mHasFailed || !isSynced;
+        }
+        mRecordsSynced.notify_all();
+    }
+}
+
+bool Journal::writeBatch(std::string_view batch) const
+{
+    while (!batch.empty()) {
+        const auto writtenSize = ::write(mFileDescriptor, batch.data(), batch.size());
+        if (writtenSize < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        batch.remove_prefix(static_cast<std::size_t>(writtenSize));
+    }
+
+    return ::fdatasync(mFileDescriptor) == 0;
+}
+
+} // namespace IO
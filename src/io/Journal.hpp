@@ -0,0 +1,148 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "BinaryStream.hpp"
+
+namespace IO {
+
+/**
+ * @brief Append-only write-ahead journal of records, made durable by a background thread
+ *
+ * Appending a record only encodes it into a pending buffer. The background thread writes
+ * the pending records and syncs them to disk in batches (group commit): a batch is synced
+ * once its first record waited for the sync interval, or as soon as it reaches the sync size,
+ * so a single sync is shared by every record appended in the meantime.
+ * Appended records are thus only durable after a sync, which can be awaited with flush().
+ *
+ * The file starts with a magic string and a format version, followed by the records,
+ * each of them prefixed by its size and checksum, so that a record torn by a crash
+ * (and everything after it) is detected and dropped when the journal is read back.
+ */
+class Journal
+{
+public:
+    /// Default longest time the first record of a batch waits before the batch is synced
+    static constexpr std::chrono::microseconds cDefaultSyncInterval{2000};
+
+    /// Default amount of pending bytes syncing a batch right away
+    static constexpr std::size_t cDefaultSyncSize{64U * 1024U};
+
+    /// Amount of pending bytes beyond which appending waits for the background thread
+    static constexpr std::size_t cMaxPendingSize{16U * 1024U * 1024U};
+
+    /**
+     * @brief Group commit policy of the journal
+     */
+    struct Configuration
+    {
+        /// Longest time the first record of a batch waits before the batch is synced
+        std::chrono::microseconds syncInterval{cDefaultSyncInterval};
+        /// Amount of pending bytes syncing a batch right away
+        std::size_t syncSize{cDefaultSyncSize};
+    };
+
+    /**
+     * @brief Class constructor
+     *
+     * @param[in] configuration Group commit policy of the journal
+     */
+    explicit Journal(const Configuration& configuration);
+
+    /**
+     * @brief Class destructor (syncs every appended record and closes the file)
+     */
+    ~Journal();
+
+    Journal(const Journal&) = delete;
+    Journal& operator=(const Journal&) = delete;
+    Journal(Journal&&) = delete;
+    Journal& operator=(Journal&&) = delete;
+
+    /**
+     * @brief Reads back the records of a journal
+     *
+     * Reading stops at the first torn or corrupted record (the tail left by a crash)
+     *
+     * @param[in] contents Contents of the journal file (e.g. memory mapped)
+     * @param[out] validSize Amount of bytes holding the header and the valid records
+     *
+     * @return Views of the valid records, in order (empty if the contents are not a journal)
+     */
+    [[nodiscard]] static std::optional<std::vector<std::string_view>>
+          readRecords(std::string_view contents, std::size_t& validSize);
+
+    /**
+     * @brief Opens the file to append the records to and starts the background thread
+     *
+     * The file is created if needed, and truncated to its valid size
+     * (so that new records follow the valid ones)
+     *
+     * @param[in] fileName Name of the journal file
+     * @param[in] validSize Amount of valid bytes of the file (see readRecords)
+     *
+     * @return True if the file was opened (false otherwise)
+     */
+    [[nodiscard]] bool open(const std::string& fileName, std::size_t validSize);
+
+    /**
+     * @brief Appends a record (it is durable once the background thread syncs it)
+     *
+     * @param[in] record Record to append
+     */
+    void append(std::string_view record);
+
+    /**
+     * @brief Waits until every record appended so far is durable
+     *
+     * @return True if every record was synced (false if writing the journal failed)
+     */
+    [[nodiscard]] bool flush();
+
+private:
+    /**
+     * @brief Body of the background thread: writes and syncs the pending records until stopped
+     */
+    void writeLoop();
+
+    /**
+     * @brief Writes a batch of records to the file and syncs it
+     *
+     * @param[in] batch Encoded records
+     *
+     * @return True if the batch was written and synced (false otherwise)
+     */
+    [[nodiscard]] bool writeBatch(std::string_view batch) const;
+
+private:
+    /// Group commit policy of the journal
+    Configuration mConfiguration;
+
+    /// Descriptor of the journal file (-1 if not opened)
+    int mFileDescriptor{-1};
+
+    /// Background thread writing and syncing the pending records
+    std::thread mWriter;
+
+    /// Synchronization of the appended and synced records
+    std::mutex mMutex;
+    std::condition_variable mRecordsAppended;
+    std::condition_variable mRecordsSynced;
+    BinaryWriter mPendingRecords;
+    uint64_t mAppendedCount{0};
+    uint64_t mSyncedCount{0};
+    std::size_t mFlushWaiterCount{0};
+    bool mHasFailed{false};
+    bool mIsStopping{false};
+};
+
+} // namespace IO
@@ -0,0 +1,94 @@
+#include "MappedFile.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+namespace IO {
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : mData{std::exchange(other.mData, nullptr)}
+    , mSize{std::exchange(other.mSize, 0)}
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other) {
+        close();
+        mData = std::exchange(other.mData, nullptr);
+        mSize = std::exchange(other.mSize, 0);
+    }
+
+    return *this;
+}
+
+bool MappedFile::open(const std::string& fileName)
+{
+    close();
+
+    const int fileDescriptor = ::open(fileName.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fileDescriptor < 0) {
+        std::cerr << "Unable to open " << fileName << ": " << std::strerror(errno) << "\n";
+        return false;
+    }
+
+    struct stat fileStatus
+    {};
+    if (::fstat(fileDescriptor, &fileStatus) != 0) {
+        std::cerr << "Unable to stat " << fileName << ": " << std::strerror(errno) << "\n";
+        ::close(fileDescriptor);
+        return false;
+    }
+
+    // Empty files cannot be mapped (but they are valid, holding no contents)
+    const auto fileSize = static_cast<std::size_t>(fileStatus.st_size);
+    if (fileSize == 0) {
+        ::close(fileDescriptor);
+        return true;
+    }
+
+    void* data = ::mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+    // The mapping keeps its own reference to the file
+    ::close(fileDescriptor);
+
+    if (data == MAP_FAILED) {
+        std::cerr << "Unable to map " << fileName << ": " << std::strerror(errno) << "\n";
+        return false;
+    }
+
+    // Purely a hint: failing to apply it does not affect the mapping
+    ::madvise(data, fileSize, MADV_SEQUENTIAL);
+
+    mData = data;
+    mSize = fileSize;
+
+    return true;
+}
+
+std::string_view MappedFile::getContents() const
+{
+    return mData ? std::string_view{static_cast<const char*>(mData), mSize} : std::string_view{};
+}
+
+void MappedFile::close()
+{
+    if (mData) {
+        ::munmap(mData, mSize);
+        mData = nullptr;
+        mSize = 0;
+    }
+}
+
+} // namespace IO
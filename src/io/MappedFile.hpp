@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace IO {
+
+/**
+ * @brief Read-only memory mapping of a whole file
+ *
+ * The contents of the file are exposed as a view, so that they can be walked
+ * without being copied (pages are loaded on demand by the operating system).
+ */
+class MappedFile
+{
+public:
+    /**
+     * @brief Class' default constructor
+     */
+    MappedFile() = default;
+
+    /**
+     * @brief Class destructor (unmaps the file, if any)
+     */
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    /**
+     * @brief Class' move constructor
+     *
+     * @param[in,out] other Mapping to take ownership of
+     */
+    MappedFile(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Class' move assignment operator
+     *
+     * @param[in,out] other Mapping to take ownership of
+     *
+     * @return Reference to this mapping
+     */
+    MappedFile& operator=(MappedFile&& other) noexcept;
+
+    /**
+     * @brief Maps the contents of a file (replacing any previous mapping)
+     *
+     * The kernel is advised that the mapping will be read sequentially
+     *
+     * @param[in] fileName Name of the file to map
+     *
+     * @return True if the file was mapped (false otherwise)
+     */
+    [[nodiscard]] bool open(const std::string& fileName);
+
+    /**
+     * @brief Getter for the contents of the mapped file
+     *
+     * @return View of the whole file (empty if no file is mapped or the file is empty)
+     */
+    [[nodiscard]] std::string_view getContents() const;
+
+private:
+    /**
+     * @brief Unmaps the current mapping (if any)
+     */
+    void close();
+
+private:
+    /// Start address of the mapping (nullptr if nothing is mapped)
+    void* mData{nullptr};
+
+    /// Size of the mapping, in bytes
+    std::size_t mSize{0};
+};
+
+} // namespace IO
@@ -0,0 +1,216 @@
+#include "CodeArena.hpp"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+#include <utility>
+
+namespace {
+/// Alignment of the code added to the arena (the fetch block size of x86-64 processors)
+constexpr std::size_t cCodeAlignment{16};
+} // namespace
+
+namespace Jit {
+
+CodeArena::~CodeArena()
+{
+    release();
+}
+
+CodeArena::CodeArena(CodeArena&& other) noexcept
+    : mChunks{std::exchange(other.mChunks, {})}
+    , mChunkOffset{std::exchange(other.mChunkOffset, 0)}
+    , mFreeBlocks{std::exchange(other.mFreeBlocks, {})}
+    , mUsedBlocks{std::exchange(other.mUsedBlocks, {})}
+{
+}
+
+CodeArena& CodeArena::operator=(CodeArena&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        mChunks = std::exchange(other.mChunks, {});
+        mChunkOffset = std::exchange(other.mChunkOffset, 0);
+        mFreeBlocks = std::exchange(other.mFreeBlocks, {});
+        mUsedBlocks = std::exchange(other.mUsedBlocks, {});
+    }
+
+    return *this;
+}
+
+const void* CodeArena::add(const std::span<const uint8_t> machineCode)
+{
+    if (machineCode.empty()) {
+        std::cerr << "Empty machine code";
+        return nullptr;
+    }
+
+    // Blocks are sized in whole alignment units, so that every block stays aligned
+    const auto size = (machineCode.size() + cCodeAlignment - 1) & ~(cCodeAlignment - 1);
+
+    const auto* code = takeFreeBlock(size);
+    if (!code) {
+        if (mChunks.empty() || mChunkOffset + size > mChunks.back().size) {
+            if (!addChunk(size)) {
+                return nullptr;
+            }
+        }
+
+        code = mChunks.back().executableView + mChunkOffset;
+        mChunkOffset += size;
+    }
+
+    // The code is only reachable through the executable view once this call returns,
+    // and x86-64 keeps instruction fetches coherent with stores, so no cache flush is needed
+    const auto* chunk = findChunk(code);
+    std::memcpy(chunk->writableView + (code - chunk->executableView),
+                machineCode.data(),
+                machineCode.size());
+    mUsedBlocks.emplace(code, size);
+
+    return code;
+}
+
+void CodeArena::remove(const void* const code)
+{
+    const auto usedBlockItr = mUsedBlocks.find(static_cast<const uint8_t*>(code));
+    if (usedBlockItr == mUsedBlocks.end()) {
+        std::cerr << "Unknown machine code removed\n";
+        return;
+    }
+
+    auto [address, size] = *usedBlockItr;
+    mUsedBlocks.erase(usedBlockItr);
+
+    // The block is merged with the adjacent free blocks of its chunk
+    const auto* chunk = findChunk(address);
+    auto nextBlockItr = mFreeBlocks.lower_bound(address);
+    if (nextBlockItr != mFreeBlocks.end() && nextBlockItr->first == address + size
+        && findChunk(nextBlockItr->first) == chunk) {
+        size += nextBlockItr->second;
+        nextBlockItr = mFreeBlocks.erase(nextBlockItr);
+    }
+
+    if (nextBlockItr != mFreeBlocks.begin()) {
+        auto& [previousAddress, previousSize] = *std::prev(nextBlockItr);
+        if (previousAddress + previousSize == address && findChunk(previousAddress) == chunk) {
+            previousSize += size;
+            return;
+        }
+    }
+
+    mFreeBlocks.emplace_hint(nextBlockItr, address, size);
+}
+
+std::size_t CodeArena::getMappedSize() const
+{
+    std::size_t mappedSize{0};
+    for (const auto& chunk : mChunks) {
+        mappedSize += chunk.size;
+    }
+
+    return mappedSize;
+}
+
+bool CodeArena::addChunk(const std::size_t minimumSize)
+{
+    const auto pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    const auto chunkSize = (std::max(minimumSize, cChunkSize) + pageSize - 1) / pageSize * pageSize;
+
+    // Both views share the pages of an anonymous file
+    const int fileDescriptor = ::memfd_create("calculator-jit", MFD_CLOEXEC);
+    if (fileDescriptor < 0) {
+        std::cerr << "Unable to create the code arena: " << std::strerror(errno) << "\n";
+        return false;
+    }
+
+    if (::ftruncate(fileDescriptor, static_cast<off_t>(chunkSize)) != 0) {
+        std::cerr << "Unable to size the code arena: " << std::strerror(errno) << "\n";
+        ::close(fileDescriptor);
+        return false;
+    }
+
+    void* writableView
+          = ::mmap(nullptr, chunkSize, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    void* executableView
+          = ::mmap(nullptr, chunkSize, PROT_READ | PROT_EXEC, MAP_SHARED, fileDescriptor, 0);
+
+    // The mappings keep their own references to the file
+    ::close(fileDescriptor);
+
+    if (writableView == MAP_FAILED || executableView == MAP_FAILED) {
+        std::cerr << "Unable to map the code arena: " << std::strerror(errno) << "\n";
+        if (writableView != MAP_FAILED) {
+            ::munmap(writableView, chunkSize);
+        }
+        if (executableView != MAP_FAILED) {
+            ::munmap(executableView, chunkSize);
+        }
+        return false;
+    }
+
+    // The unused end of the previous chunk is left for smaller code
+    if (!mChunks.empty() && mChunkOffset < mChunks.back().size) {
+        mFreeBlocks.emplace(mChunks.back().executableView + mChunkOffset,
+                            mChunks.back().size - mChunkOffset);
+    }
+
+    mChunks.push_back({static_cast<uint8_t*>(writableView),
+                       static_cast<const uint8_t*>(executableView),
+                       chunkSize});
+    mChunkOffset = 0;
+
+    return true;
+}
+
+void CodeArena::release()
+{
+    for (const auto& chunk : mChunks) {
+        ::munmap(chunk.writableView, chunk.size);
+        ::munmap(const_cast<uint8_t*>(chunk.executableView), chunk.size);
+    }
+    mChunks.clear();
+    mChunkOffset = 0;
+    mFreeBlocks.clear();
+    mUsedBlocks.clear();
+}
+
+const uint8_t* CodeArena::takeFreeBlock(const std::size_t size)
+{
+    auto bestBlockItr = mFreeBlocks.end();
+    for (auto blockItr = mFreeBlocks.begin(); blockItr != mFreeBlocks.end(); ++blockItr) {
+        if (blockItr->second >= size
+            && (bestBlockItr == mFreeBlocks.end() || blockItr->second < bestBlockItr->second)) {
+            bestBlockItr = blockItr;
+        }
+    }
+
+    if (bestBlockItr == mFreeBlocks.end()) {
+        return nullptr;
+    }
+
+    const auto [address, blockSize] = *bestBlockItr;
+    mFreeBlocks.erase(bestBlockItr);
+    if (blockSize > size) {
+        mFreeBlocks.emplace(address + size, blockSize - size);
+    }
+
+    return address;
+}
+
+const CodeArena::Chunk* CodeArena::findChunk(const uint8_t* const code) const
+{
+    for (const auto& chunk : mChunks) {
+        if (code >= chunk.executableView && code < chunk.executableView + chunk.size) {
+            return &chunk;
+        }
+    }
+
+    return nullptr;
+}
+
+} // namespace Jit
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace Jit {
+
+/**
+ * @brief Store of executable machine code
+ *
+ * Code is placed in chunks of shared memory mapped twice: a writable view, used to copy new code,
+ * and an executable view, used to run it. No page is ever both writable and executable,
+ * and adding code never changes the protection of code that other threads might be running.
+ *
+ * Removed code leaves a free block (merged with its free neighbours), which is reused by the
+ * following code that fits in it (the smallest such block is picked), so replacing code does
+ * not map more memory. Chunks are only unmapped when the arena is destroyed, so the arena must
+ * outlive every caller of the code it holds
+ */
+class CodeArena
+{
+public:
+    /// Minimum size of the chunks of the arena, in bytes
+    static constexpr std::size_t cChunkSize{64 * 1024};
+
+    /**
+     * @brief Class' default constructor (no chunk is mapped until code is added)
+     */
+    CodeArena() = default;
+
+    /**
+     * @brief Class destructor (unmaps every chunk)
+     */
+    ~CodeArena();
+
+    CodeArena(const CodeArena&) = delete;
+    CodeArena& operator=(const CodeArena&) = delete;
+
+    /**
+     * @brief Class' move constructor
+     *
+     * @param[in,out] other Arena to take ownership of
+     */
+    CodeArena(CodeArena&& other) noexcept;
+
+    /**
+     * @brief Class' move assignment operator
+     *
+     * @param[in,out] other Arena to take ownership of
+     *
+     * @return Reference to this arena
+     */
+    CodeArena& operator=(CodeArena&& other) noexcept;
+
+    /**
+     * @brief Copies machine code into the arena
+     *
+     * @param[in] machineCode Machine code to copy
+     *
+     * @return Executable address of the copied code (nullptr on failure)
+     */
+    [[nodiscard]] const void* add(std::span<const uint8_t> machineCode);
+
+    /**
+     * @brief Removes code from the arena, so that its memory can be reused
+     *
+     * No thread may be running the code anymore (nor run it later)
+     *
+     * @param[in] code Executable address of the code (as returned by add)
+     */
+    void remove(const void* code);
+
+    /**
+     * @brief Getter for the amount of memory mapped by the arena
+     *
+     * @return Total size of the chunks, in bytes
+     */
+    [[nodiscard]] std::size_t getMappedSize() const;
+
+private:
+    /**
+     * @brief Chunk of the arena, mapped twice
+     */
+    struct Chunk
+    {
+        /// Writable view of the chunk
+        uint8_t* writableView{};
+        /// Executable view of the chunk
+        const uint8_t* executableView{};
+        /// Size of the chunk, in bytes
+        std::size_t size{};
+    };
+
+    /**
+     * @brief Maps a new chunk, which becomes the one code is added to
+     *
+     * @param[in] minimumSize Minimum size of the chunk, in bytes
+     *
+     * @return True if the chunk was mapped (false otherwise)
+     */
+    [[nodiscard]] bool addChunk(std::size_t minimumSize);
+
+    /**
+     * @brief Takes the smallest free block holding the given amount of bytes
+     * (the rest of the block stays free)
+     *
+     * @param[in] size Amount of bytes to take
+     *
+     * @return Executable address of the taken bytes (nullptr if no free block is large enough)
+     */
+    [[nodiscard]] const uint8_t* takeFreeBlock(std::size_t size);
+
+    /**
+     * @brief Finds the chunk holding an executable address
+     *
+     * @param[in] code Executable address
+     *
+     * @return Pointer to the chunk (nullptr if no chunk holds the address)
+     */
+    [[nodiscard]] const Chunk* findChunk(const uint8_t* code) const;
+
+    /**
+     * @brief Unmaps every chunk
+     */
+    void release();
+
+private:
+    /// Mapped chunks (code is added to the last one)
+    std::vector<Chunk> mChunks;
+
+    /// Offset of the first free byte of the last chunk
+    std::size_t mChunkOffset{0};
+
+    /// Free blocks left by removed code (executable address -> size, in bytes)
+    std::map<const uint8_t*, std::size_t> mFreeBlocks;
+
+    /// Blocks holding code (executable address -> size, in bytes)
+    std::unordered_map<const uint8_t*, std::size_t> mUsedBlocks;
+};
+
+} // namespace Jit
@@ -0,0 +1,319 @@
+#include "CodeGenerator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <initializer_list>
+#include <limits>
+#include <span>
+
+#if defined(__x86_64__)
+namespace {
+
+/// Registers holding the values of the stack (indexed by stack depth): the caller saved ones
+/// first (rcx, r8-r11), then the callee saved ones (rbx, rbp, r12-r15), which must be preserved
+constexpr std::array<uint8_t, 11> cStackRegisters{1, 8, 9, 10, 11, 3, 5, 12, 13, 14, 15};
+/// Amount of caller saved registers at the start of the stack registers
+constexpr uint32_t cCallerSavedRegisterCount{5};
+
+/// Accumulator register (implicit dividend and quotient of divisions)
+constexpr uint8_t cRax{0};
+/// Register holding the location of the result (second argument)
+constexpr uint8_t cRsi{6};
+/// Register holding the operand values (first argument)
+constexpr uint8_t cRdi{7};
+
+/**
+ * @brief Offset of the value held by an optional operand value
+ *
+ * @return Offset, in bytes, from the start of the optional to its value
+ */
+std::ptrdiff_t getValueOffset()
+{
+    static const std::optional<Arithmetic::Value> cProbe{0};
+    return reinterpret_cast<const std::byte*>(&*cProbe)
+           - reinterpret_cast<const std::byte*>(&cProbe);
+}
+
+/**
+ * @brief Appends an immediate (little endian) to the machine code
+ *
+ * @param[in,out] machineCode Machine code being generated
+ * @param[in] value Immediate to append
+ * @param[in] byteCount Size of the immediate, in bytes
+ */
+void emitImmediate(std::vector<uint8_t>& machineCode, const uint64_t value, const int byteCount)
+{
+    for (int shift = 0; shift < byteCount * 8; shift += 8) {
+        machineCode.push_back(static_cast<uint8_t>(value >> shift));
+    }
+}
+
+/**
+ * @brief Overwrites a 32 bits immediate (little endian) of the machine code
+ *
+ * @param[in,out] machineCode Machine code being generated
+ * @param[in] position Position of the immediate
+ * @param[in] value Immediate to write
+ */
+void patchImmediate(std::vector<uint8_t>& machineCode, const std::size_t position, uint32_t value)
+{
+    for (std::size_t index = position; index < position + 4; ++index, value >>= 8) {
+        machineCode[index] = static_cast<uint8_t>(value);
+    }
+}
+
+/**
+ * @brief Appends a 64 bits instruction operating on registers (or on a memory operand
+ * addressed by a base register plus a 32 bits displacement) to the machine code
+ *
+ * @param[in,out] machineCode Machine code being generated
+ * @param[in] opCode Op code bytes of the instruction
+ * @param[in] reg Register (or op code extension) encoded in the reg field of the ModR/M byte
+ * @param[in] rm Register encoded in the r/m field of the ModR/M byte
+ * (the base register for memory operands, which cannot be rsp or r12)
+ * @param[in] displacement Displacement from the base register of the memory operand
+ * (empty for registers)
+ */
+void emitInstruction(std::vector<uint8_t>& machineCode,
+                     const std::initializer_list<uint8_t> opCode,
+                     const uint8_t reg,
+                     const uint8_t rm,
+                     const std::optional<int32_t> displacement = {})
+{
+    // REX.W selects 64 bits operands, REX.R and REX.B extend the reg and r/m fields
+    machineCode.push_back(static_cast<uint8_t>(0x48 | (reg >= 8 ? 0x4 : 0) | (rm >= 8)));
+    machineCode.insert(machineCode.end(), opCode);
+
+    const uint32_t mod{displacement ? 0b10U : 0b11U};
+    machineCode.push_back(static_cast<uint8_t>(mod << 6 | (reg & 7U) << 3 | (rm & 7U)));
+    if (displacement) {
+        emitImmediate(machineCode, static_cast<uint32_t>(*displacement), 4);
+    }
+}
+
+/**
+ * @brief Appends a conditional jump (with a 32 bits displacement) to the machine code
+ *
+ * @param[in,out] machineCode Machine code being generated
+ * @param[in] condition Condition code of the jump (e.g. 0x0 for jo, 0x4 for jz)
+ *
+ * @return Position of the displacement, to be patched once the target is known
+ */
+std::size_t emitJump(std::vector<uint8_t>& machineCode, const uint8_t condition)
+{
+    machineCode.push_back(0x0F);
+    machineCode.push_back(static_cast<uint8_t>(0x80 | condition));
+    emitImmediate(machineCode, 0, 4);
+    return machineCode.size() - 4;
+}
+
+/**
+ * @brief Appends a push or a pop of a register to the machine code
+ *
+ * @param[in,out] machineCode Machine code being generated
+ * @param[in] opCode Op code of the instruction for the register (0x50 for push, 0x58 for pop)
+ * @param[in] reg Register to push or pop
+ */
+void emitStackOperation(std::vector<uint8_t>& machineCode, const uint8_t opCode, const uint8_t reg)
+{
+    if (reg >= 8) {
+        machineCode.push_back(0x41);
+    }
+    machineCode.push_back(static_cast<uint8_t>(opCode | (reg & 7U)));
+}
+
+/**
+ * @brief Appends the load of an immediate into a register to the machine code
+ *
+ * @param[in,out] machineCode Machine code being generated
+ * @param[in] reg Register to load
+ * @param[in] value Immediate to load
+ */
+void emitLoadImmediate(std::vector<uint8_t>& machineCode,
+                       const uint8_t reg,
+                       const Arithmetic::Value value)
+{
+    if (value >= std::numeric_limits<int32_t>::min()
+        && value <= std::numeric_limits<int32_t>::max()) {
+        // mov r64, imm32 (sign extended)
+        emitInstruction(machineCode, {0xC7}, 0, reg);
+        emitImmediate(machineCode, static_cast<uint64_t>(value), 4);
+        return;
+    }
+
+    // movabs r64, imm64
+    machineCode.push_back(static_cast<uint8_t>(0x48 | (reg >= 8)));
+    machineCode.push_back(static_cast<uint8_t>(0xB8 | (reg & 7U)));
+    emitImmediate(machineCode, static_cast<uint64_t>(value), 8);
+}
+
+/**
+ * @brief Appends the restoration of the callee saved registers and the return of a value
+ * to the machine code
+ *
+ * @param[in,out] machineCode Machine code being generated
+ * @param[in] savedRegisters Callee saved registers pushed by the prologue
+ * @param[in] returnValue Value to return (0 or 1)
+ */
+void emitEpilogue(std::vector<uint8_t>& machineCode,
+                  const std::span<const uint8_t> savedRegisters,
+                  const uint8_t returnValue)
+{
+    // mov eax, imm32
+    machineCode.push_back(0xB8);
+    emitImmediate(machineCode, returnValue, 4);
+
+    for (auto reg = savedRegisters.rbegin(); reg != savedRegisters.rend(); ++reg) {
+        emitStackOperation(machineCode, 0x58, *reg);
+    }
+    machineCode.push_back(0xC3);
+}
+
+} // namespace
+#endif
+
+namespace Jit {
+
+CodeGenerator::CodeGenerator(const Bytecode::Program& program)
+    : mProgram{program}
+{
+}
+
+bool CodeGenerator::execute()
+{
+    using Bytecode::OpCode;
+
+    mMachineCode.clear();
+
+#if defined(__x86_64__)
+    static_assert(cMaxStackDepth == cStackRegisters.size());
+
+    if (mProgram.instructions.empty() || mProgram.maxStackDepth > cMaxStackDepth) {
+        return false;
+    }
+
+    // Variables are addressed relative to the operand values (rdi),
+    // so every displacement must fit in 32 bits
+    using OperandValue = std::optional<Arithmetic::Value>;
+    const auto valueOffset = getValueOffset();
+    const auto symbolIdBound
+          = static_cast<std::size_t>(std::numeric_limits<int32_t>::max() - valueOffset)
+            / sizeof(OperandValue);
+    if (std::ranges::any_of(mProgram.variables,
+                            [&](const auto symbolId) { return symbolId >= symbolIdBound; })) {
+        return false;
+    }
+
+    // Preserve the callee saved registers holding values of the stack
+    const auto savedRegisters
+          = std::span{cStackRegisters}.subspan(cCallerSavedRegisterCount).first(
+                std::max(mProgram.maxStackDepth, cCallerSavedRegisterCount)
+                - cCallerSavedRegisterCount);
+    for (const auto reg : savedRegisters) {
+        emitStackOperation(mMachineCode, 0x50, reg);
+    }
+
+    // Jumps to the failure path (patched once its position is known)
+    std::vector<std::size_t> failureJumps;
+
+    // Register holding each value of the stack: cStackRegisters[depth]
+    uint32_t stackDepth{0};
+
+    for (const auto& [opCode, operand] : mProgram.instructions) {
+        switch (opCode) {
+        case OpCode::PUSH_LITERAL:
+            emitLoadImmediate(mMachineCode, cStackRegisters[stackDepth++], operand);
+            break;
+        case OpCode::PUSH_CONSTANT:
+            emitLoadImmediate(
+                  mMachineCode, cStackRegisters[stackDepth++], mProgram.constants[operand]);
+            break;
+        case OpCode::PUSH_VARIABLE: {
+            // mov r64, qword [rdi + displacement]
+            const auto symbolId = mProgram.variables[operand];
+            const auto displacement = static_cast<int32_t>(
+                  static_cast<std::ptrdiff_t>(symbolId * sizeof(OperandValue)) + valueOffset);
+            emitInstruction(
+                  mMachineCode, {0x8B}, cStackRegisters[stackDepth++], cRdi, displacement);
+            break;
+        }
+        case OpCode::ADD:
+        case OpCode::SUB:
+        case OpCode::MULT: {
+            --stackDepth;
+            const auto destination = cStackRegisters[stackDepth - 1];
+            const auto source = cStackRegisters[stackDepth];
+
+            // add/sub r/m64, r64 or imul r64, r/m64; jo failure
+            if (opCode == OpCode::ADD) {
+                emitInstruction(mMachineCode, {0x01}, source, destination);
+            } else if (opCode == OpCode::SUB) {
+                emitInstruction(mMachineCode, {0x29}, source, destination);
+            } else {
+                emitInstruction(mMachineCode, {0x0F, 0xAF}, destination, source);
+            }
+            failureJumps.push_back(emitJump(mMachineCode, 0x0));
+            break;
+        }
+        case OpCode::DIV: {
+            --stackDepth;
+            const auto dividend = cStackRegisters[stackDepth - 1];
+            const auto divisor = cStackRegisters[stackDepth];
+
+            // test divisor, divisor; jz failure
+            emitInstruction(mMachineCode, {0x85}, divisor, divisor);
+            failureJumps.push_back(emitJump(mMachineCode, 0x4));
+
+            // cmp divisor, -1; jne division (idiv traps on the overflow of x / -1)
+            emitInstruction(mMachineCode, {0x83}, 7, divisor);
+            mMachineCode.push_back(0xFF);
+            mMachineCode.push_back(0x75);
+            mMachineCode.push_back(0);
+            const auto divisionJump = mMachineCode.size();
+
+            // neg dividend; jo failure; jmp done
+            emitInstruction(mMachineCode, {0xF7}, 3, dividend);
+            failureJumps.push_back(emitJump(mMachineCode, 0x0));
+            mMachineCode.push_back(0xEB);
+            mMachineCode.push_back(0);
+            const auto doneJump = mMachineCode.size();
+
+            // division: mov rax, dividend; cqo; idiv divisor; mov dividend, rax
+            mMachineCode[divisionJump - 1]
+                  = static_cast<uint8_t>(mMachineCode.size() - divisionJump);
+            emitInstruction(mMachineCode, {0x8B}, cRax, dividend);
+            mMachineCode.push_back(0x48);
+            mMachineCode.push_back(0x99);
+            emitInstruction(mMachineCode, {0xF7}, 7, divisor);
+            emitInstruction(mMachineCode, {0x89}, cRax, dividend);
+
+            // done:
+            mMachineCode[doneJump - 1] = static_cast<uint8_t>(mMachineCode.size() - doneJump);
+            break;
+        }
+        }
+    }
+
+    // Success: mov qword [rsi], value; return true
+    emitInstruction(mMachineCode, {0x89}, cStackRegisters[0], cRsi, 0);
+    emitEpilogue(mMachineCode, savedRegisters, 1);
+
+    // Failure: return false
+    const auto failurePosition = mMachineCode.size();
+    for (const auto jump : failureJumps) {
+        patchImmediate(mMachineCode, jump, static_cast<uint32_t>(failurePosition - (jump + 4)));
+    }
+    emitEpilogue(mMachineCode, savedRegisters, 0);
+
+    return true;
+#else
+    return false;
+#endif
+}
+
+const std::vector<uint8_t>& CodeGenerator::getMachineCode() const
+{
+    return mMachineCode;
+}
+
+} // namespace Jit
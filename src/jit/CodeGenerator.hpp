@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+#include "bytecode/Program.hpp"
+#include "evaluator/Arithmetic.hpp"
+
+namespace Jit {
+
+/**
+ * @brief Class responsible for translating a compiled arithmetic expression
+ * into native x86-64 machine code
+ *
+ * The generated function reads the values of the variables straight from the operand values
+ * (indexed by symbol id) and keeps the value stack in general purpose registers, so it produces
+ * the same values as the VirtualMachine: every operation is checked (overflow flag, zero and -1
+ * divisors), and the function stops as soon as one of them fails, without telling which error
+ * happened (the interpreter is expected to find that out).
+ *
+ * Only programs whose value stack fits in the general purpose registers can be translated,
+ * and only when targeting x86-64 (other programs keep being interpreted)
+ */
+class CodeGenerator
+{
+public:
+    /// Alias representing the generated function: it takes the operand values (indexed by
+    /// symbol id, every variable of the program having a value) and the location of the result,
+    /// and returns whether the evaluation succeeded (the result is only written if it did)
+    using NativeFunction = bool (*)(const std::optional<Arithmetic::Value>* operandValues,
+                                    Arithmetic::Value* result);
+
+    /// Maximum stack depth of the programs that can be translated (one register per value,
+    /// excluding the ones holding the arguments and the ones used by divisions)
+    static constexpr uint32_t cMaxStackDepth{11};
+
+    /**
+     * @brief Class constructor
+     *
+     * @param[in] program Reference to the compiled arithmetic expression to translate
+     */
+    explicit CodeGenerator(const Bytecode::Program& program);
+
+    /**
+     * @brief Translates the program into machine code
+     *
+     * @return True if the program was translated (false if it is not supported)
+     */
+    [[nodiscard]] bool execute();
+
+    /**
+     * @brief Getter for the generated machine code
+     *
+     * @return Machine code of the native function (position independent)
+     */
+    [[nodiscard]] const std::vector<uint8_t>& getMachineCode() const;
+
+private:
+    /// Reference to the compiled arithmetic expression to translate
+    const Bytecode::Program& mProgram;
+
+    /// Machine code being generated
+    std::vector<uint8_t> mMachineCode;
+};
+
+} // namespace Jit
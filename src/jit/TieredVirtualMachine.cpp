@@ -0,0 +1,78 @@
+#include "TieredVirtualMachine.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace Jit {
+
+TieredVirtualMachine::TieredVirtualMachine(const uint32_t compilationThreshold)
+    : mCompilationThreshold{compilationThreshold}
+{
+}
+
+Evaluator::Result TieredVirtualMachine::execute(const Bytecode::Program& program,
+                                                const Evaluator::OperandValues operandValues,
+                                                ExpressionProfile& profile)
+{
+    if (!profile.nativeFunction) {
+        // Translation is only attempted once, when the threshold is reached
+        // (the count then stays past it, so failed translations are not retried)
+        if (profile.evaluationCount <= mCompilationThreshold
+            && profile.evaluationCount++ == mCompilationThreshold) {
+            profile.nativeFunction = compile(program);
+            profile.codeArena = profile.nativeFunction ? &mCodeArena : nullptr;
+        }
+
+        if (!profile.nativeFunction) {
+            return mVirtualMachine.execute(program, operandValues);
+        }
+    }
+
+    // Native code reads the variables without checking them,
+    // so expressions with unresolved dependencies are left to the interpreter
+    const auto isResolved = [&](const Symbols::SymbolId symbolId) {
+        return symbolId < operandValues.size() && operandValues[symbolId].has_value();
+    };
+    if (!std::ranges::all_of(program.variables, isResolved)) {
+        return mVirtualMachine.execute(program, operandValues);
+    }
+
+    Evaluator::Value value{};
+    if (profile.nativeFunction(operandValues.data(), &value)) {
+        return value;
+    }
+
+    // Native code only detects that an operation failed, so the interpreter finds out which one
+    return mVirtualMachine.execute(program, operandValues);
+}
+
+void TieredVirtualMachine::resetProfile(ExpressionProfile& profile)
+{
+    if (profile.nativeFunction) {
+        profile.codeArena->remove(std::bit_cast<const void*>(profile.nativeFunction));
+    }
+
+    profile = {};
+}
+
+std::size_t TieredVirtualMachine::getCodeArenaSize() const
+{
+    return mCodeArena.getMappedSize();
+}
+
+CodeGenerator::NativeFunction TieredVirtualMachine::compile(const Bytecode::Program& program)
+{
+    if (program.instructions.size() < cMinInstructionCount) {
+        return nullptr;
+    }
+
+    CodeGenerator codeGenerator(program);
+    if (!codeGenerator.execute()) {
+        return nullptr;
+    }
+
+    const auto* code = mCodeArena.add(codeGenerator.getMachineCode());
+    return code ? std::bit_cast<CodeGenerator::NativeFunction>(code) : nullptr;
+}
+
+} // namespace Jit
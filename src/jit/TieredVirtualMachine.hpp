@@ -0,0 +1,111 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "bytecode/Program.hpp"
+#include "evaluator/Evaluator.hpp"
+#include "evaluator/VirtualMachine.hpp"
+#include "jit/CodeArena.hpp"
+#include "jit/CodeGenerator.hpp"
+
+namespace Jit {
+
+/**
+ * @brief Class responsible for executing compiled arithmetic expressions in tiers
+ *
+ * Expressions are interpreted by a VirtualMachine until they were evaluated a given amount of
+ * times, and are then translated into native code (kept in the profile of each expression),
+ * which runs every later evaluation whose variables all have a value.
+ * Expressions that are too short or cannot be translated, as well as evaluations with unresolved
+ * dependencies, keep being interpreted, and failed native evaluations are interpreted again
+ * to report their error, so results are always the same
+ */
+class TieredVirtualMachine
+{
+public:
+    /// Default amount of evaluations of an expression before it is translated into native code
+    static constexpr uint32_t cDefaultCompilationThreshold{256};
+
+    /// Minimum amount of instructions of the expressions translated into native code
+    /// (shorter ones are cheaper to interpret than to call, once many of them are hot and their
+    /// native code no longer fits in the instruction cache and branch predictors)
+    static constexpr std::size_t cMinInstructionCount{16};
+
+    /**
+     * @brief Execution profile of an expression
+     * (it must be reset through resetProfile when the expression changes)
+     */
+    struct ExpressionProfile
+    {
+        /// Amount of evaluations of the expression (up to the compilation threshold)
+        uint32_t evaluationCount{};
+        /// Native translation of the expression (nullptr while interpreted)
+        CodeGenerator::NativeFunction nativeFunction{};
+        /// Arena holding the native translation (nullptr while interpreted)
+        CodeArena* codeArena{};
+    };
+
+    /**
+     * @brief Class constructor
+     *
+     * @param[in] compilationThreshold Amount of evaluations of an expression
+     * before it is translated into native code
+     */
+    explicit TieredVirtualMachine(uint32_t compilationThreshold = cDefaultCompilationThreshold);
+
+    /**
+     * @brief Executes a compiled arithmetic expression and outputs a result
+     *
+     * Native code is owned by the tiered virtual machine that generated it,
+     * so profiles must not outlive it
+     *
+     * @param[in] program Compiled arithmetic expression to execute
+     * @param[in] operandValues Values of the operands, indexed by their symbol id
+     * @param[in,out] profile Execution profile of the expression
+     *
+     * @return Result of the arithmetic expression (the same as the one of the VirtualMachine)
+     */
+    [[nodiscard]] Evaluator::Result execute(const Bytecode::Program& program,
+                                            Evaluator::OperandValues operandValues,
+                                            ExpressionProfile& profile);
+
+    /**
+     * @brief Resets the profile of an expression, releasing its native translation (if any)
+     * back to the arena of the tiered virtual machine that generated it
+     *
+     * No thread may be executing the expression while its profile is reset
+     *
+     * @param[in,out] profile Execution profile to reset
+     */
+    static void resetProfile(ExpressionProfile& profile);
+
+    /**
+     * @brief Getter for the amount of executable memory mapped for the translated expressions
+     *
+     * @return Size of the code arena, in bytes
+     */
+    [[nodiscard]] std::size_t getCodeArenaSize() const;
+
+private:
+    /**
+     * @brief Translates an expression into native code
+     *
+     * @param[in] program Compiled arithmetic expression to translate
+     *
+     * @return Native translation of the expression (nullptr if it cannot be translated)
+     */
+    [[nodiscard]] CodeGenerator::NativeFunction compile(const Bytecode::Program& program);
+
+private:
+    /// Amount of evaluations of an expression before it is translated into native code
+    uint32_t mCompilationThreshold;
+
+    /// Interpreter running the expressions that were not translated
+    VirtualMachine mVirtualMachine;
+
+    /// Executable memory holding the translated expressions
+    CodeArena mCodeArena;
+};
+
+} // namespace Jit
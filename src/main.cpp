@@ -1,27 +1,337 @@
 
+#include <csignal>
+
+#include <array>
+#include <charconv>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <string_view>
 
+#include "calculator/BatchRunner.hpp"
+#include "calculator/ReplayRunner.hpp"
 #include "calculator/Runner.hpp"
+#include "io/MappedFile.hpp"
+#include "server/SessionServer.hpp"
+#include "utils/Methods.hpp"
+
+namespace {
+/// Command line option used to enable the batch mode
+constexpr std::string_view cBatchOption{"--batch"};
+/// Command line option used to enable the (memory mapped) replay mode
+constexpr std::string_view cReplayOption{"--replay"};
+/// Command line option used to enable the server mode
+constexpr std::string_view cServeOption{"--serve"};
+/// Command line option used to trace the instructions (preceding the other options)
+constexpr std::string_view cTraceOption{"--trace"};
+/// Command line option used to evaluate lazily (preceding the other options)
+constexpr std::string_view cLazyOption{"--lazy"};
+/// Command line option used to start from a snapshot (preceding the other options)
+constexpr std::string_view cLoadOption{"--load"};
+/// Command line option used to journal (and recover) the session (preceding the other options)
+constexpr std::string_view cJournalOption{"--journal"};
+/// Input file name used to read the batch instructions from stdin
+constexpr std::string_view cStandardInputFileName{"-"};
+/// Size of the buffers used by the batch mode (for both input and output)
+constexpr std::size_t cBatchBufferSize{1U << 20U};
 
-int main([[maybe_unused]] int argc, [[maybe_unused]] char* argv[])
+/**
+ * @brief Options applied to the calculator of every mode but the server one
+ */
+struct RunnerOptions
 {
-    Calculator::Runner calculator;
+    /// Name of the trace file (empty if tracing was not requested)
+    std::string_view traceFileName;
+    /// Evaluation mode of the expressions depending on updated values
+    Calculator::State::EvaluationMode evaluationMode{Calculator::State::EvaluationMode::EAGER};
+    /// Name of the snapshot to start from (empty to start from scratch)
+    std::string_view snapshotFileName;
+    /// Name of the journal to recover and append to (empty if journaling was not requested)
+    std::string_view journalFileName;
+};
 
-    const auto getUserInputString = [] {
-        std::cout << "\nInput Arithmetic expression to evaluate: ";
-        std::string input;
-        std::getline(std::cin, input);
+/**
+ * @brief Prints the supported command line options
+ *
+ * @param[in] programName Name of the executable
+ */
+void printUsage(const std::string_view programName)
+{
+    std::cerr << "Usage: " << programName << " [" << cTraceOption << " <trace>] [" << cLazyOption
+              << "] [" << cLoadOption << " <snapshot>] [" << cJournalOption << " <journal>] ["
+              << cBatchOption << " [<file>|"
+              << cStandardInputFileName << "] | " << cReplayOption << " <file> | " << cServeOption
+              << " <socket> [<threads>]]\n";
 
-        return input;
+    // Descriptions (and their continuation lines) all start at the same column
+    constexpr int cSyntaxWidth{22};
+    const auto printOption = [](const std::string& syntax, const std::string_view description) {
+        std::cerr << std::left << std::setw(cSyntaxWidth) << "  " + syntax << description << "\n";
     };
+    const auto printNote = [&printOption](const std::string_view note) { printOption({}, note); };
+    const auto withArgument = [](const std::string_view option, const std::string_view argument) {
+        return std::string{option} + " " + std::string{argument};
+    };
+
+    printOption("(no options)", "Interactive mode");
+    printOption(withArgument(cBatchOption, "[<file>]"),
+                "Process every instruction of <file> (or stdin) until EOF");
+    printOption(withArgument(cReplayOption, "<file>"),
+                "Memory map <file> and process every instruction it holds");
+    printOption(withArgument(cServeOption, "<socket>"),
+                "Serve a session per client connected to the Unix socket");
+    printNote("(on <threads> event loops, one per core by default)");
+    printOption(withArgument(cTraceOption, "<trace>"),
+                "Write a Chrome trace-event JSON file of the instructions");
+    printNote("(not supported by the server mode)");
+    printOption(std::string{cLazyOption}, "Only evaluate the expressions whose values are read");
+    printNote("(not supported by the server mode)");
+    printOption(withArgument(cLoadOption, "<snapshot>"),
+                "Start from a snapshot saved by the \"save <file>\" instruction");
+    printNote("(not supported by the server mode)");
+    printOption(withArgument(cJournalOption, "<journal>"),
+                "Recover the session of <journal>, then journal the instructions");
+    printNote("(not supported by the server mode)");
+}
+
+/**
+ * @brief Applies the requested options to a calculator
+ *
+ * @param[in,out] calculator Calculator to set up
+ * @param[in] options Options to apply
+ *
+ * @return True if every option was applied (false otherwise)
+ */
+bool setupRunner(Calculator::Runner& calculator, const RunnerOptions& options)
+{
+    calculator.setEvaluationMode(options.evaluationMode);
+
+    if (!options.snapshotFileName.empty()
+        && !calculator.loadSnapshot(std::string{options.snapshotFileName})) {
+        return false;
+    }
+
+    // The journal is recovered on top of the loaded snapshot (if any)
+    if (!options.journalFileName.empty()
+        && !calculator.openJournal(std::string{options.journalFileName})) {
+        return false;
+    }
+
+    return options.traceFileName.empty()
+           || calculator.enableTracing(std::string{options.traceFileName});
+}
+
+/**
+ * @brief Runs the calculator interactively, prompting for every instruction (until EOF)
+ *
+ * @param[in] options Options of the calculator
+ *
+ * @return Exit code
+ */
+int runInteractiveMode(const RunnerOptions& options)
+{
+    Calculator::Runner calculator;
+    if (!setupRunner(calculator, options)) {
+        return 1;
+    }
 
+    std::string input;
     while (true) {
-        const auto operationResults = calculator.processInstruction(getUserInputString());
+        std::cout << "\nInput Arithmetic expression to evaluate: ";
+        if (!std::getline(std::cin, input)) {
+            break;
+        }
+
+        Calculator::writeResults(
+              calculator.processInstruction(Utils::Methods::removeLineEnding(input)), std::cout);
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Disables the synchronization with C streams and installs a large stdout buffer
+ *
+ * Must be called before any I/O is performed on the standard streams
+ */
+void setupBufferedOutput()
+{
+    static std::array<char, cBatchBufferSize> outputBuffer;
+
+    std::ios_base::sync_with_stdio(false);
+    std::cin.tie(nullptr);
+    std::cout.rdbuf()->pubsetbuf(outputBuffer.data(), outputBuffer.size());
+}
+
+/**
+ * @brief Reports the summary of a non-interactive execution to stderr
+ *
+ * @param[in] statistics Statistics of the execution
+ */
+void printStatistics(const Calculator::BatchRunner::Statistics& statistics)
+{
+    std::cerr << "Instructions: " << statistics.instructionCount << "\n"
+              << "Wall time: " << statistics.wallTime.count() << " s\n"
+              << "Throughput: " << statistics.getInstructionsPerSecond() << " instructions/s\n";
+}
+
+/**
+ * @brief Runs the calculator over every instruction of a file (or stdin), without prompts
+ *
+ * Results are written through a large output buffer and a summary
+ * (instruction count, wall time and throughput) is reported to stderr at the end.
+ *
+ * @param[in] inputFileName Name of the file holding the instructions ("-" for stdin)
+ * @param[in] options Options of the calculator
+ *
+ * @return Exit code
+ */
+int runBatchMode(const std::string_view inputFileName, const RunnerOptions& options)
+{
+    static std::array<char, cBatchBufferSize> inputBuffer;
+
+    setupBufferedOutput();
+
+    std::ifstream inputFile;
+    if (inputFileName != cStandardInputFileName) {
+        inputFile.rdbuf()->pubsetbuf(inputBuffer.data(), inputBuffer.size());
+        inputFile.open(std::string{inputFileName});
 
-        for (auto itr = operationResults.cbegin(); itr != operationResults.cend(); ++itr) {
-            std::cout << *itr << (std::next(itr) != operationResults.cend() ? ", " : "\n");
+        if (!inputFile) {
+            std::cerr << "Unable to open input file: " << inputFileName << "\n";
+            return 1;
         }
     }
 
+    Calculator::BatchRunner batchRunner(inputFile.is_open() ? inputFile : std::cin, std::cout);
+    if (!setupRunner(batchRunner.getRunner(), options)) {
+        return 1;
+    }
+    printStatistics(batchRunner.execute());
+
+    return 0;
+}
+
+/**
+ * @brief Runs the calculator over every instruction of a memory mapped file, without prompts
+ *
+ * Instructions are handed to the calculator as views into the mapping (they are never copied).
+ * Results and the final summary are reported just like in the batch mode.
+ *
+ * @param[in] inputFileName Name of the file holding the instructions
+ * @param[in] options Options of the calculator
+ *
+ * @return Exit code
+ */
+int runReplayMode(const std::string_view inputFileName, const RunnerOptions& options)
+{
+    setupBufferedOutput();
+
+    IO::MappedFile inputFile;
+    if (!inputFile.open(std::string{inputFileName})) {
+        return 1;
+    }
+
+    Calculator::ReplayRunner replayRunner(inputFile.getContents(), std::cout);
+    if (!setupRunner(replayRunner.getRunner(), options)) {
+        return 1;
+    }
+    printStatistics(replayRunner.execute());
+
+    return 0;
+}
+
+/**
+ * @brief Serves calculator sessions over a Unix domain socket until SIGINT or SIGTERM is received
+ *
+ * @param[in] socketPath Path of the socket to listen on
+ * @param[in] threadCount Amount of event loops (0 runs one per available core)
+ *
+ * @return Exit code
+ */
+int runServerMode(const std::string_view socketPath, const std::size_t threadCount)
+{
+    // Termination signals are blocked before any thread is spawned (so that every thread
+    // inherits the mask) and then waited for synchronously
+    sigset_t terminationSignals;
+    sigemptyset(&terminationSignals);
+    sigaddset(&terminationSignals, SIGINT);
+    sigaddset(&terminationSignals, SIGTERM);
+    ::pthread_sigmask(SIG_BLOCK, &terminationSignals, nullptr);
+
+    Server::SessionServer server(
+          {.socketPath = std::string{socketPath}, .threadCount = threadCount});
+    if (!server.start()) {
+        return 1;
+    }
+
+    std::cerr << "Serving sessions on " << socketPath << " (" << server.getThreadCount()
+              << " threads)\n";
+
+    int signal{};
+    ::sigwait(&terminationSignals, &signal);
+
+    std::cerr << "Stopping (" << server.getSessionCount() << " open sessions)\n";
+    server.stop();
+
     return 0;
 }
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    const std::string_view programName{argc > 0 ? argv[0] : "Calculator-Challenge"};
+
+    // The trace, lazy, load and journal options precede the options of the mode
+    // (which are then handled as usual)
+    RunnerOptions options;
+    bool hasRunnerOptions{false};
+    while (argc >= 2) {
+        if (argc >= 3 && argv[1] == cTraceOption) {
+            options.traceFileName = argv[2];
+            argv += 2;
+            argc -= 2;
+        } else if (argc >= 3 && argv[1] == cLoadOption) {
+            options.snapshotFileName = argv[2];
+            argv += 2;
+            argc -= 2;
+        } else if (argc >= 3 && argv[1] == cJournalOption) {
+            options.journalFileName = argv[2];
+            argv += 2;
+            argc -= 2;
+        } else if (argv[1] == cLazyOption) {
+            options.evaluationMode = Calculator::State::EvaluationMode::LAZY;
+            ++argv;
+            --argc;
+        } else {
+            break;
+        }
+        hasRunnerOptions = true;
+    }
+
+    if (argc == 1) {
+        return runInteractiveMode(options);
+    }
+
+    if (argc <= 3 && argv[1] == cBatchOption) {
+        return runBatchMode(argc == 3 ? argv[2] : cStandardInputFileName, options);
+    }
+
+    if (argc == 3 && argv[1] == cReplayOption) {
+        return runReplayMode(argv[2], options);
+    }
+
+    if ((argc == 3 || argc == 4) && argv[1] == cServeOption && !hasRunnerOptions) {
+        std::size_t threadCount{0};
+        const std::string_view threads{argc == 4 ? argv[3] : "0"};
+
+        if (const auto [end, errorCode]
+            = std::from_chars(threads.data(), threads.data() + threads.size(), threadCount);
+            errorCode == std::errc{} && end == threads.data() + threads.size()) {
+            return runServerMode(argv[2], threadCount);
+        }
+    }
+
+    printUsage(programName);
+    return 1;
+}
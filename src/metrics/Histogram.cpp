@@ -0,0 +1,90 @@
+#include "Histogram.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace Metrics {
+
+void Histogram::record(const uint64_t value)
+{
+    ++mBucketCounts[getBucketIndex(std::min(value, cMaxTrackedValue))];
+    ++mCount;
+    mSum += value;
+    mMin = std::min(mMin, value);
+    mMax = std::max(mMax, value);
+}
+
+uint64_t Histogram::getCount() const
+{
+    return mCount;
+}
+
+uint64_t Histogram::getMin() const
+{
+    return mCount > 0 ? mMin : 0;
+}
+
+uint64_t Histogram::getMax() const
+{
+    return mMax;
+}
+
+double Histogram::getMean() const
+{
+    return mCount > 0 ? static_cast<double>(mSum) / static_cast<double>(mCount) : 0.0;
+}
+
+uint64_t Histogram::getValueAtPercentile(const double percentile) const
+{
+    if (mCount == 0) {
+        return 0;
+    }
+
+    // Rank of the value holding the percentile (at least the first value)
+    const auto rank = std::max(
+          uint64_t{1},
+          static_cast<uint64_t>(std::ceil(std::clamp(percentile, 0.0, 100.0) / 100.0
+                                          * static_cast<double>(mCount))));
+
+    uint64_t cumulativeCount{0};
+    for (std::size_t bucketIndex = 0; bucketIndex < mBucketCounts.size(); ++bucketIndex) {
+        cumulativeCount += mBucketCounts[bucketIndex];
+        if (cumulativeCount >= rank) {
+            // Values beyond the tracked ones are all counted in the last bucket
+            return bucketIndex + 1 == mBucketCounts.size()
+                         ? mMax
+                         : std::min(getBucketHighestValue(bucketIndex), mMax);
+        }
+    }
+
+    return mMax;
+}
+
+std::size_t Histogram::getBucketIndex(const uint64_t value)
+{
+    if (value < cSubBucketCount) {
+        return static_cast<std::size_t>(value);
+    }
+
+    // Values in [2^k, 2^(k+1)) are split by their cSubBucketBits highest bits
+    const auto shift = static_cast<uint32_t>(std::bit_width(value)) - cSubBucketBits;
+    const auto subBucket = (value >> shift) - cHalfSubBucketCount;
+
+    return static_cast<std::size_t>(cSubBucketCount + (shift - 1) * cHalfSubBucketCount
+                                    + subBucket);
+}
+
+uint64_t Histogram::getBucketHighestValue(const std::size_t bucketIndex)
+{
+    if (bucketIndex < cSubBucketCount) {
+        return bucketIndex;
+    }
+
+    const auto shift = (bucketIndex - cSubBucketCount) / cHalfSubBucketCount + 1;
+    const auto subBucket = (bucketIndex - cSubBucketCount) % cHalfSubBucketCount;
+
+    return (((cHalfSubBucketCount + subBucket + 1) << shift) - 1);
+}
+
+} // namespace Metrics
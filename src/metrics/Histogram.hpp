@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Metrics {
+
+/**
+ * @brief Histogram of non-negative integer values (e.g. latencies in nanoseconds) with a bounded
+ * relative error, in the style of HdrHistogram
+ *
+ * Values are counted in log-linear buckets: every power of two is split into the same amount of
+ * linear sub-buckets, so each value is counted in a bucket at most 1/16 wider than the value
+ * (values below 32 are counted exactly).
+ * Recording a value is a few arithmetic instructions and an increment, without any allocation.
+ */
+class Histogram
+{
+public:
+    /// Largest value counted in its own bucket (larger values are counted in the last bucket,
+    /// while still being reported as the maximum)
+    static constexpr uint64_t cMaxTrackedValue{(uint64_t{1} << 36U) - 1};
+
+    /**
+     * @brief Counts a value
+     *
+     * @param[in] value Value to count
+     */
+    void record(uint64_t value);
+
+    /**
+     * @brief Getter for the amount of counted values
+     *
+     * @return Amount of counted values
+     */
+    [[nodiscard]] uint64_t getCount() const;
+
+    /**
+     * @brief Getter for the smallest counted value
+     *
+     * @return Smallest counted value (0 if none was counted)
+     */
+    [[nodiscard]] uint64_t getMin() const;
+
+    /**
+     * @brief Getter for the largest counted value
+     *
+     * @return Largest counted value (0 if none was counted)
+     */
+    [[nodiscard]] uint64_t getMax() const;
+
+    /**
+     * @brief Getter for the mean of the counted values
+     *
+     * @return Mean of the counted values (0 if none was counted)
+     */
+    [[nodiscard]] double getMean() const;
+
+    /**
+     * @brief Retrieves the value below which a given percentage of the counted values lie
+     *
+     * @param[in] percentile Percentage of the counted values (0 to 100)
+     *
+     * @return Highest value of the bucket holding the percentile, capped by the largest counted
+     * value (0 if none was counted)
+     */
+    [[nodiscard]] uint64_t getValueAtPercentile(double percentile) const;
+
+private:
+    /// Amount of bits of the values distinguished within each power of two
+    static constexpr uint32_t cSubBucketBits{5};
+    /// Amount of values counted exactly (and of sub-buckets of the first power of two)
+    static constexpr uint64_t cSubBucketCount{uint64_t{1} << cSubBucketBits};
+    /// Amount of sub-buckets of every following power of two
+    static constexpr uint64_t cHalfSubBucketCount{cSubBucketCount / 2};
+    /// Amount of buckets needed to count every tracked value
+    static constexpr std::size_t cBucketCount{
+          cSubBucketCount + (36 - cSubBucketBits) * cHalfSubBucketCount};
+
+    /**
+     * @brief Finds the bucket counting a value
+     *
+     * @param[in] value Value to count (at most cMaxTrackedValue)
+     *
+     * @return Index of the bucket
+     */
+    [[nodiscard]] static std::size_t getBucketIndex(uint64_t value);
+
+    /**
+     * @brief Retrieves the highest value counted in a bucket
+     *
+     * @param[in] bucketIndex Index of the bucket
+     *
+     * @return Highest value of the bucket
+     */
+    [[nodiscard]] static uint64_t getBucketHighestValue(std::size_t bucketIndex);
+
+private:
+    /// Amount of values counted in each bucket
+    std::array<uint64_t, cBucketCount> mBucketCounts{};
+
+    /// Amount of counted values
+    uint64_t mCount{};
+
+    /// Sum of the counted values (used for the mean)
+    uint64_t mSum{};
+
+    /// Smallest counted value
+    uint64_t mMin{UINT64_MAX};
+
+    /// Largest counted value
+    uint64_t mMax{};
+};
+
+} // namespace Metrics
@@ -0,0 +1,219 @@
+#include "TraceWriter.hpp"
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+
+namespace {
+/// Identifier of the process every event is attributed to
+constexpr int cProcessId{1};
+
+/**
+ * @brief Writes a string as a JSON string literal (quoted and escaped)
+ *
+ * @param[in,out] output Stream to write the string literal to
+ * @param[in] text String to write
+ */
+void writeJSONString(std::ostream& output, const std::string_view text)
+{
+    constexpr std::array<char, 16> cHexDigits{
+          '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
+
+    output << '"';
+    for (const auto character : text) {
+        if (character == '"' || character == '\\') {
+            output << '\\' << character;
+        } else if (static_cast<unsigned char>(character) < 0x20U) {
+            const auto code = static_cast<unsigned char>(character);
+            output << "\\u00" << cHexDigits[code >> 4U] << cHexDigits[code & 0xFU];
+        } else {
+            output << character;
+        }
+    }
+    output << '"';
+}
+
+/**
+ * @brief Writes a duration in nanoseconds as microseconds (the time unit of trace events)
+ *
+ * @param[in,out] output Stream to write the duration to
+ * @param[in] nanoseconds Duration to write
+ */
+void writeMicroseconds(std::ostream& output, const uint64_t nanoseconds)
+{
+    const auto fraction = nanoseconds % 1000;
+    output << nanoseconds / 1000 << '.' << (fraction < 100 ? "0" : "") << (fraction < 10 ? "0" : "")
+           << fraction;
+}
+} // namespace
+
+namespace Metrics {
+
+TraceWriter::TraceWriter(const std::size_t threadCount)
+    : mStartTime{std::chrono::steady_clock::now()}
+    , mBuffers(std::max<std::size_t>(threadCount, 1))
+{
+    for (auto& buffer : mBuffers) {
+        buffer.reserve(cBufferCapacity);
+    }
+}
+
+TraceWriter::~TraceWriter()
+{
+    if (!mWriter.joinable()) {
+        return;
+    }
+
+    flush();
+    {
+        const std::lock_guard lock{mMutex};
+        mIsStopping = true;
+    }
+    mBufferHandedOff.notify_one();
+    mWriter.join();
+
+    mFile << "\n]}\n";
+}
+
+bool TraceWriter::open(const std::string& fileName, const std::vector<std::string>& threadNames)
+{
+    if (mWriter.joinable()) {
+        std::cerr << "Trace file already opened\n";
+        return false;
+    }
+
+    mFile.open(fileName, std::ios::trunc);
+    if (!mFile) {
+        std::cerr << "Unable to open trace file: " << fileName << "\n";
+        return false;
+    }
+
+    mFile << R"({"displayTimeUnit":"ns","traceEvents":[)";
+
+    // Tracks are named through metadata events
+    for (std::size_t thread = 0; thread < std::min(threadNames.size(), mBuffers.size());
+         ++thread) {
+        mFile << (mIsFirstEvent ? "\n" : ",\n") << R"({"ph":"M","name":"thread_name","pid":)"
+              << cProcessId << R"(,"tid":)" << thread << R"(,"args":{"name":)";
+        writeJSONString(mFile, threadNames[thread]);
+        mFile << "}}";
+        mIsFirstEvent = false;
+    }
+
+    mWriter = std::thread{[this] { writeLoop(); }};
+    return true;
+}
+
+uint64_t TraceWriter::now() const
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                       std::chrono::steady_clock::now() - mStartTime)
+                                       .count());
+}
+
+void TraceWriter::record(const std::size_t thread, Event&& event)
+{
+    auto& buffer = mBuffers[thread];
+    buffer.push_back(std::move(event));
+
+    if (buffer.size() >= cBufferCapacity) {
+        handOff(thread);
+    }
+}
+
+void TraceWriter::flush()
+{
+    for (std::size_t thread = 0; thread < mBuffers.size(); ++thread) {
+        if (!mBuffers[thread].empty()) {
+            handOff(thread);
+        }
+    }
+}
+
+void TraceWriter::handOff(const std::size_t thread)
+{
+    // Events are dropped if nothing is writing them
+    if (!mWriter.joinable()) {
+        mBuffers[thread].clear();
+        return;
+    }
+
+    std::vector<Event> replacement;
+    {
+        const std::lock_guard lock{mMutex};
+        mPendingBuffers.emplace_back(thread, std::move(mBuffers[thread]));
+
+        if (!mRecycledBuffers.empty()) {
+            replacement = std::move(mRecycledBuffers.back());
+            mRecycledBuffers.pop_back();
+        }
+    }
+    mBufferHandedOff.notify_one();
+
+    replacement.reserve(cBufferCapacity);
+    mBuffers[thread] = std::move(replacement);
+}
+
+void TraceWriter::writeLoop()
+{
+    std::vector<PendingBuffer> pendingBuffers;
+
+    while (true) {
+        {
+            std::unique_lock lock{mMutex};
+            mBufferHandedOff.wait(lock,
+                                  [this] { return mIsStopping || !mPendingBuffers.empty(); });
+
+            // Written buffers are recycled by the recording threads
+            for (auto& [_, events] : pendingBuffers) {
+                events.clear();
+                mRecycledBuffers.push_back(std::move(events));
+            }
+            pendingBuffers.clear();
+
+            if (mPendingBuffers.empty()) {
+                return; // Stopping, and every buffer was written
+            }
+            std::swap(pendingBuffers, mPendingBuffers);
+        }
+
+        for (const auto& [thread, events] : pendingBuffers) {
+            for (const auto& event : events) {
+                writeEvent(thread, event);
+            }
+        }
+        mFile.flush();
+    }
+}
+
+void TraceWriter::writeEvent(const std::size_t thread, const Event& event)
+{
+    mFile << (mIsFirstEvent ? "\n" : ",\n") << R"({"ph":"X","pid":)" << cProcessId
+          << R"(,"tid":)" << thread << R"(,"name":)";
+    writeJSONString(mFile, event.name);
+    mFile << R"(,"cat":)";
+    writeJSONString(mFile, event.category);
+    mFile << R"(,"ts":)";
+    writeMicroseconds(mFile, event.startTime);
+    mFile << R"(,"dur":)";
+    writeMicroseconds(mFile, event.duration);
+
+    mFile << R"(,"args":{)";
+    bool isFirstArgument{true};
+    for (const auto& [name, value] : event.arguments) {
+        if (name.empty()) {
+            continue;
+        }
+
+        mFile << (isFirstArgument ? "" : ",");
+        writeJSONString(mFile, name);
+        mFile << ':';
+        writeJSONString(mFile, value);
+        isFirstArgument = false;
+    }
+    mFile << "}}";
+
+    mIsFirstEvent = false;
+}
+
+} // namespace Metrics
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace Metrics {
+
+/**
+ * @brief Writer of Chrome trace-event JSON files (loadable by chrome://tracing and Perfetto)
+ *
+ * Every recording thread owns a buffer of events, which is handed off to a background thread
+ * once full (or when the writer is flushed), so recording an event never formats nor writes
+ * anything. The background thread formats the handed off events as complete ("X") events,
+ * one track per recording thread, and recycles their buffers.
+ */
+class TraceWriter
+{
+public:
+    /// Maximum amount of arguments of an event
+    static constexpr std::size_t cMaxArgumentCount{2};
+
+    /// Amount of events a buffer holds before it is handed off to the background thread
+    static constexpr std::size_t cBufferCapacity{4096};
+
+    /**
+     * @brief Named argument of an event (unused if its name is empty)
+     */
+    struct Argument
+    {
+        /// Name of the argument (it must outlive the writer, e.g. a string literal)
+        std::string_view name;
+        /// Value of the argument
+        std::string value;
+    };
+
+    /**
+     * @brief Span of time spent by a thread on a named piece of work
+     */
+    struct Event
+    {
+        /// Name of the event
+        std::string name;
+        /// Category of the event (it must outlive the writer, e.g. a string literal)
+        std::string_view category;
+        /// Start of the event, in nanoseconds since the writer was created
+        uint64_t startTime{};
+        /// Duration of the event, in nanoseconds
+        uint64_t duration{};
+        /// Arguments of the event
+        std::array<Argument, cMaxArgumentCount> arguments{};
+    };
+
+    /**
+     * @brief Class constructor
+     *
+     * @param[in] threadCount Amount of recording threads (each of them owns a track)
+     */
+    explicit TraceWriter(std::size_t threadCount = 1);
+
+    /**
+     * @brief Class destructor (flushes every buffered event and closes the file)
+     */
+    ~TraceWriter();
+
+    TraceWriter(const TraceWriter&) = delete;
+    TraceWriter& operator=(const TraceWriter&) = delete;
+    TraceWriter(TraceWriter&&) = delete;
+    TraceWriter& operator=(TraceWriter&&) = delete;
+
+    /**
+     * @brief Opens the file to write the events to and starts the background thread
+     *
+     * @param[in] fileName Name of the file (it is truncated)
+     * @param[in] threadNames Names of the tracks of the recording threads (optional)
+     *
+     * @return True if the file was opened (false otherwise)
+     */
+    [[nodiscard]] bool open(const std::string& fileName,
+                            const std::vector<std::string>& threadNames = {});
+
+    /**
+     * @brief Retrieves the current time of the trace
+     *
+     * @return Nanoseconds since the writer was created
+     */
+    [[nodiscard]] uint64_t now() const;
+
+    /**
+     * @brief Records an event
+     *
+     * A recording thread must only use its own index, and no two threads can share one
+     *
+     * @param[in] thread Index of the recording thread (below the amount of recording threads)
+     * @param[in] event Event to record
+     */
+    void record(std::size_t thread, Event&& event);
+
+    /**
+     * @brief Hands off every buffered event to the background thread
+     *
+     * No other thread may be recording events at the same time
+     */
+    void flush();
+
+private:
+    /// Alias representing a buffer of events and the index of the thread that recorded them
+    using PendingBuffer = std::pair<std::size_t, std::vector<Event>>;
+
+    /**
+     * @brief Hands off the buffer of a recording thread to the background thread,
+     * replacing it with a recycled one
+     *
+     * @param[in] thread Index of the recording thread
+     */
+    void handOff(std::size_t thread);
+
+    /**
+     * @brief Body of the background thread: writes the handed off buffers until stopped
+     */
+    void writeLoop();
+
+    /**
+     * @brief Writes an event to the file (as a JSON object)
+     *
+     * @param[in] thread Index of the thread that recorded the event
+     * @param[in] event Event to write
+     */
+    void writeEvent(std::size_t thread, const Event& event);
+
+private:
+    /// Reference point of the timestamps of the events
+    std::chrono::steady_clock::time_point mStartTime;
+
+    /// Buffer of events of each recording thread
+    std::vector<std::vector<Event>> mBuffers;
+
+    /// File the events are written to
+    std::ofstream mFile;
+
+    /// Whether no event was written yet (the following ones are comma separated)
+    bool mIsFirstEvent{true};
+
+    /// Background thread writing the handed off buffers
+    std::thread mWriter;
+
+    /// Synchronization of the hand-offs
+    std::mutex mMutex;
+    std::condition_variable mBufferHandedOff;
+    std::vector<PendingBuffer> mPendingBuffers;
+    std::vector<std::vector<Event>> mRecycledBuffers;
+    bool mIsStopping{false};
+};
+
+} // namespace Metrics
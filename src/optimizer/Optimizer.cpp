@@ -0,0 +1,386 @@
+#include "Optimizer.hpp"
+
+#include <algorithm>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+#include "evaluator/Arithmetic.hpp"
+#include "utils/Constants.hpp"
+
+namespace {
+using namespace Utils::Constants;
+
+/**
+ * @brief Copies the nodes reachable from the root of a tree into a new tree
+ *
+ * @param[in] tree Tree to copy
+ * @param[in] rootNodeIndex Index of the root node
+ *
+ * @return Tree holding only the reachable nodes (with the root as its last node)
+ */
+AST::Tree copyReachableNodes(const AST::Tree& tree, const AST::NodeIndex rootNodeIndex)
+{
+    AST::Tree reachableTree(tree.size());
+    std::vector<AST::NodeIndex> copiedNodeIndices(tree.size(), AST::cInvalidNodeIndex);
+
+    // Iterative postorder traversal of the tree:
+    // each entry holds a node index and whether its children were already copied
+    std::vector<std::pair<AST::NodeIndex, bool>> pendingNodes{{rootNodeIndex, false}};
+    while (!pendingNodes.empty()) {
+        const auto [nodeIndex, childrenCopied] = pendingNodes.back();
+        pendingNodes.pop_back();
+
+        const auto& node = tree.getNode(nodeIndex);
+        switch (node.getNodeType()) {
+        case AST::NodeType::LITERAL:
+            copiedNodeIndices[nodeIndex] = reachableTree.addLiteralNode(node.getNodeValue());
+            break;
+        case AST::NodeType::CONSTANT:
+            copiedNodeIndices[nodeIndex]
+                  = reachableTree.addConstantNode(tree.getConstantValue(node));
+            break;
+        case AST::NodeType::VARIABLE:
+            copiedNodeIndices[nodeIndex] = reachableTree.addVariableNode(node.getNodeValue());
+            break;
+        case AST::NodeType::OPERATOR:
+            if (!childrenCopied) {
+                pendingNodes.emplace_back(nodeIndex, true);
+                pendingNodes.emplace_back(node.getRightNodeIndex(), false);
+                pendingNodes.emplace_back(node.getLeftNodeIndex(), false);
+                continue;
+            }
+
+            copiedNodeIndices[nodeIndex]
+                  = reachableTree.addOperatorNode(static_cast<char>(node.getNodeValue()),
+                                                  copiedNodeIndices[node.getLeftNodeIndex()],
+                                                  copiedNodeIndices[node.getRightNodeIndex()]);
+            break;
+        }
+    }
+
+    return reachableTree;
+}
+} // namespace
+
+Optimizer::Optimizer(const AST::Tree& ast)
+    : mAst{ast}
+{
+}
+
+bool Optimizer::execute()
+{
+    if (mAst.empty()) {
+        std::cerr << "Empty AST\n";
+        return false;
+    }
+
+    mOptimizedAST = std::make_shared<AST::Tree>(mAst.size());
+    mOptimizedTerms.clear();
+    mOptimizedTerms.reserve(mAst.size());
+    mHasDiscardedNodes = false;
+    mVariables.clear();
+
+    // Children are always stored before their parent, so a single pass in storage order
+    // simplifies the operands of every node before the node itself
+    std::vector<Term> terms;
+    terms.reserve(mAst.size());
+
+    for (AST::NodeIndex nodeIndex = 0; nodeIndex < mAst.size(); ++nodeIndex) {
+        const auto& node = mAst.getNode(nodeIndex);
+
+        switch (node.getNodeType()) {
+        case AST::NodeType::LITERAL:
+        case AST::NodeType::CONSTANT: {
+            const auto value = node.getNodeType() == AST::NodeType::LITERAL
+                                     ? int64_t{node.getNodeValue()}
+                                     : mAst.getConstantValue(node);
+            terms.push_back(makeConstant(value));
+            break;
+        }
+
+        case AST::NodeType::VARIABLE: {
+            const auto symbolId = node.getNodeValue();
+            if (std::ranges::find(mVariables, symbolId) == mVariables.cend()) {
+                mVariables.push_back(symbolId);
+            }
+
+            const Term variable{mOptimizedAST->addVariableNode(symbolId), 0};
+            mOptimizedTerms.push_back(variable);
+            terms.push_back(variable);
+            break;
+        }
+
+        case AST::NodeType::OPERATOR:
+            if (node.getLeftNodeIndex() >= nodeIndex || node.getRightNodeIndex() >= nodeIndex) {
+                std::cerr << "Operator without (preceding) operands found in the AST\n";
+                return false;
+            }
+
+            terms.push_back(simplifyOperator(static_cast<char>(node.getNodeValue()),
+                                             terms[node.getLeftNodeIndex()],
+                                             terms[node.getRightNodeIndex()]));
+            break;
+        }
+    }
+
+    // Drop the nodes that are no longer part of the expression (if any),
+    // so that the root is the last node of the simplified AST
+    const auto rootNodeIndex = materialize(terms.back());
+    if (mHasDiscardedNodes || rootNodeIndex != mOptimizedAST->getRootNodeIndex()) {
+        mOptimizedAST = std::make_shared<AST::Tree>(
+              copyReachableNodes(*mOptimizedAST, rootNodeIndex));
+    }
+
+#ifdef DEBUG_BUILD
+    std::cout << "Simplified Abstract Syntax Tree:\n";
+    AST::printAST(*mOptimizedAST, mOptimizedAST->getRootNodeIndex());
+#endif
+
+    return true;
+}
+
+std::shared_ptr<const AST::Tree> Optimizer::getOptimizedAST() const
+{
+    return mOptimizedAST;
+}
+
+const std::vector<Symbols::SymbolId>& Optimizer::getVariables() const
+{
+    return mVariables;
+}
+
+Optimizer::Term Optimizer::makeConstant(const int64_t value)
+{
+    return {AST::cInvalidNodeIndex, value};
+}
+
+bool Optimizer::mayFail(const Term& term) const
+{
+    return !term.isConstant()
+           && mOptimizedAST->getNode(term.nodeIndex).getNodeType() == AST::NodeType::OPERATOR;
+}
+
+Optimizer::Term
+      Optimizer::simplifyOperator(const char operation, const Term& left, const Term& right)
+{
+    // Fold constant subtrees (unless their evaluation fails, which must be reported at runtime)
+    if (left.isConstant() && right.isConstant()) {
+        int64_t value{};
+        if (!Arithmetic::apply(operation, left.constant, right.constant, value)) {
+            return makeConstant(value);
+        }
+        return addOperator(operation, left, right);
+    }
+
+    // Helper lambda used to check if a term is a given constant
+    const auto isConstantValue = [](const Term& term, const int64_t value) {
+        return term.isConstant() && term.constant == value;
+    };
+
+    // Helper lambda used to check if multiplying a term by zero always results in zero
+    // (the term must not report an error instead)
+    const auto isAbsorbedByZero = [&](const Term& zero, const Term& term) {
+        return isConstantValue(zero, 0) && !mayFail(term);
+    };
+
+    // Remove identities
+    switch (operation) {
+    case cAddOp:
+        if (isConstantValue(right, 0)) {
+            return left;
+        }
+        if (isConstantValue(left, 0)) {
+            return right;
+        }
+        if (right.isConstant()) {
+            if (auto reassociatedTerm = reassociateOffset(left, right.constant)) {
+                return *reassociatedTerm;
+            }
+        }
+        if (left.isConstant()) {
+            if (auto reassociatedTerm = reassociateOffset(right, left.constant)) {
+                return *reassociatedTerm;
+            }
+        }
+        break;
+
+    case cSubOp:
+        if (isConstantValue(right, 0)) {
+            return left;
+        }
+        // x-c is x+(-c), which cannot be expressed for the lowest constant
+        if (right.isConstant() && right.constant != std::numeric_limits<int64_t>::min()) {
+            if (auto reassociatedTerm = reassociateOffset(left, -right.constant)) {
+                return *reassociatedTerm;
+            }
+        }
+        break;
+
+    case cMultOp:
+        if (isConstantValue(right, 1)) {
+            return left;
+        }
+        if (isConstantValue(left, 1)) {
+            return right;
+        }
+        if (isAbsorbedByZero(right, left)) {
+            mHasDiscardedNodes = true;
+            return right;
+        }
+        if (isAbsorbedByZero(left, right)) {
+            mHasDiscardedNodes = true;
+            return left;
+        }
+        if (right.isConstant()) {
+            if (auto reassociatedTerm = reassociateScaling(operation, left, right.constant)) {
+                return *reassociatedTerm;
+            }
+        }
+        if (left.isConstant()) {
+            if (auto reassociatedTerm = reassociateScaling(operation, right, left.constant)) {
+                return *reassociatedTerm;
+            }
+        }
+        break;
+
+    case cDivOp:
+        if (isConstantValue(right, 1)) {
+            return left;
+        }
+        if (right.isConstant()) {
+            if (auto reassociatedTerm = reassociateScaling(operation, left, right.constant)) {
+                return *reassociatedTerm;
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    return addOperator(operation, left, right);
+}
+
+std::optional<Optimizer::Term> Optimizer::reassociateOffset(const Term& term,
+                                                            const int64_t constant)
+{
+    // The other operand must be an addition or a subtraction of a constant as well
+    auto innerOperation = getConstantOperation(term, cAddOp);
+    int64_t innerConstant{};
+    if (innerOperation) {
+        innerConstant = innerOperation->second;
+    } else {
+        innerOperation = getConstantOperation(term, cSubOp);
+        if (!innerOperation || innerOperation->second == std::numeric_limits<int64_t>::min()) {
+            return {};
+        }
+        innerConstant = -innerOperation->second;
+    }
+
+    // Adding constants of the same sign moves the intermediate result toward the final one,
+    // so (x+a)+b overflows if and only if x+(a+b) does
+    int64_t mergedConstant{};
+    if ((innerConstant < 0) != (constant < 0)
+        || Arithmetic::add(innerConstant, constant, mergedConstant)) {
+        return {};
+    }
+
+    // The node being replaced (and its constant) are no longer part of the expression
+    mHasDiscardedNodes = true;
+    const auto& baseTerm = innerOperation->first;
+
+    // Negative constants are subtracted instead (as literals), whenever they can be negated
+    if (mergedConstant < 0 && mergedConstant != std::numeric_limits<int64_t>::min()) {
+        return addOperator(cSubOp, baseTerm, makeConstant(-mergedConstant));
+    }
+
+    return addOperator(cAddOp, baseTerm, makeConstant(mergedConstant));
+}
+
+std::optional<Optimizer::Term>
+      Optimizer::reassociateScaling(const char operation, const Term& term, const int64_t constant)
+{
+    // The other operand must be the same operation by a constant
+    const auto innerOperation = getConstantOperation(term, operation);
+    if (!innerOperation) {
+        return {};
+    }
+
+    // Multiplying by positive constants only increases magnitudes, so (x*a)*b overflows
+    // if and only if x*(a*b) does, while dividing by positive constants never fails,
+    // and (x/a)/b truncates to the same value as x/(a*b)
+    const auto innerConstant = innerOperation->second;
+    int64_t mergedConstant{};
+    if (innerConstant <= 0 || constant <= 0
+        || Arithmetic::multiply(innerConstant, constant, mergedConstant)) {
+        return {};
+    }
+
+    // The node being replaced (and its constant) are no longer part of the expression
+    mHasDiscardedNodes = true;
+    return addOperator(operation, innerOperation->first, makeConstant(mergedConstant));
+}
+
+std::optional<std::pair<Optimizer::Term, int64_t>>
+      Optimizer::getConstantOperation(const Term& term, const char operation) const
+{
+    const auto& node = mOptimizedAST->getNode(term.nodeIndex);
+    if (node.getNodeType() != AST::NodeType::OPERATOR
+        || static_cast<char>(node.getNodeValue()) != operation) {
+        return {};
+    }
+
+    // Helper lambda used to check if a node of the simplified AST holds a constant
+    const auto isConstantNode = [this](const AST::NodeIndex nodeIndex) {
+        const auto nodeType = mOptimizedAST->getNode(nodeIndex).getNodeType();
+        return nodeType == AST::NodeType::LITERAL || nodeType == AST::NodeType::CONSTANT;
+    };
+
+    const auto leftNodeIndex = node.getLeftNodeIndex();
+    const auto rightNodeIndex = node.getRightNodeIndex();
+
+    // Constant subtrees whose evaluation fails are kept as operations,
+    // so at most one of the operands is a constant
+    if (isConstantNode(rightNodeIndex)) {
+        return std::pair{mOptimizedTerms[leftNodeIndex], mOptimizedTerms[rightNodeIndex].constant};
+    }
+
+    // Only additions and multiplications are commutative
+    if ((operation == cAddOp || operation == cMultOp) && isConstantNode(leftNodeIndex)) {
+        return std::pair{mOptimizedTerms[rightNodeIndex], mOptimizedTerms[leftNodeIndex].constant};
+    }
+
+    return {};
+}
+
+Optimizer::Term
+      Optimizer::addOperator(const char operation, const Term& left, const Term& right)
+{
+    const auto leftNodeIndex = materialize(left);
+    const auto rightNodeIndex = materialize(right);
+
+    const Term term{mOptimizedAST->addOperatorNode(operation, leftNodeIndex, rightNodeIndex), 0};
+    mOptimizedTerms.push_back(term);
+
+    return term;
+}
+
+AST::NodeIndex Optimizer::materialize(const Term& term)
+{
+    if (!term.isConstant()) {
+        return term.nodeIndex;
+    }
+
+    // Constants holding (unsigned 32-bit) integers are kept as literals
+    const auto value = term.constant;
+    const bool isLiteral{value >= 0 && value <= std::numeric_limits<uint32_t>::max()};
+
+    auto materializedTerm = term;
+    materializedTerm.nodeIndex = isLiteral
+                                       ? mOptimizedAST->addLiteralNode(static_cast<uint32_t>(value))
+                                       : mOptimizedAST->addConstantNode(value);
+    mOptimizedTerms.push_back(materializedTerm);
+
+    return materializedTerm.nodeIndex;
+}
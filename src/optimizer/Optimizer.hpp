@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "ast/Tree.hpp"
+#include "symbols/SymbolTable.hpp"
+
+/**
+ * @brief Class responsible for simplifying the AST of an arithmetic expression before it is
+ * compiled, so that repeated evaluations only perform the work that depends on operands
+ *
+ * The following rewrites are applied (bottom-up, in a single pass over the AST):
+ * - constant subtrees are folded into a single constant;
+ * - identities are removed: x*1, 1*x, x/1, x+0, 0+x, x-0 (x) and x*0, 0*x (0);
+ * - chains of additions/subtractions, multiplications or divisions by constants are merged
+ *   into a single operation (e.g. (x+2)+3 becomes x+5, (x*3)*2 becomes x*6
+ *   and (x/3)/2 becomes x/6), while offsets of different signs (e.g. (x+2)-7) are left alone.
+ *
+ * Expressions are evaluated using checked integer arithmetic, so rewrites are only applied when
+ * they produce exactly the same values and errors as the original expression: constant subtrees
+ * whose evaluation fails (e.g. 1/0) are kept, so that the error is still reported, x*0 requires
+ * the evaluation of x not to fail, and merged chains require constants that make an intermediate
+ * result overflow if and only if the merged one does (additive constants of the same sign,
+ * positive scaling constants whose product does not overflow).
+ *
+ * Operands removed from the AST (e.g. by x*0) remain dependencies of the expression,
+ * so they are reported (in order of appearance) alongside the simplified AST
+ */
+class Optimizer
+{
+public:
+    /**
+     * @brief Class constructor
+     *
+     * @param[in] ast Reference to the AST to simplify
+     */
+    explicit Optimizer(const AST::Tree& ast);
+
+    /**
+     * @brief Simplifies the AST
+     *
+     * @return True if the AST was simplified successfully (false otherwise)
+     */
+    [[nodiscard]] bool execute();
+
+    /**
+     * @brief Getter for the simplified AST
+     *
+     * @return Shared pointer to the (immutable) simplified AST
+     */
+    [[nodiscard]] std::shared_ptr<const AST::Tree> getOptimizedAST() const;
+
+    /**
+     * @brief Getter for the operands of the original AST
+     *
+     * @return Distinct operands referenced by the original AST, in order of appearance
+     */
+    [[nodiscard]] const std::vector<Symbols::SymbolId>& getVariables() const;
+
+private:
+    /**
+     * @brief Simplified form of a node of the original AST
+     */
+    struct Term
+    {
+        /// Index of the simplified subtree (cInvalidNodeIndex for constants, which are only
+        /// added to the simplified AST once they become the operand of another node)
+        AST::NodeIndex nodeIndex{AST::cInvalidNodeIndex};
+        /// Value of the term (only meaningful for constants)
+        int64_t constant{};
+
+        /**
+         * @brief Checks if the term is a constant
+         *
+         * @return True if the term is a constant (false otherwise)
+         */
+        [[nodiscard]] bool isConstant() const { return nodeIndex == AST::cInvalidNodeIndex; }
+    };
+
+    /**
+     * @brief Creates a constant term
+     *
+     * @param[in] value Value of the constant
+     *
+     * @return Term holding the constant
+     */
+    [[nodiscard]] static Term makeConstant(int64_t value);
+
+    /**
+     * @brief Checks if the evaluation of a term might fail
+     *
+     * @param[in] term Term to evaluate
+     *
+     * @return True if the term holds an operation (false for constants and operands)
+     */
+    [[nodiscard]] bool mayFail(const Term& term) const;
+
+    /**
+     * @brief Simplifies an operator node of the original AST
+     *
+     * @param[in] operation Binary operator of the node
+     * @param[in] left Simplified left operand
+     * @param[in] right Simplified right operand
+     *
+     * @return Simplified node
+     */
+    [[nodiscard]] Term simplifyOperator(char operation, const Term& left, const Term& right);
+
+    /**
+     * @brief Tries to merge an addition of a constant into the one (if any)
+     * performed by the other operand, e.g. (x+2)+3 into x+5
+     * (constants of different signs are not merged: x+2 may overflow while x-5 does not)
+     *
+     * @param[in] term Non constant operand
+     * @param[in] constant Constant added to the operand (negated for subtractions)
+     *
+     * @return Merged node (empty if the operations cannot be merged without changing results)
+     */
+    [[nodiscard]] std::optional<Term> reassociateOffset(const Term& term, int64_t constant);
+
+    /**
+     * @brief Tries to merge a multiplication/division by a constant into the same operation
+     * (if any) performed by the other operand, e.g. (x*3)*2 into x*6
+     *
+     * @param[in] operation Binary operator ('*' or '/')
+     * @param[in] term Non constant operand
+     * @param[in] constant Constant operand (the divisor for divisions)
+     *
+     * @return Merged node (empty if the operations cannot be merged without changing results)
+     */
+    [[nodiscard]] std::optional<Term>
+          reassociateScaling(char operation, const Term& term, int64_t constant);
+
+    /**
+     * @brief Retrieves the non constant operand and the constant operand of a node
+     * of the simplified AST
+     *
+     * @param[in] term Term of the node
+     * @param[in] operation Binary operator the node must hold
+     *
+     * @return Non constant operand and constant operand (the right one for subtractions and
+     * divisions), or empty if the node is not such an operation
+     */
+    [[nodiscard]] std::optional<std::pair<Term, int64_t>>
+          getConstantOperation(const Term& term, char operation) const;
+
+    /**
+     * @brief Adds an operator node to the simplified AST
+     *
+     * @param[in] operation Binary operator of the node
+     * @param[in] left Left operand
+     * @param[in] right Right operand
+     *
+     * @return Term of the new node
+     */
+    [[nodiscard]] Term addOperator(char operation, const Term& left, const Term& right);
+
+    /**
+     * @brief Adds a term to the simplified AST (if not part of it already)
+     *
+     * @param[in] term Term to add
+     *
+     * @return Index of the node holding the term
+     */
+    AST::NodeIndex materialize(const Term& term);
+
+private:
+    /// Reference to the AST to simplify
+    const AST::Tree& mAst;
+
+    /// Simplified AST being generated
+    std::shared_ptr<AST::Tree> mOptimizedAST;
+
+    /// Terms of the nodes of the simplified AST (indexed by node index)
+    std::vector<Term> mOptimizedTerms;
+
+    /// Whether some nodes of the simplified AST were discarded (e.g. x in x*0)
+    bool mHasDiscardedNodes{};
+
+    /// Operands referenced by the original AST, in order of appearance
+    std::vector<Symbols::SymbolId> mVariables;
+};
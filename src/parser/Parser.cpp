@@ -1,336 +1,168 @@
 #include "Parser.hpp"
 
 #include <algorithm>
-#include <cctype>
 #include <iostream>
-#include <ranges>
+#include <limits>
 #include <utility>
 #include <vector>
-#include <unordered_set>
 
-#include "ast/Node.hpp"
+#include "ast/Tree.hpp"
 #include "utils/Constants.hpp"
+#include "utils/ExpressionScanner.hpp"
+#include "utils/Grammar.hpp"
 #include "utils/Methods.hpp"
 
 namespace {
 using namespace Utils::Constants;
+using namespace Utils::Grammar;
 
 /**
- * @brief Checks if the provided character is a parenthesis
- *
- * @param[in] character Character to evaluate
- *
- * @return True if is a supported parenthesis (false otherwise)
+ * @brief Builds the AST of an expression from its tokens, in postfix order
+ * (see Utils::Grammar::scanExpression)
  */
-constexpr bool isParenthesis(const char character)
+class ASTBuilder
 {
-    switch (character) {
-    case cLeftParenthesis:
-    case cRightParenthesis:
-        return true;
-    default:
-        return false;
+public:
+    /**
+     * @brief Class constructor
+     *
+     * @param[in,out] tree AST to add the nodes to
+     * @param[in,out] symbolTable Symbol table used to intern the variables
+     * @param[in,out] nodeIndexStack Indices of the AST nodes still waiting for a parent node
+     */
+    ASTBuilder(AST::Tree& tree,
+               Symbols::SymbolTable& symbolTable,
+               std::stack<AST::NodeIndex, std::vector<AST::NodeIndex>>& nodeIndexStack)
+        : mTree{tree}
+        , mSymbolTable{symbolTable}
+        , mNodeIndexStack{nodeIndexStack}
+    {
     }
-}
 
-/**
- * @brief Checks if the provided character is a valid binary operator
- *
- * @param[in] character Character to evaluate
- *
- * @return True if is a supported operator (false otherwise)
- */
-constexpr bool isOperator(const char character)
-{
-    switch (character) {
-    case cAddOp:
-    case cSubOp:
-    case cMultOp:
-    case cDivOp:
-        return true;
-    default:
-        return false;
+    /**
+     * @brief Adds a variable node (variables are interned, so that the AST only holds
+     * their symbol ids)
+     *
+     * @param[in] name Name of the variable
+     */
+    void addVariable(const std::string_view name)
+    {
+        mNodeIndexStack.push(mTree.addVariableNode(mSymbolTable.intern(name)));
     }
-}
 
-/**
- * @brief Checks if the provided character is a single digit integer
- *
- * @param[in] previousCharacter Adjacent character to evaluate (cannot be a digit)
- * @param[in] character Character to evaluate
- *
- * @return True if is a single digit character (false otherwise)
- */
-constexpr bool isSingleDigitInteger(const char previousCharacter, const char character)
-{
-    return !std::isdigit(previousCharacter) && std::isdigit(character);
-}
+    /**
+     * @brief Adds a literal node
+     * (literals that do not fit in a node are kept as constants of the AST)
+     *
+     * @param[in] literal Value of the literal
+     */
+    void addLiteral(const int64_t literal)
+    {
+        mNodeIndexStack.push(literal <= std::numeric_limits<uint32_t>::max()
+                                   ? mTree.addLiteralNode(static_cast<uint32_t>(literal))
+                                   : mTree.addConstantNode(literal));
+    }
 
-/**
- * @brief Checks if the provided character is a unary minus
- *
- * @param[in] previousCharacter Adjacent character to evaluate (cannot be an operator, space or '(')
- * @param[in] character Character to evaluate
- *
- * @return True if character is an unary minus (false otherwise)
- */
-constexpr bool isUnaryMinus(const char previousCharacter, const char character)
-{
-    return character == cSubOp
-           && (isOperator(previousCharacter) || std::isspace(previousCharacter)
-               || previousCharacter == cLeftParenthesis);
-}
+    /**
+     * @brief Adds an operator node, whose operands are the two last nodes without a parent
+     *
+     * @param[in] operation Operator of the node
+     */
+    void addOperator(const char operation)
+    {
+        const auto rightNodeIndex = mNodeIndexStack.top();
+        mNodeIndexStack.pop();
 
-/**
- * @brief Determines the precedence level of an operator based on its type
- *
- * When constructing the AST using the Shunting Yard algorithm,
- * each operator being processed causes its preceding operators to "execute"
- * (new nodes in the AST are created) only if it has a higher precedence value
- *
- * Precedence levels:
- * - '('        : 1 (lowest precedence)
- * - '+', '-'   : 2
- * - '*', '/'   : 3
- * - ')'        : 4 (highest precedence)
- *
- * @param[in] op Operator whose precedence is to be determined
- *
- * @return The precedence level of the operator
- */
-constexpr uint8_t operatorPrecedence(const char op)
-{
-    switch (op) {
-    case cRightParenthesis:
-        return 4;
-    case cMultOp:
-    case cDivOp:
-        return 3;
-    case cAddOp:
-    case cSubOp:
-        return 2;
-    case cLeftParenthesis:
-        return 1;
-    default:
-        return 0;
+        const auto leftNodeIndex = mNodeIndexStack.top();
+        mNodeIndexStack.pop();
+
+        mNodeIndexStack.push(mTree.addOperatorNode(operation, leftNodeIndex, rightNodeIndex));
     }
-}
+
+private:
+    /// AST the nodes are added to
+    AST::Tree& mTree;
+
+    /// Symbol table used to intern the variables
+    Symbols::SymbolTable& mSymbolTable;
+
+    /// Indices of the AST nodes still waiting for a parent node
+    std::stack<AST::NodeIndex, std::vector<AST::NodeIndex>>& mNodeIndexStack;
+};
 } // namespace
 
-Parser::Parser(const std::string& inputToParse)
+Parser::Parser(const std::string_view inputToParse, Symbols::SymbolTable& symbolTable)
     : mInputString{inputToParse}
-    , mRHSValueStack{std::make_unique<ASTofRSH>()}
+    , mSymbolTable{symbolTable}
 {
 }
 
 bool Parser::execute()
 {
-    Utils::Methods::removeWhiteSpacesFromString(mInputString);
-
-    const auto inputStringTokens
-          = Utils::Methods::splitString(mInputString, Utils::Constants::cAssignOp);
-
-    if (inputStringTokens.size() != 2) {
-        return false;
-    }
-
-    mLHSString = inputStringTokens.front();
-    mRHSString = inputStringTokens.back();
-
     return parseLHS() && parseRHS();
 }
 
-std::string Parser::getOperandOfLHS() const
+std::string_view Parser::getOperandOfLHS() const
 {
     return mLHSString;
 }
 
-std::shared_ptr<Parser::ASTofRSH> Parser::getASTOfRHS() const
+std::shared_ptr<const Parser::ASTofRSH> Parser::getASTOfRHS() const
 {
-    return mRHSValueStack;
+    return mRHSAST;
 }
 
-bool Parser::parseLHS()
+std::string_view Parser::getError() const
 {
-    // TODO[FM]: Add support for a more complex parsing.
-    // Ideally we would also create an AST for the LHS but for now,
-    // we only support LHS values with a single letter operands
-    // (e.g. 'x' from in "x=2+2")
-    if (mLHSString.size() != 1) {
-        return false;
-    }
-
-    return true;
+    return mError;
 }
 
-bool Parser::parseRHS()
+bool Parser::isValidLHS(const std::string_view lhs)
 {
-    return validateRHS() && createASTforRHS();
+    // The LHS is a single identifier: a letter or an underscore,
+    // followed by any amount of letters, digits and underscores (e.g. "x" or "total_2")
+    // TODO[FM]: Ideally we would also create an AST for the LHS
+    return !lhs.empty() && isIdentifierStart(lhs.front())
+           && std::ranges::all_of(lhs, isOperandCharacter);
 }
 
-bool Parser::validateRHS()
+bool Parser::parseLHS()
 {
-    if (mRHSString.empty()) {
-        std::cerr << "Empty expression provided" << "\n";
+    // Scan the input up to the assignment operator, which splits it into its LHS and RHS
+    const auto assignOpPosition = mInputString.find(cAssignOp);
+    if (assignOpPosition == std::string_view::npos) {
         return false;
     }
 
-    // String will be wrapped around parenthesis for easier parsing
-    std::string validatedString{cLeftParenthesis};
-    validatedString.reserve(mRHSString.size());
-
-    uint32_t leftParenthesisCounter{0};
-    uint32_t rightParenthesisCounter{0};
+    mLHSString = Utils::Methods::trimWhiteSpaces(mInputString.substr(0, assignOpPosition));
+    mRHSString = mInputString.substr(assignOpPosition + 1);
 
-    for (const auto& character : mRHSString) {
-
-        const auto& previousValidCharacter = validatedString.back();
-
-        // Check digit validity
-        // TODO: Add support for expressions with integers with more than one digit
-        if (isSingleDigitInteger(previousValidCharacter, character)) {
-
-            // Right parenthesis should not be followed by a digit (e.g. ")2" )
-            if (previousValidCharacter == cRightParenthesis) {
-                std::cerr << "Invalid expression provided" << "\n";
-                return false;
-            }
-        }
-        // Check operator validity
-        else if (isOperator(character)) {
-
-            // Check if the operator is used as a unary minus
-            // TODO: Add support for expressions with negative integers (e.g. "-2*3")
-            if (isUnaryMinus(previousValidCharacter, character)) {
-                std::cout << "Negative values are not currently supported" << "\n";
-                return false;
-            }
-
-            // Check if the previous character was not and operator or a left parenthesis
-            // (e.g. "++2" or ")+2")
-            if (isOperator(previousValidCharacter) || previousValidCharacter == cLeftParenthesis) {
-                std::cerr << "Invalid expression provided" << "\n";
-                return false;
-            }
-        }
-        // Check parenthesis validity
-        else if (isParenthesis(character)) {
-
-            // Keep tabs on the amount of parenthesis pairs
-            if (character == cLeftParenthesis) {
-                ++leftParenthesisCounter;
-            } else if (character == cRightParenthesis) {
-                ++rightParenthesisCounter;
-            }
-
-            // Left parenthesis should not be preceded by a digit (e.g. "2("))
-            // TODO: Add support for expressions with implicit multiplication
-            if (character == cLeftParenthesis && std::isdigit(previousValidCharacter)) {
-                std::cerr << "Invalid expression provided" << "\n";
-                return false;
-            }
-        }
-        // Account for single character variables
-        else if (!std::isalpha(character)) {
-            std::cerr << "Invalid expression provided" << "\n";
-            return false;
-        }
-
-        validatedString.push_back(character);
-    }
-
-    // Validate the amount of parenthesis pairs
-    if (leftParenthesisCounter != rightParenthesisCounter) {
-        std::cerr << "Parenthesis do not match" << "\n";
-        return false;
-    }
-
-    // Validate that the expression does not end with an operator
-    if (isOperator(validatedString.back())) {
-        std::cerr << "Invalid expression provided" << "\n";
-        return false;
-    }
-
-    // Finalize the string wrapping by adding a right parenthesis at the end
-    validatedString.append(1, cRightParenthesis);
-    mRHSString.swap(validatedString);
-    mRHSString.shrink_to_fit();
-
-    return true;
+    return isValidLHS(mLHSString);
 }
 
-bool Parser::createASTforRHS()
+bool Parser::parseRHS()
 {
-    if (mRHSString.empty()) {
-        std::cerr << "Empty expression provided" << "\n";
-        return false;
-    }
-
-    // Helper lambda used to add new nodes to the AST
-    const auto generateNewNode = [this]() {
-        if (!mRHSOperatorStack.empty() && !mRHSValueStack->empty()) {
-
-            const auto operation = mRHSOperatorStack.top();
-            mRHSOperatorStack.pop();
-
-            auto rightValue = std::move(mRHSValueStack->top());
-            mRHSValueStack->pop();
-
-            auto leftValue = std::move(mRHSValueStack->top());
-            mRHSValueStack->pop();
-
-            mRHSValueStack->emplace(std::make_unique<AST::Node>(
-                  operation, std::move(leftValue), std::move(rightValue)));
-        }
-    };
-
-    // Analyse input
-    for (const auto& character : mRHSString) {
-
-        // Account for the possibility that we might have either a number or a variable in the
-        // provided string
-        if (std::isdigit(character) || std::isalpha(character)) {
-            mRHSValueStack->emplace(std::make_unique<AST::Node>(character));
-
-        } else if (isOperator(character)) {
-
-            // Generate new nodes until an operator with a lower precedence
-            // than the new one is found on the top of the operator stack
-            while (!mRHSOperatorStack.empty()
-                   && operatorPrecedence(mRHSOperatorStack.top())
-                            >= operatorPrecedence(character)) {
-                generateNewNode();
-            }
-
-            mRHSOperatorStack.push(character);
-
-        } else if (character == cLeftParenthesis) {
-            mRHSOperatorStack.push(character);
-
-        } else if (character == cRightParenthesis) {
-
-            // Generate new nodes until we reach the closest left parenthesis
-            while (!mRHSOperatorStack.empty() && mRHSOperatorStack.top() != cLeftParenthesis) {
-                generateNewNode();
-            }
-
-            // Pop left parenthesis
-            if (!mRHSOperatorStack.empty()) {
-                mRHSOperatorStack.pop();
-            }
-        }
+    // An expression never has more nodes than characters,
+    // so a single allocation is enough to hold the whole AST (and the node index stack)
+    mRHSAST = std::make_shared<ASTofRSH>(mRHSString.size());
+    {
+        std::vector<AST::NodeIndex> nodeIndexStackStorage;
+        nodeIndexStackStorage.reserve(mRHSString.size());
+        mRHSNodeIndexStack = decltype(mRHSNodeIndexStack){std::move(nodeIndexStackStorage)};
     }
 
-    // Generate new nodes until the operator stack is empty
-    while (!mRHSOperatorStack.empty()) {
-        generateNewNode();
+    // Tokenization, syntax validation and AST construction (Shunting Yard algorithm)
+    // all happen in a single forward scan of the RHS,
+    // which is rejected as soon as an unexpected token is found
+    ASTBuilder astBuilder{*mRHSAST, mSymbolTable, mRHSNodeIndexStack};
+    mError = scanExpression(mRHSString, astBuilder);
+    if (!mError.empty()) {
+        return false;
     }
 
 #ifdef DEBUG_BUILD
-    if (!mRHSValueStack->empty()) {
-        std::cout << "Generated Abstract Syntax Tree:\n";
-        AST::printAST(mRHSValueStack->top());
-    }
+    std::cout << "Generated Abstract Syntax Tree:\n";
+    AST::printAST(*mRHSAST, mRHSAST->getRootNodeIndex());
 #endif
 
     return true;
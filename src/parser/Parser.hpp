@@ -2,9 +2,11 @@
 
 #include <memory>
 #include <stack>
-#include <string>
+#include <string_view>
+#include <vector>
 
-#include "ast/Node.hpp"
+#include "ast/Tree.hpp"
+#include "symbols/SymbolTable.hpp"
 
 /**
  * @brief Class responsible for parsing arithmetic expressions and generating Abstract Syntax Trees
@@ -12,15 +14,18 @@
 class Parser
 {
 public:
-    /// Alias representing a whole AST (stack of AST node unique pointers)
-    using ASTofRSH = std::stack<std::unique_ptr<AST::Node>>;
+    /// Alias representing a whole AST (arena of index-linked AST nodes)
+    using ASTofRSH = AST::Tree;
 
     /**
      * @brief Class constructor
      *
-     * @param[in] inputToParse String containing the arithmetic expression to parse
+     * The parser does not copy the input, so the viewed characters must outlive it
+     *
+     * @param[in] inputToParse View of the arithmetic expression to parse
+     * @param[in,out] symbolTable Symbol table used to intern the operands of the expression
      */
-    explicit Parser(const std::string& inputToParse);
+    explicit Parser(std::string_view inputToParse, Symbols::SymbolTable& symbolTable);
 
     /**
      * @brief Checks the input for a valid arithmetic expression and generates the appropriate AST
@@ -32,61 +37,72 @@ public:
     /**
      * @brief Retrieves the operand of the LHS (Left Hand Side) expression
      *
-     * @return String containing the operand of the LHS
+     * @return View of the operand of the LHS (into the parsed input)
      */
-    [[nodiscard]] std::string getOperandOfLHS() const;
+    [[nodiscard]] std::string_view getOperandOfLHS() const;
 
     /**
      * @brief Getter for the generated AST of the RHS (Right Hand Side) expression
      *
-     * @return Shared pointer to a stack containing all the ATS nodes
+     * @return Shared pointer to the (immutable) AST holding all the nodes of the RHS
      */
-    [[nodiscard]] std::shared_ptr<ASTofRSH> getASTOfRHS() const;
+    [[nodiscard]] std::shared_ptr<const ASTofRSH> getASTOfRHS() const;
 
-private:
     /**
-     * @brief Parses the LHS of the arithmetic expression
+     * @brief Getter for the reason why the RHS expression was rejected
      *
-     * @return True if parsing the LHS was successful (false otherwise)
+     * @return Description of the syntax error (empty if none was found)
      */
-    [[nodiscard]] bool parseLHS();
+    [[nodiscard]] std::string_view getError() const;
 
     /**
-     * @brief Parses the RHS (Right Hand Side) of the arithmetic expression
+     * @brief Checks if the provided string is a valid LHS (Left Hand Side) operand
      *
-     * @return True if parsing the RHS was successful (false otherwise)
+     * @param[in] lhs String (without white spaces) holding the LHS of an arithmetic expression
+     *
+     * @return True if the LHS is valid (false otherwise)
      */
-    [[nodiscard]] bool parseRHS();
+    [[nodiscard]] static bool isValidLHS(std::string_view lhs);
 
+private:
     /**
-     * @brief Validates the RHS of the arithmetic expression
+     * @brief Parses the LHS of the arithmetic expression
+     * (splitting the input into its LHS and RHS at the assignment operator)
      *
-     * @return True if the RHS is a valid expression, false otherwise
+     * @return True if parsing the LHS was successful (false otherwise)
      */
-    [[nodiscard]] bool validateRHS();
+    [[nodiscard]] bool parseLHS();
 
     /**
-     * @brief Creates an AST for the RHS of the arithmetic expression
+     * @brief Parses the RHS (Right Hand Side) of the arithmetic expression
      *
-     * Uses the Shunting Yard algorithm to convert the RHS expression into an AST
+     * Validates the RHS and creates its AST in a single forward scan
+     * (see Utils::Grammar::scanExpression).
+     * The RHS is rejected as soon as an unexpected token is found.
      *
-     * @return True if AST creation was successful (false otherwise)
+     * @return True if parsing the RHS was successful (false otherwise)
      */
-    [[nodiscard]] bool createASTforRHS();
+    [[nodiscard]] bool parseRHS();
 
 private:
-    ///  String representation of the LHS operand
-    std::string mLHSString;
+    /// View of the LHS operand (without white spaces)
+    std::string_view mLHSString;
+
+    /// View of the RHS expression (white spaces are skipped while parsing)
+    std::string_view mRHSString;
+
+    /// View of the input to parse
+    std::string_view mInputString;
 
-    /// String representation of the RHS expression
-    std::string mRHSString;
+    /// Symbol table used to intern the operands found in the RHS
+    Symbols::SymbolTable& mSymbolTable;
 
-    /// Input string to parse
-    std::string mInputString;
+    /// Stack to manage the indices of the AST nodes still waiting for a parent node
+    std::stack<AST::NodeIndex, std::vector<AST::NodeIndex>> mRHSNodeIndexStack;
 
-    /// Stack to manage the operators of the RHS arithmetic expression during RHS expression parsing
-    std::stack<char> mRHSOperatorStack;
+    /// Shared ownership pointer holding the AST that represents the RHS expression
+    std::shared_ptr<ASTofRSH> mRHSAST;
 
-    /// Shared ownership pointer holding a stack of AST nodes that represent the RHS expression
-    std::shared_ptr<ASTofRSH> mRHSValueStack;
+    /// Reason why the RHS expression was rejected (empty if none)
+    std::string_view mError;
 };
@@ -0,0 +1,206 @@
+#include "EventLoop.hpp"
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+namespace {
+/// Maximum amount of events handled per poll
+constexpr int cMaxPolledEvents{256};
+
+/// Events polled on every session socket (edge triggered, since sockets are drained)
+constexpr uint32_t cSessionEvents{EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET};
+
+/// Events polled on the socket of a session while it does not read instructions
+constexpr uint32_t cPausedSessionEvents{EPOLLOUT | EPOLLRDHUP | EPOLLET};
+
+/**
+ * @brief Pins the calling thread to a core
+ *
+ * Purely a hint: failing to pin the thread does not affect the loop
+ *
+ * @param[in] core Index of the core
+ */
+void pinToCore(const std::size_t core)
+{
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core, &cpuSet);
+    ::pthread_setaffinity_np(::pthread_self(), sizeof(cpuSet), &cpuSet);
+}
+} // namespace
+
+namespace Server {
+
+EventLoop::EventLoop(const int listeningSocket,
+                     const Session::Options sessionOptions,
+                     std::atomic<std::size_t>& sessionCount)
+    : mListeningSocket{listeningSocket}
+    , mSessionOptions{sessionOptions}
+    , mSessionCount{sessionCount}
+{
+}
+
+EventLoop::~EventLoop()
+{
+    stop();
+}
+
+bool EventLoop::start(const std::size_t core)
+{
+    mPoller = ::epoll_create1(EPOLL_CLOEXEC);
+    mStopEvent = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (mPoller < 0 || mStopEvent < 0) {
+        std::cerr << "Unable to create the event loop: " << std::strerror(errno) << "\n";
+        return false;
+    }
+
+    // Only one of the loops is woken up for each incoming connection
+    epoll_event listeningEvent{.events = EPOLLIN | EPOLLEXCLUSIVE,
+                               .data = {.fd = mListeningSocket}};
+    epoll_event stopEvent{.events = EPOLLIN, .data = {.fd = mStopEvent}};
+
+    if (::epoll_ctl(mPoller, EPOLL_CTL_ADD, mListeningSocket, &listeningEvent) != 0
+        || ::epoll_ctl(mPoller, EPOLL_CTL_ADD, mStopEvent, &stopEvent) != 0) {
+        std::cerr << "Unable to poll the server sockets: " << std::strerror(errno) << "\n";
+        return false;
+    }
+
+    mThread = std::thread([this, core] {
+        pinToCore(core);
+        run();
+    });
+
+    return true;
+}
+
+void EventLoop::stop()
+{
+    if (mThread.joinable()) {
+        const uint64_t increment{1};
+        [[maybe_unused]] const auto writeCount = ::write(mStopEvent, &increment, sizeof(increment));
+        mThread.join();
+    }
+
+    mSessionCount -= mSessions.size();
+    mSessions.clear();
+
+    for (auto* const fileDescriptor : {&mPoller, &mStopEvent}) {
+        if (*fileDescriptor >= 0) {
+            ::close(*fileDescriptor);
+            *fileDescriptor = -1;
+        }
+    }
+}
+
+void EventLoop::run()
+{
+    std::array<epoll_event, cMaxPolledEvents> events;
+
+    while (true) {
+        const auto eventCount = ::epoll_wait(mPoller, events.data(), cMaxPolledEvents, -1);
+        if (eventCount < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            std::cerr << "Unable to poll the sessions: " << std::strerror(errno) << "\n";
+            return;
+        }
+
+        for (int index = 0; index < eventCount; ++index) {
+            const auto& event = events[static_cast<std::size_t>(index)];
+            const auto socket = event.data.fd;
+
+            if (socket == mStopEvent) {
+                return;
+            }
+
+            if (socket == mListeningSocket) {
+                acceptSessions();
+            } else if (const auto sessionItr = mSessions.find(socket);
+                       sessionItr != mSessions.end()) {
+                serveSession(*sessionItr->second, event.events);
+            }
+        }
+    }
+}
+
+void EventLoop::acceptSessions()
+{
+    while (true) {
+        const int socket
+              = ::accept4(mListeningSocket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (socket < 0) {
+            // Other loops may have accepted the pending connections already (EAGAIN)
+            if (errno != EAGAIN && errno != EINTR) {
+                std::cerr << "Unable to accept a session: " << std::strerror(errno) << "\n";
+            }
+            return;
+        }
+
+        auto session = std::make_unique<Session>(socket, mSessionOptions);
+
+        epoll_event sessionEvent{.events = cSessionEvents, .data = {.fd = socket}};
+        if (::epoll_ctl(mPoller, EPOLL_CTL_ADD, socket, &sessionEvent) != 0) {
+            std::cerr << "Unable to poll a session: " << std::strerror(errno) << "\n";
+            continue;
+        }
+
+        mSessions.emplace(socket, std::move(session));
+        ++mSessionCount;
+    }
+}
+
+void EventLoop::serveSession(Session& session, const uint32_t events)
+{
+    // Whatever the peer sent before hanging up is still processed
+    bool isOpen = (events & EPOLLERR) == 0U;
+    const auto wasReceivingPaused = session.isReceivingPaused();
+
+    if (isOpen && !wasReceivingPaused && (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) != 0U) {
+        isOpen = session.receive();
+    }
+    const auto isPausedBeforeSending = session.isReceivingPaused();
+
+    // Responses are sent right away: the socket is only waited on when its buffer is full
+    if (!session.send()) {
+        isOpen = false;
+    }
+
+    // Paused sessions are only polled for output. Polling them for input again re-arms the edge
+    // trigger, so the instructions left unread are reported right away (even if reading was
+    // paused and resumed while serving these events)
+    if (isOpen && isPausedBeforeSending) {
+        const auto isReceivingPaused = session.isReceivingPaused();
+        if (!wasReceivingPaused || !isReceivingPaused) {
+            epoll_event sessionEvent{
+                  .events = isReceivingPaused ? cPausedSessionEvents : cSessionEvents,
+                  .data = {.fd = session.getSocket()}};
+            isOpen = ::epoll_ctl(mPoller, EPOLL_CTL_MOD, session.getSocket(), &sessionEvent) == 0;
+        }
+    }
+
+    if (!isOpen || session.isFinished()) {
+        closeSession(session.getSocket());
+    }
+}
+
+void EventLoop::closeSession(const int socket)
+{
+    ::epoll_ctl(mPoller, EPOLL_CTL_DEL, socket, nullptr);
+
+    if (mSessions.erase(socket) > 0) {
+        --mSessionCount;
+    }
+}
+
+} // namespace Server
@@ -0,0 +1,107 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+
+#include "Session.hpp"
+
+namespace Server {
+
+/**
+ * @brief Event loop serving a shard of the calculator sessions on its own thread
+ *
+ * Every loop polls the (shared) listening socket: the kernel wakes a single loop per incoming
+ * connection and the session it accepts stays pinned to that loop for its whole lifetime,
+ * so sessions are never shared between threads.
+ */
+class EventLoop
+{
+public:
+    /**
+     * @brief Class constructor
+     *
+     * @param[in] listeningSocket Non-blocking listening socket (owned by the server)
+     * @param[in] sessionOptions Options of every session
+     * @param[in,out] sessionCount Amount of open sessions, shared by every loop of the server
+     */
+    EventLoop(int listeningSocket,
+              Session::Options sessionOptions,
+              std::atomic<std::size_t>& sessionCount);
+
+    /**
+     * @brief Class destructor (stops the loop, closing its sessions)
+     */
+    ~EventLoop();
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+    EventLoop(EventLoop&&) = delete;
+    EventLoop& operator=(EventLoop&&) = delete;
+
+    /**
+     * @brief Starts serving sessions on a new thread
+     *
+     * @param[in] core Index of the core the thread is pinned to (ignored if not available)
+     *
+     * @return True if the loop was started (false otherwise)
+     */
+    [[nodiscard]] bool start(std::size_t core);
+
+    /**
+     * @brief Stops the loop and waits for its thread to finish (closing its sessions)
+     */
+    void stop();
+
+private:
+    /**
+     * @brief Body of the thread: dispatches socket events until the loop is stopped
+     */
+    void run();
+
+    /**
+     * @brief Accepts every pending connection, opening a session for each of them
+     */
+    void acceptSessions();
+
+    /**
+     * @brief Handles the events of a session socket
+     *
+     * @param[in] session Session whose socket has events
+     * @param[in] events Polled events
+     */
+    void serveSession(Session& session, uint32_t events);
+
+    /**
+     * @brief Closes a session, unregistering its socket
+     *
+     * @param[in] socket Socket of the session
+     */
+    void closeSession(int socket);
+
+private:
+    /// Listening socket shared by every loop of the server
+    int mListeningSocket;
+
+    /// Options of every session
+    Session::Options mSessionOptions;
+
+    /// Amount of open sessions, shared by every loop of the server
+    std::atomic<std::size_t>& mSessionCount;
+
+    /// Poller of the loop (epoll instance)
+    int mPoller{-1};
+
+    /// Event used to wake the loop up when it must stop
+    int mStopEvent{-1};
+
+    /// Sessions served by the loop, indexed by their socket
+    std::unordered_map<int, std::unique_ptr<Session>> mSessions;
+
+    /// Thread running the loop
+    std::thread mThread;
+};
+
+} // namespace Server
@@ -0,0 +1,139 @@
+#include "Session.hpp"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <string_view>
+
+#include "utils/Methods.hpp"
+
+namespace {
+/// Size of the chunks read from the socket
+constexpr std::size_t cReadChunkSize{16 * 1024};
+} // namespace
+
+namespace Server {
+
+Session::Session(const int socket, const Options& options)
+    : mSocket{socket}
+    , mRunner{options.expressionCacheCapacity}
+{
+    mRunner.setFileCommandsEnabled(options.areFileCommandsEnabled);
+    mRunner.setDiagnosticsStream(mDiscardedDiagnostics);
+}
+
+Session::~Session()
+{
+    ::close(mSocket);
+}
+
+int Session::getSocket() const
+{
+    return mSocket;
+}
+
+bool Session::receive()
+{
+    std::array<char, cReadChunkSize> chunk;
+
+    // Drain the socket (it is polled in edge triggered mode), unless too many responses
+    // are queued: the remaining instructions are then left in the socket,
+    // which pushes back on the client once its buffers are full
+    while (!isReceivingPaused()) {
+        const auto readCount = ::recv(mSocket, chunk.data(), chunk.size(), 0);
+
+        if (readCount > 0) {
+            mInputBuffer.append(chunk.data(), static_cast<std::size_t>(readCount));
+            if (!processInstructions()) {
+                return false;
+            }
+            continue;
+        }
+
+        if (readCount == 0) {
+            // Peer hang up: whatever was left is not a complete instruction,
+            // but the queued responses are still sent
+            mHasPeerHungUp = true;
+            return true;
+        }
+
+        if (errno == EINTR) {
+            continue;
+        }
+
+        return errno == EAGAIN;
+    }
+
+    return true;
+}
+
+bool Session::send()
+{
+    while (mSentByteCount < mOutputBuffer.size()) {
+        const auto sentCount = ::send(mSocket,
+                                      mOutputBuffer.data() + mSentByteCount,
+                                      mOutputBuffer.size() - mSentByteCount,
+                                      MSG_NOSIGNAL);
+
+        if (sentCount >= 0) {
+            mSentByteCount += static_cast<std::size_t>(sentCount);
+            continue;
+        }
+
+        if (errno == EINTR) {
+            continue;
+        }
+
+        return errno == EAGAIN;
+    }
+
+    // Everything was sent: the buffer storage is kept for the next responses
+    mOutputBuffer.clear();
+    mSentByteCount = 0;
+
+    return true;
+}
+
+bool Session::isReceivingPaused() const
+{
+    return mOutputBuffer.size() - mSentByteCount >= cMaxQueuedResponseSize;
+}
+
+bool Session::isFinished() const
+{
+    return mHasPeerHungUp && mOutputBuffer.empty();
+}
+
+std::size_t Session::getInstructionCount() const
+{
+    return mInstructionCount;
+}
+
+bool Session::processInstructions()
+{
+    std::string_view input{mInputBuffer};
+
+    for (auto lineEnd = input.find('\n'); lineEnd != std::string_view::npos;
+         lineEnd = input.find('\n')) {
+        const auto instruction = Utils::Methods::removeLineEnding(input.substr(0, lineEnd));
+        input.remove_prefix(lineEnd + 1);
+
+        const auto results = mRunner.processInstruction(instruction);
+        for (auto itr = results.cbegin(); itr != results.cend(); ++itr) {
+            if (itr != results.cbegin()) {
+                mOutputBuffer += ", ";
+            }
+            mOutputBuffer += *itr;
+        }
+        mOutputBuffer += '\n';
+        ++mInstructionCount;
+    }
+
+    mInputBuffer.erase(0, mInputBuffer.size() - input.size());
+
+    return mInputBuffer.size() <= cMaxInstructionLength;
+}
+
+} // namespace Server
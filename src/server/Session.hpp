@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+
+#include "calculator/Runner.hpp"
+
+namespace Server {
+
+/**
+ * @brief Calculator session of a client connected to the server
+ *
+ * Every session owns its own calculator, fed with the instructions received over its
+ * (non-blocking) socket. The line protocol mirrors the batch mode: one instruction per line
+ * is received and exactly one line is sent back for each of them, holding its comma separated
+ * results (empty if the instruction has no results), so that clients can pipeline instructions.
+ * The only multi-line response is the report of the "stats" command (one line per entry).
+ *
+ * Clients that do not read their responses are pushed back on: no more instructions are read
+ * while too many responses are queued, so the memory of a session stays bounded.
+ */
+class Session
+{
+public:
+    /// Maximum length of an instruction (sessions sending longer lines are closed)
+    static constexpr std::size_t cMaxInstructionLength{64 * 1024};
+
+    /// Amount of queued response bytes beyond which no more instructions are read
+    static constexpr std::size_t cMaxQueuedResponseSize{1024 * 1024};
+
+    /**
+     * @brief Options of the calculator of a session
+     */
+    struct Options
+    {
+        /// Capacity of the expression cache of the calculator
+        std::size_t expressionCacheCapacity{Calculator::Runner::cDefaultExpressionCacheCapacity};
+        /// Whether the client can save and load snapshots (files of the server)
+        bool areFileCommandsEnabled{false};
+    };
+
+    /**
+     * @brief Class constructor
+     *
+     * @param[in] socket Connected (non-blocking) socket, owned by the session from now on
+     * @param[in] options Options of the calculator of the session
+     */
+    Session(int socket, const Options& options);
+
+    /**
+     * @brief Class destructor (closes the socket)
+     */
+    ~Session();
+
+    Session(const Session&) = delete;
+    Session& operator=(const Session&) = delete;
+    Session(Session&&) = delete;
+    Session& operator=(Session&&) = delete;
+
+    /**
+     * @brief Getter for the socket of the session
+     *
+     * @return File descriptor of the socket
+     */
+    [[nodiscard]] int getSocket() const;
+
+    /**
+     * @brief Reads the available instructions and processes the complete ones,
+     * queuing their responses
+     *
+     * Reading stops early once receiving is paused (see isReceivingPaused)
+     *
+     * @return False if the session must be closed (error or protocol violation)
+     */
+    [[nodiscard]] bool receive();
+
+    /**
+     * @brief Sends as many queued responses as the socket accepts
+     *
+     * @return False if the session must be closed (error)
+     */
+    [[nodiscard]] bool send();
+
+    /**
+     * @brief Checks whether reading instructions is paused until the queued responses are sent
+     *
+     * @return True if too many responses are queued
+     */
+    [[nodiscard]] bool isReceivingPaused() const;
+
+    /**
+     * @brief Checks whether the session is over: the peer hung up and every response was sent
+     *
+     * @return True if the session can be closed
+     */
+    [[nodiscard]] bool isFinished() const;
+
+    /**
+     * @brief Getter for the amount of instructions processed by the session
+     *
+     * @return Processed instructions
+     */
+    [[nodiscard]] std::size_t getInstructionCount() const;
+
+private:
+    /**
+     * @brief Processes every complete instruction of the input buffer
+     *
+     * @return False if the longest incomplete instruction exceeds the maximum length
+     */
+    [[nodiscard]] bool processInstructions();
+
+private:
+    /// Connected socket of the client
+    int mSocket;
+
+    /// Stream discarding the diagnostics of the calculator (it has no buffer), so that clients
+    /// cannot flood the log of the server with them (nor interleave them with other sessions')
+    std::ostream mDiscardedDiagnostics{nullptr};
+
+    /// Calculator of the session
+    Calculator::Runner mRunner;
+
+    /// Received bytes not yet processed (an incomplete instruction, at most)
+    std::string mInputBuffer;
+
+    /// Responses not yet sent
+    std::string mOutputBuffer;
+
+    /// Amount of bytes of the output buffer already sent
+    std::size_t mSentByteCount{0};
+
+    /// Amount of instructions processed by the session
+    std::size_t mInstructionCount{0};
+
+    /// Whether the peer hung up (no more instructions will be received)
+    bool mHasPeerHungUp{false};
+};
+
+} // namespace Server
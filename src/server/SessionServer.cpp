@@ -0,0 +1,108 @@
+#include "SessionServer.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+namespace {
+/// Maximum amount of connections waiting to be accepted
+constexpr int cListenBacklog{4096};
+} // namespace
+
+namespace Server {
+
+SessionServer::SessionServer(Configuration configuration)
+    : mConfiguration{std::move(configuration)}
+{
+    if (mConfiguration.threadCount == 0) {
+        mConfiguration.threadCount = std::max(1U, std::thread::hardware_concurrency());
+    }
+}
+
+SessionServer::~SessionServer()
+{
+    stop();
+}
+
+bool SessionServer::start()
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+
+    if (mConfiguration.socketPath.empty()
+        || mConfiguration.socketPath.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Invalid socket path: " << mConfiguration.socketPath << "\n";
+        return false;
+    }
+    std::copy(mConfiguration.socketPath.begin(),
+              mConfiguration.socketPath.end(),
+              std::begin(address.sun_path));
+
+    mListeningSocket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (mListeningSocket < 0) {
+        std::cerr << "Unable to create the socket: " << std::strerror(errno) << "\n";
+        return false;
+    }
+
+    // A socket left behind by a previous server would make the binding fail
+    ::unlink(mConfiguration.socketPath.c_str());
+
+    if (::bind(mListeningSocket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0
+        || ::listen(mListeningSocket, cListenBacklog) != 0) {
+        std::cerr << "Unable to listen on " << mConfiguration.socketPath << ": "
+                  << std::strerror(errno) << "\n";
+        stop();
+        return false;
+    }
+
+    const auto coreCount = std::max(1U, std::thread::hardware_concurrency());
+    for (std::size_t index = 0; index < mConfiguration.threadCount; ++index) {
+        mEventLoops.push_back(std::make_unique<EventLoop>(
+              mListeningSocket,
+              Session::Options{.expressionCacheCapacity = mConfiguration.expressionCacheCapacity,
+                               .areFileCommandsEnabled = mConfiguration.areFileCommandsEnabled},
+              mSessionCount));
+
+        if (!mEventLoops.back()->start(index % coreCount)) {
+            stop();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void SessionServer::stop()
+{
+    // Event loops (and their sessions) go first, since they poll the listening socket
+    mEventLoops.clear();
+
+    if (mListeningSocket >= 0) {
+        ::close(mListeningSocket);
+        ::unlink(mConfiguration.socketPath.c_str());
+        mListeningSocket = -1;
+    }
+}
+
+const std::string& SessionServer::getSocketPath() const
+{
+    return mConfiguration.socketPath;
+}
+
+std::size_t SessionServer::getThreadCount() const
+{
+    return mConfiguration.threadCount;
+}
+
+std::size_t SessionServer::getSessionCount() const
+{
+    return mSessionCount;
+}
+
+} // namespace Server
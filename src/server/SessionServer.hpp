@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "EventLoop.hpp"
+#include "calculator/Runner.hpp"
+
+namespace Server {
+
+/**
+ * @brief Server hosting many independent calculator sessions in a single process
+ *
+ * Clients connect to a local (Unix domain) socket and each connection gets its own session
+ * (i.e. its own calculator). Sessions are sharded between event loops, one per thread,
+ * each of them pinned to a core.
+ */
+class SessionServer
+{
+public:
+    /**
+     * @brief Configuration of the server
+     */
+    struct Configuration
+    {
+        /// Path of the socket the server listens on (replaced if it already exists)
+        std::string socketPath;
+        /// Amount of event loops (0 runs one per available core)
+        std::size_t threadCount{0};
+        /// Capacity of the expression cache of every session
+        std::size_t expressionCacheCapacity{Calculator::Runner::cDefaultExpressionCacheCapacity};
+        /// Whether clients can save and load snapshots (reading and writing files of the server)
+        bool areFileCommandsEnabled{false};
+    };
+
+    /**
+     * @brief Class constructor
+     *
+     * @param[in] configuration Configuration of the server
+     */
+    explicit SessionServer(Configuration configuration);
+
+    /**
+     * @brief Class destructor (stops the server)
+     */
+    ~SessionServer();
+
+    SessionServer(const SessionServer&) = delete;
+    SessionServer& operator=(const SessionServer&) = delete;
+    SessionServer(SessionServer&&) = delete;
+    SessionServer& operator=(SessionServer&&) = delete;
+
+    /**
+     * @brief Starts listening for clients and serving their sessions (on background threads)
+     *
+     * @return True if the server was started (false otherwise)
+     */
+    [[nodiscard]] bool start();
+
+    /**
+     * @brief Stops serving sessions (closing all of them) and removes the socket
+     */
+    void stop();
+
+    /**
+     * @brief Getter for the path of the socket the server listens on
+     *
+     * @return Socket path
+     */
+    [[nodiscard]] const std::string& getSocketPath() const;
+
+    /**
+     * @brief Getter for the amount of event loops
+     *
+     * @return Amount of threads serving sessions
+     */
+    [[nodiscard]] std::size_t getThreadCount() const;
+
+    /**
+     * @brief Getter for the amount of open sessions
+     *
+     * @return Amount of connected clients
+     */
+    [[nodiscard]] std::size_t getSessionCount() const;
+
+private:
+    /// Configuration of the server
+    Configuration mConfiguration;
+
+    /// Listening socket (shared by every event loop)
+    int mListeningSocket{-1};
+
+    /// Amount of open sessions, updated by every event loop
+    std::atomic<std::size_t> mSessionCount{0};
+
+    /// Event loops serving the sessions
+    std::vector<std::unique_ptr<EventLoop>> mEventLoops;
+};
+
+} // namespace Server
@@ -0,0 +1,150 @@
+#include "SymbolTable.hpp"
+
+#include <algorithm>
+#include <functional>
+
+namespace {
+/// Amount of slots of the lookup table once the first name is interned
+constexpr std::size_t cInitialSlotCount{16};
+
+/**
+ * @brief Hashes an operand name
+ *
+ * @param[in] name Operand name
+ *
+ * @return Hash of the name
+ */
+std::size_t hashName(const std::string_view name)
+{
+    return std::hash<std::string_view>{}(name);
+}
+
+/**
+ * @brief Extracts the tag stored in the lookup table from the hash of a name
+ *
+ * The lower bits of the hash select the first slot to probe,
+ * so the upper ones tell apart the names probing the same slots
+ *
+ * @param[in] hash Hash of the name
+ *
+ * @return Tag of the hash
+ */
+constexpr uint32_t getHashTag(const std::size_t hash)
+{
+    return static_cast<uint32_t>(static_cast<uint64_t>(hash) >> 32U);
+}
+} // namespace
+
+namespace Symbols {
+
+SymbolId SymbolTable::intern(const std::string_view name)
+{
+    const auto hash = hashName(name);
+
+    if (!mSlots.empty()) {
+        if (const auto& slot = mSlots[findSlot(name, hash)]; slot.symbolId != cEmptySlot) {
+            return slot.symbolId;
+        }
+    }
+
+    // Keeping at most half of the slots occupied keeps the probe sequences short
+    if (2 * (size() + 1) > mSlots.size()) {
+        rehash(std::max(cInitialSlotCount, 2 * mSlots.size()));
+    }
+
+    const auto symbolId = static_cast<SymbolId>(size());
+    mNameCharacters.append(name);
+    mNameOffsets.push_back(mNameCharacters.size());
+    mSlots[findSlot(name, hash)] = {getHashTag(hash), symbolId};
+
+    return symbolId;
+}
+
+std::optional<SymbolId> SymbolTable::find(const std::string_view name) const
+{
+    if (mSlots.empty()) {
+        return {};
+    }
+
+    if (const auto& slot = mSlots[findSlot(name, hashName(name))]; slot.symbolId != cEmptySlot) {
+        return slot.symbolId;
+    }
+
+    return {};
+}
+
+std::string_view SymbolTable::getName(const SymbolId symbolId) const
+{
+    const auto nameOffset = mNameOffsets[symbolId];
+    return std::string_view{mNameCharacters}.substr(nameOffset,
+                                                    mNameOffsets[symbolId + 1] - nameOffset);
+}
+
+std::size_t SymbolTable::size() const
+{
+    return mNameOffsets.size() - 1;
+}
+
+void SymbolTable::truncate(const std::size_t symbolCount)
+{
+    const auto slotMask = mSlots.size() - 1;
+
+    // The slots of the forgotten names are emptied (while their names are still available),
+    // moving back the names that follow them in a probe sequence, so that they are still found
+    // (backward shift deletion)
+    for (auto symbolId = size(); symbolId > symbolCount; --symbolId) {
+        const auto name = getName(static_cast<SymbolId>(symbolId - 1));
+        auto emptySlotIndex = findSlot(name, hashName(name));
+        mSlots[emptySlotIndex].symbolId = cEmptySlot;
+
+        for (auto slotIndex = (emptySlotIndex + 1) & slotMask;
+             mSlots[slotIndex].symbolId != cEmptySlot;
+             slotIndex = (slotIndex + 1) & slotMask) {
+            // A name can only be moved back if its probe sequence starts before the empty slot
+            const auto firstSlotIndex = hashName(getName(mSlots[slotIndex].symbolId)) & slotMask;
+            if (((slotIndex - firstSlotIndex) & slotMask)
+                >= ((slotIndex - emptySlotIndex) & slotMask)) {
+                mSlots[emptySlotIndex] = mSlots[slotIndex];
+                mSlots[slotIndex].symbolId = cEmptySlot;
+                emptySlotIndex = slotIndex;
+            }
+        }
+    }
+
+    if (symbolCount < size()) {
+        mNameCharacters.resize(mNameOffsets[symbolCount]);
+        mNameOffsets.resize(symbolCount + 1);
+    }
+}
+
+std::size_t SymbolTable::findSlot(const std::string_view name, const std::size_t hash) const
+{
+    const auto slotMask = mSlots.size() - 1;
+    const auto hashTag = getHashTag(hash);
+
+    for (auto slotIndex = hash & slotMask;; slotIndex = (slotIndex + 1) & slotMask) {
+        const auto& slot = mSlots[slotIndex];
+        if (slot.symbolId == cEmptySlot
+            || (slot.hashTag == hashTag && getName(slot.symbolId) == name)) {
+            return slotIndex;
+        }
+    }
+}
+
+void SymbolTable::rehash(const std::size_t slotCount)
+{
+    mSlots.assign(slotCount, {0, cEmptySlot});
+
+    // Names are unique, so each of them is placed in the first empty slot of its probe sequence
+    for (SymbolId symbolId = 0; symbolId < size(); ++symbolId) {
+        const auto hash = hashName(getName(symbolId));
+
+        auto slotIndex = hash & (slotCount - 1);
+        while (mSlots[slotIndex].symbolId != cEmptySlot) {
+            slotIndex = (slotIndex + 1) & (slotCount - 1);
+        }
+        mSlots[slotIndex] = {getHashTag(hash), symbolId};
+    }
+}
+
+} // namespace Symbols
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Symbols {
+
+/// Alias representing the dense integer identifier of an interned operand name
+using SymbolId = uint32_t;
+
+/**
+ * @brief Class responsible for interning operand names
+ *
+ * Every distinct name is mapped (once) to a dense identifier, starting at 0,
+ * so that operand related data can be stored in flat containers indexed by that identifier.
+ * Names are only needed again when presenting results.
+ *
+ * Names are stored back to back in a single buffer and looked up through an open addressing
+ * (linear probing) hash table of identifiers, which is kept at most half full,
+ * so lookups stay a short scan of adjacent slots regardless of the amount of names.
+ */
+class SymbolTable
+{
+public:
+    /**
+     * @brief Class' default constructor
+     */
+    SymbolTable() = default;
+
+    /**
+     * @brief Retrieves the identifier of a name, interning it if it was never seen before
+     *
+     * @param[in] name Operand name
+     *
+     * @return Identifier of the name
+     */
+    [[nodiscard]] SymbolId intern(std::string_view name);
+
+    /**
+     * @brief Retrieves the identifier of an already interned name
+     *
+     * @param[in] name Operand name
+     *
+     * @return Identifier of the name (empty if the name was never interned)
+     */
+    [[nodiscard]] std::optional<SymbolId> find(std::string_view name) const;
+
+    /**
+     * @brief Retrieves the name associated with an identifier
+     *
+     * @param[in] symbolId Identifier of an interned name
+     *
+     * @return View of the operand name (only valid until the next name is interned)
+     */
+    [[nodiscard]] std::string_view getName(SymbolId symbolId) const;
+
+    /**
+     * @brief Getter for the amount of interned names
+     *
+     * @return Number of interned names (which is also the next identifier to be assigned)
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @brief Forgets the most recently interned names, keeping the first ones only
+     * (used to roll back the names introduced by a rejected instruction)
+     *
+     * @param[in] symbolCount Amount of names to keep (their identifiers are not changed)
+     */
+    void truncate(std::size_t symbolCount);
+
+private:
+    /**
+     * @brief Slot of the lookup table
+     */
+    struct Slot
+    {
+        /// Upper half of the hash of the name (compared before the name itself)
+        uint32_t hashTag;
+        /// Identifier of the name (cEmptySlot if the slot is empty)
+        SymbolId symbolId;
+    };
+
+    /// Identifier marking the empty slots of the lookup table
+    static constexpr SymbolId cEmptySlot{UINT32_MAX};
+
+    /**
+     * @brief Finds the slot holding a name or, if it is absent, the empty slot ending its probe
+     *
+     * @param[in] name Operand name
+     * @param[in] hash Hash of the name
+     *
+     * @return Index of the slot (the lookup table must not be empty)
+     */
+    [[nodiscard]] std::size_t findSlot(std::string_view name, std::size_t hash) const;
+
+    /**
+     * @brief Resizes the lookup table, placing every interned name again
+     *
+     * @param[in] slotCount New amount of slots (a power of two)
+     */
+    void rehash(std::size_t slotCount);
+
+private:
+    /// Characters of the interned names, back to back (in order of their identifiers)
+    std::string mNameCharacters;
+
+    /// Offsets of the interned names into mNameCharacters (plus the end of the last one)
+    std::vector<std::size_t> mNameOffsets{0};
+
+    /// Lookup table used to find identifiers by name (its size is a power of two)
+    std::vector<Slot> mSlots;
+};
+
+} // namespace Symbols
@@ -0,0 +1,188 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <vector>
+
+#include "utils/Constants.hpp"
+#include "utils/Grammar.hpp"
+
+namespace Utils::Grammar {
+
+/**
+ * @brief Receiver of the tokens of an arithmetic expression, in postfix order
+ */
+template <typename T>
+concept ExpressionOutput = requires(T output, std::string_view name, int64_t value, char op) {
+    // Variable (an identifier)
+    output.addVariable(name);
+    // Integer literal
+    output.addLiteral(value);
+    // Binary operator, consuming the two previous operands
+    output.addOperator(op);
+};
+
+/**
+ * @brief Scans an arithmetic expression (the RHS of an assignment), validating it
+ * and outputting its tokens in postfix order (Shunting Yard algorithm)
+ *
+ * Tokenization, syntax validation and reordering all happen in a single forward scan,
+ * which stops as soon as an unexpected token is found (the output is then incomplete).
+ * The grammar only allows operands and binary operators to alternate,
+ * so tracking which one comes next is enough to validate the expression:
+ * - operands (and '(') are expected at the start, after an operator and after '(';
+ * - operators (and ')') are expected after an operand and after ')'.
+ *
+ * Everything is constexpr, so that expressions are parsed the same way at run time (by the
+ * Parser) and at compile time (by Calculator::Expr)
+ *
+ * @tparam Output Type of the receiver of the tokens
+ *
+ * @param[in] expression Arithmetic expression to scan (it must outlive the output variables)
+ * @param[in,out] output Receiver of the tokens
+ *
+ * @return Reason why the expression was rejected (empty if valid)
+ */
+template <ExpressionOutput Output>
+[[nodiscard]] constexpr std::string_view scanExpression(const std::string_view expression,
+                                                        Output& output)
+{
+    using namespace Utils::Constants;
+
+    // An expression never has more operators than characters,
+    // so a single allocation is enough to hold the whole stack
+    std::vector<char> operatorStack;
+    operatorStack.reserve(expression.size() + 1);
+
+    // Helper lambda used to output the operator on top of the stack
+    const auto outputOperator = [&]() {
+        output.addOperator(operatorStack.back());
+        operatorStack.pop_back();
+    };
+
+    // Helper lambda used to output operators until the closest left parenthesis is reached
+    // (which is then popped)
+    const auto closeParenthesis = [&]() {
+        while (operatorStack.back() != cLeftParenthesis) {
+            outputOperator();
+        }
+        operatorStack.pop_back();
+    };
+
+    // The expression is handled as if it was wrapped around parenthesis
+    // (the right one is handled after the scan)
+    operatorStack.push_back(cLeftParenthesis);
+    uint32_t openParenthesisCounter{0};
+    bool isOperandExpected{true};
+    bool isEmpty{true};
+
+    for (std::size_t position = 0; position < expression.size(); ++position) {
+        const auto character = expression[position];
+
+        // White spaces are not meaningful
+        if (isWhiteSpace(character)) {
+            continue;
+        }
+        isEmpty = false;
+
+        // Account for the possibility that we might have either an integer literal or a variable,
+        // both of them spanning every following character that can be part of an operand
+        if (isOperandCharacter(character)) {
+            if (!isOperandExpected) {
+                return "Invalid expression provided";
+            }
+
+            auto operandEnd = position + 1;
+            while (operandEnd < expression.size() && isOperandCharacter(expression[operandEnd])) {
+                ++operandEnd;
+            }
+            const auto operand = expression.substr(position, operandEnd - position);
+            position = operandEnd - 1;
+
+            if (isIdentifierStart(character)) {
+                output.addVariable(operand);
+            } else {
+                // Literals are made of digits only (e.g. "2a" is rejected),
+                // and must fit in the values expressions are evaluated with
+                int64_t literal{0};
+                for (const auto digitCharacter : operand) {
+                    if (!isDigit(digitCharacter)) {
+                        return "Invalid expression provided";
+                    }
+
+                    const auto digit = digitCharacter - '0';
+                    if (literal > (std::numeric_limits<int64_t>::max() - digit) / 10) {
+                        return "Integer literal is too large";
+                    }
+                    literal = literal * 10 + digit;
+                }
+
+                output.addLiteral(literal);
+            }
+            isOperandExpected = false;
+
+        } else if (isOperator(character)) {
+            if (isOperandExpected) {
+                // TODO: Add support for expressions with negative integers (e.g. "-2*3")
+                return character == cSubOp ? "Negative values are not currently supported"
+                                           : "Invalid expression provided";
+            }
+
+            // Output operators until an operator with a lower precedence
+            // than the new one is found on the top of the operator stack
+            while (operatorPrecedence(operatorStack.back()) >= operatorPrecedence(character)) {
+                outputOperator();
+            }
+
+            operatorStack.push_back(character);
+            isOperandExpected = true;
+
+        } else if (character == cLeftParenthesis) {
+            // TODO: Add support for expressions with implicit multiplication (e.g. "2(")
+            if (!isOperandExpected) {
+                return "Invalid expression provided";
+            }
+
+            operatorStack.push_back(character);
+            ++openParenthesisCounter;
+
+        } else if (character == cRightParenthesis) {
+            if (openParenthesisCounter == 0) {
+                return "Parenthesis do not match";
+            }
+            if (isOperandExpected) {
+                return "Invalid expression provided";
+            }
+
+            closeParenthesis();
+            --openParenthesisCounter;
+
+        } else {
+            return "Invalid expression provided";
+        }
+    }
+
+    if (isEmpty) {
+        return "Empty expression provided";
+    }
+
+    // Validate that the expression does not end with an operator
+    if (isOperandExpected) {
+        return "Invalid expression provided";
+    }
+
+    // Validate the amount of parenthesis pairs
+    if (openParenthesisCounter != 0) {
+        return "Parenthesis do not match";
+    }
+
+    // Close the wrapping parenthesis, outputting the remaining operators
+    closeParenthesis();
+
+    return {};
+}
+
+} // namespace Utils::Grammar
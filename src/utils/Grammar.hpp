@@ -0,0 +1,151 @@
+#pragma once
+
+#include <cstdint>
+
+#include "utils/Constants.hpp"
+
+/**
+ * @brief Character classes and operator precedences of the arithmetic expressions grammar
+ *
+ * Everything is constexpr (and independent of the C locale),
+ * so that expressions can be parsed both at run time and at compile time
+ */
+namespace Utils::Grammar {
+
+/**
+ * @brief Checks if the provided character is a white space (as in the "C" locale)
+ *
+ * @param[in] character Character to evaluate
+ *
+ * @return True if the character is a white space (false otherwise)
+ */
+[[nodiscard]] constexpr bool isWhiteSpace(const char character)
+{
+    switch (character) {
+    case ' ':
+    case '\t':
+    case '\n':
+    case '\v':
+    case '\f':
+    case '\r':
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Checks if the provided character is a decimal digit
+ *
+ * @param[in] character Character to evaluate
+ *
+ * @return True if the character is a digit (false otherwise)
+ */
+[[nodiscard]] constexpr bool isDigit(const char character)
+{
+    return character >= '0' && character <= '9';
+}
+
+/**
+ * @brief Checks if the provided character can start an identifier
+ *
+ * @param[in] character Character to evaluate
+ *
+ * @return True if it is a letter or an underscore (false otherwise)
+ */
+[[nodiscard]] constexpr bool isIdentifierStart(const char character)
+{
+    return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z')
+           || character == '_';
+}
+
+/**
+ * @brief Checks if the provided character can be part of an operand
+ * (an identifier, made of letters, digits and underscores, or an integer literal)
+ *
+ * @param[in] character Character to evaluate
+ *
+ * @return True if the character can be part of an operand (false otherwise)
+ */
+[[nodiscard]] constexpr bool isOperandCharacter(const char character)
+{
+    return isIdentifierStart(character) || isDigit(character);
+}
+
+/**
+ * @brief Checks if the provided character is a parenthesis
+ *
+ * @param[in] character Character to evaluate
+ *
+ * @return True if is a supported parenthesis (false otherwise)
+ */
+[[nodiscard]] constexpr bool isParenthesis(const char character)
+{
+    using namespace Utils::Constants;
+    switch (character) {
+    case cLeftParenthesis:
+    case cRightParenthesis:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Checks if the provided character is a valid binary operator
+ *
+ * @param[in] character Character to evaluate
+ *
+ * @return True if is a supported operator (false otherwise)
+ */
+[[nodiscard]] constexpr bool isOperator(const char character)
+{
+    using namespace Utils::Constants;
+    switch (character) {
+    case cAddOp:
+    case cSubOp:
+    case cMultOp:
+    case cDivOp:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/**
+ * @brief Determines the precedence level of an operator based on its type
+ *
+ * When constructing the AST using the Shunting Yard algorithm,
+ * each operator being processed causes its preceding operators to "execute"
+ * (new nodes in the AST are created) only if it has a higher precedence value
+ *
+ * Precedence levels:
+ * - '('        : 1 (lowest precedence)
+ * - '+', '-'   : 2
+ * - '*', '/'   : 3
+ * - ')'        : 4 (highest precedence)
+ *
+ * @param[in] op Operator whose precedence is to be determined
+ *
+ * @return The precedence level of the operator
+ */
+[[nodiscard]] constexpr uint8_t operatorPrecedence(const char op)
+{
+    using namespace Utils::Constants;
+    switch (op) {
+    case cRightParenthesis:
+        return 4;
+    case cMultOp:
+    case cDivOp:
+        return 3;
+    case cAddOp:
+    case cSubOp:
+        return 2;
+    case cLeftParenthesis:
+        return 1;
+    default:
+        return 0;
+    }
+}
+
+} // namespace Utils::Grammar
@@ -4,6 +4,7 @@
 #include <cctype>
 #include <iostream>
 #include <ranges>
+#include <string_view>
 #include <utility>
 #include <vector>
 
@@ -41,4 +42,46 @@ inline constexpr void removeWhiteSpacesFromString(std::string& stringToTrim)
           stringToTrim.end());
 }
 
+/**
+ * @brief Removes the leading and trailing whitespace characters from the provided view
+ *
+ * @param[in] stringToTrim View to trim
+ *
+ * @return View of the provided characters without leading and trailing whitespaces
+ */
+[[nodiscard]] inline constexpr std::string_view trimWhiteSpaces(std::string_view stringToTrim)
+{
+    const auto isWhiteSpace = [](const char stringChar) {
+        return std::isspace(static_cast<unsigned char>(stringChar)) != 0;
+    };
+
+    while (!stringToTrim.empty() && isWhiteSpace(stringToTrim.front())) {
+        stringToTrim.remove_prefix(1);
+    }
+    while (!stringToTrim.empty() && isWhiteSpace(stringToTrim.back())) {
+        stringToTrim.remove_suffix(1);
+    }
+
+    return stringToTrim;
+}
+
+/**
+ * @brief Removes the line ending left at the end of a line of text
+ *
+ * Lines are split on '\n', so the carriage return of Windows line endings ("\r\n") is dropped
+ * here, so that every input (stdin, files, logs and sockets) accepts both line endings
+ *
+ * @param[in] line Line of text (without its '\n')
+ *
+ * @return View of the line without its trailing carriage return
+ */
+[[nodiscard]] inline constexpr std::string_view removeLineEnding(std::string_view line)
+{
+    if (!line.empty() && line.back() == '\r') {
+        line.remove_suffix(1);
+    }
+
+    return line;
+}
+
 } // namespace Utils::Methods
@@ -0,0 +1,278 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+
+namespace Utils {
+
+/**
+ * @brief Immutable (persistent) vector, implemented as a 4-way trie of shared nodes
+ *
+ * Updating a vector produces a new one that shares every untouched node with the original,
+ * so keeping many versions around only costs memory proportional to their differences,
+ * and copying a version is constant time (a single root pointer).
+ * Entries that were never set hold a default constructed value.
+ * Nodes are kept small since every update copies a whole path (from the root to a leaf).
+ *
+ * @tparam T Type of the entries (must be default constructible and equality comparable)
+ */
+template <typename T>
+class PersistentVector
+{
+public:
+    /// Alias representing an update of the entry at a given index
+    using Update = std::pair<std::size_t, T>;
+
+    /**
+     * @brief Class' default constructor (empty vector)
+     */
+    PersistentVector() = default;
+
+    /**
+     * @brief Getter for the amount of entries of the vector
+     *
+     * @return One past the highest index that was ever set
+     */
+    [[nodiscard]] std::size_t size() const { return mSize; }
+
+    /**
+     * @brief Retrieves an entry of the vector
+     *
+     * @param[in] index Index of the entry (entries beyond the end of the vector are default)
+     *
+     * @return Value of the entry
+     */
+    [[nodiscard]] T get(const std::size_t index) const
+    {
+        if (index >= mSize) {
+            return T{};
+        }
+
+        const Node* node = mRoot.get();
+        for (auto shift = mShift; node && shift > 0; shift -= cBits) {
+            node = static_cast<const Branch*>(node)->children[(index >> shift) & cMask].get();
+        }
+
+        return node ? static_cast<const Leaf*>(node)->values[index & cMask] : T{};
+    }
+
+    /**
+     * @brief Creates a new version of the vector with some of its entries updated
+     *
+     * Only the nodes on the paths to the updated entries are copied
+     *
+     * @param[in] updates Updated entries, sorted by (unique) index
+     *
+     * @return Updated vector
+     */
+    [[nodiscard]] PersistentVector with(const std::span<const Update> updates) const
+    {
+        if (updates.empty()) {
+            return *this;
+        }
+
+        PersistentVector updatedVector{*this};
+        updatedVector.mSize = std::max(mSize, updates.back().first + 1);
+
+        // Grow the trie (one level at a time, keeping the current root as the first child)
+        // until it can hold the highest updated index
+        while ((updatedVector.mSize - 1) >> updatedVector.mShift >= cBranchingFactor) {
+            if (updatedVector.mRoot) {
+                auto root = std::make_shared<Branch>();
+                root->children[0] = std::move(updatedVector.mRoot);
+                updatedVector.mRoot = std::move(root);
+            }
+            updatedVector.mShift += cBits;
+        }
+
+        updatedVector.mRoot = update(updatedVector.mRoot, updatedVector.mShift, updates);
+
+        return updatedVector;
+    }
+
+    /**
+     * @brief Calls a function for every index whose entry differs between two versions
+     *
+     * Subtrees shared by both versions are skipped,
+     * so the cost is proportional to the differences between the versions
+     *
+     * @param[in] other Version to compare against
+     * @param[in] callback Function called with the index of every differing entry
+     */
+    template <typename Callback>
+    void forEachDifference(const PersistentVector& other, Callback&& callback) const
+    {
+        const auto shift = std::max(mShift, other.mShift);
+        difference({mRoot.get(), mShift}, {other.mRoot.get(), other.mShift}, shift, 0, callback);
+    }
+
+private:
+    /// Amount of index bits consumed by each level of the trie
+    static constexpr std::size_t cBits{2};
+    /// Amount of children (or entries) of each node
+    static constexpr std::size_t cBranchingFactor{std::size_t{1} << cBits};
+    /// Mask selecting the index bits of a single level
+    static constexpr std::size_t cMask{cBranchingFactor - 1};
+
+    /**
+     * @brief Base of the nodes of the trie
+     */
+    struct Node
+    {
+    };
+
+    /**
+     * @brief Inner node of the trie
+     */
+    struct Branch : Node
+    {
+        /// Child nodes (missing ones only hold default entries)
+        std::array<std::shared_ptr<const Node>, cBranchingFactor> children{};
+    };
+
+    /**
+     * @brief Leaf node of the trie
+     */
+    struct Leaf : Node
+    {
+        /// Entries of the leaf
+        std::array<T, cBranchingFactor> values{};
+    };
+
+    /**
+     * @brief Reference to a (possibly missing) node, viewed from a level of the trie
+     *
+     * A trie shallower than the viewing level is seen as the first child of missing levels
+     */
+    struct NodeView
+    {
+        /// Referenced node (nullptr if missing)
+        const Node* node{};
+        /// Level of the referenced node
+        std::size_t shift{};
+
+        /**
+         * @brief Retrieves a child of the viewed node
+         *
+         * @param[in] viewShift Level the node is viewed from
+         * @param[in] childIndex Index of the child
+         *
+         * @return View of the child, one level below
+         */
+        [[nodiscard]] NodeView child(const std::size_t viewShift,
+                                     const std::size_t childIndex) const
+        {
+            if (!node) {
+                return {};
+            }
+            if (shift < viewShift) {
+                return childIndex == 0 ? *this : NodeView{};
+            }
+
+            return {static_cast<const Branch*>(node)->children[childIndex].get(), shift - cBits};
+        }
+    };
+
+    /**
+     * @brief Copies the path to a set of updated entries
+     *
+     * @param[in] node Node to update (nullptr if missing)
+     * @param[in] shift Level of the node
+     * @param[in] updates Updated entries below the node, sorted by index
+     *
+     * @return Updated node
+     */
+    static std::shared_ptr<const Node>
+          update(const std::shared_ptr<const Node>& node,
+                 const std::size_t shift,
+                 const std::span<const Update> updates)
+    {
+        if (shift == 0) {
+            auto leaf = node ? std::make_shared<Leaf>(*static_cast<const Leaf*>(node.get()))
+                             : std::make_shared<Leaf>();
+            for (const auto& [index, value] : updates) {
+                leaf->values[index & cMask] = value;
+            }
+
+            return leaf;
+        }
+
+        auto branch = node ? std::make_shared<Branch>(*static_cast<const Branch*>(node.get()))
+                           : std::make_shared<Branch>();
+
+        // Updates are sorted, so the ones below each child are contiguous
+        for (auto begin = updates.begin(); begin != updates.end();) {
+            const auto childIndex = (begin->first >> shift) & cMask;
+            auto end = begin;
+            while (end != updates.end() && ((end->first >> shift) & cMask) == childIndex) {
+                ++end;
+            }
+
+            branch->children[childIndex] = update(
+                  branch->children[childIndex], shift - cBits, std::span<const Update>{begin, end});
+            begin = end;
+        }
+
+        return branch;
+    }
+
+    /**
+     * @brief Reports the differing entries below two nodes
+     *
+     * @param[in] left View of the first node
+     * @param[in] right View of the second node
+     * @param[in] shift Level both nodes are viewed from
+     * @param[in] base First index below the nodes
+     * @param[in] callback Function called with the index of every differing entry
+     */
+    template <typename Callback>
+    static void difference(const NodeView left,
+                           const NodeView right,
+                           const std::size_t shift,
+                           const std::size_t base,
+                           Callback& callback)
+    {
+        if (left.node == right.node && left.shift == right.shift) {
+            return;
+        }
+
+        if (shift == 0) {
+            // Missing leaves only hold default entries
+            static const Leaf cDefaultLeaf{};
+            const auto& leftValues
+                  = (left.node ? *static_cast<const Leaf*>(left.node) : cDefaultLeaf).values;
+            const auto& rightValues
+                  = (right.node ? *static_cast<const Leaf*>(right.node) : cDefaultLeaf).values;
+
+            for (std::size_t index = 0; index < cBranchingFactor; ++index) {
+                if (!(leftValues[index] == rightValues[index])) {
+                    callback(base + index);
+                }
+            }
+            return;
+        }
+
+        for (std::size_t childIndex = 0; childIndex < cBranchingFactor; ++childIndex) {
+            difference(left.child(shift, childIndex),
+                       right.child(shift, childIndex),
+                       shift - cBits,
+                       base + (childIndex << shift),
+                       callback);
+        }
+    }
+
+private:
+    /// Root node of the trie (nullptr if no entry was set yet)
+    std::shared_ptr<const Node> mRoot;
+
+    /// Level of the root node (amount of index bits below it)
+    std::size_t mShift{0};
+
+    /// One past the highest index that was ever set
+    std::size_t mSize{0};
+};
+
+} // namespace Utils
@@ -1,5 +1,13 @@
 #include "gtest/gtest.h"
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "calculator/BatchRunner.hpp"
 #include "calculator/Runner.hpp"
 #include "utils/Methods.hpp"
 
@@ -35,3 +43,468 @@ TEST(CalculatorIntegrationTest, calculatorCorrectlyPerformsSupportedOperations)
         ASSERT_EQ(operationResults, expectedResults);
     }
 }
+
+/**
+ * @brief Tests that the calculator serves repeated expressions from its expression cache
+ * (regardless of white spaces and of the LHS operand) without changing their results
+ */
+TEST(CalculatorIntegrationTest, calculatorReusesCompiledExpressions)
+{
+    Calculator::Runner calculator;
+
+    for (const auto& [arithmeticExpression, expectedResults] :
+         std::initializer_list<std::pair<std::string, std::vector<std::string>>>{
+               {"a=2", {"a = 2"}},
+               {"x=a*b+c", {}},                    // Cache miss (pending dependencies)
+               {"b=3", {"b = 3"}},
+               {"c=4", {"c = 4", "x = 10"}},
+               {"y = a * b + c", {"y = 10"}},      // Cache hit
+               {"b=5", {"b = 5", "x = 14"}},
+               {"z=a*b+c", {"z = 14"}},            // Cache hit
+               {"2z=a*b+c", {}}                    // Invalid LHS (cache is not queried)
+         }) {
+
+        const auto operationResults = calculator.processInstruction(arithmeticExpression);
+        ASSERT_EQ(operationResults, expectedResults) << arithmeticExpression;
+    }
+
+    const auto& cacheStatistics = calculator.getExpressionCacheStatistics();
+    ASSERT_EQ(cacheStatistics.hits, 2);
+    ASSERT_EQ(cacheStatistics.misses, 5);
+}
+
+/**
+ * @brief Tests that operands can be named with multiple characters and that literals can span
+ * multiple digits, while white spaces still separate the operands
+ */
+TEST(CalculatorIntegrationTest, calculatorHandlesMultiCharacterOperands)
+{
+    Calculator::Runner calculator;
+
+    for (const auto& [arithmeticExpression, expectedResults] :
+         std::initializer_list<std::pair<std::string, std::vector<std::string>>>{
+               {"total = price * quantity + 1000", {}},
+               {"price = 125", {"price = 125"}},
+               {"quantity = 12", {"quantity = 12", "total = 2500"}},
+               {"price_2 = price quantity", {}},  // Rejected: operands are not separated
+               {"price_2 = 12 5", {}},            // Rejected: literals are not separated
+               {"undo =1", {"undo = 1"}},         // Operands can be named after commands
+               {"result", {"return undo = 1"}},
+               {"big = 9223372036854775807", {"big = 9223372036854775807"}},
+               {"bigger = 9223372036854775808", {}}  // Rejected: literal is too large
+         }) {
+
+        const auto operationResults = calculator.processInstruction(arithmeticExpression);
+        ASSERT_EQ(operationResults, expectedResults) << arithmeticExpression;
+    }
+
+    ASSERT_EQ(calculator.getOperandValue("total"), 2500);
+    ASSERT_EQ(calculator.getOperandValue("price_2"), std::nullopt);
+}
+
+/**
+ * @brief Tests that undoing operations restores exactly the state that preceded them
+ * (including the values propagated to dependants and the dependencies between operands)
+ */
+TEST(CalculatorIntegrationTest, calculatorUndoRestoresPreviousState)
+{
+    Calculator::Runner calculator;
+
+    for (const auto& [arithmeticExpression, expectedResults] :
+         std::initializer_list<std::pair<std::string, std::vector<std::string>>>{
+               {"b=a+1", {}},
+               {"a=1", {"a = 1", "b = 2"}},
+               {"a=5", {"a = 5", "b = 6"}},
+               {"undo 1", {"delete a"}},             // 'a' and 'b' go back to their values
+               {"result", {"return a = 1"}},
+               {"undo 1", {"delete a"}},             // 'a' has no value anymore (nor 'b')
+               {"result", {}},
+               {"undo 1", {"delete b"}},             // 'b' no longer depends on 'a'
+               {"a=2", {"a = 2"}},
+               {"c=a*3", {"c = 6"}},
+               {"result", {"return c = 6"}}
+         }) {
+
+        const auto operationResults = calculator.processInstruction(arithmeticExpression);
+        ASSERT_EQ(operationResults, expectedResults) << arithmeticExpression;
+    }
+
+    ASSERT_EQ(calculator.getOperandValue("a"), 2);
+    ASSERT_EQ(calculator.getOperandValue("b"), std::nullopt);
+}
+
+/**
+ * @brief Tests that, in lazy mode, assignments only output the value of their own operand,
+ * while the values of their dependants are computed when read ("get", "result" or expressions)
+ */
+TEST(CalculatorIntegrationTest, calculatorEvaluatesLazily)
+{
+    Calculator::Runner calculator;
+    calculator.setEvaluationMode(Calculator::State::EvaluationMode::LAZY);
+
+    for (const auto& [arithmeticExpression, expectedResults] :
+         std::initializer_list<std::pair<std::string, std::vector<std::string>>>{
+               {"b=a+1", {}},
+               {"c=b*2", {}},
+               {"a=1", {"a = 1"}},                   // 'b' and 'c' are only marked dirty
+               {"get c", {"c = 4"}},                 // Computes 'b' and then 'c'
+               {"a=5", {"a = 5"}},
+               {"d=c+b", {"d = 18"}},                // Reads up-to-date values of 'b' and 'c'
+               {"undo 1", {"delete d"}},
+               {"undo 1", {"delete a"}},             // Back to a = 1
+               {"get b", {"b = 2"}},
+               {"result", {"return a = 1"}},
+               {"get x", {}},                        // Unknown operand
+               {"get 5", {}},                        // Not an operand
+               {"get a b", {}},                      // Invalid expression
+               {"get=3", {"get = 3"}},               // Operands can be named after commands
+               {"get get", {"get = 3"}}
+         }) {
+
+        const auto operationResults = calculator.processInstruction(arithmeticExpression);
+        ASSERT_EQ(operationResults, expectedResults) << arithmeticExpression;
+    }
+
+    ASSERT_EQ(calculator.getOperandValue("c"), 4);
+
+    // Switching back to eager mode brings every value up to date
+    ASSERT_EQ(calculator.processInstruction("a=2"), std::vector<std::string>{"a = 2"});
+    calculator.setEvaluationMode(Calculator::State::EvaluationMode::EAGER);
+    ASSERT_EQ(calculator.processInstruction("get c"), std::vector<std::string>{"c = 6"});
+    ASSERT_EQ(calculator.processInstruction("a=3"),
+              (std::vector<std::string>{"a = 3", "b = 4", "c = 8"}));
+}
+
+/**
+ * @brief Tests that a session restored from a snapshot (through the "save" and "load"
+ * instructions) continues exactly where the saved one left off
+ */
+TEST(CalculatorIntegrationTest, calculatorRestoresSnapshots)
+{
+    const auto snapshotPath = std::filesystem::temp_directory_path() / "it_Snapshot.bin";
+    const auto snapshotFileName = snapshotPath.string();
+
+    {
+        Calculator::Runner calculator;
+        calculator.setEvaluationMode(Calculator::State::EvaluationMode::LAZY);
+
+        for (const auto* instruction : {"b=a+1", "c=b*2", "total=c+offset", "a=3", "offset=10"}) {
+            static_cast<void>(calculator.processInstruction(instruction));
+        }
+        ASSERT_TRUE(calculator.processInstruction("save " + snapshotFileName).empty());
+    }
+
+    // The lazy snapshot is loaded by an eager session (refreshing its dirty expressions)
+    Calculator::Runner calculator;
+    static_cast<void>(calculator.processInstruction("x=1"));
+    ASSERT_TRUE(calculator.processInstruction("load " + snapshotFileName).empty());
+    std::filesystem::remove(snapshotPath);
+
+    ASSERT_EQ(calculator.getOperandValue("x"), std::nullopt);
+
+    for (const auto& [arithmeticExpression, expectedResults] :
+         std::initializer_list<std::pair<std::string, std::vector<std::string>>>{
+               {"get total", {"total = 18"}},
+               {"result", {"return offset = 10"}},
+               {"a=1", {"a = 1", "b = 2", "c = 4", "total = 14"}},
+               {"undo 2", {"delete a", "delete offset"}},
+               {"get c", {"c = 8"}},
+               {"undo 3", {"delete a", "delete total", "delete c"}},
+               {"a=5", {"a = 5", "b = 6"}},
+               {"load " + snapshotFileName, {}}, // The session is kept when loading fails
+               {"get b", {"b = 6"}}
+         }) {
+
+        const auto operationResults = calculator.processInstruction(arithmeticExpression);
+        ASSERT_EQ(operationResults, expectedResults) << arithmeticExpression;
+    }
+}
+
+/**
+ * @brief Tests that a session recovered from its journal (replayed on top of its last snapshot,
+ * or from scratch if the snapshot is missing) continues exactly where the journaled one left off
+ */
+TEST(CalculatorIntegrationTest, calculatorRecoversJournaledSessions)
+{
+    const auto journalPath = std::filesystem::temp_directory_path() / "it_Journal.bin";
+    const auto journalCopyPath = std::filesystem::temp_directory_path() / "it_JournalCopy.bin";
+    const auto snapshotPath = std::filesystem::temp_directory_path() / "it_JournalSnapshot.bin";
+    std::filesystem::remove(journalPath);
+
+    // Rejected instructions are not journaled
+    const std::vector<std::string> instructions{
+          "b=a+1", "c=b*2", "x=1/0", "a=3", "save " + snapshotPath.string(),
+          "a=5",   "undo 1", "d=c+1", "e=d+", "undo x", "result"};
+    const std::vector<std::string> followingInstructions{
+          "get d", "result", "a=4", "undo 2", "get c", "f=c*10"};
+
+    // Reference session, never interrupted
+    Calculator::Runner referenceCalculator;
+    for (const auto& instruction : instructions) {
+        static_cast<void>(referenceCalculator.processInstruction(instruction));
+    }
+    std::vector<std::vector<std::string>> expectedResults;
+    for (const auto& instruction : followingInstructions) {
+        expectedResults.push_back(referenceCalculator.processInstruction(instruction));
+    }
+
+    // The journaled session is interrupted (keeping its journal and snapshot only)
+    {
+        Calculator::Runner calculator;
+        ASSERT_TRUE(calculator.openJournal(journalPath.string()));
+        for (const auto& instruction : instructions) {
+            static_cast<void>(calculator.processInstruction(instruction));
+        }
+    }
+    std::filesystem::copy_file(journalPath, journalCopyPath,
+                               std::filesystem::copy_options::overwrite_existing);
+
+    for (const auto isSnapshotKept : {true, false}) {
+        std::filesystem::copy_file(journalCopyPath, journalPath,
+                                   std::filesystem::copy_options::overwrite_existing);
+        if (!isSnapshotKept) {
+            std::filesystem::remove(snapshotPath);
+        }
+
+        {
+            Calculator::Runner calculator;
+            ASSERT_TRUE(calculator.openJournal(journalPath.string()));
+            ASSERT_EQ(calculator.getOperandValue("x"), std::nullopt);
+
+            for (std::size_t index = 0; index < followingInstructions.size(); ++index) {
+                ASSERT_EQ(calculator.processInstruction(followingInstructions[index]),
+                          expectedResults[index])
+                      << followingInstructions[index] << " (snapshot kept: " << isSnapshotKept
+                      << ")";
+            }
+        }
+
+        // The journal records the following instructions as well
+        Calculator::Runner calculator;
+        ASSERT_TRUE(calculator.openJournal(journalPath.string()));
+        for (const auto* operand : {"a", "b", "c", "d", "f"}) {
+            ASSERT_EQ(calculator.getOperandValue(operand),
+                      referenceCalculator.getOperandValue(operand))
+                  << operand << " (snapshot kept: " << isSnapshotKept << ")";
+        }
+        ASSERT_EQ(calculator.processInstruction("undo 1"),
+                  std::vector<std::string>{"delete f"});
+    }
+
+    std::filesystem::remove(journalPath);
+    std::filesystem::remove(journalCopyPath);
+}
+
+/**
+ * @brief Tests that expressions closing a cycle of dependencies (of any length) are rejected
+ */
+TEST(CalculatorIntegrationTest, calculatorRejectsCyclicDependencies)
+{
+    Calculator::Runner calculator;
+
+    for (const auto& [arithmeticExpression, expectedResults] :
+         std::initializer_list<std::pair<std::string, std::vector<std::string>>>{
+               {"b=a+1", {}},
+               {"c=b*2", {}},
+               {"d=c+b", {}},
+               {"a=d-1", {}},                        // Rejected: 'a' -> 'b' -> 'c' -> 'd' -> 'a'
+               {"e=e+1", {}},                        // Rejected: 'e' depends on itself
+               {"a=1", {"a = 1", "b = 2", "c = 4", "d = 6"}},
+               {"undo 1", {"delete a"}},             // The rejected expressions were not registered
+               {"undo 3", {"delete d", "delete c", "delete b"}}
+         }) {
+
+        const auto operationResults = calculator.processInstruction(arithmeticExpression);
+        ASSERT_EQ(operationResults, expectedResults) << arithmeticExpression;
+    }
+}
+
+/**
+ * @brief Tests that the operand names introduced by rejected instructions are forgotten,
+ * so that they are not reused by cached programs nor saved in snapshots
+ */
+TEST(CalculatorIntegrationTest, calculatorForgetsNamesOfRejectedInstructions)
+{
+    const auto snapshotPath = std::filesystem::temp_directory_path()
+                              / ("it_Forgotten_" + std::to_string(::getpid()) + ".bin");
+    const auto snapshotFileName = snapshotPath.string();
+
+    Calculator::Runner calculator;
+
+    for (const auto& [arithmeticExpression, expectedResults] :
+         std::initializer_list<std::pair<std::string, std::vector<std::string>>>{
+               {"b=a+1", {}},
+               {"a=b+ghost", {}},                    // Rejected: cyclic dependency
+               {"failed=7/0", {}},                   // Rejected: division by zero
+               {"x=(unknown", {}},                   // Rejected: invalid expression
+               {"z=1", {"z = 1"}},                   // Gets the identifier 'ghost' had
+               {"a=1", {"a = 1", "b = 2"}},
+               {"x=b+ghost", {}},                    // Not served the program of 'a=b+ghost'
+               {"ghost=5", {"ghost = 5", "x = 7"}},
+               {"save " + snapshotFileName, {}}
+         }) {
+
+        const auto operationResults = calculator.processInstruction(arithmeticExpression);
+        ASSERT_EQ(operationResults, expectedResults) << arithmeticExpression;
+    }
+
+    std::ifstream snapshotFile(snapshotPath, std::ios::binary);
+    std::stringstream snapshot;
+    snapshot << snapshotFile.rdbuf();
+    ASSERT_EQ(snapshot.str().find("failed"), std::string::npos);
+    ASSERT_EQ(snapshot.str().find("unknown"), std::string::npos);
+
+    Calculator::Runner restoredCalculator;
+    ASSERT_TRUE(restoredCalculator.processInstruction("load " + snapshotFileName).empty());
+    std::filesystem::remove(snapshotPath);
+
+    ASSERT_EQ(restoredCalculator.getOperandValue("x"), 7);
+    ASSERT_EQ(restoredCalculator.getOperandValue("z"), 1);
+}
+
+/**
+ * @brief Tests that the diagnostics of the calculator are written to the stream it was given
+ */
+TEST(CalculatorIntegrationTest, calculatorWritesDiagnosticsToItsStream)
+{
+    Calculator::Runner calculator;
+    std::ostringstream diagnostics;
+    calculator.setDiagnosticsStream(diagnostics);
+
+    for (const auto* instruction : {"result", "x=(1+", "a=1/0", "get b"}) {
+        ASSERT_TRUE(calculator.processInstruction(instruction).empty()) << instruction;
+    }
+
+    ASSERT_EQ(diagnostics.str(),
+              "There is no result available yet\n"
+              "Invalid expression provided\n"
+              "Invalid arithmetic expression provided\n"
+              "Unable to evaluate 'a': division by zero\n"
+              "Unknown operand 'b'\n");
+}
+
+/**
+ * @brief Tests that expressions whose evaluation fails (division by zero, overflow) are rejected,
+ * while pending expressions failing during a propagation lose their values
+ */
+TEST(CalculatorIntegrationTest, calculatorReportsFailedEvaluations)
+{
+    Calculator::Runner calculator;
+
+    for (const auto& [arithmeticExpression, expectedResults] :
+         std::initializer_list<std::pair<std::string, std::vector<std::string>>>{
+               {"a=7/0", {}},                        // Rejected: division by zero
+               {"result", {}},
+               {"b=4/a", {}},
+               {"a=2", {"a = 2", "b = 2"}},
+               {"a=0", {"a = 0"}},                   // 'b' fails (and loses its value)
+               {"result", {"return a = 0"}},
+               {"a=0-9", {"a = -9", "b = 0"}},       // Divisions truncate toward zero
+               {"c=9*9*9*9*9*9*9*9*9*9*9*9*9*9*9*9*9*9*9", {"c = 1350851717672992089"}},
+               {"d=c*9", {}},                        // Rejected: integer overflow
+               {"undo 2", {"delete c", "delete a"}}  // 'b' goes back to having no value
+         }) {
+
+        const auto operationResults = calculator.processInstruction(arithmeticExpression);
+        ASSERT_EQ(operationResults, expectedResults) << arithmeticExpression;
+    }
+
+    ASSERT_EQ(calculator.getOperandValue("a"), 0);
+    ASSERT_EQ(calculator.getOperandValue("b"), std::nullopt);
+    ASSERT_EQ(calculator.getOperandValue("d"), std::nullopt);
+}
+
+/**
+ * @brief Tests that the "stats" command reports the latency histograms and counters of the
+ * processed instructions (when statistics are compiled in), without affecting the calculator
+ */
+TEST(CalculatorIntegrationTest, calculatorReportsStatistics)
+{
+    // Histograms are only allocated once something is recorded (idle calculators stay small)
+    ASSERT_LE(sizeof(Calculator::Statistics), sizeof(void*));
+
+    Calculator::Runner calculator;
+
+    for (const auto* arithmeticExpression : {"b=a+1", "c=b*2", "a=3", "a=3", "undo 1"}) {
+        static_cast<void>(calculator.processInstruction(arithmeticExpression));
+    }
+
+    const auto results = calculator.processInstruction("stats");
+    if constexpr (!Calculator::Statistics::cIsEnabled) {
+        ASSERT_TRUE(results.empty());
+        return;
+    }
+
+    // The report is written with one entry per line, rather than comma separated
+    ASSERT_EQ(results.size(), 1);
+    std::ostringstream output;
+    Calculator::writeResults(results, output);
+
+    std::vector<std::string> statistics;
+    std::istringstream report(output.str());
+    for (std::string line; std::getline(report, line);) {
+        statistics.push_back(line);
+    }
+    ASSERT_EQ(statistics.size(), Calculator::Statistics::cStageCount + 4);
+    ASSERT_TRUE(statistics.front().starts_with("instruction (ns): count=5 "));
+    ASSERT_TRUE(statistics.back().starts_with("expression cache: "));
+
+    const auto findLine = [&statistics](const std::string& prefix) {
+        const auto itr = std::ranges::find_if(
+              statistics, [&prefix](const std::string& line) { return line.starts_with(prefix); });
+        return itr == statistics.end() ? std::string{} : *itr;
+    };
+
+    ASSERT_FALSE(findLine("instruction (ns): count=5 ").empty());
+    ASSERT_FALSE(findLine("parsing (ns): count=3 ").empty()); // "a=3" is compiled only once
+    ASSERT_FALSE(findLine("undo (ns): count=1 ").empty());
+    ASSERT_FALSE(findLine("evaluations per instruction: count=4 min=1 ").empty());
+    ASSERT_FALSE(findLine("cascade size: count=2 ").empty());
+    ASSERT_EQ(findLine("pending expressions"), "pending expressions: 0");
+    ASSERT_EQ(findLine("expression cache"), "expression cache: hits=1 misses=3 evictions=0");
+
+    // Statistics do not affect the calculator
+    ASSERT_EQ(calculator.getOperandValue("c"), 8);
+}
+
+/**
+ * @brief Tests that traced instructions enclose the propagation of their value updates,
+ * whose re-evaluations are traced with the operand that triggered them and their wave
+ * (including the ones evaluated by other propagation threads)
+ */
+TEST(CalculatorIntegrationTest, calculatorTracesCascades)
+{
+    constexpr std::size_t cFanOutSize{2048};
+    const auto traceFilePath = std::filesystem::temp_directory_path() / "it_Tracing.json";
+
+    {
+        Calculator::Runner calculator(Calculator::Runner::cDefaultExpressionCacheCapacity, 2);
+        ASSERT_TRUE(calculator.enableTracing(traceFilePath.string()));
+
+        static_cast<void>(calculator.processInstruction("b=a+1"));
+        static_cast<void>(calculator.processInstruction("c=b*2"));
+        for (std::size_t index = 0; index < cFanOutSize; ++index) {
+            static_cast<void>(calculator.processInstruction("x" + std::to_string(index) + "=c+1"));
+        }
+        ASSERT_EQ(calculator.processInstruction("a=3").size(), cFanOutSize + 3);
+    }
+
+    std::stringstream trace;
+    trace << std::ifstream(traceFilePath).rdbuf();
+    std::filesystem::remove(traceFilePath);
+
+    const auto countOccurrences = [text = trace.str()](const std::string& pattern) {
+        std::size_t count{0};
+        for (auto position = text.find(pattern); position != std::string::npos;
+             position = text.find(pattern, position + pattern.size())) {
+            ++count;
+        }
+        return count;
+    };
+
+    ASSERT_EQ(countOccurrences(R"("cat":"instruction")"), cFanOutSize + 3);
+    ASSERT_EQ(countOccurrences(R"("name":"a","cat":"propagation")"), 1);
+    ASSERT_EQ(countOccurrences(R"("cat":"evaluation")"), cFanOutSize + 2);
+    ASSERT_EQ(countOccurrences(R"("name":"b","cat":"evaluation")"), 1);
+    ASSERT_EQ(countOccurrences(R"("args":{"trigger":"a","wave":"2"})"), cFanOutSize);
+}
@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+#include "calculator/BatchRunner.hpp"
+#include "calculator/ReplayRunner.hpp"
+
+/**
+ * @brief Tests that the batch runner processes every instruction until EOF,
+ * writing the results in the same format as the interactive mode (without prompts)
+ */
+TEST(BatchProcessingIntegrationTest, batchRunnerProcessesInstructionsUntilEOF)
+{
+    std::istringstream input{"a=2+3\n"
+                             "b=e-2\n"
+                             "c=1+2\n"
+                             "d=e/3\n"
+                             "e=a+c\n"
+                             "f=3+4\n"
+                             "undo 2\n"
+                             "e=2+2\n"
+                             "f=g*7\n"
+                             "result\n"
+                             "g=3*2"};
+    std::ostringstream output;
+
+    Calculator::BatchRunner batchRunner(input, output);
+    const auto statistics = batchRunner.execute();
+
+    ASSERT_EQ(statistics.instructionCount, 11);
+    ASSERT_EQ(output.str(),
+              "a = 5\n"
+              "c = 3\n"
+              "e = 8, b = 6, d = 2\n"
+              "f = 7\n"
+              "delete f, delete e\n"
+              "e = 4, b = 2, d = 1\n"
+              "return e = 4\n"
+              "g = 6, f = 42\n");
+}
+
+/**
+ * @brief Tests that the batch runner handles an empty input stream
+ */
+TEST(BatchProcessingIntegrationTest, batchRunnerHandlesEmptyInput)
+{
+    std::istringstream input;
+    std::ostringstream output;
+
+    Calculator::BatchRunner batchRunner(input, output);
+    const auto statistics = batchRunner.execute();
+
+    ASSERT_EQ(statistics.instructionCount, 0);
+    ASSERT_TRUE(output.str().empty());
+}
+
+/**
+ * @brief Tests that the batch runner accepts instructions with Windows line endings
+ */
+TEST(BatchProcessingIntegrationTest, batchRunnerHandlesWindowsLineEndings)
+{
+    std::istringstream input{"a=2+3\r\n"
+                             "b=a*2\r\n"
+                             "undo 1\r\n"
+                             "result\r\n"
+                             "get a\r"};
+    std::ostringstream output;
+
+    Calculator::BatchRunner batchRunner(input, output);
+    const auto statistics = batchRunner.execute();
+
+    ASSERT_EQ(statistics.instructionCount, 5);
+    ASSERT_EQ(output.str(),
+              "a = 5\n"
+              "b = 10\n"
+              "delete b\n"
+              "return a = 5\n"
+              "a = 5\n");
+}
+
+/**
+ * @brief Tests that the replay runner walks an in-memory log line by line
+ * (including an unterminated last line and Windows line endings),
+ * producing the same results as the batch runner
+ */
+TEST(BatchProcessingIntegrationTest, replayRunnerProcessesEveryLineOfTheLog)
+{
+    constexpr std::string_view instructionsLog{"a=2+3\r\n"
+                                               "b = a * 2\n"
+                                               "\n"
+                                               "undo 1\n"
+                                               "result"};
+    std::ostringstream output;
+
+    Calculator::ReplayRunner replayRunner(instructionsLog, output);
+    const auto statistics = replayRunner.execute();
+
+    ASSERT_EQ(statistics.instructionCount, 5);
+    ASSERT_EQ(output.str(),
+              "a = 5\n"
+              "b = 10\n"
+              "delete b\n"
+              "return a = 5\n");
+}
@@ -0,0 +1,263 @@
+#include "gtest/gtest.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "server/SessionServer.hpp"
+
+namespace {
+/**
+ * @brief Connects a client to the server
+ *
+ * @param[in] socketPath Path of the server socket
+ *
+ * @return Connected socket (-1 on failure)
+ */
+int connectClient(const std::string& socketPath)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    std::copy(socketPath.begin(), socketPath.end(), std::begin(address.sun_path));
+
+    const int socket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (::connect(socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        ::close(socket);
+        return -1;
+    }
+
+    return socket;
+}
+
+/**
+ * @brief Sends every instruction at once and collects the responses until the server hangs up
+ *
+ * @param[in] socket Connected socket (closed once done)
+ * @param[in] instructions Instructions to send (one per line)
+ *
+ * @return Responses of the server
+ */
+std::string sendInstructions(const int socket, const std::string& instructions)
+{
+    for (std::size_t sentCount = 0; sentCount < instructions.size();) {
+        const auto count = ::send(
+              socket, instructions.data() + sentCount, instructions.size() - sentCount, 0);
+        if (count <= 0) {
+            break;
+        }
+        sentCount += static_cast<std::size_t>(count);
+    }
+    ::shutdown(socket, SHUT_WR);
+
+    std::string responses;
+    std::array<char, 4096> chunk;
+    for (auto count = ::recv(socket, chunk.data(), chunk.size(), 0); count > 0;
+         count = ::recv(socket, chunk.data(), chunk.size(), 0)) {
+        responses.append(chunk.data(), static_cast<std::size_t>(count));
+    }
+    ::close(socket);
+
+    return responses;
+}
+} // namespace
+
+/**
+ * @brief Test fixture for the SessionServer class
+ */
+class ServerIntegrationTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        mSocketPath = ::testing::TempDir() + "calculator_" + std::to_string(::getpid()) + ".sock";
+        mServer = std::make_unique<Server::SessionServer>(
+              Server::SessionServer::Configuration{.socketPath = mSocketPath, .threadCount = 2});
+        ASSERT_TRUE(mServer->start());
+    }
+
+protected:
+    /// Path of the server socket
+    std::string mSocketPath;
+
+    /// Server under test
+    std::unique_ptr<Server::SessionServer> mServer;
+};
+
+/**
+ * @brief Tests that the server answers every instruction with exactly one line
+ * (empty if the instruction has no results), using the batch mode format
+ */
+TEST_F(ServerIntegrationTest, serverAnswersEveryInstruction)
+{
+    const auto socket = connectClient(mSocketPath);
+    ASSERT_GE(socket, 0);
+
+    ASSERT_EQ(sendInstructions(socket,
+                               "a=2+3\n"
+                               "b=e-2\n"
+                               "c=1+2\n"
+                               "d=e/3\n"
+                               "e=a+c\n"
+                               "undo 2\n"
+                               "result\n"
+                               "x=(1+\n"),
+              "a = 5\n"
+              "\n"
+              "c = 3\n"
+              "\n"
+              "e = 8, b = 6, d = 2\n"
+              "delete e, delete d\n"
+              "return c = 3\n"
+              "\n");
+}
+
+/**
+ * @brief Tests that concurrent clients get independent sessions
+ */
+TEST_F(ServerIntegrationTest, concurrentClientsHaveIndependentSessions)
+{
+    constexpr int clientCount{32};
+
+    std::vector<int> sockets;
+    for (int client = 0; client < clientCount; ++client) {
+        sockets.push_back(connectClient(mSocketPath));
+        ASSERT_GE(sockets.back(), 0);
+    }
+
+    // Every client is connected before any of them hangs up
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (mServer->getSessionCount() < clientCount
+           && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(mServer->getSessionCount(), clientCount);
+
+    std::vector<std::string> responses(clientCount);
+    std::vector<std::thread> clients;
+    for (int client = 0; client < clientCount; ++client) {
+        clients.emplace_back([&, client] {
+            const auto digit = std::to_string(client % 10);
+            responses[static_cast<std::size_t>(client)]
+                  = sendInstructions(sockets[static_cast<std::size_t>(client)],
+                             "b=a*2\na=" + digit + "\nresult\n");
+        });
+    }
+    for (auto& client : clients) {
+        client.join();
+    }
+
+    for (int client = 0; client < clientCount; ++client) {
+        const auto value = client % 10;
+        ASSERT_EQ(responses[static_cast<std::size_t>(client)],
+                  "\na = " + std::to_string(value) + ", b = " + std::to_string(2 * value)
+                        + "\nreturn a = " + std::to_string(value) + "\n");
+    }
+}
+
+/**
+ * @brief Tests that clients cannot save nor load snapshots (files of the server) by default
+ */
+TEST_F(ServerIntegrationTest, serverRejectsFileCommands)
+{
+    const auto snapshotPath
+          = ::testing::TempDir() + "calculator_" + std::to_string(::getpid()) + ".snapshot";
+    std::filesystem::remove(snapshotPath);
+
+    const auto socket = connectClient(mSocketPath);
+    ASSERT_GE(socket, 0);
+
+    ASSERT_EQ(sendInstructions(socket,
+                               "a=1\n"
+                               "save " + snapshotPath + "\n"
+                               "load " + snapshotPath + "\n"
+                               "result\n"),
+              "a = 1\n"
+              "\n"
+              "\n"
+              "return a = 1\n");
+    ASSERT_FALSE(std::filesystem::exists(snapshotPath));
+}
+
+/**
+ * @brief Tests that the diagnostics of the sessions (e.g. rejected instructions)
+ * are not written to the log of the server
+ */
+TEST_F(ServerIntegrationTest, serverDropsSessionDiagnostics)
+{
+    const auto socket = connectClient(mSocketPath);
+    ASSERT_GE(socket, 0);
+
+    ::testing::internal::CaptureStderr();
+    const auto responses = sendInstructions(socket, "x=(1+\na=1/0\nget b\nresult\n");
+    const auto log = ::testing::internal::GetCapturedStderr();
+
+    ASSERT_EQ(responses, "\n\n\n\n");
+    ASSERT_EQ(log, "");
+}
+
+/**
+ * @brief Tests that the server stops reading the instructions of a client that does not read
+ * its responses, and resumes (answering every instruction) once they are read
+ */
+TEST_F(ServerIntegrationTest, serverPushesBackOnClientsNotReadingResponses)
+{
+    constexpr std::size_t cMaxSentSize{64 * 1024 * 1024};
+    constexpr auto cIdleTimeout = std::chrono::milliseconds(500);
+
+    const auto socket = connectClient(mSocketPath);
+    ASSERT_GE(socket, 0);
+
+    std::string batch;
+    for (int instruction = 0; instruction < 4096; ++instruction) {
+        batch += "a=1\n";
+    }
+
+    // Instructions are sent until the server stops reading them for a while
+    std::size_t sentSize{0};
+    auto idleTime = std::chrono::milliseconds(0);
+    while (sentSize < cMaxSentSize && idleTime < cIdleTimeout) {
+        const auto offset = sentSize % batch.size();
+        const auto count
+              = ::send(socket, batch.data() + offset, batch.size() - offset, MSG_DONTWAIT);
+        if (count > 0) {
+            sentSize += static_cast<std::size_t>(count);
+            idleTime = std::chrono::milliseconds(0);
+        } else {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            idleTime += std::chrono::milliseconds(10);
+        }
+    }
+    ASSERT_LT(sentSize, cMaxSentSize);
+
+    // The rest of the last batch is sent while the responses are read
+    std::string responses;
+    std::thread reader{[&] {
+        std::array<char, 4096> chunk;
+        for (auto count = ::recv(socket, chunk.data(), chunk.size(), 0); count > 0;
+             count = ::recv(socket, chunk.data(), chunk.size(), 0)) {
+            responses.append(chunk.data(), static_cast<std::size_t>(count));
+        }
+    }};
+
+    const auto remainingSize = batch.size() - sentSize % batch.size();
+    for (auto offset = batch.size() - remainingSize; offset < batch.size();) {
+        const auto count = ::send(socket, batch.data() + offset, batch.size() - offset, 0);
+        ASSERT_GT(count, 0);
+        offset += static_cast<std::size_t>(count);
+    }
+    ::shutdown(socket, SHUT_WR);
+    reader.join();
+    ::close(socket);
+
+    const auto instructionCount = (sentSize + remainingSize) / std::string_view{"a=1\n"}.size();
+    ASSERT_EQ(std::ranges::count(responses, '\n'), instructionCount);
+    ASSERT_EQ(responses.size(), instructionCount * std::string_view{"a = 1\n"}.size());
+}
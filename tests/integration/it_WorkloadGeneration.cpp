@@ -0,0 +1,153 @@
+#include "gtest/gtest.h"
+
+#include <sstream>
+
+#include "generator/WorkloadGenerator.hpp"
+#include "generator/WorkloadVerifier.hpp"
+
+namespace {
+/**
+ * @brief Generates a workload and verifies the calculator against it
+ *
+ * @param[in] parameters Parameters of the workload
+ * @param[in] evaluationMode Evaluation mode of the calculator
+ *
+ * @return Report of the verification
+ */
+Generator::WorkloadVerifier::Report
+      generateAndVerify(const Generator::WorkloadParameters& parameters,
+                        const Calculator::State::EvaluationMode evaluationMode
+                        = Calculator::State::EvaluationMode::EAGER)
+{
+    std::ostringstream instructions;
+    std::ostringstream expectedResults;
+    std::ostringstream expectedState;
+
+    Generator::WorkloadGenerator generator(parameters);
+    EXPECT_TRUE(generator.execute(instructions, expectedResults));
+    generator.writeExpectedState(expectedState);
+
+    const auto instructionsString = instructions.str();
+    const auto expectedResultsString = expectedResults.str();
+    const auto expectedStateString = expectedState.str();
+
+    return Generator::WorkloadVerifier(
+                 instructionsString, expectedResultsString, expectedStateString, evaluationMode)
+          .execute();
+}
+} // namespace
+
+/**
+ * @brief Tests that the calculator matches the reference model for every workload shape
+ * (with undo commands and result polls interleaved)
+ */
+TEST(WorkloadGenerationIntegrationTest, calculatorMatchesReferenceModelForEveryShape)
+{
+    for (const auto shapeName : {"chain", "fan-out", "diamond", "random-dag", "mixed"}) {
+        const auto shape = Generator::parseWorkloadShape(shapeName);
+        ASSERT_TRUE(shape.has_value());
+
+        for (const uint64_t seed : {1U, 2U, 3U}) {
+            const auto report = generateAndVerify({.shape = *shape,
+                                                   .seed = seed,
+                                                   .instructionCount = 2000,
+                                                   .operandCount = 26,
+                                                   .undoPercentage = 10,
+                                                   .resultPercentage = 10});
+
+            ASSERT_EQ(report.instructionCount, 2000) << shapeName << " (seed " << seed << ")";
+            ASSERT_TRUE(report.isSuccessful()) << shapeName << " (seed " << seed << ")";
+        }
+    }
+}
+
+/**
+ * @brief Tests that the calculator matches the reference model for dependency graphs
+ * with more operands than letters (named with multiple characters)
+ */
+TEST(WorkloadGenerationIntegrationTest, calculatorMatchesReferenceModelForLargeGraphs)
+{
+    for (const auto shapeName : {"chain", "random-dag"}) {
+        const auto report = generateAndVerify({.shape = *Generator::parseWorkloadShape(shapeName),
+                                               .seed = 7,
+                                               .instructionCount = 5000,
+                                               .operandCount = 1000,
+                                               .undoPercentage = 1,
+                                               .resultPercentage = 10});
+
+        ASSERT_EQ(report.instructionCount, 5000) << shapeName;
+        ASSERT_TRUE(report.isSuccessful()) << shapeName;
+    }
+}
+
+/**
+ * @brief Tests that the lazily evaluating calculator reads the same values as the reference model
+ * (which propagates every update eagerly) for every workload shape
+ */
+TEST(WorkloadGenerationIntegrationTest, lazyCalculatorMatchesReferenceModel)
+{
+    for (const auto shapeName : {"chain", "fan-out", "diamond", "random-dag", "mixed"}) {
+        for (const uint64_t seed : {1U, 2U, 3U}) {
+            const auto report
+                  = generateAndVerify({.shape = *Generator::parseWorkloadShape(shapeName),
+                                       .seed = seed,
+                                       .instructionCount = 2000,
+                                       .operandCount = 26,
+                                       .undoPercentage = 10,
+                                       .resultPercentage = 10},
+                                      Calculator::State::EvaluationMode::LAZY);
+
+            ASSERT_EQ(report.instructionCount, 2000) << shapeName << " (seed " << seed << ")";
+            ASSERT_TRUE(report.isSuccessful()) << shapeName << " (seed " << seed << ")";
+        }
+    }
+}
+
+/**
+ * @brief Tests that the same parameters always generate the same workload
+ */
+TEST(WorkloadGenerationIntegrationTest, generatorIsDeterministic)
+{
+    const Generator::WorkloadParameters parameters{.seed = 42, .instructionCount = 500};
+
+    std::ostringstream firstInstructions;
+    std::ostringstream firstExpectedResults;
+    std::ostringstream secondInstructions;
+    std::ostringstream secondExpectedResults;
+
+    ASSERT_TRUE(Generator::WorkloadGenerator(parameters).execute(firstInstructions,
+                                                                 firstExpectedResults));
+    ASSERT_TRUE(Generator::WorkloadGenerator(parameters).execute(secondInstructions,
+                                                                 secondExpectedResults));
+
+    ASSERT_EQ(firstInstructions.str(), secondInstructions.str());
+    ASSERT_EQ(firstExpectedResults.str(), secondExpectedResults.str());
+}
+
+/**
+ * @brief Tests that the generator rejects dependency graphs without dependencies
+ */
+TEST(WorkloadGenerationIntegrationTest, generatorRejectsInvalidOperandCount)
+{
+    std::ostringstream instructions;
+    std::ostringstream expectedResults;
+
+    ASSERT_FALSE(Generator::WorkloadGenerator({.operandCount = 1})
+                       .execute(instructions, expectedResults));
+    ASSERT_TRUE(instructions.str().empty());
+}
+
+/**
+ * @brief Tests that the verifier detects results that differ from the expected ones
+ */
+TEST(WorkloadGenerationIntegrationTest, verifierDetectsMismatches)
+{
+    const auto report
+          = Generator::WorkloadVerifier("a=1+2\nb=a*2\n", "a = 3\nb = 7\n", "a = 3\nb = 5\n")
+                  .execute();
+
+    ASSERT_EQ(report.instructionCount, 2);
+    ASSERT_EQ(report.mismatchedInstructionCount, 1);
+    ASSERT_EQ(report.mismatchedOperandCount, 1);
+    ASSERT_FALSE(report.isSuccessful());
+}
@@ -0,0 +1,147 @@
+#include "gtest/gtest.h"
+
+#include <limits>
+#include <random>
+#include <string>
+
+#include "calculator/Expr.hpp"
+#include "evaluator/Evaluator.hpp"
+#include "parser/Parser.hpp"
+
+using namespace ::testing;
+
+namespace {
+/**
+ * @brief Evaluates an arithmetic expression (the RHS of an assignment) with the Evaluator
+ *
+ * @param[in] arithmeticExpression Arithmetic expression to evaluate
+ * @param[in] operands Names and values of its operands
+ *
+ * @return Result of the evaluation (dependencies if the expression is invalid)
+ */
+Evaluator::Result
+      evaluate(const std::string_view arithmeticExpression,
+               const std::vector<std::pair<std::string_view, Evaluator::Value>>& operands)
+{
+    Symbols::SymbolTable symbolTable;
+    std::vector<std::optional<Evaluator::Value>> operandValues;
+    for (const auto& [name, value] : operands) {
+        operandValues.resize(symbolTable.intern(name) + 1U);
+        operandValues.back() = value;
+    }
+
+    const auto input = "x = " + std::string{arithmeticExpression};
+    Parser parser(input, symbolTable);
+    if (!parser.execute()) {
+        return Evaluator::Dependencies{};
+    }
+
+    Evaluator evaluator(*parser.getASTOfRHS(), operandValues);
+    return evaluator.execute();
+}
+} // namespace
+
+/**
+ * @brief Tests that fully literal expressions are evaluated at compile time
+ */
+TEST(ExprUnitTest, literalExpressionsAreCompileTimeConstants)
+{
+    static_assert(Calculator::Expr<"2*(3+4)">::value() == 14);
+    static_assert(Calculator::Expr<" 7 / 2 - 10 ">::value() == -7);
+    static_assert(Calculator::Expr<"(1-8)/2">::value() == -3);
+    static_assert(Calculator::Expr<"9223372036854775807">::value()
+                  == std::numeric_limits<Arithmetic::Value>::max());
+    static_assert(Calculator::Expr<"((((1))))+2*3-4/2">::value() == 5);
+
+    // Expressions with the same text as the Evaluator's must produce the same value
+    ASSERT_EQ(evaluate("2*(3+4)", {}), Evaluator::Result{Calculator::Expr<"2*(3+4)">::value()});
+}
+
+/**
+ * @brief Tests that expressions with variables bind their arguments in order of appearance,
+ * and that they can be evaluated at compile time as well
+ */
+TEST(ExprUnitTest, variablesAreBoundInOrderOfAppearance)
+{
+    using Margin = Calculator::Expr<"(price - cost) * 100 / price + cost - cost">;
+    static_assert(Margin::cVariableCount == 2);
+    static_assert(Margin::cVariables[0] == "price" && Margin::cVariables[1] == "cost");
+
+    static_assert([] {
+        Arithmetic::Value margin{};
+        return !Margin::evaluate(margin, 250, 200) && margin == 20;
+    }());
+
+    Arithmetic::Value margin{};
+    ASSERT_FALSE(Margin::evaluate(margin, 400, 100));
+    ASSERT_EQ(margin, 75);
+}
+
+/**
+ * @brief Tests that failed evaluations output the same errors as the Evaluator
+ */
+TEST(ExprUnitTest, failedEvaluationsOutputErrors)
+{
+    using Quotient = Calculator::Expr<"a / (b - 2)">;
+
+    Arithmetic::Value result{42};
+    ASSERT_EQ(Quotient::evaluate(result, 1, 2), Arithmetic::Error::DIVISION_BY_ZERO);
+    ASSERT_EQ(Quotient::evaluate(result, std::numeric_limits<Arithmetic::Value>::min(), 1),
+              Arithmetic::Error::INTEGER_OVERFLOW);
+    ASSERT_EQ(result, 42);
+
+    using Product = Calculator::Expr<"a * 4294967296 * 4294967296">;
+    ASSERT_EQ(Product::evaluate(result, 1), Arithmetic::Error::INTEGER_OVERFLOW);
+    ASSERT_EQ(evaluate("a * 4294967296 * 4294967296", {{"a", 1}}),
+              Evaluator::Result{Evaluator::Error::INTEGER_OVERFLOW});
+}
+
+/**
+ * @brief Tests that invalid expressions are rejected at compile time
+ * (for the same reasons as the Parser rejects them)
+ */
+TEST(ExprUnitTest, invalidExpressionsAreRejected)
+{
+    constexpr auto compile = [](const std::string_view expression) consteval {
+        return Calculator::compileExpr<32>(expression).error;
+    };
+
+    static_assert(compile("") == "Empty expression provided");
+    static_assert(compile("  ") == "Empty expression provided");
+    static_assert(compile("-1") == "Negative values are not currently supported");
+    static_assert(compile("(1+2") == "Parenthesis do not match");
+    static_assert(compile("1+2)") == "Parenthesis do not match");
+    static_assert(compile("2a") == "Invalid expression provided");
+    static_assert(compile("a b") == "Invalid expression provided");
+    static_assert(compile("1+") == "Invalid expression provided");
+    static_assert(compile("9223372036854775808") == "Integer literal is too large");
+    static_assert(compile("a_1 * (b + 2)").empty());
+}
+
+/**
+ * @brief Tests that expressions with variables evaluate to the same values as the Evaluator
+ */
+TEST(ExprUnitTest, expressionsMatchEvaluator)
+{
+    constexpr std::string_view cExpression{"(a*3-b)/(b+7)+a/2+(a-b)*(a+b)-c*(c-1)"};
+    using Formula = Calculator::Expr<"(a*3-b)/(b+7)+a/2+(a-b)*(a+b)-c*(c-1)">;
+
+    std::mt19937 randomEngine{7}; // NOLINT: deterministic seed
+    std::uniform_int_distribution<Arithmetic::Value> distribution{-100000, 100000};
+
+    for (int evaluation = 0; evaluation < 1000; ++evaluation) {
+        const auto a = distribution(randomEngine);
+        const auto b = distribution(randomEngine);
+        const auto c = distribution(randomEngine);
+
+        Arithmetic::Value result{};
+        const auto error = Formula::evaluate(result, a, b, c);
+        const auto expectedResult = evaluate(cExpression, {{"a", a}, {"b", b}, {"c", c}});
+
+        if (error) {
+            ASSERT_EQ(Evaluator::Result{*error}, expectedResult);
+        } else {
+            ASSERT_EQ(Evaluator::Result{result}, expectedResult);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#include "gtest/gtest.h"
+
+#include "calculator/ExpressionCache.hpp"
+
+using namespace ::testing;
+
+/**
+ * @brief Tests that the ExpressionCache serves cached programs and keeps track of hits and misses
+ */
+TEST(ExpressionCacheUnitTest, expressionCacheCountsHitsAndMisses)
+{
+    Calculator::ExpressionCache expressionCache(2);
+
+    ASSERT_EQ(expressionCache.find("a+b"), nullptr);
+
+    const auto program = std::make_shared<const Bytecode::Program>();
+    expressionCache.insert("a+b", program);
+
+    ASSERT_EQ(expressionCache.find("a+b"), program);
+    ASSERT_EQ(expressionCache.find("a+b"), program);
+    ASSERT_EQ(expressionCache.find("a-b"), nullptr);
+
+    const auto& statistics = expressionCache.getStatistics();
+    ASSERT_EQ(statistics.hits, 2);
+    ASSERT_EQ(statistics.misses, 2);
+    ASSERT_EQ(statistics.evictions, 0);
+}
+
+/**
+ * @brief Tests that the ExpressionCache evicts the least recently used program when full
+ */
+TEST(ExpressionCacheUnitTest, expressionCacheEvictsLeastRecentlyUsedProgram)
+{
+    Calculator::ExpressionCache expressionCache(2);
+
+    expressionCache.insert("1+1", std::make_shared<const Bytecode::Program>());
+    expressionCache.insert("2+2", std::make_shared<const Bytecode::Program>());
+
+    // Mark "1+1" as the most recently used, leaving "2+2" as the eviction candidate
+    ASSERT_NE(expressionCache.find("1+1"), nullptr);
+
+    expressionCache.insert("3+3", std::make_shared<const Bytecode::Program>());
+
+    ASSERT_EQ(expressionCache.size(), 2);
+    ASSERT_EQ(expressionCache.getStatistics().evictions, 1);
+    ASSERT_NE(expressionCache.find("1+1"), nullptr);
+    ASSERT_NE(expressionCache.find("3+3"), nullptr);
+    ASSERT_EQ(expressionCache.find("2+2"), nullptr);
+}
+
+/**
+ * @brief Tests that an ExpressionCache without capacity never caches programs
+ */
+TEST(ExpressionCacheUnitTest, expressionCacheWithoutCapacityIsDisabled)
+{
+    Calculator::ExpressionCache expressionCache(0);
+
+    expressionCache.insert("1+1", std::make_shared<const Bytecode::Program>());
+
+    ASSERT_EQ(expressionCache.size(), 0);
+    ASSERT_EQ(expressionCache.find("1+1"), nullptr);
+}
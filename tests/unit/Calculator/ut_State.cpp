@@ -0,0 +1,393 @@
+#include "gtest/gtest.h"
+
+#include <limits>
+#include <string>
+
+#include "calculator/State.hpp"
+
+using namespace ::testing;
+
+/**
+ * @brief Test fixture for the State class
+ */
+class StateUnitTest : public Test
+{
+protected:
+    /**
+     * @brief Creates a program that adds all the provided variables (and a literal)
+     *
+     * @param[in] variables Operands to add
+     * @param[in] literal Literal to add
+     *
+     * @return Shared pointer to the compiled program
+     */
+    [[nodiscard]] static std::shared_ptr<const Bytecode::Program>
+          createSumProgram(std::vector<Symbols::SymbolId> variables, const uint32_t literal)
+    {
+        using Bytecode::OpCode;
+
+        auto program = std::make_shared<Bytecode::Program>();
+        program->instructions.push_back({OpCode::PUSH_LITERAL, literal});
+
+        for (uint32_t slot = 0; slot < variables.size(); ++slot) {
+            program->instructions.push_back({OpCode::PUSH_VARIABLE, slot});
+            program->instructions.push_back({OpCode::ADD, 0});
+        }
+
+        program->variables = std::move(variables);
+        program->maxStackDepth = 2;
+
+        return program;
+    }
+
+    /**
+     * @brief Builds a layered dependency graph whose waves are large enough
+     * to be evaluated concurrently
+     *
+     * Every operand of the first layer depends on the source, while every operand of the other
+     * layers depends on an operand of the previous layer. Every expression also reads a
+     * neighbour of its own layer (which is not registered as a dependency), so its result
+     * would depend on the evaluation order if it was not evaluated against the previous wave.
+     *
+     * @param[in,out] state State to build the dependency graph in
+     * @param[in] readCount Amount of times each expression reads its inputs
+     */
+    void createLayeredGraph(Calculator::State& state, const std::size_t readCount = 1)
+    {
+        for (std::size_t layer = 1; layer <= cLayerCount; ++layer) {
+            for (std::size_t index = 0; index < cLayerSize; ++index) {
+                state.updateOperationOrder(operandId(layer, index));
+                state.storeExpressionValue(operandId(layer, index),
+                                           static_cast<Evaluator::Value>(index % 5));
+            }
+        }
+
+        for (std::size_t layer = 1; layer <= cLayerCount; ++layer) {
+            for (std::size_t index = 0; index < cLayerSize; ++index) {
+                const auto dependency = layer == 1 ? mSymbolTable.intern("s")
+                                                   : operandId(layer - 1, (index * 7) % cLayerSize);
+                const auto neighbour = operandId(layer, (index + 1) % cLayerSize);
+
+                std::vector<Symbols::SymbolId> variables;
+                for (std::size_t read = 0; read < readCount; ++read) {
+                    variables.insert(variables.end(), {dependency, neighbour});
+                }
+
+                ASSERT_TRUE(state.storeExpressionDependencies(
+                      operandId(layer, index),
+                      createSumProgram(std::move(variables), static_cast<uint32_t>(layer)),
+                      {dependency}));
+            }
+        }
+    }
+
+    /**
+     * @brief Interns an operand of the layered dependency graph
+     *
+     * @param[in] layer Layer of the operand
+     * @param[in] index Index of the operand within its layer
+     *
+     * @return Symbol id of the operand
+     */
+    [[nodiscard]] Symbols::SymbolId operandId(const std::size_t layer, const std::size_t index)
+    {
+        return mSymbolTable.intern("l" + std::to_string(layer) + "_" + std::to_string(index));
+    }
+
+protected:
+    /// Amount of operands of each layer of the dependency graph
+    static constexpr std::size_t cLayerSize{2 * Calculator::State::cDefaultMinParallelWaveSize};
+    /// Amount of dependant layers of the dependency graph
+    static constexpr std::size_t cLayerCount{4};
+
+    /// Symbol table used to intern the operands of the dependency graph
+    Symbols::SymbolTable mSymbolTable;
+};
+
+/**
+ * @brief Tests that propagating a value update with several threads produces
+ * the same affected values, in the same order, as the serial propagation
+ */
+TEST_F(StateUnitTest, parallelPropagationMatchesSerialPropagation)
+{
+    Calculator::State serialState;
+    Calculator::State parallelState(4);
+    createLayeredGraph(serialState);
+    createLayeredGraph(parallelState);
+
+    const auto sourceOperand = mSymbolTable.intern("s");
+    for (int value = 1; value <= 3; ++value) {
+        const auto serialValues = serialState.storeExpressionValue(sourceOperand, value);
+        const auto parallelValues = parallelState.storeExpressionValue(sourceOperand, value);
+
+        ASSERT_EQ(serialValues.size(), 1 + cLayerCount * cLayerSize);
+        ASSERT_EQ(serialValues, parallelValues);
+    }
+
+    ASSERT_EQ(serialState.getOperandValues(), parallelState.getOperandValues());
+}
+
+/**
+ * @brief Tests that propagating value updates through expressions translated into native code
+ * produces the same affected values as interpreting them
+ */
+TEST_F(StateUnitTest, nativePropagationMatchesInterpretedPropagation)
+{
+    // Long enough expressions to be translated
+    constexpr std::size_t readCount{Jit::TieredVirtualMachine::cMinInstructionCount / 4};
+
+    Calculator::State interpretedState(1, std::numeric_limits<uint32_t>::max());
+    Calculator::State nativeState(1, 0);
+    createLayeredGraph(interpretedState, readCount);
+    createLayeredGraph(nativeState, readCount);
+
+    const auto sourceOperand = mSymbolTable.intern("s");
+    for (int value = -3; value <= 3; ++value) {
+        ASSERT_EQ(nativeState.storeExpressionValue(sourceOperand, value),
+                  interpretedState.storeExpressionValue(sourceOperand, value));
+    }
+
+    ASSERT_EQ(nativeState.getOperandValues(), interpretedState.getOperandValues());
+}
+
+/**
+ * @brief Tests that dependencies closing a cycle of any length are rejected
+ * without modifying the state, while acyclic ones are accepted in any definition order
+ */
+TEST_F(StateUnitTest, cyclicDependenciesAreRejected)
+{
+    constexpr std::size_t chainLength{100};
+    Calculator::State state;
+
+    const auto chainOperand = [&](const std::size_t index) {
+        return mSymbolTable.intern("c" + std::to_string(index));
+    };
+
+    // Define the chain from its end, so that every new dependency reorders the operands
+    for (std::size_t index = chainLength - 1; index > 0; --index) {
+        const auto dependency = chainOperand(index - 1);
+        ASSERT_TRUE(state.storeExpressionDependencies(
+              chainOperand(index), createSumProgram({dependency}, 1), {dependency}));
+        state.updateOperationOrder(chainOperand(index));
+    }
+
+    const auto firstOperand = chainOperand(0);
+    const auto lastOperand = chainOperand(chainLength - 1);
+    const auto otherOperand = mSymbolTable.intern("o");
+
+    ASSERT_FALSE(state.storeExpressionDependencies(firstOperand,
+                                                   createSumProgram({otherOperand, lastOperand}, 0),
+                                                   {otherOperand, lastOperand}));
+    ASSERT_FALSE(state.storeExpressionDependencies(
+          firstOperand, createSumProgram({firstOperand}, 0), {firstOperand}));
+    ASSERT_TRUE(state.storeExpressionDependencies(
+          otherOperand, createSumProgram({lastOperand}, 0), {lastOperand}));
+    state.updateOperationOrder(otherOperand);
+
+    // The rejected dependencies were not registered, so the whole chain is resolved
+    const auto affectedValues = state.storeExpressionValue(firstOperand, 0);
+    ASSERT_EQ(affectedValues.size(), chainLength + 1);
+    const auto expectedValue = static_cast<Evaluator::Value>(chainLength) - 1;
+    ASSERT_EQ(state.getOperandValues()[lastOperand], expectedValue);
+    ASSERT_EQ(state.getOperandValues()[otherOperand], expectedValue);
+}
+
+/**
+ * @brief Tests that expressions whose evaluation fails during a propagation lose their values
+ * (as do their dependants), reporting the errors, until a later update resolves them again
+ */
+TEST_F(StateUnitTest, failedPropagationsClearDependantValues)
+{
+    Calculator::State state;
+
+    const auto first = mSymbolTable.intern("a");
+    const auto second = mSymbolTable.intern("b");
+    const auto third = mSymbolTable.intern("c");
+
+    ASSERT_TRUE(state.storeExpressionDependencies(second, createSumProgram({first}, 1), {first}));
+    state.updateOperationOrder(second);
+    ASSERT_TRUE(state.storeExpressionDependencies(third, createSumProgram({second}, 1), {second}));
+    state.updateOperationOrder(third);
+
+    ASSERT_EQ(state.storeExpressionValue(first, 0).size(), 3);
+    ASSERT_EQ(state.getOperandValues()[third], 2);
+
+    // a + 1 overflows: b loses its value, and so does c (b is no longer available)
+    const auto affectedValues
+          = state.storeExpressionValue(first, std::numeric_limits<Evaluator::Value>::max());
+    ASSERT_EQ(affectedValues.size(), 1);
+    ASSERT_EQ(state.getOperandValues()[second], std::nullopt);
+    ASSERT_EQ(state.getOperandValues()[third], std::nullopt);
+
+    const std::vector<Calculator::State::OperandError> expectedErrors{
+          {second, Evaluator::Error::INTEGER_OVERFLOW}};
+    ASSERT_EQ(state.getLastPropagationErrors(), expectedErrors);
+
+    // A later update resolves both of them again
+    ASSERT_EQ(state.storeExpressionValue(first, 5).size(), 3);
+    ASSERT_EQ(state.getOperandValues()[third], 7);
+    ASSERT_TRUE(state.getLastPropagationErrors().empty());
+}
+
+/**
+ * @brief Tests that the State counts its pending expressions and the expressions evaluated
+ * while propagating each value update
+ */
+TEST_F(StateUnitTest, propagationCountersTrackEvaluations)
+{
+    Calculator::State state;
+
+    const auto first = mSymbolTable.intern("a");
+    const auto second = mSymbolTable.intern("b");
+    const auto third = mSymbolTable.intern("c");
+
+    ASSERT_EQ(state.getPendingExpressionCount(), 0);
+
+    ASSERT_TRUE(state.storeExpressionDependencies(second, createSumProgram({first}, 1), {first}));
+    state.updateOperationOrder(second);
+    ASSERT_TRUE(state.storeExpressionDependencies(third, createSumProgram({second}, 1), {second}));
+    state.updateOperationOrder(third);
+    ASSERT_EQ(state.getPendingExpressionCount(), 2);
+
+    ASSERT_EQ(state.storeExpressionValue(first, 0).size(), 3);
+    ASSERT_EQ(state.getLastPropagationEvaluationCount(), 2);
+    ASSERT_EQ(state.getPendingExpressionCount(), 0);
+
+    // Updating an operand nobody depends on evaluates nothing
+    ASSERT_EQ(state.storeExpressionValue(third, 9).size(), 1);
+    ASSERT_EQ(state.getLastPropagationEvaluationCount(), 0);
+}
+
+/**
+ * @brief Tests that, in lazy mode, value updates only mark the dependant expressions dirty,
+ * which are evaluated (at most once) when read, and that undo restores their dirty states
+ */
+TEST_F(StateUnitTest, lazyModeEvaluatesOnRead)
+{
+    Calculator::State state;
+    state.setEvaluationMode(Calculator::State::EvaluationMode::LAZY);
+
+    const auto first = mSymbolTable.intern("a");
+    const auto second = mSymbolTable.intern("b");
+    const auto third = mSymbolTable.intern("c");
+
+    ASSERT_TRUE(state.storeExpressionDependencies(second, createSumProgram({first}, 1), {first}));
+    state.updateOperationOrder(second);
+    ASSERT_TRUE(state.storeExpressionDependencies(
+          third, createSumProgram({first, second}, 1), {first, second}));
+    state.updateOperationOrder(third);
+
+    const std::vector<Calculator::State::OperandValue> expectedValues{{first, 1}};
+    ASSERT_EQ(state.storeExpressionValue(first, 1), expectedValues);
+    state.updateOperationOrder(first);
+    ASSERT_EQ(state.getLastPropagationEvaluationCount(), 0);
+    ASSERT_EQ(state.getPendingExpressionCount(), 2);
+    ASSERT_EQ(state.getOperandValues()[third], std::nullopt);
+
+    // Reading 'c' evaluates 'b' first, and both of them only once
+    state.refreshOperands(std::vector{third, third});
+    ASSERT_EQ(state.getLastPropagationEvaluationCount(), 2);
+    ASSERT_EQ(state.getOperandValues()[second], 2);
+    ASSERT_EQ(state.getOperandValues()[third], 4);
+    ASSERT_EQ(state.getPendingExpressionCount(), 0);
+
+    state.refreshOperands(std::vector{third});
+    ASSERT_EQ(state.getLastPropagationEvaluationCount(), 0);
+
+    ASSERT_EQ(state.storeExpressionValue(first, 5).size(), 1);
+    state.updateOperationOrder(first);
+    ASSERT_EQ(state.getPendingExpressionCount(), 2);
+
+    // Undoing the update restores the state recorded by the previous one (still dirty)
+    ASSERT_EQ(state.undoLastRegisteredOperations(1), std::vector{first});
+    ASSERT_EQ(state.getPendingExpressionCount(), 2);
+    state.refreshOperands(std::vector{third});
+    ASSERT_EQ(state.getLastPropagationEvaluationCount(), 2);
+    ASSERT_EQ(state.getOperandValues()[third], 4);
+
+    // Switching to eager mode evaluates every dirty expression
+    ASSERT_EQ(state.storeExpressionValue(first, 2).size(), 1);
+    state.setEvaluationMode(Calculator::State::EvaluationMode::EAGER);
+    ASSERT_EQ(state.getPendingExpressionCount(), 0);
+    ASSERT_EQ(state.getOperandValues()[third], 6);
+}
+
+/**
+ * @brief Tests that a loaded state behaves exactly like the saved one
+ * (values, propagations and undo of the whole operation history)
+ */
+TEST_F(StateUnitTest, loadedStateMatchesSavedState)
+{
+    Calculator::State savedState;
+    createLayeredGraph(savedState);
+
+    const auto sourceOperand = mSymbolTable.intern("s");
+    static_cast<void>(savedState.storeExpressionValue(sourceOperand, 1));
+    savedState.updateOperationOrder(sourceOperand);
+
+    IO::BinaryWriter writer;
+    savedState.save(writer);
+
+    Calculator::State loadedState;
+    IO::BinaryReader reader(writer.getBuffer());
+    ASSERT_TRUE(loadedState.load(reader, mSymbolTable.size()));
+    ASSERT_EQ(loadedState.getOperandValues(), savedState.getOperandValues());
+    ASSERT_EQ(loadedState.getLastFulfilledOperation(), savedState.getLastFulfilledOperation());
+
+    ASSERT_EQ(loadedState.storeExpressionValue(sourceOperand, 2),
+              savedState.storeExpressionValue(sourceOperand, 2));
+    loadedState.updateOperationOrder(sourceOperand);
+    savedState.updateOperationOrder(sourceOperand);
+
+    // Undo every operation, one at a time
+    while (!savedState.undoLastRegisteredOperations(1).empty()) {
+        ASSERT_FALSE(loadedState.undoLastRegisteredOperations(1).empty());
+        ASSERT_EQ(loadedState.getOperandValues(), savedState.getOperandValues());
+    }
+    ASSERT_TRUE(loadedState.undoLastRegisteredOperations(1).empty());
+}
+
+/**
+ * @brief Tests that truncated or inconsistent encoded states are rejected,
+ * leaving the state untouched
+ */
+TEST_F(StateUnitTest, invalidEncodedStatesAreRejected)
+{
+    Calculator::State savedState;
+    const auto first = mSymbolTable.intern("a");
+    const auto second = mSymbolTable.intern("b");
+
+    ASSERT_TRUE(savedState.storeExpressionDependencies(
+          second, createSumProgram({first}, 1), {first}));
+    savedState.updateOperationOrder(second);
+
+    IO::BinaryWriter writer;
+    savedState.save(writer);
+    const auto& encodedState = writer.getBuffer();
+
+    Calculator::State state;
+    static_cast<void>(state.storeExpressionValue(first, 5));
+    state.updateOperationOrder(first);
+
+    // Every truncation is rejected
+    for (std::size_t size = 0; size < encodedState.size(); ++size) {
+        IO::BinaryReader reader(std::string_view{encodedState}.substr(0, size));
+        ASSERT_FALSE(state.load(reader, mSymbolTable.size())) << size;
+    }
+
+    // Programs referencing operands that were never interned are rejected
+    {
+        IO::BinaryReader reader(encodedState);
+        ASSERT_FALSE(state.load(reader, 1));
+    }
+
+    // Trailing data is rejected
+    {
+        const auto paddedState = encodedState + '\0';
+        IO::BinaryReader reader(paddedState);
+        ASSERT_FALSE(state.load(reader, mSymbolTable.size()));
+    }
+
+    ASSERT_EQ(state.getOperandValues()[first], 5);
+    ASSERT_EQ(state.getLastFulfilledOperation(), (Calculator::State::OperandValue{first, 5}));
+}
@@ -0,0 +1,61 @@
+#include "gtest/gtest.h"
+
+#include "compiler/Compiler.hpp"
+#include "parser/Parser.hpp"
+
+using namespace ::testing;
+
+/**
+ * @brief Tests that the Compiler fails when the provided AST is empty
+ */
+TEST(CompilerUnitTest, compilerFailsWhenASTIsEmpty)
+{
+    const AST::Tree emptyAST;
+
+    Compiler compiler(emptyAST);
+    ASSERT_FALSE(compiler.execute());
+}
+
+/**
+ * @brief Tests that the Compiler lowers an AST into the expected postfix instruction stream,
+ * assigning a single variable slot to each distinct operand (symbol id)
+ */
+TEST(CompilerUnitTest, compilerGeneratesPostfixInstructionStream)
+{
+    using Bytecode::OpCode;
+
+    Symbols::SymbolTable symbolTable;
+    Parser parser("x = a*(b+3)-a/2", symbolTable);
+    ASSERT_TRUE(parser.execute());
+
+    Compiler compiler(*parser.getASTOfRHS());
+    ASSERT_TRUE(compiler.execute());
+
+    const auto program = compiler.getProgram();
+    ASSERT_NE(program, nullptr);
+
+    // a b 3 + * a 2 / -
+    const std::vector<std::pair<OpCode, uint32_t>> expectedInstructions{
+          {OpCode::PUSH_VARIABLE, 0},
+          {OpCode::PUSH_VARIABLE, 1},
+          {OpCode::PUSH_LITERAL, 3},
+          {OpCode::ADD, 0},
+          {OpCode::MULT, 0},
+          {OpCode::PUSH_VARIABLE, 0},
+          {OpCode::PUSH_LITERAL, 2},
+          {OpCode::DIV, 0},
+          {OpCode::SUB, 0}};
+
+    ASSERT_EQ(program->instructions.size(), expectedInstructions.size());
+    for (std::size_t index = 0; index < expectedInstructions.size(); ++index) {
+        ASSERT_EQ(program->instructions[index].opCode, expectedInstructions[index].first);
+        ASSERT_EQ(program->instructions[index].operand, expectedInstructions[index].second);
+    }
+
+    const std::vector<Symbols::SymbolId> expectedVariables{*symbolTable.find("a"),
+                                                           *symbolTable.find("b")};
+    ASSERT_EQ(program->variables, expectedVariables);
+
+    constexpr uint32_t expectedMaxStackDepth{3};
+    ASSERT_EQ(program->maxStackDepth, expectedMaxStackDepth);
+}
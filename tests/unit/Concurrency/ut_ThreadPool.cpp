@@ -0,0 +1,52 @@
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <vector>
+
+#include "concurrency/ThreadPool.hpp"
+
+/**
+ * @brief Tests that a parallel loop processes every index exactly once,
+ * for both even and uneven splits between the participants
+ */
+TEST(ThreadPoolUnitTest, parallelForProcessesEveryIndexOnce)
+{
+    Concurrency::ThreadPool threadPool(4);
+    ASSERT_EQ(threadPool.getThreadCount(), 4);
+
+    for (const std::size_t count : {1U, 7U, 64U, 1000U, 4099U}) {
+        std::vector<std::atomic<int>> visitCounts(count);
+
+        threadPool.parallelFor(count, 16, [&](std::size_t participant, std::size_t begin,
+                                              std::size_t end) {
+            ASSERT_LT(participant, threadPool.getThreadCount());
+            ASSERT_LE(end - begin, 16);
+
+            for (auto index = begin; index < end; ++index) {
+                ++visitCounts[index];
+            }
+        });
+
+        for (std::size_t index = 0; index < count; ++index) {
+            ASSERT_EQ(visitCounts[index], 1) << "index " << index << " of " << count;
+        }
+    }
+}
+
+/**
+ * @brief Tests that a single thread pool runs loops on the calling thread only
+ */
+TEST(ThreadPoolUnitTest, singleThreadPoolRunsOnCallingThread)
+{
+    Concurrency::ThreadPool threadPool(0);
+    ASSERT_EQ(threadPool.getThreadCount(), 1);
+
+    std::size_t processedCount{0};
+    threadPool.parallelFor(100, 8, [&](std::size_t participant, std::size_t begin,
+                                       std::size_t end) {
+        ASSERT_EQ(participant, 0);
+        processedCount += end - begin;
+    });
+
+    ASSERT_EQ(processedCount, 100);
+}
@@ -0,0 +1,177 @@
+#include "gtest/gtest.h"
+
+#include <limits>
+#include <random>
+
+#include "compiler/Compiler.hpp"
+#include "evaluator/BatchVirtualMachine.hpp"
+#include "evaluator/VirtualMachine.hpp"
+#include "parser/Parser.hpp"
+
+using namespace ::testing;
+
+/**
+ * @brief Test fixture for the BatchVirtualMachine class
+ */
+class BatchVirtualMachineUnitTest : public Test
+{
+protected:
+    /**
+     * @brief Parses an arithmetic expression and compiles its RHS
+     *
+     * @param[in] arithmeticExpression Arithmetic expression to compile
+     *
+     * @return Shared pointer to the compiled program (nullptr on failure)
+     */
+    [[nodiscard]] std::shared_ptr<const Bytecode::Program>
+          compile(const std::string& arithmeticExpression)
+    {
+        Parser parser(arithmeticExpression, mSymbolTable);
+        if (!parser.execute()) {
+            return nullptr;
+        }
+
+        Compiler compiler(*parser.getASTOfRHS());
+        return compiler.execute() ? compiler.getProgram() : nullptr;
+    }
+
+    /**
+     * @brief Fills a column for every interned operand with pseudo-random values
+     *
+     * @param[in] bindingCount Amount of values of each column
+     * @param[in] candidateValues Values to pick from (non zero digits if empty)
+     */
+    void createOperandColumns(const std::size_t bindingCount,
+                              const std::vector<Evaluator::Value>& candidateValues = {})
+    {
+        std::mt19937 randomEngine{42};
+        std::uniform_int_distribution<std::size_t> distribution{
+              0, candidateValues.empty() ? 8 : candidateValues.size() - 1};
+
+        mColumnValues.assign(mSymbolTable.size(), std::vector<Evaluator::Value>(bindingCount));
+        for (auto& columnValues : mColumnValues) {
+            for (auto& value : columnValues) {
+                const auto index = distribution(randomEngine);
+                value = candidateValues.empty() ? static_cast<Evaluator::Value>(index + 1)
+                                                : candidateValues[index];
+            }
+        }
+
+        mOperandColumns.assign(mColumnValues.begin(), mColumnValues.end());
+    }
+
+protected:
+    /// Symbol table used to intern the operands of the compiled expressions
+    Symbols::SymbolTable mSymbolTable;
+
+    /// Values of the operand columns, indexed by symbol id
+    std::vector<std::vector<Evaluator::Value>> mColumnValues;
+
+    /// Views of the operand columns, indexed by symbol id
+    std::vector<BatchVirtualMachine::Column> mOperandColumns;
+
+    /// Virtual machine under test
+    BatchVirtualMachine mBatchVirtualMachine;
+};
+
+/**
+ * @brief Tests that the BatchVirtualMachine outputs, for every binding,
+ * the same result as the VirtualMachine (including the bindings of a partial tile)
+ */
+TEST_F(BatchVirtualMachineUnitTest, batchVirtualMachineMatchesVirtualMachineResults)
+{
+    constexpr std::size_t bindingCount{3 * BatchVirtualMachine::cLaneCount + 17};
+
+    for (const auto& arithmeticExpression : {"x = 4+5+7/2",
+                                             "x = 4+a+7/b",
+                                             "x = a*(b+3)-a/2",
+                                             "x = (a-b)/(b*b)",
+                                             "x = (c*(a+6/b)/4)-c"}) {
+
+        const auto program = compile(arithmeticExpression);
+        ASSERT_NE(program, nullptr);
+        createOperandColumns(bindingCount);
+
+        std::vector<Evaluator::Value> results(bindingCount);
+        std::vector<std::optional<Evaluator::Error>> errors(bindingCount);
+        ASSERT_TRUE(mBatchVirtualMachine.execute(*program, mOperandColumns, results, errors));
+
+        VirtualMachine virtualMachine;
+        std::vector<std::optional<Evaluator::Value>> operandValues(mSymbolTable.size());
+
+        for (std::size_t binding = 0; binding < bindingCount; ++binding) {
+            for (std::size_t symbolId = 0; symbolId < operandValues.size(); ++symbolId) {
+                operandValues[symbolId] = mColumnValues[symbolId][binding];
+            }
+
+            const auto expectedResult = virtualMachine.execute(*program, operandValues);
+            ASSERT_TRUE(std::holds_alternative<Evaluator::Value>(expectedResult));
+            ASSERT_EQ(results[binding], std::get<Evaluator::Value>(expectedResult))
+                  << arithmeticExpression << " (binding " << binding << ")";
+            ASSERT_FALSE(errors[binding].has_value());
+        }
+    }
+}
+
+/**
+ * @brief Tests that the BatchVirtualMachine outputs, for every binding,
+ * the same error as the VirtualMachine (and the same value when there is none)
+ */
+TEST_F(BatchVirtualMachineUnitTest, batchVirtualMachineMatchesVirtualMachineErrors)
+{
+    constexpr std::size_t bindingCount{2 * BatchVirtualMachine::cLaneCount + 5};
+    constexpr auto cMinValue{std::numeric_limits<Evaluator::Value>::min()};
+    constexpr auto cMaxValue{std::numeric_limits<Evaluator::Value>::max()};
+    const std::vector<Evaluator::Value> candidateValues{cMinValue, cMaxValue, -1, 0, 1, 3};
+
+    for (const auto& arithmeticExpression :
+         {"x = a/b", "x = (a+b)*c", "x = a*b-c/(a+1)", "x = (a-b)/(c-1)+a/c"}) {
+
+        const auto program = compile(arithmeticExpression);
+        ASSERT_NE(program, nullptr);
+        createOperandColumns(bindingCount, candidateValues);
+
+        std::vector<Evaluator::Value> results(bindingCount);
+        std::vector<std::optional<Evaluator::Error>> errors(bindingCount);
+        ASSERT_TRUE(mBatchVirtualMachine.execute(*program, mOperandColumns, results, errors));
+
+        VirtualMachine virtualMachine;
+        std::vector<std::optional<Evaluator::Value>> operandValues(mSymbolTable.size());
+
+        for (std::size_t binding = 0; binding < bindingCount; ++binding) {
+            for (std::size_t symbolId = 0; symbolId < operandValues.size(); ++symbolId) {
+                operandValues[symbolId] = mColumnValues[symbolId][binding];
+            }
+
+            const auto expectedResult = virtualMachine.execute(*program, operandValues);
+            const auto result = errors[binding] ? Evaluator::Result{*errors[binding]}
+                                                : Evaluator::Result{results[binding]};
+            ASSERT_EQ(result, expectedResult)
+                  << arithmeticExpression << " (binding " << binding << ")";
+        }
+    }
+}
+
+/**
+ * @brief Tests that the BatchVirtualMachine fails when a variable of the program
+ * has no column, or a column that is too short (or the error column does not fit the results)
+ */
+TEST_F(BatchVirtualMachineUnitTest, batchVirtualMachineFailsWhenColumnsAreMissing)
+{
+    const auto program = compile("x = a+b");
+    ASSERT_NE(program, nullptr);
+
+    std::vector<Evaluator::Value> results(8);
+    std::vector<std::optional<Evaluator::Error>> errors(results.size());
+    ASSERT_FALSE(mBatchVirtualMachine.execute(*program, {}, results, errors));
+
+    createOperandColumns(results.size() - 1);
+    ASSERT_FALSE(mBatchVirtualMachine.execute(*program, mOperandColumns, results, errors));
+
+    createOperandColumns(results.size());
+    ASSERT_TRUE(mBatchVirtualMachine.execute(*program, mOperandColumns, results, errors));
+
+    // Every result needs room for its error
+    ASSERT_FALSE(mBatchVirtualMachine.execute(
+          *program, mOperandColumns, results, std::span{errors}.first(results.size() - 1)));
+}
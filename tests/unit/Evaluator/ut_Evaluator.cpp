@@ -2,6 +2,13 @@
 
 #include "evaluator/Evaluator.hpp"
 
+namespace {
+/// Symbol id of the operand 'a'
+constexpr Symbols::SymbolId cSymbolIdA{0};
+/// Symbol id of the operand 'b'
+constexpr Symbols::SymbolId cSymbolIdB{1};
+} // namespace
+
 /**
  * @brief Tests that the Evaluator correctly calculates the integer result
  * from ASTs representing arithmetic expressions without dependencies
@@ -9,96 +16,161 @@
 TEST(EvaluatorUnitTest, evaluatorOutputsCorrectResultWithoutDependencies)
 {
     // Constructing a valid AST for the arithmetic expression: "4+5+7/2"
-    using namespace AST;
-    const auto rootNode = std::make_unique<Node>(
-          // First Level: root node representing '+'
-          '+',
-          // Second Level: left child (4 + 5)
-          std::make_unique<Node>('+',
-                                 // Third Level: leaf nodes '4' and '5'
-                                 std::make_unique<Node>('4'),
-                                 std::make_unique<Node>('5')),
-          // Second Level: right child (7 / 2)
-          std::make_unique<Node>('/',
-                                 // Third Level: leaf nodes '7' and '2'
-                                 std::make_unique<Node>('7'),
-                                 std::make_unique<Node>('2')));
-
-    // Create an Evaluator with the AST and an empty operand lookup map
-    Evaluator evaluator(rootNode, {});
+    // (child nodes are added before their parents, so the last added node is the root)
+    AST::Tree ast;
+    // Third Level: leaf nodes '4' and '5'
+    const auto leftLeftLeaf = ast.addLiteralNode(4);
+    const auto leftRightLeaf = ast.addLiteralNode(5);
+    // Second Level: left child (4 + 5)
+    const auto leftChild = ast.addOperatorNode('+', leftLeftLeaf, leftRightLeaf);
+    // Third Level: leaf nodes '7' and '2'
+    const auto rightLeftLeaf = ast.addLiteralNode(7);
+    const auto rightRightLeaf = ast.addLiteralNode(2);
+    // Second Level: right child (7 / 2)
+    const auto rightChild = ast.addOperatorNode('/', rightLeftLeaf, rightRightLeaf);
+    // First Level: root node representing '+'
+    ast.addOperatorNode('+', leftChild, rightChild);
+
+    // Create an Evaluator with the AST and no operand values
+    Evaluator evaluator(ast, {});
     const auto result = evaluator.execute();
 
     // Verify that the evaluation resulted in the expected integer value
-    ASSERT_TRUE(std::holds_alternative<int>(result));
+    ASSERT_TRUE(std::holds_alternative<Evaluator::Value>(result));
     constexpr auto expectedValue{/* 4 + 5 + 7 / 2 = 4 + 5 + 3 = 12 */ 12};
-    ASSERT_EQ(std::get<int>(result), expectedValue);
+    ASSERT_EQ(std::get<Evaluator::Value>(result), expectedValue);
 }
 
 /**
  * @brief Tests that the Evaluator correctly calculates the integer result
  * from ASTs representing arithmetic expressions with dependencies
- * when the appropriate dependencies lookup map is provided
+ * when the appropriate operand values are provided
  */
 TEST(EvaluatorUnitTest, evaluatorOutputsCorrectResultWithDependencies)
 {
     // Constructing a valid AST for the arithmetic expression: "4+a+7/b"
-    using namespace AST;
-    const auto rootNode = std::make_unique<Node>(
-          // First Level: root node representing '+'
-          '+',
-          // Second Level: left child (4 + a)
-          std::make_unique<Node>('+',
-                                 // Third Level: leaf nodes '4' and 'a'
-                                 std::make_unique<Node>('4'),
-                                 std::make_unique<Node>('a')),
-          // Second Level: right child (7 / b)
-          std::make_unique<Node>('/',
-                                 // Third Level: leaf nodes '7' and 'b'
-                                 std::make_unique<Node>('7'),
-                                 std::make_unique<Node>('b')));
-
-    // Setup the dependencies lookup map
-    const std::unordered_map<std::string, int> dependenciesLookupMap{{"a", 5}, {"b", 2}};
-
-    // Create an Evaluator with the AST and the operand lookup map
-    Evaluator evaluator(rootNode, dependenciesLookupMap);
+    // (child nodes are added before their parents, so the last added node is the root)
+    AST::Tree ast;
+    // Third Level: leaf nodes '4' and 'a'
+    const auto leftLeftLeaf = ast.addLiteralNode(4);
+    const auto leftRightLeaf = ast.addVariableNode(cSymbolIdA);
+    // Second Level: left child (4 + a)
+    const auto leftChild = ast.addOperatorNode('+', leftLeftLeaf, leftRightLeaf);
+    // Third Level: leaf nodes '7' and 'b'
+    const auto rightLeftLeaf = ast.addLiteralNode(7);
+    const auto rightRightLeaf = ast.addVariableNode(cSymbolIdB);
+    // Second Level: right child (7 / b)
+    const auto rightChild = ast.addOperatorNode('/', rightLeftLeaf, rightRightLeaf);
+    // First Level: root node representing '+'
+    ast.addOperatorNode('+', leftChild, rightChild);
+
+    // Setup the operand values (indexed by symbol id): a = 5, b = 2
+    const std::vector<std::optional<Evaluator::Value>> operandValues{5, 2};
+
+    // Create an Evaluator with the AST and the operand values
+    Evaluator evaluator(ast, operandValues);
     const auto result = evaluator.execute();
 
     // Verify that the evaluation resulted in the expected integer value
-    ASSERT_TRUE(std::holds_alternative<int>(result));
+    ASSERT_TRUE(std::holds_alternative<Evaluator::Value>(result));
     constexpr auto expectedValue{/* 4 + 5 + 7 / 2 = 4 + 5 + 3 = 12 */ 12};
-    ASSERT_EQ(std::get<int>(result), expectedValue);
+    ASSERT_EQ(std::get<Evaluator::Value>(result), expectedValue);
 }
 
 /**
  * @brief Tests that the Evaluator cannot calculate a result from ASTs
- * representing arithmetic expressions with dependencies when no dependency map is provided
+ * representing arithmetic expressions with dependencies when no operand values are provided
  * and instead returns the list of the corresponding unmet dependencies
  */
 TEST(EvaluatorUnitTest, evaluatorOutputsDependenciesInsteadOfResult)
 {
     // Constructing a valid AST for the arithmetic expression: "4+a+7/b"
-    using namespace AST;
-    const auto rootNode = std::make_unique<Node>(
-          // First Level: root node representing '+'
-          '+',
-          // Second Level: left child (4 + a)
-          std::make_unique<Node>('+',
-                                 // Third Level: leaf nodes '4' and 'a'
-                                 std::make_unique<Node>('4'),
-                                 std::make_unique<Node>('a')),
-          // Second Level: right child (7 / b)
-          std::make_unique<Node>('/',
-                                 // Third Level: leaf nodes '7' and 'b'
-                                 std::make_unique<Node>('7'),
-                                 std::make_unique<Node>('b')));
-
-    // Create an Evaluator with the AST and an empty operand lookup map
-    Evaluator evaluator(rootNode, {});
+    // (child nodes are added before their parents, so the last added node is the root)
+    AST::Tree ast;
+    // Third Level: leaf nodes '4' and 'a'
+    const auto leftLeftLeaf = ast.addLiteralNode(4);
+    const auto leftRightLeaf = ast.addVariableNode(cSymbolIdA);
+    // Second Level: left child (4 + a)
+    const auto leftChild = ast.addOperatorNode('+', leftLeftLeaf, leftRightLeaf);
+    // Third Level: leaf nodes '7' and 'b'
+    const auto rightLeftLeaf = ast.addLiteralNode(7);
+    const auto rightRightLeaf = ast.addVariableNode(cSymbolIdB);
+    // Second Level: right child (7 / b)
+    const auto rightChild = ast.addOperatorNode('/', rightLeftLeaf, rightRightLeaf);
+    // First Level: root node representing '+'
+    ast.addOperatorNode('+', leftChild, rightChild);
+
+    // Create an Evaluator with the AST and no operand values
+    Evaluator evaluator(ast, {});
     const auto result = evaluator.execute();
 
     // Verify that the evaluation resulted in the expected dependencies
     ASSERT_TRUE(std::holds_alternative<Evaluator::Dependencies>(result));
-    const Evaluator::Dependencies expectedDependencies{"a", "b"};
+    const Evaluator::Dependencies expectedDependencies{cSymbolIdA, cSymbolIdB};
     ASSERT_EQ(std::get<Evaluator::Dependencies>(result), expectedDependencies);
 }
+
+/**
+ * @brief Tests that the Evaluator truncates the quotients of divisions toward zero
+ */
+TEST(EvaluatorUnitTest, evaluatorTruncatesQuotientsTowardZero)
+{
+    // Constructing a valid AST for the arithmetic expression: "a/2"
+    AST::Tree ast;
+    const auto leftLeaf = ast.addVariableNode(cSymbolIdA);
+    const auto rightLeaf = ast.addLiteralNode(2);
+    ast.addOperatorNode('/', leftLeaf, rightLeaf);
+
+    using ValuePair = std::pair<Evaluator::Value, Evaluator::Value>;
+    for (const auto& [aValue, expectedValue] : {ValuePair{7, 3}, ValuePair{-7, -3}, {-1, 0}}) {
+        const std::vector<std::optional<Evaluator::Value>> operandValues{aValue};
+
+        Evaluator evaluator(ast, operandValues);
+        ASSERT_EQ(evaluator.execute(), Evaluator::Result{expectedValue}) << "a = " << aValue;
+    }
+}
+
+/**
+ * @brief Tests that the Evaluator outputs the first error found (in evaluation order)
+ * when operations of an arithmetic expression fail, unless it has unmet dependencies
+ */
+TEST(EvaluatorUnitTest, evaluatorOutputsErrorsInsteadOfResult)
+{
+    // Constructing a valid AST for the arithmetic expression: "a*a+7/b"
+    AST::Tree ast;
+    // Third Level: leaf nodes 'a' and 'a'
+    const auto leftLeftLeaf = ast.addVariableNode(cSymbolIdA);
+    const auto leftRightLeaf = ast.addVariableNode(cSymbolIdA);
+    // Second Level: left child (a * a)
+    const auto leftChild = ast.addOperatorNode('*', leftLeftLeaf, leftRightLeaf);
+    // Third Level: leaf nodes '7' and 'b'
+    const auto rightLeftLeaf = ast.addLiteralNode(7);
+    const auto rightRightLeaf = ast.addVariableNode(cSymbolIdB);
+    // Second Level: right child (7 / b)
+    const auto rightChild = ast.addOperatorNode('/', rightLeftLeaf, rightRightLeaf);
+    // First Level: root node representing '+'
+    ast.addOperatorNode('+', leftChild, rightChild);
+
+    constexpr Evaluator::Value cLargeValue{Evaluator::Value{1} << 32};
+
+    // b = 0: division by zero
+    {
+        const std::vector<std::optional<Evaluator::Value>> operandValues{3, 0};
+        Evaluator evaluator(ast, operandValues);
+        ASSERT_EQ(evaluator.execute(), Evaluator::Result{Evaluator::Error::DIVISION_BY_ZERO});
+    }
+
+    // a = 2^32: a * a overflows, before the division by zero is evaluated
+    {
+        const std::vector<std::optional<Evaluator::Value>> operandValues{cLargeValue, 0};
+        Evaluator evaluator(ast, operandValues);
+        ASSERT_EQ(evaluator.execute(), Evaluator::Result{Evaluator::Error::INTEGER_OVERFLOW});
+    }
+
+    // b is unknown: the dependencies take precedence over the overflow
+    {
+        const std::vector<std::optional<Evaluator::Value>> operandValues{cLargeValue};
+        Evaluator evaluator(ast, operandValues);
+        ASSERT_EQ(evaluator.execute(), Evaluator::Result{Evaluator::Dependencies{cSymbolIdB}});
+    }
+}
@@ -0,0 +1,152 @@
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "compiler/Compiler.hpp"
+#include "evaluator/Evaluator.hpp"
+#include "evaluator/VirtualMachine.hpp"
+#include "parser/Parser.hpp"
+
+using namespace ::testing;
+
+/**
+ * @brief Test fixture for the VirtualMachine class
+ */
+class VirtualMachineUnitTest : public Test
+{
+protected:
+    /**
+     * @brief Builds the operand values lookup (indexed by symbol id) from operand names
+     *
+     * @param[in] namedValues Pairs of operand names and their values
+     *
+     * @return Operand values, indexed by the symbol ids of the operands
+     */
+    [[nodiscard]] std::vector<std::optional<Evaluator::Value>> createOperandValues(
+          std::initializer_list<std::pair<std::string_view, Evaluator::Value>> namedValues)
+    {
+        std::vector<std::optional<Evaluator::Value>> operandValues;
+
+        for (const auto& [name, value] : namedValues) {
+            const auto symbolId = mSymbolTable.intern(name);
+            operandValues.resize(std::max<std::size_t>(operandValues.size(), symbolId + 1U));
+            operandValues[symbolId] = value;
+        }
+
+        return operandValues;
+    }
+
+    /**
+     * @brief Parses an arithmetic expression and compiles its RHS
+     *
+     * @param[in] arithmeticExpression Arithmetic expression to compile
+     *
+     * @return Shared pointer to the compiled program (nullptr on failure)
+     */
+    [[nodiscard]] std::shared_ptr<const Bytecode::Program>
+          compile(const std::string& arithmeticExpression)
+    {
+        Parser parser(arithmeticExpression, mSymbolTable);
+        if (!parser.execute()) {
+            return nullptr;
+        }
+
+        mAST = parser.getASTOfRHS();
+
+        Compiler compiler(*mAST);
+        return compiler.execute() ? compiler.getProgram() : nullptr;
+    }
+
+protected:
+    /// Symbol table used to intern the operands of the compiled expressions
+    Symbols::SymbolTable mSymbolTable;
+
+    /// AST of the last compiled expression (used as reference for the Evaluator)
+    std::shared_ptr<const AST::Tree> mAST;
+
+    /// Virtual machine under test
+    VirtualMachine mVirtualMachine;
+};
+
+/**
+ * @brief Tests that the VirtualMachine outputs the same results as the Evaluator
+ */
+TEST_F(VirtualMachineUnitTest, virtualMachineMatchesEvaluatorResults)
+{
+    const auto operandValues = createOperandValues({{"a", 5}, {"b", 2}});
+
+    for (const auto& arithmeticExpression : {"x = 4+5+7/2",
+                                             "x = (4 + 5 * (7 - 3)) - 2",
+                                             "x = 7+3*(1/(2/(3+1)-1))",
+                                             "x = (2*(3+6/2)/4)",
+                                             "x = 4+a+7/b",
+                                             "x = a*(b+3)-a/2",
+                                             "x = (a-b)/(b*b)"}) {
+
+        const auto program = compile(arithmeticExpression);
+        ASSERT_NE(program, nullptr);
+
+        const auto result = mVirtualMachine.execute(*program, operandValues);
+
+        Evaluator evaluator(*mAST, operandValues);
+        const auto expectedResult = evaluator.execute();
+
+        ASSERT_TRUE(std::holds_alternative<Evaluator::Value>(result));
+        ASSERT_EQ(result, expectedResult) << arithmeticExpression;
+    }
+}
+
+/**
+ * @brief Tests that the VirtualMachine outputs the same errors as the Evaluator
+ * (the first failing operation, in evaluation order)
+ */
+TEST_F(VirtualMachineUnitTest, virtualMachineMatchesEvaluatorErrors)
+{
+    constexpr auto cMaxValue{std::numeric_limits<Evaluator::Value>::max()};
+    constexpr auto cMinValue{std::numeric_limits<Evaluator::Value>::min()};
+    const auto operandValues
+          = createOperandValues({{"a", cMaxValue}, {"b", cMinValue}, {"c", 0}, {"d", -1}});
+
+    for (const auto& [arithmeticExpression, expectedError] :
+         {std::pair{"x = 7/c", Evaluator::Error::DIVISION_BY_ZERO},
+          {"x = 5/(d+1)+a", Evaluator::Error::DIVISION_BY_ZERO},
+          {"x = a+1", Evaluator::Error::INTEGER_OVERFLOW},
+          {"x = b-1", Evaluator::Error::INTEGER_OVERFLOW},
+          {"x = a*2", Evaluator::Error::INTEGER_OVERFLOW},
+          {"x = b/d", Evaluator::Error::INTEGER_OVERFLOW},
+          {"x = (a+1)/c", Evaluator::Error::INTEGER_OVERFLOW},
+          {"x = 1/c+(a+1)", Evaluator::Error::DIVISION_BY_ZERO}}) {
+
+        const auto program = compile(arithmeticExpression);
+        ASSERT_NE(program, nullptr);
+
+        const auto result = mVirtualMachine.execute(*program, operandValues);
+
+        Evaluator evaluator(*mAST, operandValues);
+        ASSERT_EQ(result, evaluator.execute()) << arithmeticExpression;
+        ASSERT_EQ(result, Evaluator::Result{expectedError}) << arithmeticExpression;
+    }
+
+    // Values at the limits are exact
+    const auto program = compile("x = (a-1)+(b+a)/d");
+    ASSERT_NE(program, nullptr);
+    ASSERT_EQ(mVirtualMachine.execute(*program, operandValues), Evaluator::Result{cMaxValue});
+}
+
+/**
+ * @brief Tests that the VirtualMachine outputs the unmet dependencies of a program
+ * instead of a result when some of its variables cannot be resolved
+ */
+TEST_F(VirtualMachineUnitTest, virtualMachineOutputsDependenciesInsteadOfResult)
+{
+    const auto program = compile("x = 4+a+7/b*a");
+    ASSERT_NE(program, nullptr);
+
+    const auto operandValues = createOperandValues({{"a", 1}});
+    const auto result = mVirtualMachine.execute(*program, operandValues);
+
+    ASSERT_TRUE(std::holds_alternative<Evaluator::Dependencies>(result));
+    const Evaluator::Dependencies expectedDependencies{*mSymbolTable.find("b")};
+    ASSERT_EQ(std::get<Evaluator::Dependencies>(result), expectedDependencies);
+}
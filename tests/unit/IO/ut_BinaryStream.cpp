@@ -0,0 +1,57 @@
+#include "gtest/gtest.h"
+
+#include <limits>
+
+#include "io/BinaryStream.hpp"
+
+using namespace ::testing;
+
+/**
+ * @brief Tests that integers and bytes written by a BinaryWriter are read back unchanged
+ * (integers being encoded in little-endian order)
+ */
+TEST(BinaryStreamUnitTest, readerDecodesWrittenData)
+{
+    IO::BinaryWriter writer;
+    writer.write<uint32_t>(0x04030201U);
+    writer.write<int64_t>(std::numeric_limits<int64_t>::min());
+    writer.write<uint8_t>(7);
+    writer.writeBytes("abc");
+
+    ASSERT_EQ(writer.getBuffer().substr(0, 4), "\x01\x02\x03\x04");
+
+    IO::BinaryReader reader(writer.getBuffer());
+    ASSERT_EQ(reader.read<uint32_t>(), 0x04030201U);
+    ASSERT_EQ(reader.read<int64_t>(), std::numeric_limits<int64_t>::min());
+    ASSERT_EQ(reader.read<uint8_t>(), 7);
+    ASSERT_FALSE(reader.isAtEnd());
+    ASSERT_EQ(reader.readBytes(3), "abc");
+    ASSERT_TRUE(reader.isAtEnd());
+}
+
+/**
+ * @brief Tests that reading past the end of the data (or more elements than it can hold)
+ * fails every later read
+ */
+TEST(BinaryStreamUnitTest, readerFailsOnTruncatedData)
+{
+    IO::BinaryWriter writer;
+    writer.write<uint32_t>(3);
+    writer.write<uint32_t>(1);
+    writer.write<uint16_t>(2);
+
+    // Three elements of four bytes do not fit in the six bytes left
+    IO::BinaryReader countReader(writer.getBuffer());
+    ASSERT_EQ(countReader.readCount(sizeof(uint32_t)), 0);
+    ASSERT_FALSE(countReader.isValid());
+    ASSERT_EQ(countReader.read<uint16_t>(), 0);
+
+    IO::BinaryReader reader(writer.getBuffer());
+    ASSERT_EQ(reader.readCount(sizeof(uint16_t)), 3);
+    ASSERT_EQ(reader.read<uint32_t>(), 1);
+    ASSERT_EQ(reader.read<uint32_t>(), 0);
+    ASSERT_FALSE(reader.isValid());
+    ASSERT_EQ(reader.read<uint8_t>(), 0);
+    ASSERT_TRUE(reader.readBytes(1).empty());
+    ASSERT_FALSE(reader.isAtEnd());
+}
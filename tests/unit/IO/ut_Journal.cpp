@@ -0,0 +1,135 @@
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "io/Journal.hpp"
+
+using namespace ::testing;
+
+/**
+ * @brief Test fixture for the Journal class
+ */
+class JournalUnitTest : public Test
+{
+protected:
+    /**
+     * @brief Removes the temporary file used by the tests
+     */
+    void TearDown() override
+    {
+        std::filesystem::remove(mFilePath);
+    }
+
+    /**
+     * @brief Reads the whole contents of the temporary file used by the tests
+     *
+     * @return Contents of the file
+     */
+    [[nodiscard]] std::string readFile() const
+    {
+        std::ifstream file(mFilePath, std::ios::binary);
+        std::ostringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+protected:
+    /// Path of the temporary file used by the running test (one per test and process)
+    const std::filesystem::path mFilePath{TempDir() + "ut_Journal_"
+                                          + UnitTest::GetInstance()->current_test_info()->name()
+                                          + "_" + std::to_string(::getpid()) + ".bin"};
+};
+
+/**
+ * @brief Tests that appended records are durable once flushed, and are read back in order
+ * (after the journal is reopened as well)
+ */
+TEST_F(JournalUnitTest, appendedRecordsAreReadBack)
+{
+    {
+        // Records appended before the sync interval elapses share a single sync
+        IO::Journal journal({.syncInterval = std::chrono::seconds{10}});
+        ASSERT_TRUE(journal.open(mFilePath.string(), 0));
+
+        journal.append("a=1");
+        journal.append("");
+        journal.append("undo 1");
+        ASSERT_TRUE(journal.flush());
+
+        std::size_t validSize{};
+        const auto contents = readFile();
+        ASSERT_EQ(IO::Journal::readRecords(contents, validSize),
+                  (std::vector<std::string_view>{"a=1", "", "undo 1"}));
+        ASSERT_EQ(validSize, contents.size());
+
+        journal.append("b=a+1");
+    }
+
+    // Records still pending are synced on destruction
+    std::size_t validSize{};
+    auto contents = readFile();
+    ASSERT_EQ(IO::Journal::readRecords(contents, validSize),
+              (std::vector<std::string_view>{"a=1", "", "undo 1", "b=a+1"}));
+
+    {
+        IO::Journal journal({});
+        ASSERT_TRUE(journal.open(mFilePath.string(), validSize));
+        journal.append("c=2");
+    }
+
+    contents = readFile();
+    ASSERT_EQ(IO::Journal::readRecords(contents, validSize),
+              (std::vector<std::string_view>{"a=1", "", "undo 1", "b=a+1", "c=2"}));
+}
+
+/**
+ * @brief Tests that torn and corrupted records are dropped (with everything after them),
+ * and are overwritten by the following records
+ */
+TEST_F(JournalUnitTest, tornRecordsAreDropped)
+{
+    {
+        IO::Journal journal({});
+        ASSERT_TRUE(journal.open(mFilePath.string(), 0));
+        journal.append("a=1");
+        journal.append("b=2");
+    }
+
+    const auto contents = readFile();
+    std::size_t validSize{};
+
+    // Record cut short by a crash
+    ASSERT_EQ(IO::Journal::readRecords(contents.substr(0, contents.size() - 1), validSize),
+              std::vector<std::string_view>{"a=1"});
+
+    // Record whose contents do not match their checksum
+    auto corruptedContents = contents;
+    corruptedContents.back() = '3';
+    ASSERT_EQ(IO::Journal::readRecords(corruptedContents, validSize),
+              std::vector<std::string_view>{"a=1"});
+
+    // Partial headers hold no records, while other files are not journals
+    ASSERT_EQ(IO::Journal::readRecords(contents.substr(0, 5), validSize),
+              std::vector<std::string_view>{});
+    ASSERT_EQ(validSize, 0);
+    ASSERT_EQ(IO::Journal::readRecords("a=1\nb=2\nc=3\n", validSize), std::nullopt);
+
+    // The torn record is overwritten by the following ones
+    std::ofstream(mFilePath, std::ios::binary | std::ios::trunc) << corruptedContents;
+    ASSERT_EQ(IO::Journal::readRecords(corruptedContents, validSize),
+              std::vector<std::string_view>{"a=1"});
+    {
+        IO::Journal journal({});
+        ASSERT_TRUE(journal.open(mFilePath.string(), validSize));
+        journal.append("c=3");
+    }
+
+    const auto recoveredContents = readFile();
+    ASSERT_EQ(IO::Journal::readRecords(recoveredContents, validSize),
+              (std::vector<std::string_view>{"a=1", "c=3"}));
+    ASSERT_EQ(validSize, recoveredContents.size());
+}
@@ -0,0 +1,75 @@
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+
+#include "io/MappedFile.hpp"
+
+using namespace ::testing;
+
+/**
+ * @brief Test fixture for the MappedFile class
+ */
+class MappedFileUnitTest : public Test
+{
+protected:
+    /**
+     * @brief Removes the temporary file used by the tests
+     */
+    void TearDown() override
+    {
+        std::filesystem::remove(mFilePath);
+    }
+
+    /**
+     * @brief Writes the provided contents to the temporary file used by the tests
+     *
+     * @param[in] contents Contents of the file
+     */
+    void writeFile(const std::string_view contents)
+    {
+        std::ofstream file(mFilePath, std::ios::binary);
+        file << contents;
+    }
+
+protected:
+    /// Temporary file of the running test, named after the test and the process
+    const std::filesystem::path mFilePath{TempDir() + "ut_MappedFile_"
+                                          + UnitTest::GetInstance()->current_test_info()->name()
+                                          + "_" + std::to_string(::getpid()) + ".txt"};
+};
+
+/**
+ * @brief Tests that the MappedFile exposes the whole contents of the mapped file
+ */
+TEST_F(MappedFileUnitTest, mappedFileExposesFileContents)
+{
+    constexpr std::string_view contents{"a=1\nb=a+2\nresult"};
+    writeFile(contents);
+
+    IO::MappedFile mappedFile;
+    ASSERT_TRUE(mappedFile.open(mFilePath.string()));
+    ASSERT_EQ(mappedFile.getContents(), contents);
+
+    // Ownership of the mapping is transferred on move
+    const IO::MappedFile movedMappedFile{std::move(mappedFile)};
+    ASSERT_EQ(movedMappedFile.getContents(), contents);
+}
+
+/**
+ * @brief Tests that the MappedFile handles empty and missing files
+ */
+TEST_F(MappedFileUnitTest, mappedFileHandlesEmptyAndMissingFiles)
+{
+    writeFile("");
+
+    IO::MappedFile mappedFile;
+    ASSERT_TRUE(mappedFile.open(mFilePath.string()));
+    ASSERT_TRUE(mappedFile.getContents().empty());
+
+    std::filesystem::remove(mFilePath);
+    ASSERT_FALSE(mappedFile.open(mFilePath.string()));
+    ASSERT_TRUE(mappedFile.getContents().empty());
+}
@@ -0,0 +1,233 @@
+#include "gtest/gtest.h"
+
+#include <bit>
+#include <functional>
+#include <limits>
+#include <random>
+
+#include "compiler/Compiler.hpp"
+#include "evaluator/Evaluator.hpp"
+#include "jit/CodeArena.hpp"
+#include "jit/CodeGenerator.hpp"
+#include "parser/Parser.hpp"
+
+using namespace ::testing;
+
+/**
+ * @brief Test fixture for the CodeGenerator class
+ */
+class CodeGeneratorUnitTest : public Test
+{
+protected:
+    /**
+     * @brief Parses an arithmetic expression and compiles its RHS
+     *
+     * @param[in] arithmeticExpression Arithmetic expression to compile
+     *
+     * @return Shared pointer to the compiled program (nullptr on failure)
+     */
+    [[nodiscard]] std::shared_ptr<const Bytecode::Program>
+          compile(const std::string& arithmeticExpression)
+    {
+        Parser parser(arithmeticExpression, mSymbolTable);
+        if (!parser.execute()) {
+            return nullptr;
+        }
+
+        mAST = parser.getASTOfRHS();
+
+        Compiler compiler(*mAST);
+        return compiler.execute() ? compiler.getProgram() : nullptr;
+    }
+
+    /**
+     * @brief Translates a program into native code
+     *
+     * @param[in] program Compiled arithmetic expression to translate
+     *
+     * @return Native function (nullptr if the program could not be translated)
+     */
+    [[nodiscard]] Jit::CodeGenerator::NativeFunction translate(const Bytecode::Program& program)
+    {
+        Jit::CodeGenerator codeGenerator(program);
+        if (!codeGenerator.execute()) {
+            return nullptr;
+        }
+
+        const auto* code = mCodeArena.add(codeGenerator.getMachineCode());
+        return code ? std::bit_cast<Jit::CodeGenerator::NativeFunction>(code) : nullptr;
+    }
+
+    /**
+     * @brief Runs a native function
+     *
+     * @param[in] nativeFunction Native function to run
+     * @param[in] operandValues Values of the operands, indexed by their symbol id
+     *
+     * @return Value computed by the native function (empty if one of its operations failed)
+     */
+    [[nodiscard]] static std::optional<Evaluator::Value>
+          run(const Jit::CodeGenerator::NativeFunction nativeFunction,
+              const std::vector<std::optional<Evaluator::Value>>& operandValues)
+    {
+        Evaluator::Value value{};
+        return nativeFunction(operandValues.data(), &value) ? std::optional{value} : std::nullopt;
+    }
+
+protected:
+    /// Symbol table used to intern the operands of the compiled expressions
+    Symbols::SymbolTable mSymbolTable;
+
+    /// AST of the last compiled expression (used as reference for the Evaluator)
+    std::shared_ptr<const AST::Tree> mAST;
+
+    /// Executable memory holding the translated expressions
+    Jit::CodeArena mCodeArena;
+};
+
+/**
+ * @brief Tests that native code outputs the same values as the Evaluator, and fails whenever
+ * the Evaluator outputs an error, for random expressions (using every stack register)
+ * and operand values (including the extreme ones)
+ */
+TEST_F(CodeGeneratorUnitTest, nativeCodeMatchesEvaluatorResults)
+{
+    std::mt19937 randomEngine{7};
+    const auto random = [&](const uint32_t bound) {
+        return std::uniform_int_distribution<uint32_t>{0, bound - 1}(randomEngine);
+    };
+
+    constexpr std::string_view operators{"+-*/"};
+    constexpr std::string_view operands{"abcdefgh0139"};
+
+    // Helper lambda used to generate a random expression (as an infix string),
+    // nesting right operands to grow the value stack
+    std::function<std::string(uint32_t)> generateExpression = [&](const uint32_t depth) {
+        if (depth == 0 || random(6) == 0) {
+            return std::string{operands[random(static_cast<uint32_t>(operands.size()))]};
+        }
+
+        return "(" + std::string{operands[random(static_cast<uint32_t>(operands.size()))]}
+               + operators[random(4)] + generateExpression(depth - 1) + ")";
+    };
+
+    // Push the variables far from the start of the operand values
+    std::vector<std::optional<Evaluator::Value>> operandValues;
+    for (int index = 0; index < 1000; ++index) {
+        operandValues.resize(mSymbolTable.intern("padding" + std::to_string(index)) + 1U);
+    }
+
+    for (int expressionIndex = 0; expressionIndex < 500; ++expressionIndex) {
+        const auto arithmeticExpression
+              = "x = " + generateExpression(Jit::CodeGenerator::cMaxStackDepth - 1);
+        const auto program = compile(arithmeticExpression);
+        ASSERT_NE(program, nullptr);
+
+        const auto nativeFunction = translate(*program);
+        ASSERT_NE(nativeFunction, nullptr) << arithmeticExpression;
+
+        for (const auto variable : operands.substr(0, 8)) {
+            const auto symbolId = mSymbolTable.intern(std::string{variable});
+            operandValues.resize(std::max<std::size_t>(operandValues.size(), symbolId + 1U));
+            operandValues[symbolId] = random(50) == 0
+                                            ? std::numeric_limits<Evaluator::Value>::min()
+                                            : static_cast<Evaluator::Value>(random(2001)) - 1000;
+        }
+
+        Evaluator evaluator(*mAST, operandValues);
+        const auto expectedResult = evaluator.execute();
+
+        if (const auto value = run(nativeFunction, operandValues)) {
+            ASSERT_EQ(Evaluator::Result{*value}, expectedResult) << arithmeticExpression;
+        } else {
+            ASSERT_TRUE(std::holds_alternative<Evaluator::Error>(expectedResult))
+                  << arithmeticExpression;
+        }
+    }
+}
+
+/**
+ * @brief Tests that constants that do not fit in 32 bits are translated
+ */
+TEST_F(CodeGeneratorUnitTest, nativeCodeHandlesConstants)
+{
+    using Bytecode::OpCode;
+
+    const auto a = mSymbolTable.intern("a");
+
+    Bytecode::Program program;
+    program.instructions = {{OpCode::PUSH_VARIABLE, 0},
+                            {OpCode::PUSH_CONSTANT, 0},
+                            {OpCode::MULT, 0},
+                            {OpCode::PUSH_CONSTANT, 1},
+                            {OpCode::ADD, 0}};
+    program.variables = {a};
+    program.constants = {-(Evaluator::Value{1} << 40), Evaluator::Value{5} << 33};
+    program.maxStackDepth = 2;
+
+    const auto nativeFunction = translate(program);
+    ASSERT_NE(nativeFunction, nullptr);
+
+    std::vector<std::optional<Evaluator::Value>> operandValues(a + 1U);
+    operandValues[a] = 3;
+    ASSERT_EQ(run(nativeFunction, operandValues), 3 * program.constants[0] + program.constants[1]);
+}
+
+/**
+ * @brief Tests that native code fails exactly when an operation fails
+ * (overflows, divisions by zero and the division of the lowest value by -1)
+ */
+TEST_F(CodeGeneratorUnitTest, nativeCodeFailsOnFailedOperations)
+{
+    constexpr auto cMaxValue{std::numeric_limits<Evaluator::Value>::max()};
+    constexpr auto cMinValue{std::numeric_limits<Evaluator::Value>::min()};
+    const std::vector<Evaluator::Value> candidateValues{cMinValue, cMaxValue, -1, 0, 7};
+
+    for (const auto& arithmeticExpression :
+         {"x = a+b", "x = a-b", "x = a*b", "x = a/b", "x = b/a", "x = (a+b)/(a-b)"}) {
+        const auto program = compile(arithmeticExpression);
+        ASSERT_NE(program, nullptr);
+
+        const auto nativeFunction = translate(*program);
+        ASSERT_NE(nativeFunction, nullptr) << arithmeticExpression;
+
+        std::vector<std::optional<Evaluator::Value>> operandValues(mSymbolTable.size());
+        for (const auto aValue : candidateValues) {
+            for (const auto bValue : candidateValues) {
+                operandValues[*mSymbolTable.find("a")] = aValue;
+                operandValues[*mSymbolTable.find("b")] = bValue;
+
+                Evaluator evaluator(*mAST, operandValues);
+                const auto expectedResult = evaluator.execute();
+                const auto value = run(nativeFunction, operandValues);
+
+                ASSERT_EQ(value.has_value(),
+                          std::holds_alternative<Evaluator::Value>(expectedResult))
+                      << arithmeticExpression << " with a = " << aValue << ", b = " << bValue;
+                if (value) {
+                    ASSERT_EQ(Evaluator::Result{*value}, expectedResult);
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief Tests that programs whose value stack does not fit in the registers
+ * are not translated
+ */
+TEST_F(CodeGeneratorUnitTest, codeGeneratorRejectsDeepPrograms)
+{
+    std::string arithmeticExpression{"x = "};
+    for (uint32_t depth = 0; depth < Jit::CodeGenerator::cMaxStackDepth; ++depth) {
+        arithmeticExpression += "a-(";
+    }
+    arithmeticExpression += "a" + std::string(Jit::CodeGenerator::cMaxStackDepth, ')');
+
+    const auto program = compile(arithmeticExpression);
+    ASSERT_NE(program, nullptr);
+    ASSERT_GT(program->maxStackDepth, Jit::CodeGenerator::cMaxStackDepth);
+
+    Jit::CodeGenerator codeGenerator(*program);
+    ASSERT_FALSE(codeGenerator.execute());
+}
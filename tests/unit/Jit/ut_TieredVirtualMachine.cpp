@@ -0,0 +1,212 @@
+#include "gtest/gtest.h"
+
+#include "compiler/Compiler.hpp"
+#include "evaluator/Evaluator.hpp"
+#include "jit/TieredVirtualMachine.hpp"
+#include "parser/Parser.hpp"
+
+using namespace ::testing;
+
+namespace {
+/// Amount of evaluations of an expression before it is translated into native code
+constexpr uint32_t cCompilationThreshold{4};
+} // namespace
+
+/**
+ * @brief Test fixture for the TieredVirtualMachine class
+ */
+class TieredVirtualMachineUnitTest : public Test
+{
+protected:
+    /**
+     * @brief Parses an arithmetic expression and compiles its RHS
+     *
+     * @param[in] arithmeticExpression Arithmetic expression to compile
+     *
+     * @return Shared pointer to the compiled program (nullptr on failure)
+     */
+    [[nodiscard]] std::shared_ptr<const Bytecode::Program>
+          compile(const std::string& arithmeticExpression)
+    {
+        Parser parser(arithmeticExpression, mSymbolTable);
+        if (!parser.execute()) {
+            return nullptr;
+        }
+
+        mAST = parser.getASTOfRHS();
+
+        Compiler compiler(*mAST);
+        return compiler.execute() ? compiler.getProgram() : nullptr;
+    }
+
+protected:
+    /// Symbol table used to intern the operands of the compiled expressions
+    Symbols::SymbolTable mSymbolTable;
+
+    /// AST of the last compiled expression (used as reference for the Evaluator)
+    std::shared_ptr<const AST::Tree> mAST;
+
+    /// Tiered virtual machine under test
+    Jit::TieredVirtualMachine mTieredVirtualMachine{cCompilationThreshold};
+};
+
+/**
+ * @brief Tests that expressions are translated into native code once they reach the threshold,
+ * producing the same results as the Evaluator before and after the translation
+ */
+TEST_F(TieredVirtualMachineUnitTest, expressionsAreTranslatedAfterThreshold)
+{
+    const auto program = compile("x = (a*3-b)/(b+7)+a/2+(a-b)*(a+b)");
+    ASSERT_NE(program, nullptr);
+
+    std::vector<std::optional<Evaluator::Value>> operandValues(mSymbolTable.size());
+    Jit::TieredVirtualMachine::ExpressionProfile profile;
+
+    for (int value = 0; value < 20; ++value) {
+        operandValues[*mSymbolTable.find("a")] = value * 13 - 50;
+        operandValues[*mSymbolTable.find("b")] = value;
+
+        const auto result = mTieredVirtualMachine.execute(*program, operandValues, profile);
+
+        Evaluator evaluator(*mAST, operandValues);
+        ASSERT_EQ(result, evaluator.execute());
+        ASSERT_EQ(profile.nativeFunction != nullptr,
+                  static_cast<uint32_t>(value) >= cCompilationThreshold);
+    }
+}
+
+/**
+ * @brief Tests that translated expressions with unresolved dependencies
+ * output their dependencies (through the interpreter)
+ */
+TEST_F(TieredVirtualMachineUnitTest, translatedExpressionsOutputDependencies)
+{
+    const auto program = compile("x = a+b*2+(a-1)*(b+3)-a/4+5");
+    ASSERT_NE(program, nullptr);
+
+    const auto a = *mSymbolTable.find("a");
+    const auto b = *mSymbolTable.find("b");
+    std::vector<std::optional<Evaluator::Value>> operandValues(mSymbolTable.size(), 1);
+    Jit::TieredVirtualMachine::ExpressionProfile profile;
+
+    for (uint32_t evaluation = 0; evaluation <= cCompilationThreshold; ++evaluation) {
+        ASSERT_EQ(mTieredVirtualMachine.execute(*program, operandValues, profile),
+                  Evaluator::Result{8});
+    }
+    ASSERT_NE(profile.nativeFunction, nullptr);
+
+    operandValues[b].reset();
+    ASSERT_EQ(mTieredVirtualMachine.execute(*program, operandValues, profile),
+              Evaluator::Result{Evaluator::Dependencies{b}});
+
+    // Operands beyond the end of the operand values are unresolved as well
+    operandValues.resize(a + 1U);
+    ASSERT_EQ(mTieredVirtualMachine.execute(*program, {operandValues.data(), a}, profile),
+              (Evaluator::Result{Evaluator::Dependencies{a, b}}));
+}
+
+/**
+ * @brief Tests that translated expressions whose evaluation fails output the same errors
+ * as the Evaluator (through the interpreter)
+ */
+TEST_F(TieredVirtualMachineUnitTest, translatedExpressionsOutputErrors)
+{
+    const auto program = compile("x = (a*3-b)/(b+7)+a/2+(a-b)*(a+b)");
+    ASSERT_NE(program, nullptr);
+
+    const auto a = *mSymbolTable.find("a");
+    const auto b = *mSymbolTable.find("b");
+    std::vector<std::optional<Evaluator::Value>> operandValues(mSymbolTable.size(), 1);
+    Jit::TieredVirtualMachine::ExpressionProfile profile;
+
+    for (uint32_t evaluation = 0; evaluation <= cCompilationThreshold; ++evaluation) {
+        ASSERT_TRUE(std::holds_alternative<Evaluator::Value>(
+              mTieredVirtualMachine.execute(*program, operandValues, profile)));
+    }
+    ASSERT_NE(profile.nativeFunction, nullptr);
+
+    // b = -7: division by zero
+    operandValues[b] = -7;
+    ASSERT_EQ(mTieredVirtualMachine.execute(*program, operandValues, profile),
+              Evaluator::Result{Evaluator::Error::DIVISION_BY_ZERO});
+
+    // a = 2^62: a * 3 overflows
+    operandValues[a] = Evaluator::Value{1} << 62;
+    operandValues[b] = 1;
+    ASSERT_EQ(mTieredVirtualMachine.execute(*program, operandValues, profile),
+              Evaluator::Result{Evaluator::Error::INTEGER_OVERFLOW});
+
+    Evaluator evaluator(*mAST, operandValues);
+    ASSERT_EQ(evaluator.execute(), Evaluator::Result{Evaluator::Error::INTEGER_OVERFLOW});
+}
+
+/**
+ * @brief Tests that expressions that are too short or cannot be translated keep being interpreted
+ */
+TEST_F(TieredVirtualMachineUnitTest, untranslatableExpressionsAreInterpreted)
+{
+    const auto shortProgram = compile("x = a*2+1");
+    ASSERT_NE(shortProgram, nullptr);
+    ASSERT_LT(shortProgram->instructions.size(), Jit::TieredVirtualMachine::cMinInstructionCount);
+
+    std::vector<std::optional<Evaluator::Value>> shortOperandValues(mSymbolTable.size(), 5);
+    Jit::TieredVirtualMachine::ExpressionProfile shortProfile;
+
+    for (uint32_t evaluation = 0; evaluation < 2 * cCompilationThreshold; ++evaluation) {
+        ASSERT_EQ(mTieredVirtualMachine.execute(*shortProgram, shortOperandValues, shortProfile),
+                  Evaluator::Result{11});
+    }
+    ASSERT_EQ(shortProfile.nativeFunction, nullptr);
+
+    std::string arithmeticExpression{"x = "};
+    for (uint32_t depth = 0; depth < Jit::CodeGenerator::cMaxStackDepth; ++depth) {
+        arithmeticExpression += "a-(";
+    }
+    arithmeticExpression += "2" + std::string(Jit::CodeGenerator::cMaxStackDepth, ')');
+
+    const auto program = compile(arithmeticExpression);
+    ASSERT_NE(program, nullptr);
+
+    std::vector<std::optional<Evaluator::Value>> operandValues(mSymbolTable.size(), 5);
+    Jit::TieredVirtualMachine::ExpressionProfile profile;
+
+    for (uint32_t evaluation = 0; evaluation < 2 * cCompilationThreshold; ++evaluation) {
+        Evaluator evaluator(*mAST, operandValues);
+        ASSERT_EQ(mTieredVirtualMachine.execute(*program, operandValues, profile),
+                  evaluator.execute());
+    }
+    ASSERT_EQ(profile.nativeFunction, nullptr);
+}
+
+/**
+ * @brief Tests that resetting the profiles of redefined expressions releases their native code,
+ * so that hot expressions can be redefined without mapping more executable memory
+ */
+TEST_F(TieredVirtualMachineUnitTest, resetProfilesReleaseNativeCode)
+{
+    constexpr int redefinitionCount{2000};
+
+    Jit::TieredVirtualMachine::ExpressionProfile profile;
+
+    for (int redefinition = 0; redefinition < redefinitionCount; ++redefinition) {
+        // Expressions of different sizes, so that free blocks are split and merged
+        const auto program = compile(
+              "x = (a*3-b)/(b+7)+a/2+(a-b)*(a+b)+" + std::to_string(redefinition)
+              + (redefinition % 3 == 0 ? "+(a*b-7)/(a+b+2)*(b-a)" : ""));
+        ASSERT_NE(program, nullptr);
+
+        Jit::TieredVirtualMachine::resetProfile(profile);
+        ASSERT_EQ(profile.nativeFunction, nullptr);
+
+        const std::vector<std::optional<Evaluator::Value>> operandValues(mSymbolTable.size(), 3);
+        for (uint32_t evaluation = 0; evaluation <= cCompilationThreshold; ++evaluation) {
+            Evaluator evaluator(*mAST, operandValues);
+            ASSERT_EQ(mTieredVirtualMachine.execute(*program, operandValues, profile),
+                      evaluator.execute());
+        }
+        ASSERT_NE(profile.nativeFunction, nullptr);
+    }
+
+    // Every translation fits in the first chunk (it would take many without reuse)
+    ASSERT_EQ(mTieredVirtualMachine.getCodeArenaSize(), Jit::CodeArena::cChunkSize);
+}
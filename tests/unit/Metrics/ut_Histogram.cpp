@@ -0,0 +1,86 @@
+#include "gtest/gtest.h"
+
+#include <array>
+
+#include "metrics/Histogram.hpp"
+
+using namespace ::testing;
+
+/**
+ * @brief Tests that an empty Histogram reports zero for every statistic
+ */
+TEST(HistogramUnitTest, emptyHistogramReportsZero)
+{
+    const Metrics::Histogram histogram;
+
+    ASSERT_EQ(histogram.getCount(), 0);
+    ASSERT_EQ(histogram.getMin(), 0);
+    ASSERT_EQ(histogram.getMax(), 0);
+    ASSERT_DOUBLE_EQ(histogram.getMean(), 0.0);
+    ASSERT_EQ(histogram.getValueAtPercentile(50.0), 0);
+}
+
+/**
+ * @brief Tests that the Histogram reports small values exactly
+ */
+TEST(HistogramUnitTest, histogramCountsSmallValuesExactly)
+{
+    Metrics::Histogram histogram;
+    for (uint64_t value = 0; value < 32; ++value) {
+        histogram.record(value);
+    }
+
+    ASSERT_EQ(histogram.getCount(), 32);
+    ASSERT_EQ(histogram.getMin(), 0);
+    ASSERT_EQ(histogram.getMax(), 31);
+    ASSERT_DOUBLE_EQ(histogram.getMean(), 15.5);
+    ASSERT_EQ(histogram.getValueAtPercentile(0.0), 0);
+    ASSERT_EQ(histogram.getValueAtPercentile(50.0), 15);
+    ASSERT_EQ(histogram.getValueAtPercentile(90.0), 28);
+    ASSERT_EQ(histogram.getValueAtPercentile(100.0), 31);
+}
+
+/**
+ * @brief Tests that the percentiles reported by the Histogram are never below the exact ones,
+ * and at most 1/16 above them
+ */
+TEST(HistogramUnitTest, histogramBoundsRelativeError)
+{
+    constexpr uint64_t cValueCount{1'000'000};
+
+    Metrics::Histogram histogram;
+    for (uint64_t value = 1; value <= cValueCount; ++value) {
+        histogram.record(value);
+    }
+
+    ASSERT_EQ(histogram.getMin(), 1);
+    ASSERT_EQ(histogram.getMax(), cValueCount);
+    ASSERT_DOUBLE_EQ(histogram.getMean(), 500'000.5);
+
+    constexpr std::array cPercentiles{1.0, 10.0, 50.0, 90.0, 99.0, 99.9, 100.0};
+    for (const auto percentile : cPercentiles) {
+        const auto exactValue
+              = static_cast<uint64_t>(percentile / 100.0 * static_cast<double>(cValueCount));
+        const auto reportedValue = histogram.getValueAtPercentile(percentile);
+
+        ASSERT_GE(reportedValue, exactValue) << "percentile " << percentile;
+        ASSERT_LE(reportedValue, exactValue + exactValue / 16) << "percentile " << percentile;
+    }
+}
+
+/**
+ * @brief Tests that values beyond the tracked ones are still counted and reported as the maximum
+ */
+TEST(HistogramUnitTest, histogramCountsUntrackedValues)
+{
+    constexpr uint64_t cLargeValue{Metrics::Histogram::cMaxTrackedValue * 16};
+
+    Metrics::Histogram histogram;
+    histogram.record(7);
+    histogram.record(cLargeValue);
+
+    ASSERT_EQ(histogram.getCount(), 2);
+    ASSERT_EQ(histogram.getValueAtPercentile(50.0), 7);
+    ASSERT_EQ(histogram.getValueAtPercentile(100.0), cLargeValue);
+    ASSERT_EQ(histogram.getMax(), cLargeValue);
+}
@@ -0,0 +1,143 @@
+#include "gtest/gtest.h"
+
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "metrics/TraceWriter.hpp"
+
+using namespace ::testing;
+
+/**
+ * @brief Test fixture for the TraceWriter class
+ */
+class TraceWriterUnitTest : public Test
+{
+protected:
+    /**
+     * @brief Removes the temporary trace file used by the tests
+     */
+    void TearDown() override
+    {
+        std::filesystem::remove(mFilePath);
+    }
+
+    /**
+     * @brief Reads the temporary trace file used by the tests
+     *
+     * @return Contents of the file
+     */
+    [[nodiscard]] std::string readFile() const
+    {
+        std::ifstream file(mFilePath);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        return contents.str();
+    }
+
+    /**
+     * @brief Counts the occurrences of a string in another one
+     *
+     * @param[in] text String to search in
+     * @param[in] pattern String to count
+     *
+     * @return Amount of (non-overlapping) occurrences
+     */
+    [[nodiscard]] static std::size_t countOccurrences(const std::string& text,
+                                                      const std::string& pattern)
+    {
+        std::size_t count{0};
+        for (auto position = text.find(pattern); position != std::string::npos;
+             position = text.find(pattern, position + pattern.size())) {
+            ++count;
+        }
+        return count;
+    }
+
+protected:
+    /// Temporary trace file of the running test (named after it, and after the process)
+    const std::filesystem::path mFilePath{TempDir() + "ut_TraceWriter_"
+                                          + UnitTest::GetInstance()->current_test_info()->name()
+                                          + "_" + std::to_string(::getpid()) + ".json"};
+};
+
+/**
+ * @brief Tests that the TraceWriter writes the events of every recording thread on its own track,
+ * as complete events with escaped names and their arguments
+ */
+TEST_F(TraceWriterUnitTest, traceWriterWritesCompleteEvents)
+{
+    {
+        Metrics::TraceWriter traceWriter(2);
+        ASSERT_TRUE(traceWriter.open(mFilePath.string(), {"main", "worker"}));
+
+        traceWriter.record(0,
+                           {.name = "a=\"b\"\\c\n",
+                            .category = "instruction",
+                            .startTime = 1500,
+                            .duration = 2042,
+                            .arguments = {{{"trigger", "a"}}}});
+
+        std::thread worker{[&traceWriter] {
+            traceWriter.record(1, {.name = "b", .category = "evaluation", .startTime = 7});
+        }};
+        worker.join();
+    }
+
+    const auto trace = readFile();
+    ASSERT_TRUE(trace.starts_with(R"({"displayTimeUnit":"ns","traceEvents":[)"));
+    ASSERT_TRUE(trace.ends_with("]}\n"));
+
+    ASSERT_EQ(countOccurrences(trace, R"("ph":"M")"), 2);
+    ASSERT_NE(trace.find(R"("tid":1,"args":{"name":"worker"})"), std::string::npos);
+
+    ASSERT_EQ(countOccurrences(trace, R"("ph":"X")"), 2);
+    ASSERT_NE(trace.find(R"("tid":0,"name":"a=\"b\"\\c\u000a","cat":"instruction",)"
+                         R"("ts":1.500,"dur":2.042,"args":{"trigger":"a"}})"),
+              std::string::npos);
+    ASSERT_NE(trace.find(R"("tid":1,"name":"b","cat":"evaluation","ts":0.007,"dur":0.000,)"
+                         R"("args":{}})"),
+              std::string::npos);
+}
+
+/**
+ * @brief Tests that full buffers are handed off (and recycled) without losing any event
+ */
+TEST_F(TraceWriterUnitTest, traceWriterHandsOffFullBuffers)
+{
+    constexpr std::size_t cEventCount{3 * Metrics::TraceWriter::cBufferCapacity + 5};
+
+    {
+        Metrics::TraceWriter traceWriter;
+        ASSERT_TRUE(traceWriter.open(mFilePath.string()));
+
+        for (std::size_t event = 0; event < cEventCount; ++event) {
+            traceWriter.record(0,
+                               {.name = std::to_string(event),
+                                .category = "test",
+                                .startTime = traceWriter.now()});
+        }
+    }
+
+    const auto trace = readFile();
+    ASSERT_EQ(countOccurrences(trace, R"("ph":"X")"), cEventCount);
+    ASSERT_NE(trace.find(R"("name":")" + std::to_string(cEventCount - 1) + "\""),
+              std::string::npos);
+}
+
+/**
+ * @brief Tests that the TraceWriter reports files that cannot be opened,
+ * dropping the events recorded afterwards
+ */
+TEST_F(TraceWriterUnitTest, traceWriterRejectsInvalidFiles)
+{
+    Metrics::TraceWriter traceWriter;
+    ASSERT_FALSE(traceWriter.open((mFilePath / "missing" / "trace.json").string()));
+
+    traceWriter.record(0, {.name = "dropped", .category = "test"});
+    traceWriter.flush();
+}
@@ -0,0 +1,239 @@
+#include "gtest/gtest.h"
+
+#include <functional>
+#include <limits>
+#include <random>
+
+#include "compiler/Compiler.hpp"
+#include "evaluator/VirtualMachine.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "parser/Parser.hpp"
+
+using namespace ::testing;
+
+/**
+ * @brief Test fixture for the Optimizer class
+ */
+class OptimizerUnitTest : public Test
+{
+protected:
+    /**
+     * @brief Parses an arithmetic expression and simplifies the AST of its RHS
+     *
+     * @param[in] arithmeticExpression Arithmetic expression to simplify
+     *
+     * @return True if both parsing and simplification were successful (false otherwise)
+     */
+    [[nodiscard]] bool optimize(const std::string& arithmeticExpression)
+    {
+        Parser parser(arithmeticExpression, mSymbolTable);
+        if (!parser.execute()) {
+            return false;
+        }
+
+        mAST = parser.getASTOfRHS();
+        mOptimizer = std::make_unique<Optimizer>(*mAST);
+
+        return mOptimizer->execute();
+    }
+
+    /**
+     * @brief Compiles the simplified AST (keeping the operands of the original AST)
+     *
+     * @return Shared pointer to the compiled program (nullptr on failure)
+     */
+    [[nodiscard]] std::shared_ptr<const Bytecode::Program> compileOptimizedAST() const
+    {
+        Compiler compiler(*mOptimizer->getOptimizedAST(), mOptimizer->getVariables());
+        return compiler.execute() ? compiler.getProgram() : nullptr;
+    }
+
+    /**
+     * @brief Validates the instructions of the compiled simplified AST
+     *
+     * @param[in] expectedInstructions Expected op codes and operands
+     */
+    void expectOptimizedInstructions(
+          const std::vector<std::pair<Bytecode::OpCode, uint32_t>>& expectedInstructions) const
+    {
+        const auto program = compileOptimizedAST();
+        ASSERT_NE(program, nullptr);
+
+        ASSERT_EQ(program->instructions.size(), expectedInstructions.size());
+        for (std::size_t index = 0; index < expectedInstructions.size(); ++index) {
+            ASSERT_EQ(program->instructions[index].opCode, expectedInstructions[index].first);
+            ASSERT_EQ(program->instructions[index].operand, expectedInstructions[index].second);
+        }
+    }
+
+protected:
+    /// Symbol table used to intern the operands of the expressions
+    Symbols::SymbolTable mSymbolTable;
+
+    /// AST of the RHS of the last parsed expression
+    std::shared_ptr<const AST::Tree> mAST;
+
+    /// Optimizer of the last parsed expression
+    std::unique_ptr<Optimizer> mOptimizer;
+};
+
+/**
+ * @brief Tests that the Optimizer fails when the provided AST is empty
+ */
+TEST_F(OptimizerUnitTest, optimizerFailsWhenASTIsEmpty)
+{
+    const AST::Tree emptyAST;
+
+    Optimizer optimizer(emptyAST);
+    ASSERT_FALSE(optimizer.execute());
+}
+
+/**
+ * @brief Tests that constant subtrees are folded into a single constant,
+ * unless their evaluation fails
+ */
+TEST_F(OptimizerUnitTest, optimizerFoldsConstantSubtrees)
+{
+    using Bytecode::OpCode;
+
+    ASSERT_TRUE(optimize("x = (2*3+1)*y"));
+    ASSERT_EQ(mAST->size(), 7);
+    ASSERT_EQ(mOptimizer->getOptimizedAST()->size(), 3);
+
+    // 7 y *
+    expectOptimizedInstructions({{OpCode::PUSH_LITERAL, 7},
+                                 {OpCode::PUSH_VARIABLE, 0},
+                                 {OpCode::MULT, 0}});
+
+    // Constants that do not fit in a literal are kept as constants (with truncated quotients)
+    ASSERT_TRUE(optimize("x = y+(1-4)/2"));
+    expectOptimizedInstructions({{OpCode::PUSH_VARIABLE, 0},
+                                 {OpCode::PUSH_CONSTANT, 0},
+                                 {OpCode::ADD, 0}});
+    ASSERT_EQ(compileOptimizedAST()->constants, std::vector<int64_t>{-1});
+
+    // Failing subtrees are kept, so that their errors are reported when evaluated
+    ASSERT_TRUE(optimize("x = y+1/0"));
+    ASSERT_EQ(mOptimizer->getOptimizedAST()->size(), mAST->size());
+
+    // 9^20 overflows, so only its first 19 factors are folded: y+(C*9)
+    std::string arithmeticExpression{"x = y+9"};
+    for (int factor = 1; factor < 20; ++factor) {
+        arithmeticExpression += "*9";
+    }
+    ASSERT_TRUE(optimize(arithmeticExpression));
+    ASSERT_EQ(mOptimizer->getOptimizedAST()->size(), 5);
+}
+
+/**
+ * @brief Tests that identities are removed, while the operands remain the ones of the original AST
+ */
+TEST_F(OptimizerUnitTest, optimizerRemovesIdentities)
+{
+    using Bytecode::OpCode;
+
+    ASSERT_TRUE(optimize("x = (a*1+0*b-0)/1+(5-5)"));
+    expectOptimizedInstructions({{OpCode::PUSH_VARIABLE, 0}});
+
+    const std::vector<Symbols::SymbolId> expectedVariables{*mSymbolTable.find("a"),
+                                                           *mSymbolTable.find("b")};
+    ASSERT_EQ(mOptimizer->getVariables(), expectedVariables);
+    ASSERT_EQ(compileOptimizedAST()->variables, expectedVariables);
+
+    // Multiplying a value whose evaluation might fail by zero is not an identity
+    ASSERT_TRUE(optimize("x = a/b*0"));
+    ASSERT_EQ(mOptimizer->getOptimizedAST()->size(), mAST->size());
+}
+
+/**
+ * @brief Tests that chains of operations by constants are merged
+ * only when the merged operation fails exactly when the original ones do
+ */
+TEST_F(OptimizerUnitTest, optimizerMergesConstantChains)
+{
+    using Bytecode::OpCode;
+
+    ASSERT_TRUE(optimize("x = (a+2)+3"));
+    expectOptimizedInstructions(
+          {{OpCode::PUSH_VARIABLE, 0}, {OpCode::PUSH_LITERAL, 5}, {OpCode::ADD, 0}});
+
+    ASSERT_TRUE(optimize("x = 4+(a-6-1)"));
+    expectOptimizedInstructions({{OpCode::PUSH_LITERAL, 4},
+                                 {OpCode::PUSH_VARIABLE, 0},
+                                 {OpCode::PUSH_LITERAL, 7},
+                                 {OpCode::SUB, 0},
+                                 {OpCode::ADD, 0}});
+
+    ASSERT_TRUE(optimize("x = 2*(4*a)*8"));
+    expectOptimizedInstructions(
+          {{OpCode::PUSH_VARIABLE, 0}, {OpCode::PUSH_LITERAL, 64}, {OpCode::MULT, 0}});
+
+    ASSERT_TRUE(optimize("x = a/3/5"));
+    expectOptimizedInstructions(
+          {{OpCode::PUSH_VARIABLE, 0}, {OpCode::PUSH_LITERAL, 15}, {OpCode::DIV, 0}});
+
+    // Mixed operations, and negative scaling constants, are kept
+    for (const auto* arithmeticExpression : {"x = a*3/2", "x = a*(0-1)*(0-1)", "x = (a/2)*2"}) {
+        ASSERT_TRUE(optimize(arithmeticExpression));
+        ASSERT_EQ(compileOptimizedAST()->instructions.size(), 5) << arithmeticExpression;
+    }
+}
+
+/**
+ * @brief Tests that simplified expressions evaluate to the same values as the original ones
+ */
+TEST_F(OptimizerUnitTest, optimizedExpressionsPreserveValues)
+{
+    std::mt19937 randomEngine{42};
+    const auto random = [&](const uint32_t bound) {
+        return std::uniform_int_distribution<uint32_t>{0, bound - 1}(randomEngine);
+    };
+
+    constexpr std::string_view operators{"+-*/"};
+    constexpr std::string_view operands{"ab0124"};
+
+    // Helper lambda used to generate a random expression (as an infix string)
+    std::function<std::string(uint32_t)> generateExpression = [&](const uint32_t depth) {
+        if (depth == 0 || random(4) == 0) {
+            return std::string{operands[random(static_cast<uint32_t>(operands.size()))]};
+        }
+
+        return "(" + generateExpression(depth - 1) + operators[random(4)]
+               + generateExpression(depth - 1) + ")";
+    };
+
+    const auto a = mSymbolTable.intern("a");
+    const auto b = mSymbolTable.intern("b");
+    VirtualMachine virtualMachine;
+
+    for (int expressionIndex = 0; expressionIndex < 2000; ++expressionIndex) {
+        const auto arithmeticExpression = "x = " + generateExpression(5);
+        ASSERT_TRUE(optimize(arithmeticExpression)) << arithmeticExpression;
+
+        Compiler originalCompiler(*mAST);
+        ASSERT_TRUE(originalCompiler.execute());
+        const auto originalProgram = originalCompiler.getProgram();
+        const auto optimizedProgram = compileOptimizedAST();
+        ASSERT_NE(optimizedProgram, nullptr);
+        ASSERT_EQ(optimizedProgram->variables, originalProgram->variables);
+
+        constexpr auto cMaxValue{std::numeric_limits<Evaluator::Value>::max()};
+        constexpr auto cMinValue{std::numeric_limits<Evaluator::Value>::min()};
+        for (const auto& [aValue, bValue] : {std::pair<Evaluator::Value, Evaluator::Value>{0, 0},
+                                             {3, -7},
+                                             {-5, 2},
+                                             {1 << 26, 3},
+                                             {123457, -(1 << 30)},
+                                             {cMaxValue, -1},
+                                             {cMinValue, 2},
+                                             {cMaxValue / 3, cMinValue / 5}}) {
+            std::vector<std::optional<Evaluator::Value>> operandValues(std::max(a, b) + 1U);
+            operandValues[a] = aValue;
+            operandValues[b] = bValue;
+
+            ASSERT_EQ(virtualMachine.execute(*optimizedProgram, operandValues),
+                      virtualMachine.execute(*originalProgram, operandValues))
+                  << arithmeticExpression << " with a = " << aValue << ", b = " << bValue;
+        }
+    }
+}
@@ -18,7 +18,7 @@ protected:
     void testInputs(const bool isSuccessScenario)
     {
         for (const auto& inputString : mTestInputs) {
-            Parser parser(inputString);
+            Parser parser(inputString, mSymbolTable);
             ASSERT_EQ(isSuccessScenario, parser.execute());
         }
     }
@@ -26,40 +26,58 @@ protected:
     /**
      * @brief Compares two ASTs to determine if they are identical
      *
-     * @param[in] rootNodeA Reference to the root node of the first AST
-     * @param[in] rootNodeB Reference to the root node of the second AST
+     * @param[in] astA Reference to the first AST
+     * @param[in] nodeIndexA Index of the node of the first AST to compare
+     * @param[in] astB Reference to the second AST
+     * @param[in] nodeIndexB Index of the node of the second AST to compare
      *
      * @return True if the ASTs are identical (false otherwise)
      */
-    [[nodiscard]] bool areASTsIdentical(const std::unique_ptr<AST::Node>& rootNodeA,
-                                        const std::unique_ptr<AST::Node>& rootNodeB)
+    [[nodiscard]] bool areASTsIdentical(const AST::Tree& astA,
+                                        const AST::NodeIndex nodeIndexA,
+                                        const AST::Tree& astB,
+                                        const AST::NodeIndex nodeIndexB)
     {
-        return (!rootNodeA && !rootNodeB)
-               || ((rootNodeA && rootNodeB)
-                   && (rootNodeA->getNodeValue() == rootNodeB->getNodeValue())
-                   && areASTsIdentical(rootNodeA->getReferenceToLeftNodePointer(),
-                                       rootNodeB->getReferenceToLeftNodePointer())
-                   && areASTsIdentical(rootNodeA->getReferenceToRightNodePointer(),
-                                       rootNodeB->getReferenceToRightNodePointer()));
+        if (nodeIndexA == AST::cInvalidNodeIndex || nodeIndexB == AST::cInvalidNodeIndex) {
+            return nodeIndexA == nodeIndexB;
+        }
+
+        const auto& nodeA = astA.getNode(nodeIndexA);
+        const auto& nodeB = astB.getNode(nodeIndexB);
+
+        return (nodeA.getNodeType() == nodeB.getNodeType())
+               && (nodeA.getNodeValue() == nodeB.getNodeValue())
+               && areASTsIdentical(
+                     astA, nodeA.getLeftNodeIndex(), astB, nodeB.getLeftNodeIndex())
+               && areASTsIdentical(
+                     astA, nodeA.getRightNodeIndex(), astB, nodeB.getRightNodeIndex());
     }
 
     /**
      * @brief Counts the total number of nodes inside an AST
      *
-     * @param[in] rootNode Reference to the root node of the AST
+     * @param[in] ast Reference to the AST
+     * @param[in] nodeIndex Index of the node to start counting from
      *
      * @return Number of nodes of the AST
      */
-    [[nodiscard]] uint32_t getNumberOfNodes(const std::unique_ptr<AST::Node>& rootNode)
+    [[nodiscard]] uint32_t getNumberOfNodes(const AST::Tree& ast, const AST::NodeIndex nodeIndex)
     {
-        return !rootNode ? 0
-                         : 1 + getNumberOfNodes(rootNode->getReferenceToLeftNodePointer())
-                                 + getNumberOfNodes(rootNode->getReferenceToRightNodePointer());
+        if (nodeIndex == AST::cInvalidNodeIndex) {
+            return 0;
+        }
+
+        const auto& node = ast.getNode(nodeIndex);
+        return 1 + getNumberOfNodes(ast, node.getLeftNodeIndex())
+               + getNumberOfNodes(ast, node.getRightNodeIndex());
     }
 
 protected:
     /// List of inputs to be tested
     std::vector<std::string> mTestInputs;
+
+    /// Symbol table used to intern the operands found by the parser
+    Symbols::SymbolTable mSymbolTable;
 };
 
 /**
@@ -81,11 +99,13 @@ TEST_F(ParserUnitTest, parserFailsWhenNegativeNumbersAreProvided)
 }
 
 /**
- * @brief Tests that the Parser fails when the input has integers with more than one digit
+ * @brief Tests that the Parser fails when the input has integers that do not fit in 64 bits
  */
 TEST_F(ParserUnitTest, parserFailsWhenLiteralsAreTooLarge)
 {
-    mTestInputs = {"a = 42", "b = 1337", "c = 11*11+3-(20)", "d = 10  +  1"};
+    mTestInputs = {"a = 9223372036854775808",
+                   "b = 99999999999999999999*2",
+                   "c = 1+(18446744073709551616)"};
     testInputs(false);
 }
 
@@ -129,6 +149,15 @@ TEST_F(ParserUnitTest, parserFailsWhenOperatorsAreIncorrectlyUsed)
     testInputs(false);
 }
 
+/**
+ * @brief Tests that the Parser fails when operands are not separated by an operator
+ */
+TEST_F(ParserUnitTest, parserFailsWhenOperandsAreAdjacent)
+{
+    mTestInputs = {"a = b c", "b = 2a", "c = a 2", "d = (a)(b)", "e = 1 = 2", "f = 12 34"};
+    testInputs(false);
+}
+
 /**
  * @brief Tests that the Parser succeeds when the input has the correct syntax
  */
@@ -140,10 +169,52 @@ TEST_F(ParserUnitTest, parserSucceedsWhenValidInputIsProvided)
                    "d = 5+(1*2)",
                    "e = 2+3* 1 - 2",
                    "f = 7+3*(1/(2/(3+1)-1))",
-                   "g = (2*(3+6/2)/4)"};
+                   "g = (2*(3+6/2)/4)",
+                   "total = price*quantity + 42",
+                   "_tmp2 = (x_1 + 1337) / 10",
+                   "h = 9223372036854775807 - a1"};
     testInputs(true);
 }
 
+/**
+ * @brief Tests that the Parser fails when the LHS is not a single identifier
+ */
+TEST_F(ParserUnitTest, parserFailsWhenLHSIsInvalid)
+{
+    mTestInputs = {"= 1", "2a = 1", "a b = 1", "a+b = 1", "(a) = 1"};
+    testInputs(false);
+}
+
+/**
+ * @brief Tests that the Parser handles identifiers and literals spanning multiple characters
+ * (keeping the literals that do not fit in a node as constants)
+ */
+TEST_F(ParserUnitTest, parserHandlesMultiCharacterOperands)
+{
+    Parser parser("total_2 = price * 4294967296 + 42", mSymbolTable);
+    ASSERT_TRUE(parser.execute());
+    ASSERT_EQ(parser.getOperandOfLHS(), "total_2");
+    ASSERT_EQ(mSymbolTable.find("price"), 0);
+
+    AST::Tree expectedAST;
+    {
+        const auto price = expectedAST.addVariableNode(0);
+        const auto constant = expectedAST.addConstantNode(4294967296);
+        const auto multiplication = expectedAST.addOperatorNode('*', price, constant);
+        const auto fortyTwo = expectedAST.addLiteralNode(42);
+        expectedAST.addOperatorNode('+', multiplication, fortyTwo);
+    }
+
+    const auto retrievedAST = parser.getASTOfRHS();
+    ASSERT_NE(retrievedAST, nullptr);
+    ASSERT_EQ(retrievedAST->size(), expectedAST.size());
+    ASSERT_TRUE(areASTsIdentical(*retrievedAST,
+                                 retrievedAST->getRootNodeIndex(),
+                                 expectedAST,
+                                 expectedAST.getRootNodeIndex()));
+    ASSERT_EQ(retrievedAST->getConstantValue(retrievedAST->getNode(1)), 4294967296);
+}
+
 /**
  * @brief Tests that the Parser is able to retrieve a correct LHS operand
  * and constructs a valid RHS AST from the input
@@ -152,15 +223,17 @@ TEST_F(ParserUnitTest, parserRetrievesCorrectOperandAndAST)
 {
     constexpr auto validArithmeticExpression{"a = 5+(1*2)"};
     constexpr auto expectedOperand{"a"};
-    const auto expectedAST = std::make_unique<AST::Node>(
-          '+', // First Level
-          std::make_unique<AST::Node>('5'),
-          std::make_unique<AST::Node>('*', // Second Level
-                                      std::make_unique<AST::Node>('1'),
-                                      std::make_unique<AST::Node>('2')));
+    AST::Tree expectedAST;
+    {
+        const auto five = expectedAST.addLiteralNode(5);
+        const auto one = expectedAST.addLiteralNode(1);
+        const auto two = expectedAST.addLiteralNode(2);
+        const auto multiplication = expectedAST.addOperatorNode('*', one, two); // Second Level
+        expectedAST.addOperatorNode('+', five, multiplication);                 // First Level
+    }
     constexpr auto expectedASTNodeCount{5};
 
-    Parser parser(validArithmeticExpression);
+    Parser parser(validArithmeticExpression, mSymbolTable);
     ASSERT_TRUE(parser.execute());
     ASSERT_EQ(parser.getOperandOfLHS(), expectedOperand);
 
@@ -169,7 +242,9 @@ TEST_F(ParserUnitTest, parserRetrievesCorrectOperandAndAST)
     ASSERT_NE(retrievedAST, nullptr);
     ASSERT_FALSE(retrievedAST->empty());
 
-    const auto& astRootNode = retrievedAST->top();
-    ASSERT_EQ(getNumberOfNodes(astRootNode), expectedASTNodeCount);
-    ASSERT_TRUE(areASTsIdentical(astRootNode, expectedAST));
+    const auto astRootNodeIndex = retrievedAST->getRootNodeIndex();
+    ASSERT_EQ(retrievedAST->size(), expectedASTNodeCount);
+    ASSERT_EQ(getNumberOfNodes(*retrievedAST, astRootNodeIndex), expectedASTNodeCount);
+    ASSERT_TRUE(areASTsIdentical(
+          *retrievedAST, astRootNodeIndex, expectedAST, expectedAST.getRootNodeIndex()));
 }
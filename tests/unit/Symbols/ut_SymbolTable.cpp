@@ -0,0 +1,108 @@
+#include "gtest/gtest.h"
+
+#include <string>
+
+#include "symbols/SymbolTable.hpp"
+
+using namespace ::testing;
+
+/**
+ * @brief Tests that the SymbolTable assigns dense identifiers, in order of first appearance,
+ * and returns the same identifier every time a name is interned again
+ */
+TEST(SymbolTableUnitTest, symbolTableAssignsDenseIdentifiers)
+{
+    Symbols::SymbolTable symbolTable;
+
+    ASSERT_EQ(symbolTable.intern("b"), 0);
+    ASSERT_EQ(symbolTable.intern("a"), 1);
+    ASSERT_EQ(symbolTable.intern("b"), 0);
+    ASSERT_EQ(symbolTable.intern("c"), 2);
+    ASSERT_EQ(symbolTable.size(), 3);
+
+    ASSERT_EQ(symbolTable.getName(0), "b");
+    ASSERT_EQ(symbolTable.getName(1), "a");
+    ASSERT_EQ(symbolTable.getName(2), "c");
+}
+
+/**
+ * @brief Tests that the SymbolTable only finds names that were previously interned
+ */
+TEST(SymbolTableUnitTest, symbolTableFindsInternedNamesOnly)
+{
+    Symbols::SymbolTable symbolTable;
+
+    ASSERT_FALSE(symbolTable.find("x").has_value());
+
+    const auto symbolId = symbolTable.intern("x");
+
+    ASSERT_EQ(symbolTable.find("x"), symbolId);
+    ASSERT_FALSE(symbolTable.find("y").has_value());
+    ASSERT_EQ(symbolTable.size(), 1);
+}
+
+/**
+ * @brief Tests that the SymbolTable keeps finding every name as the lookup table grows,
+ * including names sharing prefixes and names of different lengths
+ */
+TEST(SymbolTableUnitTest, symbolTableScalesToManyNames)
+{
+    constexpr Symbols::SymbolId cNameCount{100000};
+    Symbols::SymbolTable symbolTable;
+
+    const auto createName = [](const Symbols::SymbolId index) {
+        return "operand_" + std::to_string(index);
+    };
+
+    for (Symbols::SymbolId index = 0; index < cNameCount; ++index) {
+        ASSERT_EQ(symbolTable.intern(createName(index)), index);
+    }
+    ASSERT_EQ(symbolTable.size(), cNameCount);
+
+    for (Symbols::SymbolId index = 0; index < cNameCount; ++index) {
+        ASSERT_EQ(symbolTable.intern(createName(index)), index);
+        ASSERT_EQ(symbolTable.find(createName(index)), index);
+        ASSERT_EQ(symbolTable.getName(index), createName(index));
+    }
+
+    ASSERT_FALSE(symbolTable.find("operand_").has_value());
+    ASSERT_FALSE(symbolTable.find(createName(cNameCount)).has_value());
+    ASSERT_FALSE(symbolTable.find("").has_value());
+    ASSERT_EQ(symbolTable.size(), cNameCount);
+}
+
+/**
+ * @brief Tests that truncating the SymbolTable forgets the most recent names only,
+ * whose identifiers are then assigned again to the next interned names
+ */
+TEST(SymbolTableUnitTest, symbolTableForgetsTruncatedNames)
+{
+    constexpr Symbols::SymbolId cNameCount{1000};
+    constexpr Symbols::SymbolId cKeptNameCount{300};
+    Symbols::SymbolTable symbolTable;
+
+    const auto createName = [](const Symbols::SymbolId index) {
+        return "operand_" + std::to_string(index);
+    };
+
+    for (Symbols::SymbolId index = 0; index < cNameCount; ++index) {
+        ASSERT_EQ(symbolTable.intern(createName(index)), index);
+    }
+
+    symbolTable.truncate(cKeptNameCount);
+    ASSERT_EQ(symbolTable.size(), cKeptNameCount);
+
+    for (Symbols::SymbolId index = 0; index < cNameCount; ++index) {
+        if (index < cKeptNameCount) {
+            ASSERT_EQ(symbolTable.find(createName(index)), index);
+            ASSERT_EQ(symbolTable.getName(index), createName(index));
+        } else {
+            ASSERT_FALSE(symbolTable.find(createName(index)).has_value());
+        }
+    }
+
+    ASSERT_EQ(symbolTable.intern("x"), cKeptNameCount);
+    ASSERT_EQ(symbolTable.getName(cKeptNameCount), "x");
+    ASSERT_EQ(symbolTable.find("x"), cKeptNameCount);
+    ASSERT_EQ(symbolTable.size(), cKeptNameCount + 1);
+}
@@ -0,0 +1,95 @@
+#include "gtest/gtest.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+#include "utils/PersistentVector.hpp"
+
+namespace {
+/// Alias representing the tested vector
+using Vector = Utils::PersistentVector<int>;
+
+/**
+ * @brief Creates a new version of a vector with a single entry updated
+ *
+ * @param[in] vector Vector to update
+ * @param[in] index Index of the entry
+ * @param[in] value New value of the entry
+ *
+ * @return Updated vector
+ */
+Vector with(const Vector& vector, const std::size_t index, const int value)
+{
+    const std::vector<Vector::Update> updates{{index, value}};
+    return vector.with(updates);
+}
+} // namespace
+
+/**
+ * @brief Tests that updating a vector leaves every previous version untouched
+ */
+TEST(PersistentVectorUnitTest, updatesKeepPreviousVersions)
+{
+    std::vector<Vector> versions{Vector{}};
+    std::vector<std::map<std::size_t, int>> expectedVersions{{}};
+
+    // Indices spread over several levels of the trie (growing it along the way)
+    for (const std::size_t index : {0U, 5U, 31U, 32U, 1000U, 5U, 40000U, 0U, 1U << 20U}) {
+        const auto value = static_cast<int>(versions.size());
+        versions.push_back(with(versions.back(), index, value));
+
+        expectedVersions.push_back(expectedVersions.back());
+        expectedVersions.back()[index] = value;
+    }
+
+    for (std::size_t version = 0; version < versions.size(); ++version) {
+        for (const std::size_t index : {0U, 1U, 5U, 31U, 32U, 33U, 1000U, 40000U, 1U << 20U}) {
+            const auto& expectedValues = expectedVersions[version];
+            const auto expectedItr = expectedValues.find(index);
+
+            ASSERT_EQ(versions[version].get(index),
+                      expectedItr != expectedValues.end() ? expectedItr->second : 0)
+                  << "version " << version << ", index " << index;
+        }
+    }
+    ASSERT_EQ(versions.back().size(), (1U << 20U) + 1);
+}
+
+/**
+ * @brief Tests that batched updates are applied at once
+ */
+TEST(PersistentVectorUnitTest, batchedUpdatesAreApplied)
+{
+    const std::vector<Vector::Update> updates{{1, 1}, {2, 2}, {40, 3}, {1100, 4}};
+    const auto vector = Vector{}.with(updates);
+
+    for (const auto& [index, value] : updates) {
+        ASSERT_EQ(vector.get(index), value);
+    }
+    ASSERT_EQ(vector.get(3), 0);
+    ASSERT_EQ(vector.size(), 1101);
+}
+
+/**
+ * @brief Tests that only the differing entries of two versions are reported,
+ * including versions of different sizes
+ */
+TEST(PersistentVectorUnitTest, differencesBetweenVersionsAreReported)
+{
+    const auto base = with(with(Vector{}, 3, 1), 70, 2);
+    const auto updated = with(with(with(base, 70, 5), 4000, 6), 3, 1);
+
+    std::set<std::size_t> differences;
+    updated.forEachDifference(base, [&](const std::size_t index) { differences.insert(index); });
+    ASSERT_EQ(differences, (std::set<std::size_t>{70, 4000}));
+
+    differences.clear();
+    Vector{}.forEachDifference(updated,
+                               [&](const std::size_t index) { differences.insert(index); });
+    ASSERT_EQ(differences, (std::set<std::size_t>{3, 70, 4000}));
+
+    differences.clear();
+    updated.forEachDifference(updated, [&](const std::size_t index) { differences.insert(index); });
+    ASSERT_TRUE(differences.empty());
+}